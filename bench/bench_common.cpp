@@ -0,0 +1,52 @@
+#include "bench_common.hpp"
+#include "dataset_generator.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+std::filesystem::path bench_directory() {
+  static const std::filesystem::path directory = [] {
+    auto path = std::filesystem::temp_directory_path() / "taskproc_bench";
+    std::filesystem::create_directories(path);
+    return path;
+  }();
+  return directory;
+}
+
+const BenchDataset &bench_dataset(size_t task_count) {
+  static std::map<size_t, std::unique_ptr<BenchDataset>> datasets;
+  auto &dataset = datasets[task_count];
+  if (dataset)
+    return *dataset;
+
+  dataset = std::make_unique<BenchDataset>();
+  dataset->tasks = generate_tasks(DatasetOptions{task_count, 42});
+  const std::string stem = "tasks_" + std::to_string(task_count);
+  dataset->csv = bench_directory() / (stem + ".csv");
+  dataset->json = bench_directory() / (stem + ".json");
+  dataset->ndjson = bench_directory() / (stem + ".jsonl");
+  for (const auto &path : {dataset->csv, dataset->json, dataset->ndjson}) {
+    write_dataset(path, dataset->tasks);
+  }
+  return *dataset;
+}
+
+void dataset_sizes(benchmark::internal::Benchmark *bench) {
+  const char *env = std::getenv("TASKPROC_BENCH_SIZES");
+  std::string_view sizes = env && *env ? env : "10000,1000000";
+  while (!sizes.empty()) {
+    const size_t comma = sizes.find(',');
+    const std::string_view item = sizes.substr(0, comma);
+    long long size = 0;
+    auto [end, ec] = std::from_chars(item.data(), item.data() + item.size(), size);
+    if (ec == std::errc{} && end == item.data() + item.size() && size > 0)
+      bench->Arg(size);
+    if (comma == std::string_view::npos)
+      break;
+    sizes.remove_prefix(comma + 1);
+  }
+  bench->Unit(benchmark::kMillisecond);
+}
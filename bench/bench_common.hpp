@@ -0,0 +1,34 @@
+#pragma once
+#include "core/task.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+/// A generated dataset, kept in memory and on disk in every reader format
+struct BenchDataset {
+  std::vector<Task> tasks;
+  std::filesystem::path csv;
+  std::filesystem::path json;
+  std::filesystem::path ndjson;
+};
+
+/**
+ * @brief Dataset of `task_count` tasks, generated and written on first use.
+ * @post Files live under the system temp directory and are reused for the
+ *       rest of the run. Each run writes them again; generation is deterministic,
+ *       so every run reads identical files.
+ */
+const BenchDataset &bench_dataset(size_t task_count);
+
+/**
+ * @brief Register one run per dataset size.
+ *
+ * Sizes come from the comma-separated `TASKPROC_BENCH_SIZES` environment
+ * variable (default "10000,1000000"); set it to "10000,1000000,10000000" to
+ * include the 10M-task dataset.
+ */
+void dataset_sizes(benchmark::internal::Benchmark *bench);
+
+/// Directory scratch files are written to
+std::filesystem::path bench_directory();
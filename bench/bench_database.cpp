@@ -0,0 +1,144 @@
+#include "bench_common.hpp"
+#include "core/database.hpp"
+#include "core/expr_parser.hpp"
+#include "core/filter_expr.hpp"
+#include <string_view>
+
+namespace {
+// Filters covering the indexed, compiled-predicate and compound paths
+constexpr std::string_view INDEXED_FILTER = "status=todo";
+constexpr std::string_view RANGE_FILTER = "priority>=4";
+constexpr std::string_view TEXT_FILTER = "title!=Fix login page #1";
+constexpr std::string_view COMPOUND_FILTER = "status IN (todo, in-progress) AND (priority>=4 OR assignee=user0)";
+
+Database loaded_database(size_t task_count) {
+  Database database;
+  database.load(bench_dataset(task_count).tasks);
+  return database;
+}
+
+void BM_Database_Load(benchmark::State &state) {
+  const auto &tasks = bench_dataset(static_cast<size_t>(state.range(0))).tasks;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<Task> copy = tasks;
+    Database database;
+    state.ResumeTiming();
+
+    database.load(std::move(copy));
+    benchmark::DoNotOptimize(database.total_task_count());
+
+    state.PauseTiming();
+    database = Database{}; // keep the teardown out of the measurement
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks.size()));
+}
+
+void BM_Database_ApplyFilter(benchmark::State &state, std::string_view expr) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+  const auto filter = ExpressionParser::parse_filter_expr(expr);
+  if (!filter) {
+    state.SkipWithError("filter does not parse");
+    return;
+  }
+
+  for (auto _ : state) {
+    database.reset_view();
+    database.apply_filter(*filter);
+    benchmark::DoNotOptimize(database.view_task_count());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+
+void BM_Database_ApplySort(benchmark::State &state, SortField field) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+
+  for (auto _ : state) {
+    database.reset_view();
+    database.apply_sort(SortSpec{field, SortDirection::Descending});
+    benchmark::DoNotOptimize(database.current_view().data()); // sorting is lazy; materialize it
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+
+// Multi-key order only (IDs, no Task rebuild): packed keys plus radix sort
+void BM_Database_SortKeys(benchmark::State &state, std::string_view expr) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+  const auto keys = ExpressionParser::parse_sort_keys(expr);
+  if (!keys) {
+    state.SkipWithError("sort keys do not parse");
+    return;
+  }
+
+  for (auto _ : state) {
+    database.reset_view();
+    database.apply_sort(*keys);
+    benchmark::DoNotOptimize(database.current_view_ids().data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+
+// First page of a freshly sorted view: top-K selection instead of a full sort
+void BM_Database_TopPage(benchmark::State &state, SortField field) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+
+  for (auto _ : state) {
+    database.reset_view();
+    database.apply_sort(SortSpec{field, SortDirection::Descending});
+    benchmark::DoNotOptimize(database.view_page(0, 50).data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+
+// status_stats, average_priority and overdue_count over a view with dense and sparse chunks
+void BM_Database_Aggregates(benchmark::State &state) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+  database.apply_filter(*ExpressionParser::parse_filter_expr(RANGE_FILTER));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(database.status_stats());
+    benchmark::DoNotOptimize(database.average_priority());
+    benchmark::DoNotOptimize(database.overdue_count("2024-06-01"));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * database.view_task_count()));
+}
+
+void BM_Database_ReplayHistory(benchmark::State &state) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+  Database database = loaded_database(task_count);
+  const std::vector<ViewAction> history{
+      {ViewOpType::Filter, "status IN (todo, in-progress)"},
+      {ViewOpType::FindByTag, "bug"},
+      {ViewOpType::Sort, "priority desc"},
+      {ViewOpType::Filter, "priority>=2"},
+      {ViewOpType::Sort, "created_date"},
+  };
+
+  for (auto _ : state) {
+    database.replay_history(history);
+    benchmark::DoNotOptimize(database.current_view().data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+} // anonymous namespace
+
+BENCHMARK(BM_Database_Load)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplyFilter, indexed_status, INDEXED_FILTER)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplyFilter, priority_range, RANGE_FILTER)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplyFilter, title_not_equal, TEXT_FILTER)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplyFilter, compound, COMPOUND_FILTER)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplySort, priority, SortField::Priority)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplySort, title, SortField::Title)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_ApplySort, created_date, SortField::CreatedDate)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_SortKeys, due_priority, "due_date, priority desc")->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_SortKeys, title_due_priority, "title, due_date, priority desc")->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_TopPage, priority, SortField::Priority)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Database_TopPage, title, SortField::Title)->Apply(dataset_sizes);
+BENCHMARK(BM_Database_Aggregates)->Apply(dataset_sizes);
+BENCHMARK(BM_Database_ReplayHistory)->Apply(dataset_sizes);
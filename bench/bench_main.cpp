@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+// Pass --benchmark_out=<file> --benchmark_out_format=json for machine-readable results
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#include "bench_common.hpp"
+#include "io/csv_reader.hpp"
+#include "io/json_reader.hpp"
+#include "io/ndjson_reader.hpp"
+#include "io/parallel_csv_reader.hpp"
+
+namespace {
+template <typename Reader>
+void read_file(benchmark::State &state, const std::filesystem::path &path) {
+  Reader reader;
+  size_t tasks = 0;
+  for (auto _ : state) {
+    auto result = reader.read_tasks(path.string());
+    tasks = result.size();
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * tasks));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+}
+
+void BM_CSVReader_ReadTasks(benchmark::State &state) {
+  read_file<CSVReader>(state, bench_dataset(static_cast<size_t>(state.range(0))).csv);
+}
+
+void BM_ParallelCSVReader_ReadTasks(benchmark::State &state) {
+  read_file<ParallelCSVReader>(state, bench_dataset(static_cast<size_t>(state.range(0))).csv);
+}
+
+void BM_JSONReader_ReadTasks(benchmark::State &state) {
+  read_file<JSONReader>(state, bench_dataset(static_cast<size_t>(state.range(0))).json);
+}
+
+void BM_NDJSONReader_ReadTasks(benchmark::State &state) {
+  read_file<NDJSONReader>(state, bench_dataset(static_cast<size_t>(state.range(0))).ndjson);
+}
+} // anonymous namespace
+
+BENCHMARK(BM_CSVReader_ReadTasks)->Apply(dataset_sizes);
+BENCHMARK(BM_ParallelCSVReader_ReadTasks)->Apply(dataset_sizes)->UseRealTime();
+BENCHMARK(BM_JSONReader_ReadTasks)->Apply(dataset_sizes);
+BENCHMARK(BM_NDJSONReader_ReadTasks)->Apply(dataset_sizes)->UseRealTime();
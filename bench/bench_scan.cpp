@@ -0,0 +1,74 @@
+#include "bench_common.hpp"
+#include "core/row_bitmap.hpp"
+#include "core/scan_kernels.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+constexpr std::int32_t PRIORITY_TARGET = 4; // "priority>=4", about a fifth of the rows
+
+std::vector<std::int32_t> priority_column(size_t task_count) {
+  const auto &tasks = bench_dataset(task_count).tasks;
+  std::vector<std::int32_t> column(tasks.size());
+  std::transform(tasks.begin(), tasks.end(), column.begin(), [](const Task &task) { return task.priority; });
+  return column;
+}
+
+// Baseline: the per-row `remove_if` compaction over a row vector that filters used before bitmaps and kernels
+void BM_Scan_RemoveIf(benchmark::State &state) {
+  const auto column = priority_column(static_cast<size_t>(state.range(0)));
+  std::vector<std::uint32_t> rows(column.size());
+
+  for (auto _ : state) {
+    std::iota(rows.begin(), rows.end(), 0u);
+    const auto kept = std::remove_if(
+        rows.begin(), rows.end(), [&column](std::uint32_t row) { return column[row] < PRIORITY_TARGET; });
+    benchmark::DoNotOptimize(kept);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+}
+
+// Match bitmap of the whole column, one RowBitmap chunk per call
+void BM_Scan_Compare(benchmark::State &state, const ScanKernels &(*kernels)()) {
+  const auto column = priority_column(static_cast<size_t>(state.range(0)));
+  const auto rows = static_cast<std::uint32_t>(column.size());
+  std::vector<std::uint64_t> words((rows + 63) / 64);
+  state.SetLabel(std::string(kernels().isa));
+
+  for (auto _ : state) {
+    for (std::uint32_t base = 0; base < rows; base += RowBitmap::CHUNK) {
+      kernels().compare(column.data() + base,
+                        std::min(RowBitmap::CHUNK, rows - base),
+                        ScanOp::GreaterEqual,
+                        PRIORITY_TARGET,
+                        std::nullopt,
+                        words.data() + base / 64);
+    }
+    benchmark::DoNotOptimize(words.data());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+}
+
+// Sum of the priorities under a half-full membership mask
+void BM_Scan_MaskedSum(benchmark::State &state, const ScanKernels &(*kernels)()) {
+  const auto column = priority_column(static_cast<size_t>(state.range(0)));
+  const auto rows = static_cast<std::uint32_t>(column.size());
+  std::vector<std::uint64_t> words((rows + 63) / 64, 0x5555555555555555u);
+  state.SetLabel(std::string(kernels().isa));
+
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (std::uint32_t base = 0; base < rows; base += RowBitmap::CHUNK) {
+      sum += kernels().masked_sum(column.data() + base, std::min(RowBitmap::CHUNK, rows - base), words.data() + base / 64);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+}
+} // anonymous namespace
+
+BENCHMARK(BM_Scan_RemoveIf)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Scan_Compare, scalar, scalar_scan_kernels)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Scan_Compare, dispatched, scan_kernels)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Scan_MaskedSum, scalar, scalar_scan_kernels)->Apply(dataset_sizes);
+BENCHMARK_CAPTURE(BM_Scan_MaskedSum, dispatched, scan_kernels)->Apply(dataset_sizes);
@@ -0,0 +1,33 @@
+#include "bench_common.hpp"
+#include "io/view_storage.hpp"
+#include <numeric>
+
+namespace {
+// Persist a ten-action history plus a materialized view of every task
+void BM_ViewStorage_Persist(benchmark::State &state) {
+  const size_t task_count = static_cast<size_t>(state.range(0));
+
+  // ViewStorage writes next to the working directory captured at construction
+  const auto previous = std::filesystem::current_path();
+  std::filesystem::current_path(bench_directory());
+  ViewStorage storage;
+  std::filesystem::current_path(previous);
+
+  storage.set_filepath(bench_dataset(task_count).csv);
+  for (int i = 0; i < 10; ++i) {
+    storage.push_action({ViewOpType::Filter, "priority>=" + std::to_string(i % 5 + 1)});
+  }
+  MaterializedView view;
+  view.history_hash = storage.history_hash();
+  view.task_ids.resize(task_count);
+  std::iota(view.task_ids.begin(), view.task_ids.end(), 1);
+  storage.set_materialized_view(std::move(view));
+
+  for (auto _ : state) {
+    storage.persist();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * task_count));
+}
+} // anonymous namespace
+
+BENCHMARK(BM_ViewStorage_Persist)->Apply(dataset_sizes);
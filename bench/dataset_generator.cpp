@@ -0,0 +1,228 @@
+#include "dataset_generator.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+/// SplitMix64: tiny, fast and fully specified, so datasets are portable
+class Rng {
+private:
+  std::uint64_t state_;
+
+public:
+  explicit Rng(std::uint64_t seed) noexcept : state_(seed) {}
+
+  std::uint64_t next() noexcept {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /// Uniform in [0, bound)
+  std::uint64_t below(std::uint64_t bound) noexcept { return next() % bound; }
+};
+
+/// Picks an index with probability proportional to integer weights
+class WeightedPick {
+private:
+  std::vector<std::uint64_t> cumulative_;
+
+public:
+  explicit WeightedPick(const std::vector<std::uint64_t> &weights) {
+    std::uint64_t total = 0;
+    for (std::uint64_t weight : weights) {
+      cumulative_.push_back(total += weight);
+    }
+  }
+
+  size_t operator()(Rng &rng) const noexcept {
+    const std::uint64_t ticket = rng.below(cumulative_.back());
+    return static_cast<size_t>(std::upper_bound(cumulative_.begin(), cumulative_.end(), ticket) - cumulative_.begin());
+  }
+};
+
+/// Zipf(1) weights scaled to integers: rank k gets SCALE / (k + 1)
+std::vector<std::uint64_t> zipf_weights(size_t n) {
+  constexpr std::uint64_t SCALE = 1'000'000;
+  std::vector<std::uint64_t> weights(n);
+  for (size_t k = 0; k < n; ++k) {
+    weights[k] = SCALE / (k + 1);
+  }
+  return weights;
+}
+
+constexpr std::array<std::string_view, 4> STATUSES{"todo", "in-progress", "done", "blocked"};
+constexpr std::array<std::string_view, 12> COMMON_TAGS{
+    "bug", "backend", "frontend", "urgent", "feature", "api", "ui", "database", "security", "docs", "testing", "infra"};
+constexpr std::array<std::string_view, 12> VERBS{
+    "Fix", "Add", "Refactor", "Remove", "Update", "Investigate", "Document", "Optimize", "Test", "Review",
+    "Migrate", "Design"};
+constexpr std::array<std::string_view, 12> NOUNS{
+    "login page", "checkout flow", "search index", "user profile", "billing job", "report export",
+    "session cache", "audit log", "settings page", "email sender", "API gateway", "dashboard"};
+constexpr size_t TAG_VOCABULARY = 256;
+constexpr size_t ASSIGNEES = 64;
+
+std::string tag_name(size_t rank) {
+  if (rank < COMMON_TAGS.size())
+    return std::string(COMMON_TAGS[rank]);
+  char name[16];
+  std::snprintf(name, sizeof(name), "tag-%03zu", rank);
+  return name;
+}
+
+// Post: "YYYY-MM-DD" for `days` since 1970-01-01 (proleptic Gregorian)
+std::string iso_date(long days) {
+  days += 719468;
+  const long era = days / 146097;
+  const long doe = days - era * 146097;
+  const long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const long mp = (5 * doy + 2) / 153;
+  const long day = doy - (153 * mp + 2) / 5 + 1;
+  const long month = mp < 10 ? mp + 3 : mp - 9;
+  const long year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+  char date[16];
+  std::snprintf(date, sizeof(date), "%04ld-%02ld-%02ld", year, month, day);
+  return date;
+}
+
+std::string csv_quoted(std::string_view value) {
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"')
+      quoted += '"';
+    quoted += c;
+  }
+  return quoted + '"';
+}
+
+std::string json_string(std::string_view value) {
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      quoted += '\\';
+    quoted += c;
+  }
+  return quoted + '"';
+}
+
+void write_csv(std::ofstream &out, const std::vector<Task> &tasks) {
+  out << "id,title,status,priority,created_date,description,assignee,due_date,tags\n";
+  for (const auto &task : tasks) {
+    std::string tags;
+    for (const auto &tag : task.tags) {
+      tags += (tags.empty() ? "" : ",") + tag;
+    }
+    out << task.id << ',' << csv_quoted(task.title) << ',' << task.status << ',' << task.priority << ','
+        << task.created_date << ',' << csv_quoted(task.description.value_or("")) << ','
+        << task.assignee.value_or("") << ',' << task.due_date.value_or("") << ',' << csv_quoted(tags) << '\n';
+  }
+}
+
+void write_json_object(std::ofstream &out, const Task &task) {
+  out << "{\"id\":" << task.id << ",\"title\":" << json_string(task.title)
+      << ",\"status\":" << json_string(task.status) << ",\"priority\":" << task.priority
+      << ",\"created_date\":" << json_string(task.created_date);
+  if (task.description)
+    out << ",\"description\":" << json_string(*task.description);
+  if (task.assignee)
+    out << ",\"assignee\":" << json_string(*task.assignee);
+  if (task.due_date)
+    out << ",\"due_date\":" << json_string(*task.due_date);
+  out << ",\"tags\":[";
+  for (size_t i = 0; i < task.tags.size(); ++i) {
+    out << (i ? "," : "") << json_string(task.tags[i]);
+  }
+  out << "]}";
+}
+} // anonymous namespace
+
+std::vector<Task> generate_tasks(const DatasetOptions &options) {
+  Rng rng(options.seed);
+  const WeightedPick status({40, 25, 30, 5});
+  const WeightedPick priority({30, 30, 20, 12, 8});
+  const WeightedPick tag_count({15, 35, 30, 15, 5});
+  const WeightedPick tag(zipf_weights(TAG_VOCABULARY));
+  const WeightedPick assignee(zipf_weights(ASSIGNEES));
+
+  constexpr long FIRST_CREATED = 19358; // 2023-01-01
+  constexpr long CREATED_SPAN = 731;    // through 2024-12-31
+
+  std::vector<Task> tasks;
+  tasks.reserve(options.task_count);
+  for (size_t i = 0; i < options.task_count; ++i) {
+    const int id = static_cast<int>(i + 1);
+    std::string title = std::string(VERBS[rng.below(VERBS.size())]) + " " +
+                        std::string(NOUNS[rng.below(NOUNS.size())]) + " #" + std::to_string(id);
+
+    const long created = FIRST_CREATED + static_cast<long>(rng.below(CREATED_SPAN));
+    std::optional<std::string> due;
+    if (rng.below(100) >= 20)
+      due = iso_date(created + 1 + static_cast<long>(rng.below(60)));
+
+    std::optional<std::string> description;
+    if (rng.below(100) < 70)
+      description = "Follow-up on " + std::string(NOUNS[rng.below(NOUNS.size())]) + ", see ticket " +
+                    std::to_string(rng.below(100000));
+
+    std::optional<std::string> owner;
+    if (rng.below(100) >= 10)
+      owner = "user" + std::to_string(assignee(rng));
+
+    std::vector<std::string> tags;
+    for (size_t n = tag_count(rng); tags.size() < n;) {
+      std::string name = tag_name(tag(rng));
+      if (std::find(tags.begin(), tags.end(), name) == tags.end())
+        tags.push_back(std::move(name));
+    }
+
+    tasks.emplace_back(id,
+                       std::move(title),
+                       std::string(STATUSES[status(rng)]),
+                       static_cast<int>(priority(rng)) + 1,
+                       iso_date(created),
+                       std::move(description),
+                       std::move(owner),
+                       std::move(due),
+                       std::move(tags));
+  }
+  return tasks;
+}
+
+void write_dataset(const std::filesystem::path &path, const std::vector<Task> &tasks) {
+  const std::string extension = path.extension().string();
+  const bool csv = extension == ".csv";
+  const bool json = extension == ".json";
+  const bool ndjson = extension == ".jsonl" || extension == ".ndjson";
+  if (!csv && !json && !ndjson)
+    throw std::runtime_error("unsupported dataset extension: " + extension);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("cannot open dataset file for writing: " + path.string());
+
+  if (csv) {
+    write_csv(out, tasks);
+  } else if (json) {
+    out << "[\n";
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      write_json_object(out, tasks[i]);
+      out << (i + 1 < tasks.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+  } else {
+    for (const auto &task : tasks) {
+      write_json_object(out, task);
+      out << '\n';
+    }
+  }
+
+  if (!out)
+    throw std::runtime_error("failed to write dataset file: " + path.string());
+}
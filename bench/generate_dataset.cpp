@@ -0,0 +1,37 @@
+#include "dataset_generator.hpp"
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+namespace {
+void print_usage(const char *program_name) {
+  std::cerr << "Usage: " << program_name << " <task-count> <output.{csv,json,jsonl,ndjson}> [seed]\n";
+  std::cerr << "Example: " << program_name << " 1000000 tasks_1m.csv\n";
+}
+
+bool parse_number(std::string_view text, std::uint64_t &value) {
+  auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return ec == std::errc{} && end == text.data() + text.size();
+}
+} // anonymous namespace
+
+int main(int argc, char *argv[]) {
+  DatasetOptions options;
+  std::uint64_t count = 0;
+  if (argc < 3 || argc > 4 || !parse_number(argv[1], count) || (argc == 4 && !parse_number(argv[3], options.seed))) {
+    print_usage(argv[0]);
+    return 1;
+  }
+  options.task_count = static_cast<size_t>(count);
+
+  try {
+    write_dataset(argv[2], generate_tasks(options));
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
+  std::cout << "Wrote " << options.task_count << " tasks to " << argv[2] << "\n";
+  return 0;
+}
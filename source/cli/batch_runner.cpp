@@ -0,0 +1,137 @@
+#include "cli/batch_runner.hpp"
+#include "cli/commands.hpp"
+#include "core/expr_parser.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+struct Step {
+  size_t line;
+  ParsedArgs parsed;
+};
+
+bool is_blank(char c) noexcept { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Post: the filter expressions of the consecutive filter steps starting at `first`.
+std::vector<std::string> consecutive_filters(const std::vector<Step> &steps, size_t first) {
+  std::vector<std::string> exprs;
+  for (size_t i = first; i < steps.size() && steps[i].parsed.command == Command::Filter; ++i) {
+    exprs.push_back(join_args(steps[i].parsed.args));
+  }
+  return exprs;
+}
+} // anonymous namespace
+
+std::optional<std::string> BatchRunner::read_script(const ParsedArgs &parsed) {
+  if (parsed.args.size() == 2)
+    return parsed.args[1]; // -c <text>
+
+  if (parsed.args.empty() || parsed.args[0] == "-")
+    return std::string(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+
+  std::ifstream ifs(parsed.args[0], std::ios::binary);
+  if (!ifs) {
+    std::cerr << "Failed to open batch script: " << parsed.args[0] << "\n";
+    return std::nullopt;
+  }
+  std::ostringstream text;
+  text << ifs.rdbuf();
+  return std::move(text).str();
+}
+
+std::optional<std::vector<std::string>> BatchRunner::split_line(std::string_view line) {
+  std::vector<std::string> args;
+  size_t i = 0;
+  for (;;) {
+    while (i < line.size() && is_blank(line[i])) {
+      ++i;
+    }
+    if (i == line.size() || line[i] == '#')
+      return args;
+
+    std::string arg;
+    bool in_quotes = false;
+    for (; i < line.size() && (in_quotes || !is_blank(line[i])); ++i) {
+      const char c = line[i];
+      if (c == '"')
+        in_quotes = !in_quotes;
+      else if (in_quotes && c == '\\' && i + 1 < line.size() && (line[i + 1] == '"' || line[i + 1] == '\\'))
+        arg += line[++i];
+      else
+        arg += c;
+    }
+    if (in_quotes)
+      return std::nullopt;
+    args.push_back(std::move(arg));
+  }
+}
+
+int BatchRunner::run(DataManager &data_manager, std::string_view script) {
+  // 1. Parse every line first, so a syntax error anywhere runs nothing
+  std::vector<Step> steps;
+  size_t line_number = 0;
+  while (!script.empty()) {
+    const size_t end = std::min(script.find('\n'), script.size());
+    const std::string_view line = script.substr(0, end);
+    script.remove_prefix(std::min(end + 1, script.size()));
+    ++line_number;
+
+    auto args = split_line(line);
+    if (!args) {
+      std::cerr << "Error: line " << line_number << ": unterminated quote\n";
+      return 1;
+    }
+    if (args->empty())
+      continue;
+
+    const std::string command = args->front();
+    ParsedArgs parsed = CommandParser::parse(std::move(*args));
+    if (!parsed.is_valid()) {
+      std::cerr << "Error: line " << line_number << ": " << parsed.error_message << "\n";
+      return 1;
+    }
+    if (parsed.command == Command::Batch || parsed.command == Command::Serve || parsed.command == Command::Stop) {
+      std::cerr << "Error: line " << line_number << ": '" << command << "' cannot run inside a batch\n";
+      return 1;
+    }
+    if (parsed.command == Command::Filter && !ExpressionParser::parse_filter_expr(join_args(parsed.args))) {
+      std::cerr << "Error: line " << line_number << ": invalid filter expression\n";
+      return 1;
+    }
+    steps.push_back(Step{line_number, std::move(parsed)});
+  }
+
+  // 2. Run them against one DataManager; the storage is written once, at the end
+  data_manager.begin_batch();
+  int status = 0;
+  try {
+    for (size_t i = 0; i < steps.size() && status == 0;) {
+      const std::vector<std::string> filters = consecutive_filters(steps, i);
+      if (filters.size() > 1) {
+        std::cout << "Filtering current view (" << filters.size() << " filters in one pass)\n";
+        status = data_manager.apply_filters(filters) ? 0 : 1;
+        if (status == 0)
+          std::cout << "Tasks filtered successfully\n";
+        else
+          std::cerr << "Error: batch stopped at line " << steps[i].line << "\n";
+        i += filters.size();
+        continue;
+      }
+
+      if (steps[i].parsed.command == Command::Help)
+        CommandParser::print_help("taskproc");
+      else
+        status = run_command(data_manager, steps[i].parsed);
+      if (status != 0)
+        std::cerr << "Error: batch stopped at line " << steps[i].line << "\n";
+      ++i;
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    status = 1;
+  }
+  data_manager.end_batch();
+  return status;
+}
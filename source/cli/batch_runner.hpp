@@ -0,0 +1,45 @@
+#pragma once
+#include "../core/data_manager.hpp"
+#include "parser.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Runs a script of commands against one DataManager.
+ *
+ * A script holds one command per line, written as on the command line without
+ * the program name (`filter status=todo`). Arguments are separated by blanks;
+ * double quotes group an argument that contains blanks (`\"` and `\\` escape
+ * inside quotes), and `#` at the start of an argument begins a comment.
+ *
+ * Every line, including its filter expression, is parsed before anything
+ * runs, so a syntax error anywhere runs nothing. Commands then run in order
+ * and the script stops at the first one that fails. View storage is written
+ * once at the end (see DataManager::begin_batch), and consecutive `filter`
+ * lines are applied as one fused filter (see DataManager::apply_filters).
+ */
+class BatchRunner {
+public:
+  /**
+   * @brief Text of the script named by the arguments of a `batch` command.
+   * @pre `parsed.command == Command::Batch`.
+   * @post `-c <text>` yields `text`; `-` or no argument reads std::cin; otherwise the file named.
+   * @return std::nullopt (after reporting the error) if the script file cannot be read.
+   */
+  static std::optional<std::string> read_script(const ParsedArgs &parsed);
+
+  /**
+   * @brief Run every command of `script`.
+   * @post Commands before the first failure have run, and their storage changes are persisted.
+   * @return 0 if every command succeeded, otherwise the exit code of the first failure (1 for a syntax error).
+   */
+  static int run(DataManager &data_manager, std::string_view script);
+
+  /**
+   * @brief Split one script line into arguments.
+   * @return The arguments (empty for a blank or comment line), or std::nullopt for an unterminated quote.
+   */
+  static std::optional<std::vector<std::string>> split_line(std::string_view line);
+};
@@ -0,0 +1,278 @@
+#include "cli/command_server.hpp"
+#include "cli/commands.hpp"
+#include "cli/parser.hpp"
+#include "io/binary_io.hpp"
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+/// Requests are a few command-line arguments; anything larger is not a client of ours
+constexpr std::uint32_t MAX_REQUEST_BYTES = 1 << 20;
+
+/// How often `serve` wakes up to notice `request_stop()` while idle
+constexpr int STOP_POLL_MS = 200;
+
+/// A connected client that sends nothing, or reads none of its reply, for this long is dropped, so it
+/// cannot stall the others
+constexpr timeval CLIENT_TIMEOUT{5, 0};
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+std::runtime_error socket_error(const std::string &what) {
+  return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+sockaddr_un socket_address(const std::filesystem::path &path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string native = path.string();
+  if (native.size() >= sizeof(address.sun_path))
+    throw std::runtime_error("Socket path too long: " + native);
+  std::memcpy(address.sun_path, native.c_str(), native.size() + 1);
+  return address;
+}
+
+/// Closes the descriptor on scope exit.
+struct FileDescriptor {
+  int fd;
+  explicit FileDescriptor(int fd_) noexcept : fd(fd_) {}
+  ~FileDescriptor() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+  FileDescriptor(const FileDescriptor &) = delete;
+  FileDescriptor &operator=(const FileDescriptor &) = delete;
+};
+
+// Post: true if a server accepted a connection on `path`.
+bool connect_to(int fd, const std::filesystem::path &path) {
+  const sockaddr_un address = socket_address(path);
+  return ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+}
+
+// Post: true if all of `data` was written (false if the peer went away).
+bool write_all(int fd, std::string_view data) noexcept {
+  while (!data.empty()) {
+    const ssize_t written = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      return false;
+    data.remove_prefix(static_cast<size_t>(written));
+  }
+  return true;
+}
+
+// Post: true if exactly `size` bytes were read into `out` (false on EOF or error).
+bool read_exact(int fd, char *out, size_t size) noexcept {
+  while (size > 0) {
+    const ssize_t got = ::recv(fd, out, size, 0);
+    if (got < 0 && errno == EINTR)
+      continue;
+    if (got <= 0)
+      return false;
+    out += got;
+    size -= static_cast<size_t>(got);
+  }
+  return true;
+}
+
+bool write_frame(int fd, const ByteWriter &payload) noexcept {
+  ByteWriter frame;
+  frame.put(static_cast<std::uint32_t>(payload.size()));
+  return write_all(fd, frame.data()) && write_all(fd, payload.data());
+}
+
+// Post: the payload of one frame of at most `max_bytes`, or std::nullopt on EOF, error or an oversized frame.
+std::optional<std::string> read_frame(int fd, std::uint32_t max_bytes) {
+  std::uint32_t size = 0;
+  if (!read_exact(fd, reinterpret_cast<char *>(&size), sizeof(size)) || size > max_bytes)
+    return std::nullopt;
+  std::string payload(size, '\0');
+  if (!read_exact(fd, payload.data(), payload.size()))
+    return std::nullopt;
+  return payload;
+}
+
+/// Sends std::cout/std::cerr to string buffers until destroyed.
+class CapturedOutput {
+public:
+  std::ostringstream out;
+  std::ostringstream err;
+
+  CapturedOutput() : saved_out_(std::cout.rdbuf(out.rdbuf())), saved_err_(std::cerr.rdbuf(err.rdbuf())) {}
+  ~CapturedOutput() {
+    std::cout.rdbuf(saved_out_);
+    std::cerr.rdbuf(saved_err_);
+  }
+  CapturedOutput(const CapturedOutput &) = delete;
+  CapturedOutput &operator=(const CapturedOutput &) = delete;
+
+private:
+  std::streambuf *saved_out_;
+  std::streambuf *saved_err_;
+};
+
+// Post: the reply `run_command` (or the parser) would have printed for `args`; sets `stop` for a stop command.
+CommandReply execute(std::vector<std::string> args, DataManager &data_manager, bool &stop) {
+  const std::string_view program = "taskproc";
+  const ParsedArgs parsed = CommandParser::parse(std::move(args));
+
+  CommandReply reply;
+  {
+    CapturedOutput captured;
+    if (!parsed.is_valid()) {
+      if (!parsed.error_message.empty())
+        std::cerr << "Error: " << parsed.error_message << "\n";
+      CommandParser::print_usage(program);
+      reply.exit_code = 1;
+    } else if (parsed.command == Command::Help) {
+      CommandParser::print_help(program);
+    } else if (parsed.command == Command::Serve) {
+      std::cerr << "A server is already running\n";
+      reply.exit_code = 1;
+    } else if (parsed.command == Command::Batch && (parsed.args.empty() || parsed.args[0] == "-")) {
+      std::cerr << "A batch read from stdin must be sent with -c\n"; // our stdin is not the client's
+      reply.exit_code = 1;
+    } else if (parsed.command == Command::Stop) {
+      std::cout << "Server stopped\n";
+      stop = true;
+    } else {
+      const ProfileSession profile(parsed); // reported before the captured output is taken
+      try {
+        // The file may have changed since the last request; `load` and `reload` read it anyway
+        if (parsed.command != Command::Load && parsed.command != Command::Reload && !data_manager.refresh_if_changed())
+          std::cerr << "Warning: the tasks file changed but could not be reloaded\n";
+        reply.exit_code = run_command(data_manager, parsed);
+      } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        reply.exit_code = 1;
+      }
+    }
+    reply.out = std::move(captured.out).str();
+    reply.err = std::move(captured.err).str();
+  }
+  return reply;
+}
+} // anonymous namespace
+
+CommandServer::CommandServer(std::filesystem::path socket_path) : socket_path_(std::move(socket_path)) {
+  FileDescriptor fd(::socket(AF_UNIX, SOCK_STREAM, 0));
+  if (fd.fd < 0)
+    throw socket_error("Failed to create socket");
+
+  // A socket file nobody accepts on is left over from a server that died: replace it
+  std::error_code ec;
+  if (std::filesystem::exists(std::filesystem::symlink_status(socket_path_, ec))) {
+    FileDescriptor probe(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (probe.fd >= 0 && connect_to(probe.fd, socket_path_))
+      throw std::runtime_error("A server is already listening on " + socket_path_.string());
+    std::filesystem::remove(socket_path_, ec);
+  }
+
+  const sockaddr_un address = socket_address(socket_path_);
+  if (::bind(fd.fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+    throw socket_error("Failed to bind " + socket_path_.string());
+  if (::listen(fd.fd, SOMAXCONN) != 0) {
+    std::filesystem::remove(socket_path_, ec);
+    throw socket_error("Failed to listen on " + socket_path_.string());
+  }
+
+  listen_fd_ = fd.fd;
+  fd.fd = -1;
+}
+
+CommandServer::~CommandServer() {
+  ::close(listen_fd_);
+  std::error_code ec;
+  std::filesystem::remove(socket_path_, ec);
+}
+
+void CommandServer::request_stop() noexcept { stop_requested = 1; }
+
+void CommandServer::serve(DataManager &data_manager) {
+  stop_requested = 0;
+  bool stop = false;
+  while (!stop && !stop_requested) {
+    pollfd ready{listen_fd_, POLLIN, 0};
+    const int events = ::poll(&ready, 1, STOP_POLL_MS);
+    if (events < 0 && errno != EINTR)
+      throw socket_error("Failed to wait for connections");
+    if (events <= 0)
+      continue;
+
+    FileDescriptor client(::accept(listen_fd_, nullptr, nullptr));
+    if (client.fd < 0)
+      continue; // the client gave up before we accepted; keep serving
+    ::setsockopt(client.fd, SOL_SOCKET, SO_RCVTIMEO, &CLIENT_TIMEOUT, sizeof(CLIENT_TIMEOUT));
+    ::setsockopt(client.fd, SOL_SOCKET, SO_SNDTIMEO, &CLIENT_TIMEOUT, sizeof(CLIENT_TIMEOUT));
+    handle(client.fd, data_manager, stop);
+  }
+}
+
+void CommandServer::handle(int fd, DataManager &data_manager, bool &stop) {
+  const auto request = read_frame(fd, MAX_REQUEST_BYTES);
+  if (!request)
+    return;
+
+  std::vector<std::string> args;
+  try {
+    ByteReader in(*request);
+    const auto count = in.get<std::uint32_t>();
+    if (count > in.remaining() / sizeof(std::uint32_t))
+      return;
+    for (std::uint32_t i = 0; i < count; ++i) {
+      args.emplace_back(in.get_string());
+    }
+    if (!in.at_end())
+      return;
+  } catch (const std::runtime_error &) {
+    return; // truncated request
+  }
+
+  const CommandReply reply = execute(std::move(args), data_manager, stop);
+  ByteWriter out;
+  out.put(static_cast<std::int32_t>(reply.exit_code));
+  out.put_string(reply.out);
+  out.put_string(reply.err);
+  write_frame(fd, out); // a client that went away just misses its reply
+}
+
+std::optional<CommandReply> CommandClient::send(const std::vector<std::string> &args,
+                                                const std::filesystem::path &socket_path) {
+  std::error_code ec;
+  if (!std::filesystem::exists(std::filesystem::symlink_status(socket_path, ec)))
+    return std::nullopt;
+
+  FileDescriptor fd(::socket(AF_UNIX, SOCK_STREAM, 0));
+  if (fd.fd < 0 || !connect_to(fd.fd, socket_path))
+    return std::nullopt; // stale socket file: nobody is serving
+
+  ByteWriter request;
+  request.put(static_cast<std::uint32_t>(args.size()));
+  for (const auto &arg : args) {
+    request.put_string(arg);
+  }
+  if (!write_frame(fd.fd, request))
+    throw std::runtime_error("Lost connection to the server before sending the command");
+
+  const auto response = read_frame(fd.fd, UINT32_MAX);
+  if (!response)
+    throw std::runtime_error("Lost connection to the server before its reply");
+
+  ByteReader in(*response);
+  CommandReply reply;
+  reply.exit_code = in.get<std::int32_t>();
+  reply.out = std::string(in.get_string());
+  reply.err = std::string(in.get_string());
+  return reply;
+}
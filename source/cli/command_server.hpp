@@ -0,0 +1,87 @@
+#pragma once
+#include "../core/data_manager.hpp"
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Output of one command run by a server.
+struct CommandReply {
+  int exit_code{0};
+  std::string out; ///< What the command wrote to std::cout
+  std::string err; ///< What the command wrote to std::cerr
+};
+
+/**
+ * @brief Keeps one DataManager resident and runs forwarded commands against it.
+ *
+ * Listens on a Unix domain socket (by default "./.taskproc.sock", next to the
+ * view storage). Each connection carries one request, the command-line
+ * arguments after the program name, and receives one CommandReply. Requests
+ * are served one at a time, so commands see each other's effects in arrival
+ * order, exactly as consecutive CLI invocations would.
+ *
+ * The DataManager is still persisted after every mutating command, so the
+ * state on disk stays current and the CLI works the same once the server stops.
+ * Before each request the tasks file is fingerprinted again, and an edit made
+ * since the last request is applied first (see DataManager::refresh_if_changed).
+ *
+ * Wire format (host byte order, see ByteWriter): a request is a u32 length
+ * followed by a u32 argument count and length-prefixed strings; a reply is a u32
+ * length followed by an i32 exit code and the two length-prefixed outputs.
+ *
+ * @note `serve` redirects std::cout/std::cerr while a command runs; the process
+ *       should not write to them from other threads meanwhile.
+ */
+class CommandServer {
+public:
+  static constexpr std::string_view DEFAULT_SOCKET = ".taskproc.sock";
+
+  /**
+   * @brief Bind and listen on `socket_path`.
+   * @post The socket accepts connections; a stale socket file left by a dead server is replaced.
+   * @throws std::runtime_error if another server already listens there, or on socket errors.
+   */
+  explicit CommandServer(std::filesystem::path socket_path = std::filesystem::path(DEFAULT_SOCKET));
+
+  /// Closes the socket and removes its file.
+  ~CommandServer();
+
+  CommandServer(const CommandServer &) = delete;
+  CommandServer &operator=(const CommandServer &) = delete;
+
+  /**
+   * @brief Answer requests until a `stop` command or `request_stop()`.
+   * @post Every accepted request received a reply (or its client disconnected first).
+   * @note A malformed request is dropped without a reply; it never stops the server.
+   */
+  void serve(DataManager &data_manager);
+
+  /// Make `serve` return after the request in progress (async-signal-safe).
+  static void request_stop() noexcept;
+
+  const std::filesystem::path &socket_path() const noexcept { return socket_path_; }
+
+private:
+  std::filesystem::path socket_path_;
+  int listen_fd_{-1};
+
+  /// Read one request from `fd`, run it and write the reply.
+  void handle(int fd, DataManager &data_manager, bool &stop);
+};
+
+/// Client side of CommandServer.
+class CommandClient {
+public:
+  /**
+   * @brief Run `args` on the server listening at `socket_path`.
+   * @return The server's reply, or std::nullopt if no server is listening there
+   *         (the caller should run the command itself).
+   * @throws std::runtime_error if the server accepted the request but the connection broke
+   *         before the reply (the command may or may not have run).
+   */
+  static std::optional<CommandReply>
+  send(const std::vector<std::string> &args,
+       const std::filesystem::path &socket_path = std::filesystem::path(CommandServer::DEFAULT_SOCKET));
+};
@@ -0,0 +1,368 @@
+#include "cli/commands.hpp"
+#include "cli/batch_runner.hpp"
+#include "core/date.hpp"
+#include "core/expr_parser.hpp"
+#include "core/profiler.hpp"
+#include "core/silenced_errors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+// Current UTC date as YYYY-MM-DD
+std::string today_iso() {
+  const auto today = std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now());
+  return format_iso_date(static_cast<std::int32_t>(today.time_since_epoch().count()));
+}
+
+// One left-aligned column per aggregate, the group key first ("(none)" for the empty key)
+void print_group_stats(const std::vector<GroupStats> &groups,
+                       std::string_view field,
+                       const std::vector<Aggregate> &aggregates) {
+  auto header = [](Aggregate aggregate) -> std::string_view {
+    switch (aggregate) {
+    case Aggregate::Count:
+      return "count";
+    case Aggregate::AveragePriority:
+      return "avg_priority";
+    case Aggregate::Overdue:
+      return "overdue";
+    case Aggregate::MinDue:
+      return "min_due";
+    default:
+      return "max_due";
+    }
+  };
+  auto cell = [](const GroupStats &group, Aggregate aggregate) {
+    std::ostringstream out;
+    switch (aggregate) {
+    case Aggregate::Count:
+      out << group.count;
+      break;
+    case Aggregate::AveragePriority:
+      out << std::fixed << std::setprecision(2) << group.average_priority;
+      break;
+    case Aggregate::Overdue:
+      out << group.overdue_count;
+      break;
+    case Aggregate::MinDue:
+      out << group.min_due.value_or("-");
+      break;
+    case Aggregate::MaxDue:
+      out << group.max_due.value_or("-");
+      break;
+    }
+    return out.str();
+  };
+
+  size_t key_width = std::max(field.size(), std::string_view("(none)").size());
+  for (const auto &group : groups) {
+    key_width = std::max(key_width, group.key.size());
+  }
+  std::cout << std::left << std::setw(static_cast<int>(key_width + 2)) << field;
+  for (Aggregate aggregate : aggregates) {
+    std::cout << std::setw(14) << header(aggregate);
+  }
+  std::cout << "\n";
+  for (const auto &group : groups) {
+    std::cout << std::setw(static_cast<int>(key_width + 2)) << (group.key.empty() ? "(none)" : group.key);
+    for (Aggregate aggregate : aggregates) {
+      std::cout << std::setw(14) << cell(group, aggregate);
+    }
+    std::cout << "\n";
+  }
+  std::cout << std::right;
+}
+} // anonymous namespace
+
+int run_command(DataManager &data_manager, const ParsedArgs &parsed) {
+  switch (parsed.command) {
+  case Command::Load: {
+    std::cout << "Loading tasks from: " << parsed.args[0] << "\n";
+    bool result = data_manager.load_from_file(parsed.args[0]);
+    if (!result) {
+      std::cerr << "Failed to load tasks from file: " << parsed.args[0] << "\n";
+      return 1;
+    }
+    std::cout << "Tasks loaded successfully\n";
+    break;
+  }
+  case Command::Reload: {
+    if (parsed.incremental) {
+      std::cout << "Reloading changes from last file\n";
+      ReloadDelta delta;
+      if (!data_manager.reload_incremental(&delta)) {
+        std::cerr << "Failed to reload tasks\n";
+        return 1;
+      }
+      std::cout << "Tasks reloaded: " << delta.inserted << " inserted, " << delta.updated << " updated, "
+                << delta.deleted << " deleted\n";
+      break;
+    }
+
+    std::cout << "Reloading from last file\n";
+    bool result = data_manager.reload_tasks();
+    if (!result) {
+      std::cerr << "Failed to reload tasks\n";
+      return 1;
+    } else {
+      std::cout << "Tasks reloaded successfully\n";
+    }
+    break;
+  }
+  case Command::Status:
+    std::cout << "Current dataset status:\n";
+    // TODO: Implement status command handler
+    break;
+  case Command::Clear:
+    std::cout << "Clearing current view\n";
+    data_manager.reset_view();
+    break;
+  case Command::List: {
+    if (!data_manager.require_fields(TaskFields::all()))
+      return 1;
+    const size_t total = data_manager.view_task_count();
+    std::cout << "Current view:\n";
+
+    if (total == 0) {
+      std::cout << "No tasks in current view\n";
+      break;
+    }
+
+    std::cout << "Current tasks (" << total << "):\n";
+    const auto page = data_manager.view_page(parsed.offset, parsed.limit.value_or(total));
+    if (page.size() < total) {
+      if (page.empty()) {
+        std::cout << "No tasks at offset " << parsed.offset << "\n";
+        break;
+      }
+      std::cout << "Showing " << parsed.offset + 1 << "-" << parsed.offset + page.size() << "\n";
+    }
+    std::cout << "-------------------------\n";
+
+    for (const auto &task : page) {
+      std::cout << *task << "\n";
+    }
+
+    break;
+  }
+  case Command::Sort: {
+    std::cout << "Sorting current view\n";
+    const std::string sort_expr = parsed.args.empty() ? "id asc" : join_args(parsed.args);
+    std::cout << "Sorting tasks by: " << sort_expr << "\n";
+    bool result = data_manager.apply_sort(sort_expr);
+    if (!result) {
+      std::cerr << "Failed to sort tasks\n";
+      return 1;
+    } else {
+      std::cout << "Tasks sorted successfully\n";
+    }
+    break;
+  }
+  case Command::Filter: {
+    std::cout << "Filtering current view\n";
+    bool result = data_manager.apply_filter(join_args(parsed.args));
+    if (!result) {
+      std::cerr << "Failed to filter tasks\n";
+      return 1;
+    } else {
+      std::cout << "Tasks filtered successfully\n";
+    }
+    break;
+  }
+  case Command::FindByTag: {
+    std::cout << "Filtering current view by tag: " << parsed.args[0] << "\n";
+    bool result = data_manager.filter_by_tag(parsed.args[0]);
+    if (!result) {
+      std::cerr << "Failed to filter tasks\n";
+      return 1;
+    } else {
+      std::cout << "Tasks filtered successfully\n";
+    }
+    break;
+  }
+  case Command::Search: {
+    const std::string text = join_args(parsed.args);
+    std::cout << "Searching current view for: " << text << "\n";
+    bool result = data_manager.search_text(text);
+    if (!result) {
+      std::cerr << "Failed to search tasks\n";
+      return 1;
+    } else {
+      std::cout << "Tasks filtered successfully\n";
+    }
+    break;
+  }
+  case Command::Stats: {
+    const std::string today = parsed.today.empty() ? today_iso() : parsed.today;
+    if (!parse_iso_date(today)) {
+      std::cerr << "Invalid date for --today: " << today << "\n";
+      return 1;
+    }
+
+    if (!data_manager.require_fields(TaskField::Status | TaskField::Priority | TaskField::DueDate))
+      return 1;
+    if (parsed.group_by.empty()) {
+      const StatusStats stats = data_manager.status_stats();
+      std::cout << "Current view statistics (" << data_manager.view_task_count() << " tasks):\n";
+      std::cout << "  todo:             " << stats.todo_count << "\n";
+      std::cout << "  in-progress:      " << stats.in_progress_count << "\n";
+      std::cout << "  done:             " << stats.done_count << "\n";
+      std::cout << "  other:            " << stats.other_count << "\n";
+      std::cout << "  average priority: " << std::fixed << std::setprecision(2) << data_manager.average_priority()
+                << std::defaultfloat << "\n";
+      std::cout << "  overdue:          " << data_manager.overdue_count(today) << "\n";
+      break;
+    }
+
+    const auto field = ExpressionParser::parse_group_field(parsed.group_by);
+    const auto aggregates = parsed.aggregates.empty()
+                                ? std::optional(std::vector<Aggregate>{Aggregate::Count,
+                                                                       Aggregate::AveragePriority,
+                                                                       Aggregate::Overdue,
+                                                                       Aggregate::MinDue,
+                                                                       Aggregate::MaxDue})
+                                : ExpressionParser::parse_aggregates(parsed.aggregates);
+    if (!field || !aggregates) {
+      std::cerr << "Failed to compute statistics\n";
+      return 1;
+    }
+    if (!data_manager.require_fields(ExpressionParser::fields_of(*field)))
+      return 1;
+    std::cout << "Current view statistics by " << parsed.group_by << " (" << data_manager.view_task_count()
+              << " tasks):\n";
+    print_group_stats(data_manager.group_stats(*field, today), parsed.group_by, *aggregates);
+    break;
+  }
+
+  case Command::Export:
+  case Command::ExportAll: {
+    const std::string &target = parsed.args[0];
+    const bool all = parsed.command == Command::ExportAll;
+    if (!data_manager.require_fields(TaskFields::all()))
+      return 1;
+    // The whole view is exported straight from `current_view()`, rebuilt on the pool
+    std::vector<const Task *> selected;
+    const std::vector<const Task *> *tasks = &selected;
+    if (all)
+      selected = data_manager.all_tasks();
+    else if (parsed.offset > 0 || parsed.limit)
+      selected = data_manager.view_page(parsed.offset, parsed.limit.value_or(SIZE_MAX));
+    else
+      tasks = &data_manager.current_view();
+
+    if (!data_manager.export_tasks(*tasks, target, parsed.format)) {
+      std::cerr << "Failed to export tasks to: " << target << "\n";
+      return 1;
+    }
+    if (target != "-") // keep stdout clean for piping
+      std::cout << "Exported " << tasks->size() << (all ? " tasks" : " tasks from current view") << " to: " << target
+                << "\n";
+    break;
+  }
+
+  case Command::Batch: {
+    const auto script = BatchRunner::read_script(parsed);
+    if (!script)
+      return 1;
+    return BatchRunner::run(data_manager, *script);
+  }
+  case Command::Stop:
+    std::cerr << "No server is running\n";
+    return 1;
+
+  default:
+    // Invalid command
+    break;
+  }
+
+  return 0;
+}
+
+std::string join_args(const std::vector<std::string> &args) {
+  std::string joined;
+  for (const auto &arg : args) {
+    if (!joined.empty())
+      joined += ' ';
+    joined += arg;
+  }
+  return joined;
+}
+
+TaskFields command_fields(const ParsedArgs &parsed) {
+  switch (parsed.command) {
+  case Command::Load:
+  case Command::Clear:
+  case Command::Status:
+  case Command::Stop:
+    return TaskFields(); // the restored session is replaced or left alone
+  case Command::Reload:
+    return parsed.incremental ? TaskFields::all() : TaskFields();
+  case Command::Filter: {
+    const SilencedErrors silenced;
+    if (auto expr = ExpressionParser::parse_filter_expr(join_args(parsed.args)))
+      return ExpressionParser::fields_of(*expr);
+    return TaskFields(); // the command fails before reading any task
+  }
+  case Command::Sort: {
+    if (parsed.args.empty())
+      return TaskFields(); // "id asc"
+    const SilencedErrors silenced;
+    if (auto keys = ExpressionParser::parse_sort_keys(join_args(parsed.args)))
+      return ExpressionParser::fields_of(*keys);
+    return TaskFields();
+  }
+  case Command::FindByTag:
+    return TaskField::Tags;
+  case Command::Search:
+    return TaskField::Title | TaskField::Description;
+  case Command::Stats: {
+    TaskFields fields = TaskField::Status | TaskField::Priority | TaskField::DueDate;
+    // The group field is validated (and reported) by run_command; any of them may be named
+    if (!parsed.group_by.empty())
+      fields |= TaskField::Assignee | TaskField::Tags | TaskField::CreatedDate;
+    return fields;
+  }
+  default:
+    return TaskFields::all(); // tasks are printed or written whole, or a batch may run anything
+  }
+}
+
+SessionStart command_session(const ParsedArgs &parsed) {
+  return parsed.command == Command::Reload && parsed.incremental ? SessionStart::Previous : SessionStart::Current;
+}
+
+ProfileSession::ProfileSession(const ParsedArgs &parsed) : trace_path_(parsed.profile_trace) {
+  if (!parsed.profile && trace_path_.empty())
+    return;
+  if (!Profiler::compiled_in()) {
+    std::cerr << "Warning: profiling is not available (built without TASKPROC_PROFILING)\n";
+    return;
+  }
+  Profiler::instance().start(!trace_path_.empty());
+  active_ = true;
+}
+
+ProfileSession::~ProfileSession() {
+  if (!active_)
+    return;
+  Profiler &profiler = Profiler::instance();
+  profiler.stop();
+  try {
+    profiler.report(std::cerr);
+    if (!trace_path_.empty()) {
+      std::ofstream ofs(trace_path_, std::ios::trunc);
+      if (ofs)
+        profiler.write_trace(ofs);
+      if (!ofs)
+        std::cerr << "Warning: failed to write profile trace: " << trace_path_ << "\n";
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to report profile: " << e.what() << "\n";
+  }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "../core/data_manager.hpp"
+#include "parser.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Run one parsed command against `data_manager`.
+ *
+ * Shared by the one-shot CLI and by `taskproc serve`, so a command behaves the
+ * same whether it runs in-process or is forwarded to a server.
+ *
+ * @pre `parsed.is_valid()`; `Help` and `Serve` are handled by the caller.
+ * @post Results are written to std::cout, diagnostics to std::cerr.
+ * @return Process exit code for the command (0 on success).
+ */
+int run_command(DataManager &data_manager, const ParsedArgs &parsed);
+
+/// Words of a multi-word argument (filter expression, sort keys, search text) joined by spaces
+std::string join_args(const std::vector<std::string> &args);
+
+/**
+ * @brief Task fields `parsed` reads, so the one-shot CLI can load only those (see TaskFields).
+ *
+ * A filter, sort or `stats` decodes the fields it names; commands that print or
+ * write whole tasks, batch scripts and `serve` need every field. `run_command`
+ * asks the DataManager for any missing field, so a smaller set only costs a
+ * second decode, never a wrong result.
+ *
+ * @pre `parsed.is_valid()`.
+ */
+TaskFields command_fields(const ParsedArgs &parsed);
+
+/**
+ * @brief State of the stored session the one-shot CLI restores for `parsed`.
+ *
+ * `reload --incremental` starts from the previous snapshot and view, so the
+ * reload itself finds the rows that changed; every other command starts from
+ * the file as it is now.
+ *
+ * @pre `parsed.is_valid()`.
+ */
+SessionStart command_session(const ParsedArgs &parsed);
+
+/**
+ * @brief Profiling of one command, requested with `--profile` or `--profile-trace FILE`.
+ *
+ * Starts the Profiler if `parsed` asks for it; on destruction prints the phase
+ * breakdown to std::cerr and writes the trace file. Scoped around the command
+ * by both the one-shot CLI and `taskproc serve`, so the report of a forwarded
+ * command reaches the client with the rest of its diagnostics.
+ */
+class ProfileSession {
+public:
+  explicit ProfileSession(const ParsedArgs &parsed);
+  ~ProfileSession();
+
+  ProfileSession(const ProfileSession &) = delete;
+  ProfileSession &operator=(const ProfileSession &) = delete;
+
+private:
+  bool active_{false};
+  std::string trace_path_; ///< empty: no trace file
+};
@@ -1,17 +1,42 @@
 #include "cli/parser.hpp"
+#include <algorithm>
+#include <charconv>
 #include <iostream>
 #include <unordered_map>
 
 ParsedArgs CommandParser::parse(int argc, char *argv[]) {
+  // Skip the program name
+  return parse(argc < 2 ? std::vector<std::string>{} : std::vector<std::string>(argv + 1, argv + argc));
+}
+
+ParsedArgs CommandParser::parse(std::vector<std::string> args) {
   ParsedArgs result;
 
-  // Need at least program name + command
-  if (argc < 2) {
+  // Profiling options apply to every command and may appear anywhere
+  for (size_t i = 0; i < args.size();) {
+    if (args[i] == "--profile") {
+      result.profile = true;
+      args.erase(args.begin() + static_cast<std::ptrdiff_t>(i));
+    } else if (args[i] == "--profile-trace") {
+      if (i + 1 == args.size()) {
+        result.command = Command::Unknown;
+        result.error_message = "option '--profile-trace' requires a value";
+        return result;
+      }
+      result.profile_trace = args[i + 1];
+      args.erase(args.begin() + static_cast<std::ptrdiff_t>(i), args.begin() + static_cast<std::ptrdiff_t>(i + 2));
+    } else {
+      ++i;
+    }
+  }
+
+  // Need at least a command
+  if (args.empty()) {
     result.command = Command::Help;
     return result;
   }
 
-  std::string command = argv[1];
+  const std::string command = args.front();
   result.command = string_to_command(command);
 
   if (result.command == Command::Unknown) {
@@ -20,9 +45,8 @@ ParsedArgs CommandParser::parse(int argc, char *argv[]) {
   }
 
   // Collecting remaining arguments
-  for (int i = 2; i < argc; ++i) {
-    result.args.emplace_back(argv[i]);
-  }
+  args.erase(args.begin());
+  result.args = std::move(args);
 
   // Validate argument count for each command
   switch (result.command) {
@@ -41,13 +65,78 @@ ParsedArgs CommandParser::parse(int argc, char *argv[]) {
     }
     break;
 
+  case Command::FindByTag:
+    if (result.args.empty()) {
+      result.error_message = "command 'find-by-tag' requires a tag";
+    }
+    break;
+
+  case Command::Search:
+    if (result.args.empty()) {
+      result.error_message = "command 'search' requires a search text";
+    }
+    break;
+
+  case Command::Batch: {
+    const bool inline_script = !result.args.empty() && result.args[0] == "-c";
+    if (inline_script ? result.args.size() != 2 : result.args.size() > 1) {
+      result.error_message = "command 'batch' takes a script file, '-' for stdin, or -c <commands>";
+    }
+    break;
+  }
+
+  case Command::Reload:
+    if (result.args.size() == 1 && result.args[0] == "--incremental") {
+      result.incremental = true;
+      result.args.clear();
+    } else if (!result.args.empty()) {
+      result.error_message = "unexpected argument: " + result.args[0];
+    }
+    break;
+
   // Commands that don't require arguments
   case Command::Help:
-  case Command::Reload:
   case Command::Clear:
   case Command::Status:
+  case Command::Serve:
+  case Command::Stop:
+    break;
+
   case Command::List:
+    parse_options(result, {"--limit", "--offset"});
+    if (result.error_message.empty() && !result.args.empty()) {
+      result.error_message = "unexpected argument: " + result.args[0];
+    }
+    break;
+
+  case Command::Stats:
+    parse_options(result, {"--group-by", "--agg", "--today"});
+    if (!result.error_message.empty())
+      break;
+    if (!result.args.empty()) {
+      result.error_message = "unexpected argument: " + result.args[0];
+    } else if (!result.aggregates.empty() && result.group_by.empty()) {
+      result.error_message = "option '--agg' requires '--group-by'";
+    }
+    break;
+
+  case Command::Export:
+  case Command::ExportAll: {
+    const bool all = result.command == Command::ExportAll;
+    if (all)
+      parse_options(result, {"--format"});
+    else
+      parse_options(result, {"--limit", "--offset", "--format"});
+    if (!result.error_message.empty())
+      break;
+    if (result.args.empty()) {
+      result.error_message = std::string("command '") + (all ? "export-all" : "export") +
+                             "' requires a filename ('-' for stdout)";
+    } else if (result.args.size() > 1) {
+      result.error_message = "unexpected argument: " + result.args[1];
+    }
     break;
+  }
 
   case Command::Unknown:
     break; // Already handled above
@@ -64,7 +153,15 @@ Command CommandParser::string_to_command(std::string_view cmd_str) {
                                                                             {"status", Command::Status},
                                                                             {"list", Command::List},
                                                                             {"filter", Command::Filter},
-                                                                            {"sort", Command::Sort}};
+                                                                            {"find-by-tag", Command::FindByTag},
+                                                                            {"search", Command::Search},
+                                                                            {"sort", Command::Sort},
+                                                                            {"export", Command::Export},
+                                                                            {"export-all", Command::ExportAll},
+                                                                            {"stats", Command::Stats},
+                                                                            {"batch", Command::Batch},
+                                                                            {"serve", Command::Serve},
+                                                                            {"stop", Command::Stop}};
 
   auto it = command_map.find(cmd_str);
   if (it != command_map.end()) {
@@ -73,22 +170,97 @@ Command CommandParser::string_to_command(std::string_view cmd_str) {
   return Command::Unknown;
 }
 
+void CommandParser::parse_options(ParsedArgs &result, std::initializer_list<std::string_view> options) {
+  std::vector<std::string> args = std::move(result.args);
+  result.args.clear();
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string &option = args[i];
+    if (!option.starts_with("--")) {
+      result.args.push_back(option);
+      continue;
+    }
+    if (std::find(options.begin(), options.end(), option) == options.end()) {
+      result.error_message = "unexpected argument: " + option;
+      return;
+    }
+    if (i + 1 == args.size()) {
+      result.error_message = "option '" + option + "' requires a value";
+      return;
+    }
+
+    const std::string &text = args[++i];
+    if (option == "--format") {
+      result.format = text;
+      continue;
+    }
+    if (option == "--group-by") {
+      result.group_by = text;
+      continue;
+    }
+    if (option == "--agg") {
+      result.aggregates = text;
+      continue;
+    }
+    if (option == "--today") {
+      result.today = text;
+      continue;
+    }
+    size_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+      result.error_message = "option '" + option + "' requires a non-negative integer, got: " + text;
+      return;
+    }
+    if (option == "--limit")
+      result.limit = value;
+    else
+      result.offset = value;
+  }
+}
+
 void CommandParser::print_help(std::string_view program_name) {
   std::cout << "TaskProc CLI - Task Processing Tool\n\n";
   std::cout << "Usage: " << program_name << " [COMMAND] [OPTIONS]\n\n";
   std::cout << "Commands:\n";
   std::cout << "  help            Display this help message\n";
-  std::cout << "  load <file>     Load tasks from a file\n";
-  std::cout << "  reload          Reload tasks from the last loaded file\n";
-  std::cout << "  list            List current task view\n";
+  std::cout << "  load <file>     Load tasks from a file, or every file of a directory or glob in parallel\n";
+  std::cout << "  reload          Reload tasks from the last loaded file (--incremental: keep the view)\n";
+  std::cout << "  list            List current task view (--limit N, --offset N to page)\n";
   std::cout << "  clear           Reset task view\n";
   std::cout << "  sort            Sort tasks by priority\n";
-  std::cout << "  filter          Filter tasks by status\n";
+  std::cout << "  filter <expr>   Filter tasks: field op value, combined with AND, OR, NOT and parentheses\n";
+  std::cout << "  find-by-tag     Filter tasks by tag\n";
+  std::cout << "  search <text>   Filter tasks whose title or description contain every word\n";
+  std::cout << "  export <file>   Write the current view to a .csv, .json or .jsonl file ('-': stdout)\n";
+  std::cout << "                  (--format csv|json|ndjson, --limit N, --offset N)\n";
+  std::cout << "  export-all <file>  Write every loaded task, ignoring the view (--format F)\n";
+  std::cout << "  stats           Status counts, average priority and overdue tasks of the current view\n";
+  std::cout << "                  (--group-by status|assignee|tag|created_month,\n";
+  std::cout << "                   --agg count,avg_priority,overdue,min_due,max_due, --today YYYY-MM-DD)\n";
+  std::cout << "  batch <script>  Run one command per line in a single process ('-' or none: stdin)\n";
+  std::cout << "  serve           Keep the tasks in memory and answer the other commands (until 'stop')\n";
+  std::cout << "  stop            Stop the running server\n";
+  std::cout << "\nOptions (any command):\n";
+  std::cout << "  --profile       Print a per-phase time breakdown to stderr (plus allocations if built in)\n";
+  std::cout << "  --profile-trace <file>  Also write Chrome trace-event JSON (chrome://tracing, Perfetto)\n";
 
   std::cout << "\nExamples:\n";
   std::cout << "  " << program_name << " load tasks.csv\n";
+  std::cout << "  " << program_name << " load 'shards/*.csv'\n";
   std::cout << "  " << program_name << " filter status=todo\n";
+  std::cout << "  " << program_name << " filter 'status IN (todo, in-progress) AND (priority>=4 OR assignee=john)'\n";
+  std::cout << "  " << program_name << " find-by-tag urgent\n";
+  std::cout << "  " << program_name << " search login bug\n";
   std::cout << "  " << program_name << " sort priority desc\n";
+  std::cout << "  " << program_name << " list --limit 50 --offset 100\n";
+  std::cout << "  " << program_name << " reload --incremental\n";
+  std::cout << "  " << program_name << " stats --group-by assignee --agg count,overdue\n";
+  std::cout << "  " << program_name << " export urgent.json\n";
+  std::cout << "  " << program_name << " export - --format ndjson | jq .title\n";
+  std::cout << "  " << program_name << " batch nightly.txt\n";
+  std::cout << "  " << program_name << " serve &\n";
+  std::cout << "  " << program_name << " filter status=todo --profile-trace filter.trace.json\n";
 }
 
 void CommandParser::print_usage(std::string_view program_name) {
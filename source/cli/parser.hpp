@@ -1,16 +1,46 @@
 #pragma once
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 /// Available commands
-enum class Command { Help, Load, Reload, Clear, Status, List, Filter, Sort, Unknown };
+enum class Command {
+  Help,
+  Load,
+  Reload,
+  Clear,
+  Status,
+  List,
+  Filter,
+  FindByTag,
+  Search,
+  Sort,
+  Export,
+  ExportAll,
+  Stats,
+  Batch,
+  Serve,
+  Stop,
+  Unknown
+};
 
 /// Struct representing parsed command-line arguments
 struct ParsedArgs {
   Command command;
   std::vector<std::string> args;
   std::string error_message;
+  size_t offset{0};            ///< `--offset N` (list, export): view positions to skip
+  std::optional<size_t> limit; ///< `--limit N` (list, export): maximum number of tasks to print or write
+  std::string format;          ///< `--format F` (export, export-all): output format; empty means by extension
+  bool incremental{false};     ///< `--incremental` (reload): apply only the changed rows, keep the view
+  std::string group_by;        ///< `--group-by F` (stats): field to group by; empty means view-wide totals
+  std::string aggregates;      ///< `--agg A,B` (stats): aggregates to print; empty means all of them
+  std::string today;           ///< `--today D` (stats): reference date for overdue counts; empty means today
+  bool profile{false};         ///< `--profile` (any command): print a per-phase time and allocation breakdown
+  std::string profile_trace;   ///< `--profile-trace F` (any command): also write Chrome trace-event JSON to F
 
   bool is_valid() const { return command != Command::Unknown && error_message.empty(); }
 };
@@ -31,6 +61,14 @@ public:
    */
   static ParsedArgs parse(int argc, char *argv[]);
 
+  /**
+   * Parses the arguments that follow the program name (a forwarded request or a batch line).
+   *
+   * @param args Command followed by its arguments; empty means Help.
+   * @return ParsedArgs object containing parsed command and arguments.
+   */
+  static ParsedArgs parse(std::vector<std::string> args);
+
   /**
    * Prints help message for the program.
    *
@@ -53,4 +91,14 @@ private:
    * @return Command enum value corresponding to the input string.
    */
   static Command string_to_command(std::string_view cmd_str);
+
+  /**
+   * Moves the `options` (any of `--limit N`, `--offset N`, `--format F`, `--group-by F`, `--agg A`,
+   * `--today D`) out of `result.args` into the matching ParsedArgs fields; other arguments stay in
+   * `result.args`.
+   *
+   * @param result Parsed arguments; `error_message` is set on a malformed option or one not in `options`.
+   * @param options Options the command accepts.
+   */
+  static void parse_options(ParsedArgs &result, std::initializer_list<std::string_view> options);
 };
@@ -0,0 +1,40 @@
+// Counting replacements of the global allocation functions behind Profiler::Allocations.
+//
+// Kept apart from the profiler's own code: a replaced operator delete that is inlined next to
+// container code makes GCC pair the builtin operator new with free() (-Wmismatched-new-delete).
+#include "core/profiler.hpp"
+#include <cstdlib>
+#include <new>
+
+#if defined(TASKPROC_PROFILING) && defined(TASKPROC_PROFILE_ALLOCATIONS)
+namespace {
+// Trivially initialized, so they are usable from operator new at any point of a thread's life
+thread_local std::uint64_t thread_allocations = 0;
+thread_local std::uint64_t thread_allocated_bytes = 0;
+} // anonymous namespace
+
+// The array and nothrow forms call these.
+void *operator new(std::size_t size) {
+  ++thread_allocations;
+  thread_allocated_bytes += size;
+  for (;;) {
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+      return p;
+    const std::new_handler handler = std::get_new_handler();
+    if (!handler)
+      throw std::bad_alloc();
+    handler();
+  }
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { ::operator delete(p); }
+#endif
+
+Profiler::Allocations Profiler::Allocations::of_this_thread() noexcept {
+#if defined(TASKPROC_PROFILING) && defined(TASKPROC_PROFILE_ALLOCATIONS)
+  return Allocations{thread_allocations, thread_allocated_bytes};
+#else
+  return Allocations{};
+#endif
+}
@@ -1,14 +1,78 @@
 #include "core/data_manager.hpp"
 #include "core/expr_parser.hpp"
-#include "io/csv_reader.hpp"
+#include "core/filter_expr.hpp"
+#include "core/profiler.hpp"
+#include "core/thread_pool.hpp"
+#include "io/csv_writer.hpp"
+#include "io/dataset_files.hpp"
 #include "io/json_reader.hpp"
+#include "io/json_writer.hpp"
+#include "io/ndjson_reader.hpp"
+#include "io/output_sink.hpp"
+#include "io/parallel_csv_reader.hpp"
 #include "io/view_storage.hpp"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
-DataManager::DataManager() : storage_{} {
+namespace {
+// Fields replaying `history` reads
+TaskFields fields_of(const std::vector<ViewAction> &history) noexcept {
+  TaskFields fields;
+  for (const auto &action : history) {
+    fields |= ExpressionParser::fields_of(action);
+  }
+  return fields;
+}
+
+// Post: the tasks of every part in order, so a later shard's row wins a duplicate ID once loaded (as a later
+//       row of one file does); `shards[i].ids` lists the IDs of part `i`; IDs that shards share are reported.
+std::vector<Task> merge_shards(std::vector<std::vector<Task>> parts, std::vector<Shard> &shards) {
+  size_t total = 0;
+  for (const auto &part : parts) {
+    total += part.size();
+  }
+
+  std::unordered_map<int, size_t> owner; // ID -> last shard holding it
+  owner.reserve(total);
+  std::map<std::pair<size_t, size_t>, size_t> overridden; // (earlier, later) shard -> shared IDs
+  for (size_t i = 0; i < parts.size(); ++i) {
+    shards[i].ids.clear();
+    shards[i].ids.reserve(parts[i].size());
+    for (const auto &task : parts[i]) {
+      shards[i].ids.push_back(task.id);
+      auto [it, inserted] = owner.try_emplace(task.id, i);
+      if (!inserted && it->second != i) {
+        ++overridden[{it->second, i}];
+        it->second = i;
+      }
+    }
+  }
+  for (const auto &[pair, count] : overridden) {
+    std::cerr << "Warning: " << count << " task IDs of " << shards[pair.first].source.path << " are overridden by "
+              << shards[pair.second].source.path << "\n";
+  }
+
+  std::vector<Task> tasks;
+  tasks.reserve(total);
+  for (auto &part : parts) {
+    std::move(part.begin(), part.end(), std::back_inserter(tasks));
+    std::vector<Task>().swap(part); // release the moved-from shells shard by shard
+  }
+  return tasks;
+}
+} // anonymous namespace
+
+DataManager::DataManager(TaskFields fields, SessionStart start) : storage_{} {
+  TASKPROC_PROFILE_SCOPE("data_manager.restore_session");
   register_readers();
+  register_writers();
   try {
     if (storage_.load_from_storage()) {
       auto saved_path = storage_.filepath();
@@ -16,26 +80,40 @@ DataManager::DataManager() : storage_{} {
         current_filepath_ = saved_path->string();
       }
 
-      // 1. Load tasks from file
-      ITaskReader *reader = select_reader(current_filepath_);
-      if (!reader) {
-        std::cerr << "No reader found for file: " << current_filepath_ << "\n";
-        return;
+      // 1. A history whose view is not cached is replayed, so the fields it reads are decoded too
+      const auto &history = storage_.history();
+      current_source_ = fingerprint_dataset(current_filepath_);
+      if (start == SessionStart::Previous && current_source_) {
+        // The last snapshot of this dataset (and the view stored for it) stands in for the file
+        auto previous = snapshot_source();
+        if (previous && previous->path == current_source_->path)
+          current_source_ = std::move(previous);
       }
+      const std::vector<ViewAction> actions = ViewCache::normalize(history); // empty: the full view
+      std::optional<std::vector<int>> cached_view;
+      if (!actions.empty() && current_source_)
+        cached_view = view_cache_.find(*current_source_, actions);
+      if (!actions.empty() && !cached_view)
+        fields |= fields_of(history);
 
-      std::vector<Task> tasks = reader->read_tasks(current_filepath_);
-
-      // 2. Load into databse
-      database_.load(tasks);
-      std::cerr << "Loaded " << tasks.size() << " tasks\n";
+      // 2. Rehydrate tasks from the binary snapshot, or re-parse the file if it changed, then
+      //    move them into the database
+      std::vector<Task> tasks;
+      if (!read_current_dataset(fields, tasks))
+        return;
+      const size_t loaded = tasks.size();
+      database_.load(std::move(tasks));
+      loaded_fields_ = fields;
+      std::cerr << "Loaded " << loaded << " tasks\n";
 
-      // 3. Replay history to reconstruct view
-      const auto &history = storage_.history();
-      if (!history.empty()) {
-        database_.replay_history(history);
+      // 3. Restore the cached view, or replay history to reconstruct it
+      if (!actions.empty() && !(cached_view && database_.restore_view(*cached_view))) {
+        std::cerr << "Replaying " << history.size() << " actions\n";
+        if (!require_fields(fields_of(history)))
+          return;
+        replay_with_cache(history);
+        persist_view();
       }
-
-      std::cerr << "Replaying " << history.size() << " actions\n";
     }
   } catch (const std::exception &e) {
     std::cerr << "Warning: unable to read view from storage: " << e.what() << "\n";
@@ -43,20 +121,27 @@ DataManager::DataManager() : storage_{} {
 }
 
 void DataManager::register_readers() {
-  readers_.emplace_back(std::make_unique<CSVReader>());
+  // First match wins. ParallelCSVReader alone takes .csv files: with one thread it parses inline, so the
+  // single-threaded CSVReader would never be chosen and is not registered (it stays usable on its own)
+  readers_.emplace_back(std::make_unique<ParallelCSVReader>());
   readers_.emplace_back(std::make_unique<JSONReader>());
+  readers_.emplace_back(std::make_unique<NDJSONReader>());
 }
 
-bool DataManager::load_from_file(std::string_view filepath) {
-  ITaskReader *reader = select_reader(filepath);
-  if (!reader) {
-    std::cerr << "No reader found for file: " << filepath << "\n";
-    return false;
-  }
+void DataManager::register_writers() {
+  writers_.emplace_back(std::make_unique<CSVWriter>());
+  writers_.emplace_back(std::make_unique<JSONWriter>());
+  writers_.emplace_back(std::make_unique<NDJSONWriter>());
+}
 
+bool DataManager::load_from_file(std::string_view filepath) {
+  TASKPROC_PROFILE_SCOPE("data_manager.load");
   std::vector<Task> tasks;
+  std::optional<SourceFingerprint> source;
+  std::vector<Shard> shards;
   try {
-    tasks = reader->read_tasks(filepath);
+    if (!read_dataset(filepath, TaskFields::all(), tasks, source, shards))
+      return false;
   } catch (const std::exception &e) {
     std::cerr << "Error reading file: " << filepath << "\n";
     std::cerr << e.what() << "\n";
@@ -71,17 +156,27 @@ bool DataManager::load_from_file(std::string_view filepath) {
   // Store the filepath and clears previous history (set_filepath clears history)
   try {
     storage_.set_filepath(filepath);
-    storage_.persist();
+    if (!batching_)
+      storage_.persist();
   } catch (const std::exception &e) {
     std::cerr << "Warning: failed to persist view storage: " << e.what() << "\n";
     return false;
   }
 
-  // 1. Load tasks into database
-  database_.load(tasks);
+  // 1. Refresh the binary snapshot and shard list, then move the tasks into the database (no copy)
+  current_source_ = std::move(source);
+  shards_ = std::move(shards);
+  save_snapshot(current_source_, tasks);
+  save_shards();
+  database_.load(std::move(tasks));
+  loaded_fields_ = TaskFields::all();
   // 2. Store the filepath (this clears history for new loads)
   current_filepath_ = filepath;
   // 3. Perist (saves empty history for new loads)
+  if (batching_) {
+    persist_pending_ = true;
+    return true;
+  }
   try {
     storage_.persist();
   } catch (const std::exception &e) {
@@ -92,6 +187,328 @@ bool DataManager::load_from_file(std::string_view filepath) {
   return true;
 }
 
+bool DataManager::load_snapshot(const std::optional<SourceFingerprint> &source,
+                                std::vector<Task> &tasks,
+                                TaskFields fields) const {
+  if (!source)
+    return false;
+  try {
+    auto cached = snapshot_.read(*source, fields);
+    if (!cached)
+      return false;
+    tasks = std::move(*cached);
+    return true;
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: ignoring unreadable snapshot: " << e.what() << "\n";
+    return false;
+  }
+}
+
+bool DataManager::read_current_dataset(TaskFields fields, std::vector<Task> &tasks) {
+  if (load_snapshot(current_source_, tasks, fields))
+    return true;
+  std::vector<Shard> shards;
+  if (!read_dataset(current_filepath_, fields, tasks, current_source_, shards))
+    return false;
+  shards_ = std::move(shards);
+  save_shards();
+  // A projected parse lacks fields, so only a full one is snapshotted
+  if (fields.is_all())
+    save_snapshot(current_source_, tasks);
+  return true;
+}
+
+bool DataManager::read_dataset(std::string_view spec,
+                               TaskFields fields,
+                               std::vector<Task> &tasks,
+                               std::optional<SourceFingerprint> &source,
+                               std::vector<Shard> &shards) const {
+  if (!is_sharded_dataset(spec)) {
+    ITaskReader *reader = select_reader(spec);
+    if (!reader) {
+      std::cerr << "No reader found for file: " << spec << "\n";
+      return false;
+    }
+    source = SourceFingerprint::of(spec);
+    tasks = reader->read_tasks(spec, fields);
+    shards.clear();
+    return true;
+  }
+
+  const auto files = shard_files(spec);
+  if (files.empty()) {
+    std::cerr << "No task files found for: " << spec << "\n";
+    return false;
+  }
+  shards.assign(files.size(), Shard{});
+  std::vector<SourceFingerprint> fingerprints;
+  for (size_t i = 0; i < files.size(); ++i) {
+    auto fingerprint = SourceFingerprint::of(files[i]);
+    if (!fingerprint)
+      throw std::runtime_error("cannot stat " + files[i].string());
+    shards[i].source = *fingerprint;
+    fingerprints.push_back(std::move(*fingerprint));
+  }
+  tasks = merge_shards(read_shards(files, fields), shards);
+  source = combine_fingerprints(spec, fingerprints);
+  return true;
+}
+
+std::vector<std::filesystem::path> DataManager::shard_files(std::string_view spec) const {
+  auto files = dataset_files(spec);
+  std::erase_if(files, [this](const std::filesystem::path &file) { return !select_reader(file.string()); });
+  return files;
+}
+
+std::vector<std::vector<Task>> DataManager::read_shards(const std::vector<std::filesystem::path> &files,
+                                                        TaskFields fields) const {
+  TASKPROC_PROFILE_SCOPE("data_manager.read_shards");
+  TASKPROC_PROFILE_COUNT("data_manager.shards_read", files.size());
+  std::vector<std::vector<Task>> parts(files.size());
+  // A pool of its own: readers split large files on the shared pool and wait for it, which a job running
+  // on the shared pool must not do
+  ThreadPool pool(std::min(files.size(), ThreadPool::configured_threads()));
+  pool.parallel_for(files.size(), [&](size_t i) {
+    const std::string path = files[i].string();
+    try {
+      parts[i] = select_reader(path)->read_tasks(path, fields);
+    } catch (const std::exception &e) {
+      throw std::runtime_error(path + ": " + e.what());
+    }
+  });
+  return parts;
+}
+
+bool DataManager::read_changed_shards(std::vector<Task> &tasks,
+                                      std::optional<SourceFingerprint> &source,
+                                      std::vector<Shard> &shards) {
+  // The shards of the resident rows: as this process read them, or as recorded with the snapshot
+  if (shards_.empty() && current_source_) {
+    try {
+      if (auto stored = snapshot_.read_shards(*current_source_))
+        shards_ = std::move(*stored);
+    } catch (const std::exception &e) {
+      std::cerr << "Warning: ignoring unreadable shard list: " << e.what() << "\n";
+    }
+  }
+  if (shards_.empty())
+    return read_dataset(current_filepath_, TaskFields::all(), tasks, source, shards); // nothing to compare with
+
+  const auto files = shard_files(current_filepath_);
+  if (files.empty()) {
+    std::cerr << "No task files found for: " << current_filepath_ << "\n";
+    return false;
+  }
+
+  // 1. A new or modified shard is re-read. So is an unmodified one sharing an ID with a modified or
+  //    removed shard: a row it lost to that shard may win now, and the database only holds the winner.
+  std::unordered_map<std::string_view, const Shard *> previous;
+  for (const auto &shard : shards_) {
+    previous.emplace(shard.source.path, &shard);
+  }
+  shards.assign(files.size(), Shard{});
+  std::vector<const Shard *> unchanged(files.size(), nullptr);
+  std::unordered_set<int> displaced; // IDs of the previous versions of modified and removed shards
+  std::vector<SourceFingerprint> fingerprints;
+  for (size_t i = 0; i < files.size(); ++i) {
+    auto fingerprint = SourceFingerprint::of(files[i]);
+    if (!fingerprint)
+      throw std::runtime_error("cannot stat " + files[i].string());
+    shards[i].source = *fingerprint;
+    fingerprints.push_back(std::move(*fingerprint));
+
+    auto it = previous.find(shards[i].source.path);
+    if (it == previous.end())
+      continue;
+    if (it->second->source == shards[i].source)
+      unchanged[i] = it->second;
+    else
+      displaced.insert(it->second->ids.begin(), it->second->ids.end());
+    previous.erase(it);
+  }
+  for (const auto &[path, shard] : previous) {
+    displaced.insert(shard->ids.begin(), shard->ids.end()); // removed
+  }
+
+  std::vector<std::vector<Task>> parts(files.size());
+  std::vector<size_t> reread;
+  for (size_t i = 0; i < files.size(); ++i) {
+    const Shard *shard = unchanged[i];
+    if (!shard || std::any_of(shard->ids.begin(), shard->ids.end(), [&displaced](int id) {
+          return displaced.contains(id);
+        })) {
+      reread.push_back(i);
+      continue;
+    }
+    // 2. Any other shard is taken from memory: the database holds its row for every ID, or the row of a
+    //    later unmodified shard, which wins again below
+    parts[i].reserve(shard->ids.size());
+    for (int id : shard->ids) {
+      const Task *task = database_.get_task_by_id(id);
+      if (!task)
+        return read_dataset(current_filepath_, TaskFields::all(), tasks, source, shards); // stale shard list
+      parts[i].push_back(*task);
+    }
+  }
+
+  std::vector<std::filesystem::path> reread_files;
+  for (size_t i : reread) {
+    reread_files.push_back(files[i]);
+  }
+  auto fresh = read_shards(reread_files, TaskFields::all());
+  for (size_t k = 0; k < reread.size(); ++k) {
+    parts[reread[k]] = std::move(fresh[k]);
+  }
+
+  tasks = merge_shards(std::move(parts), shards);
+  source = combine_fingerprints(current_filepath_, fingerprints);
+  return true;
+}
+
+std::optional<SourceFingerprint> DataManager::fingerprint_dataset(std::string_view spec) const {
+  if (!is_sharded_dataset(spec))
+    return SourceFingerprint::of(spec);
+  std::vector<SourceFingerprint> fingerprints;
+  for (const auto &file : shard_files(spec)) {
+    auto fingerprint = SourceFingerprint::of(file);
+    if (!fingerprint)
+      return std::nullopt;
+    fingerprints.push_back(std::move(*fingerprint));
+  }
+  if (fingerprints.empty())
+    return std::nullopt;
+  return combine_fingerprints(spec, fingerprints);
+}
+
+bool DataManager::require_fields(TaskFields fields) {
+  if (loaded_fields_.contains(fields))
+    return true;
+  TASKPROC_PROFILE_SCOPE("data_manager.require_fields");
+  std::vector<Task> tasks;
+  try {
+    if (!read_current_dataset(TaskFields::all(), tasks))
+      return false;
+  } catch (const std::exception &e) {
+    std::cerr << "Error reading file: " << current_filepath_ << "\n";
+    std::cerr << e.what() << "\n";
+    return false;
+  }
+
+  // The same rows with every field: the view is carried over by ID (and replayed if the file changed)
+  const std::vector<int> view_ids = database_.current_view_ids();
+  database_.load(std::move(tasks));
+  loaded_fields_ = TaskFields::all();
+  const auto &history = storage_.history();
+  if (!history.empty() && !database_.restore_view(view_ids))
+    replay_with_cache(history);
+  return true;
+}
+
+std::optional<SourceFingerprint> DataManager::snapshot_source() const noexcept {
+  try {
+    return snapshot_.source();
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: ignoring unreadable snapshot: " << e.what() << "\n";
+    return std::nullopt;
+  }
+}
+
+void DataManager::save_snapshot(const std::optional<SourceFingerprint> &source,
+                                const std::vector<Task> &tasks) const noexcept {
+  if (!source)
+    return;
+  try {
+    // Written from the parsed tasks, so the database never rebuilds Task objects for it
+    std::vector<const Task *> rows;
+    rows.reserve(tasks.size());
+    for (const auto &task : tasks) {
+      rows.push_back(&task);
+    }
+    snapshot_.write(*source, rows);
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to write snapshot: " << e.what() << "\n";
+  }
+}
+
+void DataManager::save_shards() const noexcept {
+  if (!current_source_ || shards_.empty())
+    return;
+  try {
+    snapshot_.write_shards(*current_source_, shards_);
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to write shard list: " << e.what() << "\n";
+  }
+}
+
+void DataManager::load_text_index() noexcept {
+  if (!current_source_)
+    return;
+  try {
+    auto cached = snapshot_.read_text_index(*current_source_);
+    if (cached && !database_.set_text_index(std::move(*cached)))
+      std::cerr << "Warning: ignoring text index built for another dataset\n";
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: ignoring unreadable text index: " << e.what() << "\n";
+  }
+}
+
+void DataManager::save_text_index() const noexcept {
+  const TextIndex *index = database_.text_index();
+  if (!current_source_ || !index)
+    return;
+  try {
+    snapshot_.write_text_index(*current_source_, *index);
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to write text index: " << e.what() << "\n";
+  }
+}
+
+void DataManager::replay_with_cache(const std::vector<ViewAction> &history) {
+  TASKPROC_PROFILE_SCOPE("data_manager.replay");
+  // Only the actions after the longest cached prefix are applied
+  std::vector<ViewAction> actions = ViewCache::normalize(history);
+  if (current_source_) {
+    auto hit = view_cache_.longest_prefix(*current_source_, actions);
+    if (hit && database_.restore_view(hit->task_ids))
+      actions.erase(actions.begin(), actions.begin() + static_cast<std::ptrdiff_t>(hit->length));
+  }
+
+  const bool searches = std::any_of(actions.begin(), actions.end(), [](const ViewAction &action) {
+    return action.type == ViewOpType::Search;
+  });
+  if (searches)
+    load_text_index();
+  const bool indexed = database_.text_index() != nullptr;
+  database_.replay_history(actions);
+  if (!indexed && database_.text_index())
+    save_text_index();
+}
+
+bool DataManager::restore_cached(const std::vector<ViewAction> &actions) {
+  if (!current_source_)
+    return false;
+  std::vector<ViewAction> history = storage_.history();
+  history.insert(history.end(), actions.begin(), actions.end());
+  auto task_ids = view_cache_.find(*current_source_, ViewCache::normalize(history));
+  return task_ids && database_.restore_view(*task_ids);
+}
+
+void DataManager::persist_view() noexcept {
+  TASKPROC_PROFILE_SCOPE("data_manager.persist_view");
+  if (batching_) {
+    persist_pending_ = true; // the view is recorded once, by end_batch()
+    return;
+  }
+  try {
+    // The cache entry is the stored view: the next process restores it from there
+    if (current_source_ && !storage_.history().empty())
+      view_cache_.insert(*current_source_, ViewCache::normalize(storage_.history()), database_.current_view_ids());
+    storage_.persist();
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to persist view storage: " << e.what() << "\n";
+  }
+}
+
 ITaskReader *DataManager::select_reader(std::string_view filepath) const {
   for (const auto &reader : readers_) {
     if (reader->can_handle(filepath)) {
@@ -101,59 +518,205 @@ ITaskReader *DataManager::select_reader(std::string_view filepath) const {
   return nullptr;
 }
 
-bool DataManager::reload_tasks() {
-  if (current_filepath_.empty()) {
-    try {
-      if (storage_.load_from_storage()) {
-        current_filepath_ = storage_.filepath().value_or("");
-      }
-    } catch (const std::exception &e) {
-      std::cerr << "Error reading view storage: " << e.what() << "\n";
-      return false;
+const ITaskWriter *DataManager::select_writer(std::string_view filepath, std::string_view format) const {
+  for (const auto &writer : writers_) {
+    if (format.empty() ? writer->can_handle(filepath) : writer->format_name() == format) {
+      return writer.get();
     }
-    if (current_filepath_.empty()) {
-      std::cerr << "The file path is empty\n";
+  }
+  return nullptr;
+}
+
+bool DataManager::reload_tasks() {
+  TASKPROC_PROFILE_SCOPE("data_manager.reload");
+  if (!resolve_current_file())
+    return false;
+  return load_from_file(current_filepath_);
+}
+
+bool DataManager::reload_incremental(ReloadDelta *delta) {
+  TASKPROC_PROFILE_SCOPE("data_manager.reload_incremental");
+  if (!resolve_current_file())
+    return false;
+  if (database_.empty())
+    return load_from_file(current_filepath_); // nothing resident to diff against
+  if (!require_fields(TaskFields::all()))
+    return false; // rows are diffed on every field
+
+  std::vector<Task> tasks;
+  std::optional<SourceFingerprint> source;
+  std::vector<Shard> shards;
+  try {
+    // A sharded dataset re-reads only the shards that changed
+    const bool read = is_sharded_dataset(current_filepath_)
+                          ? read_changed_shards(tasks, source, shards)
+                          : read_dataset(current_filepath_, TaskFields::all(), tasks, source, shards);
+    if (!read)
       return false;
+  } catch (const std::exception &e) {
+    std::cerr << "Error reading file: " << current_filepath_ << "\n";
+    std::cerr << e.what() << "\n";
+    return false;
+  }
+  if (tasks.empty()) {
+    std::cerr << "No tasks found in file: " << current_filepath_ << "\n";
+    return false;
+  }
+
+  save_snapshot(source, tasks);
+  const ReloadDelta changes = database_.reload(std::move(tasks), storage_.history());
+  current_source_ = std::move(source);
+  shards_ = std::move(shards);
+  save_shards();
+  if (delta)
+    *delta = changes;
+
+  // The history is unchanged; its view is cached again for the new source
+  persist_view();
+  return true;
+}
+
+bool DataManager::refresh_if_changed() {
+  if (current_filepath_.empty() || database_.empty())
+    return true;
+  if (fingerprint_dataset(current_filepath_) == current_source_)
+    return true;
+  return reload_incremental();
+}
+
+bool DataManager::resolve_current_file() {
+  if (!current_filepath_.empty())
+    return true;
+  try {
+    if (storage_.load_from_storage()) {
+      current_filepath_ = storage_.filepath().value_or("");
     }
+  } catch (const std::exception &e) {
+    std::cerr << "Error reading view storage: " << e.what() << "\n";
+    return false;
   }
-  return load_from_file(current_filepath_);
+  if (current_filepath_.empty()) {
+    std::cerr << "The file path is empty\n";
+    return false;
+  }
+  return true;
 }
 
 bool DataManager::apply_filter(std::string_view filter) {
-  auto filter_spec = ExpressionParser::parse_filter(filter);
-  if (!filter_spec) {
+  auto filter_expr = ExpressionParser::parse_filter_expr(filter);
+  if (!filter_expr) {
     std::cerr << "Invalid filter expression\n";
     return false;
   }
-  database_.apply_filter(*filter_spec);
+  ViewAction action{ViewOpType::Filter, std::string(filter)};
+  if (!restore_cached({action})) {
+    if (!require_fields(ExpressionParser::fields_of(*filter_expr)))
+      return false;
+    database_.apply_filter(*filter_expr);
+  }
 
-  storage_.push_action(ViewAction{ViewOpType::Filter, std::string(filter)});
+  storage_.push_action(std::move(action));
+  persist_view();
 
-  try {
-    storage_.persist();
-  } catch (const std::exception &e) {
-    std::cerr << "Warning: failed to persist view storage: " << e.what() << "\n";
+  return true;
+}
+
+bool DataManager::apply_filters(const std::vector<std::string> &exprs) {
+  // Flatten into one AND, so the database fuses every non-indexed operand into a single pass
+  std::vector<FilterExpr> operands;
+  TaskFields fields;
+  for (const auto &expr : exprs) {
+    auto filter_expr = ExpressionParser::parse_filter_expr(expr);
+    if (!filter_expr) {
+      std::cerr << "Invalid filter expression: " << expr << "\n";
+      return false;
+    }
+    fields |= ExpressionParser::fields_of(*filter_expr);
+    if (filter_expr->kind == FilterExprKind::And) {
+      std::move(filter_expr->children.begin(), filter_expr->children.end(), std::back_inserter(operands));
+    } else {
+      operands.push_back(std::move(*filter_expr));
+    }
   }
+  if (operands.empty())
+    return true;
+  std::vector<ViewAction> actions;
+  for (const auto &expr : exprs) {
+    actions.push_back(ViewAction{ViewOpType::Filter, expr});
+  }
+  if (!restore_cached(actions)) {
+    if (!require_fields(fields))
+      return false;
+    database_.apply_filter(operands.size() == 1 ? operands.front() : FilterExpr::all_of(std::move(operands)));
+  }
+
+  for (auto &action : actions) {
+    storage_.push_action(std::move(action));
+  }
+  persist_view();
 
   return true;
 }
 
 bool DataManager::apply_sort(std::string_view sort) {
-  auto sort_spec = ExpressionParser::parse_sort(sort);
-  if (!sort_spec) {
+  auto keys = ExpressionParser::parse_sort_keys(sort);
+  if (!keys) {
     std::cerr << "Invalid sort expression\n";
     return false;
   }
-  database_.apply_sort(*sort_spec);
+  ViewAction action{ViewOpType::Sort, std::string(sort)};
+  if (!restore_cached({action})) {
+    if (!require_fields(ExpressionParser::fields_of(*keys)))
+      return false;
+    database_.apply_sort(*keys);
+  }
 
-  storage_.push_action(ViewAction{ViewOpType::Sort, std::string(sort)});
+  storage_.push_action(std::move(action));
+  persist_view();
 
-  try {
-    storage_.persist();
-  } catch (const std::exception &e) {
-    std::cerr << "Warning: failed to persist view storage: " << e.what() << "\n";
+  return true;
+}
+
+bool DataManager::filter_by_tag(std::string_view tag) {
+  if (tag.empty()) {
+    std::cerr << "Invalid tag\n";
+    return false;
+  }
+  ViewAction action{ViewOpType::FindByTag, std::string(tag)};
+  if (!restore_cached({action})) {
+    if (!require_fields(TaskField::Tags))
+      return false;
+    database_.filter_by_tag(tag);
+  }
+
+  storage_.push_action(std::move(action));
+  persist_view();
+
+  return true;
+}
+
+bool DataManager::search_text(std::string_view text) {
+  if (TextIndex::words(text).empty()) {
+    std::cerr << "Invalid search text\n";
+    return false;
   }
 
+  ViewAction action{ViewOpType::Search, std::string(text)};
+  if (!restore_cached({action})) {
+    if (!require_fields(TaskField::Title | TaskField::Description))
+      return false;
+    // Reuse the index cached by an earlier process; otherwise the search builds it and it is cached after
+    if (!database_.text_index())
+      load_text_index();
+    const bool indexed = database_.text_index() != nullptr;
+    database_.search_text(text);
+    if (!indexed)
+      save_text_index();
+  }
+
+  storage_.push_action(std::move(action));
+  persist_view();
+
   return true;
 }
 
@@ -163,7 +726,73 @@ std::string DataManager::current_file_path() const noexcept { return current_fil
 
 const std::vector<const Task *> &DataManager::current_view() const noexcept { return database_.current_view(); }
 
+std::vector<const Task *> DataManager::view_page(size_t offset, size_t limit) const {
+  return database_.view_page(offset, limit);
+}
+
+size_t DataManager::view_task_count() const noexcept { return database_.view_task_count(); }
+
+StatusStats DataManager::status_stats() const noexcept { return database_.status_stats(); }
+
+double DataManager::average_priority() const noexcept { return database_.average_priority(); }
+
+size_t DataManager::overdue_count(std::string_view today_iso) const noexcept {
+  return database_.overdue_count(today_iso);
+}
+
+std::vector<GroupStats> DataManager::group_stats(GroupField field, std::string_view today_iso) const {
+  return database_.group_stats(field, today_iso);
+}
+
+std::vector<const Task *> DataManager::all_tasks() const { return database_.all_tasks(); }
+
+bool DataManager::export_tasks(const std::vector<const Task *> &tasks,
+                               std::string_view filepath,
+                               std::string_view format) const {
+  TASKPROC_PROFILE_SCOPE("data_manager.export");
+  const bool to_stdout = filepath == "-";
+  const ITaskWriter *writer = select_writer(filepath, format.empty() && to_stdout ? "csv" : format);
+  if (!writer) {
+    if (format.empty())
+      std::cerr << "No writer found for file: " << filepath << "\n";
+    else
+      std::cerr << "Unknown export format: " << format << "\n";
+    return false;
+  }
+
+  try {
+    if (to_stdout) {
+      StreamSink sink(std::cout);
+      writer->write_tasks(tasks, sink);
+      std::cout.flush();
+    } else {
+      FileSink sink{std::filesystem::path(filepath)};
+      writer->write_tasks(tasks, sink);
+      sink.close();
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Failed to export tasks: " << e.what() << "\n";
+    return false;
+  }
+  return true;
+}
+
 void DataManager::reset_view() {
-  storage_.clear_history();
+  if (batching_) {
+    storage_.discard_history();
+    persist_pending_ = true;
+  } else {
+    storage_.clear_history();
+  }
   database_.reset_view();
 }
+
+void DataManager::begin_batch() noexcept { batching_ = true; }
+
+void DataManager::end_batch() noexcept {
+  batching_ = false;
+  if (persist_pending_) {
+    persist_pending_ = false;
+    persist_view();
+  }
+}
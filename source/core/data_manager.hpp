@@ -1,11 +1,24 @@
 #pragma once
+#include "../io/dataset_files.hpp"
 #include "../io/reader.hpp"
+#include "../io/snapshot_cache.hpp"
+#include "../io/view_cache.hpp"
 #include "../io/view_storage.hpp"
+#include "../io/writer.hpp"
 #include "core/database.hpp"
+#include "core/task_fields.hpp"
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <vector>
 
+/// State of the stored session a DataManager starts from
+enum class SessionStart {
+  Current, ///< The dataset as it is on disk now (re-parsed, and the history replayed, if it changed)
+  Previous ///< The tasks and view last snapshotted, for `reload_incremental` to diff the file against
+};
+
 /**
  * @brief DataManager manages the loading and reloading of tasks from files.
  *
@@ -14,17 +27,45 @@
 class DataManager {
 private:
   std::vector<std::unique_ptr<ITaskReader>> readers_;
+  std::vector<std::unique_ptr<ITaskWriter>> writers_;
   std::string current_filepath_;
+  std::optional<SourceFingerprint> current_source_; ///< Fingerprint of the loaded file (or of all its shards)
+  std::vector<Shard> shards_; ///< Files of a sharded dataset as last read; empty for a single file or if unknown
   ViewStorage storage_;
+  SnapshotCache snapshot_;
+  ViewCache view_cache_; ///< Views computed for recent histories of this dataset, the current one included
   Database database_;
+  TaskFields loaded_fields_{TaskFields::all()}; ///< Fields the resident tasks carry
+  bool batching_{false};        ///< Between begin_batch() and end_batch(): storage writes are deferred
+  bool persist_pending_{false}; ///< A deferred storage write is owed
 
 public:
-  /// Construct a DataManager and register available readers.
-  DataManager();
+  /**
+   * @brief Construct a DataManager, register available readers and restore the persisted view.
+   *
+   * If a dataset was previously loaded, its tasks are rehydrated from the binary
+   * snapshot when the source file is unchanged, and re-parsed otherwise.
+   *
+   * Only `fields` (plus those a replay of the stored history reads) are decoded;
+   * the others are left empty (see TaskFields) until `require_fields` asks for
+   * them. A snapshot is only written from a parse of every field.
+   *
+   * With `SessionStart::Previous`, the tasks come from the snapshot even if the
+   * file changed since (as long as it was taken of the same path), and the view
+   * stored for them is restored, so a following `reload_incremental` reports
+   * and applies what changed. Without such a snapshot the file is read as usual.
+   *
+   * @param fields Fields the caller is going to read.
+   * @param start Which state of the stored session to restore.
+   */
+  explicit DataManager(TaskFields fields = TaskFields::all(), SessionStart start = SessionStart::Current);
 
   /**
    * @brief Load tasks from `filepath` and replace the manager's tasks on success.
    *
+   * `filepath` may also be a directory or a glob pattern such as `shards/[0-9]*.csv`:
+   * its files are loaded in parallel as one dataset (see `read_dataset`).
+   *
    * @pre `filepath` is a path to a readable file and a matching reader exists.
    * @post On success: `tasks_` contains the loaded tasks and `current_filepath_`
    *       equals `filepath`.
@@ -44,6 +85,34 @@ public:
    */
   bool reload_tasks();
 
+  /**
+   * @brief Reload the current file, applying only the rows that changed and keeping the view.
+   *
+   * Unlike `reload_tasks`, the view history is kept: rows are matched by ID and compared by
+   * content hash (see Database::reload), and only inserted and updated rows are re-filtered.
+   * Of a sharded dataset, only new and modified shards are parsed again.
+   *
+   * @pre A file was previously loaded successfully.
+   * @post On success: the tasks match the file, the current view equals replaying the history
+   *       over them, and the snapshot is refreshed; `delta` (if given) holds the changed row counts.
+   * @post On failure: tasks and view are unchanged.
+   * @return true if the reload succeeded, false otherwise.
+   */
+  bool reload_incremental(ReloadDelta *delta = nullptr);
+
+  /**
+   * @brief Catch up with the current file if it changed on disk since it was read.
+   *
+   * For a long-lived manager (`taskproc serve`): the dataset is fingerprinted
+   * again and, if it differs from the one loaded, reloaded with `reload_incremental`,
+   * so the view carries over as a new process would replay it.
+   *
+   * @post The tasks match the file as it is now; nothing changes if no file is
+   *       loaded or it did not change.
+   * @return false (reported to std::cerr) if the file changed but could not be reloaded.
+   */
+  bool refresh_if_changed();
+
   /**
    * @brief Apply a filter expression to the current view and record it.
    * @pre `expr` is a valid filter expression for the engine to interpret.
@@ -52,14 +121,57 @@ public:
    */
   bool apply_filter(std::string_view expr);
 
+  /**
+   * @brief Apply several filter expressions in one pass, as if applied one after another.
+   * @pre Every expression is a valid filter expression.
+   * @post On success: the view holds the tasks matching all of them, each expression is
+   *       appended to history in order, and storage is persisted once.
+   * @throws none (returns false, applying nothing, if any expression is invalid).
+   */
+  bool apply_filters(const std::vector<std::string> &exprs);
+
   /**
    * @brief Apply a sort expression to the current view and record it.
-   * @pre `expr` is a valid sort expression (e.g., "due_date desc").
+   * @pre `expr` is a valid sort key list (e.g., "due_date desc" or "priority desc, due_date, id").
    * @post On success: the action is appended to history and persisted.
    * @throws none (returns false if no current file is known).
    */
   bool apply_sort(std::string_view expr);
 
+  /**
+   * @brief Narrow the current view to tasks carrying `tag` and record it.
+   * @pre `tag` is non-empty.
+   * @post On success: the action is appended to history and persisted.
+   * @throws none (returns false for an empty tag).
+   */
+  bool filter_by_tag(std::string_view tag);
+
+  /**
+   * @brief Narrow the current view to tasks matching every word of `text` and record it.
+   * @pre `text` contains at least one word (see Database::search_text).
+   * @post On success: the action is appended to history and persisted; a text index
+   *       built for the search is cached next to the snapshot.
+   * @throws none (returns false for a text without words).
+   */
+  bool search_text(std::string_view text);
+
+  /**
+   * @brief Make sure the resident tasks carry `fields`, decoding the dataset again if they do not.
+   *
+   * The view operations above call this for the fields they read; callers that
+   * read tasks directly (`current_view`, `view_page`, the statistics) call it
+   * first unless the fields were requested at construction.
+   *
+   * @post On success: `loaded_fields()` contains `fields` and the view is unchanged. If the
+   *       dataset was decoded again, every task was replaced: pointers obtained earlier dangle.
+   * @post On failure: tasks and view are unchanged.
+   * @throws none (returns false and reports the error if the dataset cannot be read).
+   */
+  bool require_fields(TaskFields fields);
+
+  /// Fields the resident tasks carry (every field unless constructed with a projection).
+  TaskFields loaded_fields() const noexcept { return loaded_fields_; }
+
   /**
    * @brief Get the number of tasks currently loaded.
    *
@@ -80,13 +192,76 @@ public:
    * @pre none
    * @post Returns const reference to vector of non-owning task pointers.
    * @throws none (noexcept).
-   * @note Returned pointers remain valid until next load() or reload() call.
+   * @note Returned pointers remain valid until the next load, reload, view operation or
+   *       `require_fields` call; in a projected session a view operation may decode the
+   *       dataset again (see `require_fields`), which replaces every task.
    * @note Do not store pointers beyond DataManager's lifetime.
    *
    * @return Const reference to vector of task pointers.
    */
   const std::vector<const Task *> &current_view() const noexcept;
 
+  /**
+   * @brief Tasks at positions `[offset, offset + limit)` of the current view.
+   *
+   * @post Same tasks as that slice of `current_view()`, without ordering or rebuilding the whole view.
+   * @throws std::bad_alloc if the page cannot be allocated.
+   * @note Returned pointers are invalidated as those of `current_view()` are.
+   */
+  std::vector<const Task *> view_page(size_t offset, size_t limit) const;
+
+  /// Number of tasks in the current view.
+  size_t view_task_count() const noexcept;
+
+  /// Status counts of the current view (see Database::status_stats).
+  StatusStats status_stats() const noexcept;
+
+  /// Average priority of the current view (see Database::average_priority).
+  double average_priority() const noexcept;
+
+  /// Overdue tasks of the current view as of `today_iso` (see Database::overdue_count).
+  size_t overdue_count(std::string_view today_iso) const noexcept;
+
+  /**
+   * @brief Aggregates of the current view per value of `field`, from one pass (see Database::group_stats).
+   * @throws std::bad_alloc if the groups cannot be allocated.
+   */
+  std::vector<GroupStats> group_stats(GroupField field, std::string_view today_iso) const;
+
+  /**
+   * @brief Every loaded task in ID order, ignoring the view (for `export-all`).
+   * @throws std::bad_alloc if the list cannot be allocated.
+   * @note Returned pointers are invalidated as those of `current_view()` are.
+   */
+  std::vector<const Task *> all_tasks() const;
+
+  /**
+   * @brief Write `tasks` to `filepath`, or to std::cout if `filepath` is "-".
+   *
+   * The format is `format` ("csv", "json" or "ndjson") if given, otherwise the
+   * one of the file extension; standard output defaults to CSV.
+   *
+   * @pre The pointers in `tasks` are valid (e.g. from `current_view()` or `view_page()`).
+   * @post On success: the output holds exactly `tasks`, in order.
+   * @throws none (returns false and reports the error on an unknown format or an I/O error).
+   */
+  bool export_tasks(const std::vector<const Task *> &tasks,
+                    std::string_view filepath,
+                    std::string_view format = {}) const;
+
+  /**
+   * @brief Defer view storage writes until `end_batch()`.
+   * @post Commands still update the view and history in memory; `.taskproc.storage` and
+   *       the view cache are not written (snapshots and text indexes still are).
+   */
+  void begin_batch() noexcept;
+
+  /**
+   * @brief Leave batch mode, writing the storage once if any command changed it.
+   * @post The storage on disk matches the in-memory state (failures are reported, not thrown).
+   */
+  void end_batch() noexcept;
+
   /**
    * @brief Reset the view of tasks (removes filters and sorts)
    *
@@ -98,6 +273,12 @@ private:
   /// Register built-in readers (CSV, JSON, ...).
   void register_readers();
 
+  /// Register built-in writers (CSV, JSON, NDJSON).
+  void register_writers();
+
+  /// Ensure `current_filepath_` is set, falling back to the path in view storage (errors are reported).
+  bool resolve_current_file();
+
   /**
    * @brief Select the appropriate reader for a given filename.
    *
@@ -111,4 +292,90 @@ private:
    * @return A pointer to the selected reader, or nullptr if no reader is available.
    */
   ITaskReader *select_reader(std::string_view filename) const;
+
+  /// Writer named `format`, or (if `format` is empty) the one handling `filepath`; nullptr if none.
+  const ITaskWriter *select_writer(std::string_view filepath, std::string_view format) const;
+
+  /**
+   * @brief Read the tasks cached for `source` from the snapshot, decoding only `fields`.
+   * @post Returns true and fills `tasks` if a matching snapshot exists; false otherwise
+   *       (a corrupt snapshot is reported and treated as missing).
+   */
+  bool load_snapshot(const std::optional<SourceFingerprint> &source,
+                     std::vector<Task> &tasks,
+                     TaskFields fields = TaskFields::all()) const;
+
+  /**
+   * @brief Read `fields` of the current dataset, from the snapshot if it matches `current_source_`.
+   * @post On success: `tasks` is filled and `current_source_` fingerprints what was read; a
+   *       full parse of the dataset is snapshotted.
+   * @return false (reported to std::cerr) if no reader handles the file.
+   * @throws std::exception on I/O or parse errors.
+   */
+  bool read_current_dataset(TaskFields fields, std::vector<Task> &tasks);
+
+  /**
+   * @brief Parse `fields` of the dataset `spec`: one file, or the shards of a directory or glob.
+   *
+   * Shards are parsed concurrently and concatenated in path order, so on a
+   * duplicate ID the shard that sorts last wins, as the later row of one file
+   * does. IDs shared by two shards are reported to std::cerr.
+   *
+   * @post On success: `tasks`, `source` and `shards` (empty for a single file) describe what was read.
+   * @return false (reported to std::cerr) if no reader handles the file, or no shard matches.
+   * @throws std::exception on I/O or parse errors (naming the shard that failed).
+   */
+  bool read_dataset(std::string_view spec,
+                    TaskFields fields,
+                    std::vector<Task> &tasks,
+                    std::optional<SourceFingerprint> &source,
+                    std::vector<Shard> &shards) const;
+
+  /// Files of the sharded dataset `spec` that a reader handles, in load order.
+  std::vector<std::filesystem::path> shard_files(std::string_view spec) const;
+
+  /// Parse `fields` of every file concurrently; part `i` holds the tasks of `files[i]`.
+  std::vector<std::vector<Task>> read_shards(const std::vector<std::filesystem::path> &files,
+                                             TaskFields fields) const;
+
+  /**
+   * @brief Re-read the current sharded dataset, parsing only the shards that changed since `shards_`.
+   *
+   * Unchanged shards are rebuilt from the resident rows, unless they share an
+   * ID with a modified or removed shard. Without a shard list to compare with,
+   * every shard is parsed.
+   *
+   * @pre Every field is loaded.
+   * @post As for `read_dataset`.
+   */
+  bool read_changed_shards(std::vector<Task> &tasks,
+                           std::optional<SourceFingerprint> &source,
+                           std::vector<Shard> &shards);
+
+  /// Fingerprint of the dataset `spec` as it is on disk now, or nullopt if a file cannot be stat'ed.
+  std::optional<SourceFingerprint> fingerprint_dataset(std::string_view spec) const;
+
+  /// Record `shards_` next to the snapshot of `current_source_` (failures are reported, not thrown).
+  void save_shards() const noexcept;
+
+  /// Fingerprint the stored snapshot was taken of (failures are reported, not thrown).
+  std::optional<SourceFingerprint> snapshot_source() const noexcept;
+
+  /// Snapshot the tasks just parsed from `source` (failures are reported, not thrown).
+  void save_snapshot(const std::optional<SourceFingerprint> &source, const std::vector<Task> &tasks) const noexcept;
+
+  /// Adopt the text index cached for the current source, if there is a valid one.
+  void load_text_index() noexcept;
+
+  /// Cache the database's text index for the current source (failures are reported, not thrown).
+  void save_text_index() const noexcept;
+
+  /// Rebuild the view of `history` on the freshly loaded tasks, starting from its longest cached prefix
+  void replay_with_cache(const std::vector<ViewAction> &history);
+
+  /// Replace the view with the cached view of the history followed by `actions`; false if it is not cached
+  bool restore_cached(const std::vector<ViewAction> &actions);
+
+  /// Record the current view in the view cache under the current history, then persist storage.
+  void persist_view() noexcept;
 };
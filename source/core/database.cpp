@@ -1,184 +1,316 @@
 #include "database.hpp"
+#include "core/date.hpp"
 #include "core/expr_parser.hpp"
+#include "core/filter_compiler.hpp"
+#include "core/profiler.hpp"
+#include "core/scan_kernels.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <numeric>
+#include <span>
+
+// ============================================================================
+// Parallel Helpers
+// ============================================================================
+
+size_t Database::part_count(const RowBitmap &rows) const noexcept {
+  if (pool_->size() <= 1 || rows.cardinality() < parallel_threshold_)
+    return 1;
+  return std::max<size_t>(std::min(rows.chunk_count(), pool_->size()), 1);
+}
+
+template <typename F>
+void Database::for_each_part(const RowBitmap &rows, size_t parts, const F &body) const {
+  const size_t chunks = rows.chunk_count();
+  pool_->parallel_for(parts, [&](size_t part) { body(part, chunks * part / parts, chunks * (part + 1) / parts); });
+}
+
+template <typename Pred>
+RowBitmap Database::filter_rows(const RowBitmap &rows, const Pred &pred) const {
+  // Dense chunks of a fixed-width column predicate go through the vectorized scan kernels
+  auto filter_chunks = [&rows, &pred](size_t first, size_t last) {
+    if constexpr (MaskablePredicate<Pred>) {
+      if (pred.maskable())
+        return rows.filter_masked_in(first, last, pred);
+    }
+    return rows.filter_in(first, last, pred);
+  };
+
+  const size_t parts = part_count(rows);
+  if (parts == 1)
+    return filter_chunks(0, rows.chunk_count());
+
+  // Each part compacts its own chunks; the parts cover ascending chunk ranges, so they concatenate
+  std::vector<RowBitmap> matched(parts);
+  for_each_part(rows, parts, [&](size_t part, size_t first, size_t last) { matched[part] = filter_chunks(first, last); });
+  RowBitmap result;
+  for (auto &piece : matched) {
+    result.append(std::move(piece));
+  }
+  return result;
+}
 
 // ============================================================================
 // Data Loading
 // ============================================================================
 
-void Database::load(std::vector<Task> tasks) {
-  // Clear existing data
-  tasks_.clear();
-  view_.clear();
-  status_index_.clear();
-  tag_index_.clear();
+namespace {
+// Post: indices of `tasks` in ID order; for a repeated ID only the last occurrence is kept
+std::vector<std::uint32_t> id_order(const std::vector<Task> &tasks) {
+  std::vector<std::uint32_t> order(tasks.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&tasks](std::uint32_t a, std::uint32_t b) {
+    return tasks[a].id < tasks[b].id;
+  });
 
-  // Move tasks into the map
-  for (auto &task : tasks) {
-    auto id = task.id;
-    tasks_.insert_or_assign(id, std::move(task));
+  size_t kept = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i + 1 == order.size() || tasks[order[i + 1]].id != tasks[order[i]].id)
+      order[kept++] = order[i];
   }
+  order.resize(kept);
+  return order;
+}
+} // anonymous namespace
 
-  // Rebuild view and indices
+void Database::load(std::vector<Task> tasks) {
+  TASKPROC_PROFILE_SCOPE("database.load");
+  TASKPROC_PROFILE_COUNT("database.rows_loaded", tasks.size());
+  clear();
+  const std::vector<std::uint32_t> order = id_order(tasks);
+  store(std::move(tasks), order);
   reset_view();
+}
+
+ReloadDelta Database::reload(std::vector<Task> tasks, const std::vector<ViewAction> &history) {
+  TASKPROC_PROFILE_SCOPE("database.reload");
+  const std::vector<std::uint32_t> order = id_order(tasks);
+
+  // 1. Hash both sides (row `i` of the new columns will be `tasks[order[i]]`)
+  std::vector<std::uint64_t> old_hash(columns_.size());
+  std::vector<std::uint64_t> new_hash(order.size());
+  auto hash_all = [this](size_t count, const auto &hash_one) {
+    const size_t parts = pool_->size() > 1 && count >= parallel_threshold_ ? pool_->size() : 1;
+    pool_->parallel_for(parts, [&](size_t part) {
+      for (size_t i = count * part / parts; i < count * (part + 1) / parts; ++i) {
+        hash_one(i);
+      }
+    });
+  };
+  hash_all(old_hash.size(), [&](size_t row) {
+    old_hash[row] = columns_.content_hash(static_cast<std::uint32_t>(row));
+  });
+  hash_all(new_hash.size(), [&](size_t i) { new_hash[i] = content_hash(tasks[order[i]]); });
+
+  // 2. Match rows by ID (both sides ascending); unchanged rows keep their view membership
+  ReloadDelta delta;
+  std::vector<std::uint32_t> kept_rows;    // new ordinals of unchanged rows that were in the view
+  std::vector<std::uint32_t> changed_rows; // new ordinals of inserted and updated rows
+  size_t old_row = 0;
+  for (std::uint32_t row = 0; row < order.size(); ++row) {
+    const int id = tasks[order[row]].id;
+    for (; old_row < columns_.size() && columns_.id[old_row] < id; ++old_row) {
+      ++delta.deleted;
+    }
+    if (old_row == columns_.size() || columns_.id[old_row] != id) {
+      ++delta.inserted;
+      changed_rows.push_back(row);
+      continue;
+    }
+    if (old_hash[old_row] != new_hash[row]) {
+      ++delta.updated;
+      changed_rows.push_back(row);
+    } else if (view_set_.contains(static_cast<std::uint32_t>(old_row))) {
+      kept_rows.push_back(row);
+    }
+    ++old_row;
+  }
+  delta.deleted += columns_.size() - old_row;
+  if (delta.empty())
+    return delta;
+
+  // 3. Store the new rows (this drops the text index, which no longer matches them)
+  clear();
+  store(std::move(tasks), order);
+
+  // 4. Only changed rows go through the filters since the last reset; the sorts there rebuild the chain
+  auto last_reset = std::find_if(history.rbegin(), history.rend(), [](const ViewAction &action) {
+    return action.type == ViewOpType::ResetFilters;
+  });
+  view_set_ = RowBitmap::from_sorted(changed_rows);
+  apply_actions(std::vector<ViewAction>(last_reset.base(), history.end()));
+  view_set_ |= RowBitmap::from_sorted(kept_rows);
+  view_stale_ = true;
+  return delta;
+}
+
+void Database::store(std::vector<Task> tasks, const std::vector<std::uint32_t> &order) {
+  TASKPROC_PROFILE_SCOPE("database.store_columns");
+  size_t text_bytes = 0;
+  for (std::uint32_t index : order) {
+    const Task &task = tasks[index];
+    text_bytes += task.title.size() + (task.description ? task.description->size() : 0);
+  }
+  columns_.reserve(order.size(), text_bytes);
+  for (std::uint32_t index : order) {
+    columns_.append(tasks[index]);
+    // Free each task's strings as soon as the columns hold them, so the two copies never peak together
+    std::destroy_at(&tasks[index]);
+    std::construct_at(&tasks[index], 0, std::string());
+  }
+
+  // Release the (now empty) source tasks before building indices
+  std::vector<Task>().swap(tasks);
+  hydrated_.resize(columns_.size());
   rebuild_indices();
 }
 
+void Database::clear() noexcept {
+  columns_.clear();
+  hydrated_.clear();
+  view_set_.clear();
+  sort_chain_.clear();
+  base_rank_.clear();
+  view_rows_.clear();
+  view_.clear();
+  view_stale_ = false;
+  view_hydrated_ = true;
+  status_index_.clear();
+  tag_index_.clear();
+  id_rows_.clear();
+  text_index_.reset();
+}
+
 // ============================================================================
 // View Management
 // ============================================================================
 
 void Database::reset_view() noexcept {
-  // Clear the current view
-  view_.clear();
-
-  // Reserve space (optimization)
-  view_.reserve(tasks_.size());
+  // All row ordinals, in ID order
+  view_set_ = RowBitmap::all(static_cast<std::uint32_t>(columns_.size()));
+  sort_chain_.clear();
+  base_rank_.clear();
+  view_stale_ = true;
+}
 
-  // Populate view with pointers to all tasks
-  for (const auto &[id, task] : tasks_) {
-    view_.push_back(&task);
+void Database::apply_filter(const FilterSpec &filter) {
+  // Equality on status is answered from the index
+  if (filter.field == FilterField::Status && filter.op == FilterOp::Equal) {
+    auto code = columns_.statuses.find(filter.value);
+    intersect_view(code ? status_index_[*code] : RowBitmap{});
+    return;
   }
+
+  // Compile the filter once, then run a loop specialized for the resulting predicate type
+  CompiledFilter compiled = compile_filter(filter, columns_);
+
+  std::visit([this](const auto &predicate) { view_set_ = filter_rows(view_set_, predicate); }, compiled);
+  view_stale_ = true;
 }
 
-void Database::apply_filter(const FilterSpec &filter) {
-  // Create predicate function
-  auto predicate = make_predicate(filter);
+void Database::apply_filter(const FilterExpr &expr) {
+  TASKPROC_PROFILE_SCOPE("database.filter");
+  if (expr.kind == FilterExprKind::Term) {
+    apply_filter(expr.terms.front());
+    return;
+  }
 
-  // Remove elements that DON'T match
-  view_.erase(std::remove_if(view_.begin(), view_.end(), [&predicate](const Task *t) { return !predicate(t); }),
-              view_.end());
+  view_set_ = evaluate(expr, view_set_);
+  view_stale_ = true;
 }
 
 void Database::apply_sort(const SortSpec &sort) {
-  // Create comparator function
-  auto comp = make_comparator(sort);
+  // A later sort on the same field supersedes the earlier one; ID order is total and supersedes everything
+  if (sort.field == SortField::Id) {
+    sort_chain_.clear();
+    base_rank_.clear();
+  } else {
+    std::erase_if(sort_chain_, [&sort](const SortSpec &earlier) { return earlier.field == sort.field; });
+  }
+
+  // Ascending ID is the base order itself
+  if (sort.field != SortField::Id || sort.direction != SortDirection::Ascending)
+    sort_chain_.push_back(sort);
+  view_stale_ = true;
+}
 
-  // Sort the view
-  std::stable_sort(view_.begin(), view_.end(), comp);
+void Database::apply_sort(const std::vector<SortSpec> &keys) {
+  // The newest sort is the most significant, so the primary key goes last
+  for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+    apply_sort(*it);
+  }
 }
 
 void Database::filter_by_tag(std::string_view tag) {
-  // Step 1: Use erase-remove with lambda that checks tags
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [tag](const Task* t) {
-  //         // Check if tag exists in t->tags vector
-  //         return std::find(t->tags.begin(), t->tags.end(), tag) == t->tags.end();
-  //       }),
-  //     view_.end()
-  //   );
-  //
-  // C++ CONCEPTS:
-  // - std::find searches vector, returns iterator
-  // - If not found, returns .end()
-  // - Lambda captures tag by value (string_view is cheap to copy)
-  // - Remove tasks where tag is NOT found
-  //
-  // OPTIMIZATION (optional):
-  // - Could use tag_index_ for O(1) lookup instead of O(n) iteration
-  //
-  // EXAMPLE STRUCTURE:
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [tag](const Task* t) {
-  //         return std::find(t->tags.begin(), t->tags.end(), tag) == t->tags.end();
-  //       }),
-  //     view_.end()
-  //   );
+  TASKPROC_PROFILE_SCOPE("database.find_by_tag");
+  auto code = columns_.tags.find(tag);
+  intersect_view(code ? tag_index_[*code] : RowBitmap{});
 }
 
 void Database::filter_no_tags() noexcept {
-  // Step 1: Remove tasks that HAVE tags
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [](const Task* t) { return !t->tags.empty(); }),
-  //     view_.end()
-  //   )  //
-  // C++ CONCEPTS:
-  // - Comparator: return true if a should come BEFORE b in sorted order
-  // - Ascending: a < b means a before b (smallest first)
-  // - Descending: a > b means a before b (largest first)
-  // - Lambda return type is deduced automatically
-  // - std::function can hold any callable with matching signature
-  //;
-  //
-  // C++ CONCEPTS:
-  // - .empty() returns true if container has no elements
-  // - Lambda with no captures: []
-  // - Remove if tags vector is NOT empty
-  //
-  // EXAMPLE STRUCTURE:
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [](const Task* t) { return !t->tags.empty(); }),
-  //     view_.end()
-  //   );
+  view_set_ = filter_rows(view_set_, [this](std::uint32_t row) { return columns_.tags_of(row).empty(); });
+  view_stale_ = true;
 }
 
+namespace {
+/// Searches over views below 1/TEXT_SCAN_FRACTION of the rows scan them instead of building the text index
+constexpr size_t TEXT_SCAN_FRACTION = 64;
+} // anonymous namespace
+
 void Database::search_text(std::string_view text) {
-  // Step 1: Convert search text to lowercase (for comparison)
-  //   - Create std::string lower_text
-  //   - Use std::transform with ::tolower
-  //
-  // Step 2: Create helper lambda for case-insensitive contains
-  //   auto contains_ci = [](std::string_view haystack, std::string_view needle) {
-  //     // Convert both to lowercase and use .find()
-  //   };
-  //
-  // Step 3: Remove tasks that don't match
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [&](const Task* t) {
-  //         bool in_title = contains_ci(t->title, lower_text);
-  //         bool in_desc = t->description.has_value() &&
-  //                        contains_ci(*t->description, lower_text);
-  //         return !(in_title || in_desc);
-  //       }),
-  //     view_.end()
-  //   );
-  //
-  // C++ CONCEPTS:
-  // - std::transform(s.begin(), s.end(), s.begin(), ::tolower) lowercases string
-  // - std::optional: use .has_value() to check, *opt to access
-  // - string::find(substr) returns string::npos if not found
-  //
-  // EXAMPLE STRUCTURE (helper):
-  //   auto to_lower = [](std::string s) {
-  //     std::transform(s.begin(), s.end(), s.begin(),
-  //       [](unsigned char c) { return std::tolower(c); });
-  //     return s;
-  //   };
-  //
-  //   std::string search_lower = to_lower(std::string(text));
-  //   view_.erase(
-  //     std::remove_if(view_.begin(), view_.end(),
-  //       [&](const Task* t) {
-  //         std::string title_lower = to_lower(t->title);
-  //         bool match = title_lower.find(search_lower) != std::string::npos;
-  //         if (t->description) {
-  //           std::string desc_lower = to_lower(*t->description);
-  //           match = match || (desc_lower.find(search_lower) != std::string::npos);
-  //         }
-  //         return !match;
-  //       }),
-  //     view_.end()
-  //   );
+  TASKPROC_PROFILE_SCOPE("database.search");
+  std::vector<std::string> words = TextIndex::words(text);
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+  if (words.empty())
+    return;
+
+  // A view this small is cheaper to scan than indexing every row (e.g. the rows a reload re-checks).
+  // A word has no separators, so it occurs in a folded text exactly when it is inside one of its words.
+  if (!text_index_ && view_set_.cardinality() < columns_.size() / TEXT_SCAN_FRACTION) {
+    view_set_ = view_set_.filter([this, &words](std::uint32_t row) {
+      const std::string title = TextIndex::fold(columns_.text(columns_.title[row]));
+      const std::string description = TextIndex::fold(columns_.text(columns_.description[row]));
+      return std::all_of(words.begin(), words.end(), [&](const std::string &word) {
+        return title.find(word) != std::string::npos || description.find(word) != std::string::npos;
+      });
+    });
+    view_stale_ = true;
+    return;
+  }
+
+  if (!text_index_)
+    text_index_ = std::make_unique<TextIndex>(TextIndex::build(columns_));
+
+  // Every word must match: intersect the rows of each word, starting from the view
+  RowBitmap matched = view_set_;
+  for (const auto &word : words) {
+    matched &= text_index_->rows_containing(word);
+    if (matched.empty())
+      break;
+  }
+  view_set_ = std::move(matched);
+  view_stale_ = true;
 }
 
 void Database::replay_history(const std::vector<ViewAction> &actions) noexcept {
+  TASKPROC_PROFILE_SCOPE("database.replay_history");
   reset_view();
+  apply_actions(actions);
+}
 
+void Database::apply_actions(const std::vector<ViewAction> &actions) noexcept {
   for (const auto &action : actions) {
     try {
       switch (action.type) {
       case ViewOpType::Filter: {
-        auto spec = ExpressionParser::parse_filter(action.payload);
-        if (spec) {
-          apply_filter(*spec);
-          std::cerr << "[Replay] Applied filter: " << action.payload << "\n";
+        auto expr = ExpressionParser::parse_filter_expr(action.payload);
+        if (expr) {
+          apply_filter(*expr);
         } else {
           std::cerr << "[Replay] Failed to parse filter: " << action.payload << "\n";
         }
@@ -186,10 +318,9 @@ void Database::replay_history(const std::vector<ViewAction> &actions) noexcept {
       }
 
       case ViewOpType::Sort: {
-        auto spec = ExpressionParser::parse_sort(action.payload);
-        if (spec) {
-          apply_sort(*spec);
-          std::cerr << "[Replay] Applied sort: " << action.payload << "\n";
+        auto keys = ExpressionParser::parse_sort_keys(action.payload);
+        if (keys) {
+          apply_sort(*keys);
         } else {
           std::cerr << "[Replay] Failed to parse sort: " << action.payload << "\n";
         }
@@ -199,13 +330,16 @@ void Database::replay_history(const std::vector<ViewAction> &actions) noexcept {
       case ViewOpType::FindByTag: {
         // Payload is the tag string directly
         filter_by_tag(action.payload);
-        std::cerr << "[Replay] Applied tag filter: " << action.payload << "\n";
+        break;
+      }
+
+      case ViewOpType::Search: {
+        search_text(action.payload);
         break;
       }
 
       case ViewOpType::ResetFilters: {
         reset_view();
-        std::cerr << "[Replay] Reset filters\n";
         break;
       }
 
@@ -223,36 +357,161 @@ void Database::replay_history(const std::vector<ViewAction> &actions) noexcept {
   }
 }
 
+bool Database::set_text_index(TextIndex index) {
+  if (index.row_count() != columns_.size())
+    return false;
+  text_index_ = std::make_unique<TextIndex>(std::move(index));
+  return true;
+}
+
+bool Database::restore_view(const std::vector<int> &task_ids) noexcept {
+  TASKPROC_PROFILE_SCOPE("database.restore_view");
+  try {
+    std::vector<std::uint32_t> restored;
+    restored.reserve(task_ids.size());
+    for (int id : task_ids) {
+      auto row = ordinal_of(id);
+      if (!row)
+        return false;
+      restored.push_back(*row);
+    }
+
+    // Keep an explicit order only if it differs from the ordinal order
+    std::vector<std::uint32_t> rank;
+    if (!std::is_sorted(restored.begin(), restored.end())) {
+      rank.assign(columns_.size(), 0);
+      for (std::uint32_t position = 0; position < restored.size(); ++position) {
+        rank[restored[position]] = position;
+      }
+      std::sort(restored.begin(), restored.end());
+    }
+    if (std::adjacent_find(restored.begin(), restored.end()) != restored.end())
+      return false; // duplicate IDs: not a view we produced
+
+    view_set_ = RowBitmap::from_sorted(restored);
+    sort_chain_.clear();
+    base_rank_ = std::move(rank);
+    view_stale_ = true;
+    return true;
+  } catch (const std::bad_alloc &) {
+    return false;
+  }
+}
+
 // ============================================================================
 // Data Access
 // ============================================================================
 
 const Task *Database::get_task_by_id(int id) const noexcept {
-  auto it = tasks_.find(id);
-  if (it != tasks_.end()) {
-    return &it->second;
-  } else {
+  auto row = ordinal_of(id);
+  if (!row)
+    return nullptr;
+  try {
+    return task_at(*row);
+  } catch (const std::bad_alloc &) {
     return nullptr;
   }
 }
 
+std::vector<const Task *> Database::view_page(size_t offset, size_t limit) const {
+  const size_t size = view_set_.cardinality();
+  offset = std::min(offset, size);
+  const size_t end = offset + std::min(limit, size - offset);
+
+  const std::vector<std::uint32_t> *rows = &view_rows_;
+  std::vector<std::uint32_t> selected;
+  if (view_stale_) {
+    if (end == size) {
+      materialize_rows(); // the whole order is needed anyway; keep it for later readers
+    } else {
+      selected = view_set_.to_vector();
+      order_rows(selected, end);
+      rows = &selected;
+    }
+  }
+
+  std::vector<const Task *> page;
+  page.reserve(end - offset);
+  for (size_t i = offset; i < end; ++i) {
+    page.push_back(task_at((*rows)[i]));
+  }
+  return page;
+}
+
+std::vector<const Task *> Database::all_tasks() const {
+  const size_t size = columns_.size();
+  const size_t parts = size < parallel_threshold_ ? 1 : pool_->size();
+  std::vector<const Task *> tasks(size);
+  pool_->parallel_for(parts, [this, &tasks, size, parts](size_t part) {
+    for (size_t row = size * part / parts; row < size * (part + 1) / parts; ++row) {
+      tasks[row] = task_at(static_cast<std::uint32_t>(row));
+    }
+  });
+  return tasks;
+}
+
+std::vector<int> Database::current_view_ids() const {
+  materialize_rows();
+  std::vector<int> ids;
+  ids.reserve(view_rows_.size());
+  for (std::uint32_t row : view_rows_) {
+    ids.push_back(columns_.id[row]);
+  }
+  return ids;
+}
+
 // ============================================================================
 // Aggregations and Statistics
 // ============================================================================
 
 StatusStats Database::status_stats() const noexcept {
+  TASKPROC_PROFILE_SCOPE("database.stats");
   StatusStats stats;
 
-  for (const Task *task : view_) {
-    // Check task->status and increment appropriate counter
-    if (task->status == "todo")
-      stats.todo_count++;
-    else if (task->status == "in-progress")
-      stats.in_progress_count++;
-    else if (task->status == "done")
-      stats.done_count++;
+  // Histogram over dictionary codes (one per part), then fold codes into the known buckets.
+  // With few codes, dense chunks count each code as the popcount of its equality mask and the
+  // membership bits instead of incrementing per row.
+  const size_t codes = columns_.statuses.size();
+  const bool scan = codes <= MAX_SCANNED_CODES;
+  const ScanKernels &kernels = scan_kernels();
+  const size_t parts = part_count(view_set_);
+  std::vector<std::vector<size_t>> part_counts(parts, std::vector<size_t>(codes, 0));
+  for_each_part(view_set_, parts, [&](size_t part, size_t first, size_t last) {
+    std::vector<size_t> &per_code = part_counts[part];
+    auto count_row = [this, &per_code](std::uint32_t row) { per_code[columns_.status[row]]++; };
+    if (!scan) {
+      view_set_.for_each_in(first, last, count_row);
+      return;
+    }
+
+    std::vector<std::uint64_t> matches(RowBitmap::WORDS);
+    view_set_.visit_in(
+        first,
+        last,
+        [&](std::uint32_t base, std::uint32_t count, const std::uint64_t *members) {
+          const std::int32_t *status = code_lanes(columns_.status.data() + base);
+          for (std::uint32_t code = 0; code < codes; ++code) {
+            kernels.compare(status, count, ScanOp::Equal, static_cast<std::int32_t>(code), std::nullopt, matches.data());
+            per_code[code] += kernels.count_and(matches.data(), members, (count + 63) / 64);
+          }
+        },
+        count_row);
+  });
+
+  for (std::uint32_t code = 0; code < codes; ++code) {
+    size_t count = 0;
+    for (const auto &per_code : part_counts) {
+      count += per_code[code];
+    }
+    const std::string &status = columns_.statuses.value(code);
+    if (status == "todo")
+      stats.todo_count += count;
+    else if (status == "in-progress")
+      stats.in_progress_count += count;
+    else if (status == "done")
+      stats.done_count += count;
     else
-      stats.other_count++;
+      stats.other_count += count;
   }
 
   return stats;
@@ -260,162 +519,742 @@ StatusStats Database::status_stats() const noexcept {
 
 double Database::average_priority() const noexcept {
   // Handle empty view
-  if (view_.empty())
+  if (view_set_.empty())
     return 0.0;
 
-  // Sum all priorities
-  double sum =
-      std::accumulate(view_.begin(), view_.end(), 0.0, [](int acc, const Task *task) { return acc + task->priority; });
+  // Sum all priorities, one partial sum per part; dense chunks are summed under their membership bits
+  const ScanKernels &kernels = scan_kernels();
+  const size_t parts = part_count(view_set_);
+  std::vector<std::int64_t> sums(parts, 0);
+  for_each_part(view_set_, parts, [&](size_t part, size_t first, size_t last) {
+    std::int64_t sum = 0;
+    view_set_.visit_in(
+        first,
+        last,
+        [&](std::uint32_t base, std::uint32_t count, const std::uint64_t *members) {
+          sum += kernels.masked_sum(columns_.priority.data() + base, count, members);
+        },
+        [this, &sum](std::uint32_t row) { sum += columns_.priority[row]; });
+    sums[part] = sum;
+  });
+  const std::int64_t sum = std::accumulate(sums.begin(), sums.end(), std::int64_t{0});
 
-  return sum / view_.size();
+  return static_cast<double>(sum) / static_cast<double>(view_set_.cardinality());
 }
 
 size_t Database::overdue_count(std::string_view today_iso) const noexcept {
-  // Step 1: Use std::count_if with complex predicate
-  //   return std::count_if(view_.begin(), view_.end(),
-  //     [today_iso](const Task* t) {
-  //       // Check all three conditions
-  //     });
-  //
-  // Step 2: Implement predicate logic
-  //   - Check t->due_date.has_value()
-  //   - Check *t->due_date < today_iso (ISO dates compare lexically)
-  //   - Check t->status != "done"
-
-  return 0;
-  //
-  // C++ CONCEPTS:
-  // - std::count_if counts elements matching predicate
-  // - std::optional: .has_value() check before dereferencing
-  // - ISO 8601 dates: "YYYY-MM-DD" format compares correctly as strings
-  // - Lambda captures: [today_iso] captures by value
-  //
-  // EXAMPLE STRUCTURE:
-  //   return std::count_if(view_.begin(), view_.end(),
-  //     [today_iso](const Task* t) {
-  //       if (!t->due_date.has_value()) return false;
-  //       if (t->status == "done") return false;
-  //       return *t->due_date < today_iso;
-  //     });
+  const auto today = parse_iso_date(today_iso);
+  if (!today)
+    return 0;
+
+  // A status that was never interned cannot exclude any row
+  const std::uint32_t done = columns_.statuses.find("done").value_or(TaskColumns::NO_VALUE);
+  const ScanKernels &kernels = scan_kernels();
+  const size_t parts = part_count(view_set_);
+  std::vector<size_t> counts(parts, 0);
+  for_each_part(view_set_, parts, [&](size_t part, size_t first, size_t last) {
+    size_t count = 0;
+    std::vector<std::uint64_t> due_before(RowBitmap::WORDS);
+    std::vector<std::uint64_t> not_done(RowBitmap::WORDS);
+    view_set_.visit_in(
+        first,
+        last,
+        [&](std::uint32_t base, std::uint32_t count_rows, const std::uint64_t *members) {
+          const size_t words = (count_rows + 63) / 64;
+          kernels.compare(columns_.due_day.data() + base, count_rows, ScanOp::Less, *today, NO_DATE, due_before.data());
+          kernels.compare(code_lanes(columns_.status.data() + base),
+                          count_rows,
+                          ScanOp::NotEqual,
+                          static_cast<std::int32_t>(done),
+                          std::nullopt,
+                          not_done.data());
+          for (size_t w = 0; w < words; ++w) {
+            due_before[w] &= not_done[w];
+          }
+          count += kernels.count_and(due_before.data(), members, words);
+        },
+        [&](std::uint32_t row) {
+          const std::int32_t due = columns_.due_day[row];
+          count += due != NO_DATE && due < *today && columns_.status[row] != done;
+        });
+    counts[part] = count;
+  });
+  return std::accumulate(counts.begin(), counts.end(), size_t{0});
+}
+
+namespace {
+// Running aggregates of one group; the partial ones of each part merge into the first
+struct GroupAccumulator {
+  size_t count{0};
+  std::int64_t priority_sum{0};
+  size_t overdue{0};
+  std::int32_t min_due{std::numeric_limits<std::int32_t>::max()};
+  std::int32_t max_due{NO_DATE};
+
+  void merge(const GroupAccumulator &other) noexcept {
+    count += other.count;
+    priority_sum += other.priority_sum;
+    overdue += other.overdue;
+    min_due = std::min(min_due, other.min_due);
+    max_due = std::max(max_due, other.max_due);
+  }
+};
+} // anonymous namespace
+
+std::vector<GroupStats> Database::group_stats(GroupField field, std::string_view today_iso) const {
+  TASKPROC_PROFILE_SCOPE("database.group_stats");
+  // 1. Group keys and the code -> group table of the grouped column; the last group collects missing values
+  std::vector<std::string> keys;
+  std::vector<std::uint32_t> group_of_code;
+  const std::vector<std::uint32_t> *codes = nullptr;
+  auto identity_groups = [&keys, &group_of_code](const StringDictionary &dictionary) {
+    for (std::uint32_t code = 0; code < dictionary.size(); ++code) {
+      keys.push_back(dictionary.value(code));
+      group_of_code.push_back(code);
+    }
+  };
+  switch (field) {
+  case GroupField::Status:
+    identity_groups(columns_.statuses);
+    codes = &columns_.status;
+    break;
+  case GroupField::Assignee:
+    identity_groups(columns_.assignees);
+    codes = &columns_.assignee;
+    break;
+  case GroupField::Tag:
+    identity_groups(columns_.tags);
+    break;
+  case GroupField::CreatedMonth: {
+    // Distinct dates are few; map each to its month once instead of converting per row
+    std::unordered_map<std::string, std::uint32_t> month_groups;
+    for (std::uint32_t code = 0; code < columns_.created_dates.size(); ++code) {
+      const std::int32_t day = to_day_number(columns_.created_dates.value(code));
+      if (day == NO_DATE) {
+        group_of_code.push_back(TaskColumns::NO_VALUE);
+        continue;
+      }
+      auto [it, inserted] = month_groups.try_emplace(format_iso_date(day, true), static_cast<std::uint32_t>(keys.size()));
+      if (inserted)
+        keys.push_back(it->first);
+      group_of_code.push_back(it->second);
+    }
+    codes = &columns_.created_date;
+    break;
+  }
+  }
+  const auto missing = static_cast<std::uint32_t>(keys.size());
+  keys.emplace_back();
+  for (auto &group : group_of_code) {
+    group = group == TaskColumns::NO_VALUE ? missing : group;
+  }
+
+  // 2. One pass over the view, one accumulator array per part
+  const std::optional<std::int32_t> today = parse_iso_date(today_iso);
+  const std::uint32_t done = columns_.statuses.find("done").value_or(TaskColumns::NO_VALUE);
+  const size_t parts = part_count(view_set_);
+  std::vector<std::vector<GroupAccumulator>> part_groups(parts, std::vector<GroupAccumulator>(keys.size()));
+  for_each_part(view_set_, parts, [&](size_t part, size_t first, size_t last) {
+    std::vector<GroupAccumulator> &groups = part_groups[part];
+    auto add = [&](std::uint32_t group, std::uint32_t row) {
+      GroupAccumulator &acc = groups[group];
+      const std::int32_t due = columns_.due_day[row];
+      acc.count++;
+      acc.priority_sum += columns_.priority[row];
+      if (due != NO_DATE) {
+        acc.overdue += today && due < *today && columns_.status[row] != done;
+        acc.min_due = std::min(acc.min_due, due);
+        acc.max_due = std::max(acc.max_due, due);
+      }
+    };
+
+    if (codes == nullptr) {
+      view_set_.for_each_in(first, last, [&](std::uint32_t row) {
+        const auto tags = columns_.tags_of(row);
+        if (tags.empty())
+          add(missing, row);
+        for (std::uint32_t tag : tags) {
+          add(group_of_code[tag], row);
+        }
+      });
+      return;
+    }
+    view_set_.for_each_in(first, last, [&](std::uint32_t row) {
+      const std::uint32_t code = (*codes)[row];
+      add(code == TaskColumns::NO_VALUE ? missing : group_of_code[code], row);
+    });
+  });
+  for (size_t part = 1; part < parts; ++part) {
+    for (size_t group = 0; group < keys.size(); ++group) {
+      part_groups[0][group].merge(part_groups[part][group]);
+    }
+  }
+
+  // 3. Finish the non-empty groups, ordered by key (the empty key sorts first, so move it last)
+  std::vector<GroupStats> result;
+  for (size_t group = 0; group < keys.size(); ++group) {
+    const GroupAccumulator &acc = part_groups[0][group];
+    if (acc.count == 0)
+      continue;
+    GroupStats stats;
+    stats.key = std::move(keys[group]);
+    stats.count = acc.count;
+    stats.average_priority = static_cast<double>(acc.priority_sum) / static_cast<double>(acc.count);
+    stats.overdue_count = acc.overdue;
+    if (acc.max_due != NO_DATE) {
+      stats.min_due = format_iso_date(acc.min_due);
+      stats.max_due = format_iso_date(acc.max_due);
+    }
+    result.push_back(std::move(stats));
+  }
+  std::sort(result.begin(), result.end(), [](const GroupStats &a, const GroupStats &b) { return a.key < b.key; });
+  if (!result.empty() && result.front().key.empty())
+    std::rotate(result.begin(), result.begin() + 1, result.end());
+  return result;
 }
 
 // ============================================================================
 // Internal Helpers
 // ============================================================================
 
-void Database::rebuild_indices() noexcept {
+void Database::rebuild_indices() {
+  TASKPROC_PROFILE_SCOPE("database.rebuild_indices");
   // Clear existing indices
   status_index_.clear();
   tag_index_.clear();
+  id_rows_.clear();
+
+  // IDs are sorted: a direct table from the smallest to the largest, unless they are too sparse
+  if (!columns_.id.empty()) {
+    const auto spread = static_cast<std::uint64_t>(std::int64_t{columns_.id.back()} - columns_.id.front()) + 1;
+    if (spread <= columns_.size() * ID_INDEX_SPREAD) {
+      id_base_ = columns_.id.front();
+      id_rows_.assign(spread, NO_ROW);
+      for (std::uint32_t row = 0; row < columns_.size(); ++row) {
+        id_rows_[static_cast<size_t>(std::int64_t{columns_.id[row]} - id_base_)] = row;
+      }
+    }
+  }
 
-  // Iterate through all tasks and populate indices
-  for (const auto &[id, task] : tasks_) {
-    // Add to status index
-    status_index_[task.status].push_back(&task);
-    // Add to tag index (for each tag)
-    for (const auto &tag : task.tags) {
-      tag_index_[tag].push_back(&task);
+  // Rows are appended in ordinal order, as RowBitmap::append requires
+  status_index_.resize(columns_.statuses.size());
+  tag_index_.resize(columns_.tags.size());
+  for (std::uint32_t row = 0; row < columns_.size(); ++row) {
+    status_index_[columns_.status[row]].append(row);
+    for (std::uint32_t code : columns_.tags_of(row)) {
+      tag_index_[code].append(row); // a tag repeated on one task is a no-op
     }
   }
 }
 
-std::function<bool(const Task *, const Task *)> Database::make_comparator(const SortSpec &sort) const {
-  switch (sort.field) {
-  case SortField::Priority:
-    return sort.direction == SortDirection::Ascending
-               ? [](const Task *a, const Task *b) { return a->priority < b->priority; }
-               : [](const Task *a, const Task *b) { return a->priority > b->priority; };
-  case SortField::Title:
-    return sort.direction == SortDirection::Ascending
-               ? [](const Task *a, const Task *b) { return a->title < b->title; }
-               : [](const Task *a, const Task *b) { return a->title > b->title; };
-  case SortField::Status:
-    return sort.direction == SortDirection::Ascending
-               ? [](const Task *a, const Task *b) { return a->status < b->status; }
-               : [](const Task *a, const Task *b) { return a->status > b->status; };
-  default:
-    return sort.direction == SortDirection::Ascending ? [](const Task *a, const Task *b) { return a->id < b->id; }
-                                                      : [](const Task *a, const Task *b) { return a->id > b->id; };
-  }
-
-  // TODO: Handle optional fields (due_date, assignee)
-  //   Strategy: Put tasks with missing values at the end
-  //
-  //   if (!a->due_date && !b->due_date) return false;  // equal
-  //   if (!a->due_date) return false;  // a goes after b
-  //   if (!b->due_date) return true;   // b goes after a
-  //   return *a->due_date < *b->due_date;  // normal comparison
-}
-
-std::function<bool(const Task *)> Database::make_predicate(const FilterSpec &filter) const {
-  switch (filter.field) {
-  case FilterField::Priority:
-    return [filter](const Task *t) {
-      int target = std::stoi(filter.value);
-      switch (filter.op) {
-      case FilterOp::Equal:
-        return t->priority == target;
-      case FilterOp::NotEqual:
-        return t->priority != target;
-      case FilterOp::GreaterThanOrEqual:
-        return t->priority >= target;
-      case FilterOp::LessThanOrEqual:
-        return t->priority <= target;
-      case FilterOp::GreaterThan:
-        return t->priority > target;
-      case FilterOp::LessThan:
-        return t->priority < target;
-      default:
-        return false;
-      }
-    };
-  case FilterField::Status:
-    return [filter](const Task *t) {
-      std::string target = filter.value;
-      switch (filter.op) {
-      case FilterOp::Equal:
-        return t->status == target;
-      case FilterOp::NotEqual:
-        return t->status != target;
-      default:
-        return false;
+void Database::intersect_view(const RowBitmap &rows) {
+  view_set_ &= rows;
+  view_stale_ = true;
+}
+
+RowBitmap Database::status_rows(const FilterExpr &expr) const {
+  RowBitmap result;
+  for (const auto &term : expr.terms) {
+    if (auto code = columns_.statuses.find(term.value))
+      result |= status_index_[*code];
+  }
+  return result;
+}
+
+namespace {
+// `status=value` terms and `status IN (...)` lists are answered from the status index
+bool is_indexed(const FilterExpr &expr) noexcept {
+  if (expr.kind != FilterExprKind::Term && expr.kind != FilterExprKind::In)
+    return false;
+  return std::all_of(expr.terms.begin(), expr.terms.end(), [](const FilterSpec &term) {
+    return term.field == FilterField::Status && term.op == FilterOp::Equal;
+  });
+}
+
+bool uses_index(const FilterExpr &expr) noexcept {
+  return is_indexed(expr) || std::any_of(expr.children.begin(), expr.children.end(), uses_index);
+}
+} // anonymous namespace
+
+RowBitmap Database::evaluate(const FilterExpr &expr, const RowBitmap &domain) const {
+  // Nothing indexed below this node: one fused pass over the domain
+  if (!uses_index(expr))
+    return filter_rows(domain, compile_expr(expr, columns_));
+
+  if (is_indexed(expr)) {
+    RowBitmap result = status_rows(expr);
+    result &= domain;
+    return result;
+  }
+
+  if (expr.kind == FilterExprKind::Not) {
+    RowBitmap result = domain;
+    result -= evaluate(expr.children.front(), domain);
+    return result;
+  }
+
+  // AND/OR: bitmap operands first, then the other operands fused into one pass over what is left
+  std::vector<FilterExpr> scanned;
+  std::vector<const FilterExpr *> indexed;
+  for (const auto &child : expr.children) {
+    if (uses_index(child))
+      indexed.push_back(&child);
+    else
+      scanned.push_back(child);
+  }
+  auto combine = [&scanned](FilterExpr (*make)(std::vector<FilterExpr>)) {
+    return scanned.size() == 1 ? std::move(scanned.front()) : make(std::move(scanned));
+  };
+
+  if (expr.kind == FilterExprKind::And) {
+    RowBitmap result = domain;
+    for (const FilterExpr *child : indexed) {
+      result = evaluate(*child, result);
+      if (result.empty())
+        return result;
+    }
+    if (!scanned.empty()) {
+      const FilterExpr remaining = combine(&FilterExpr::all_of);
+      result = filter_rows(result, compile_expr(remaining, columns_));
+    }
+    return result;
+  }
+
+  // OR: each operand only needs to look at rows not matched yet
+  RowBitmap result;
+  RowBitmap undecided = domain;
+  for (const FilterExpr *child : indexed) {
+    RowBitmap matched = evaluate(*child, undecided);
+    undecided -= matched;
+    result |= matched;
+  }
+  if (!scanned.empty() && !undecided.empty()) {
+    const FilterExpr remaining = combine(&FilterExpr::any_of);
+    result |= filter_rows(undecided, compile_expr(remaining, columns_));
+  }
+  return result;
+}
+
+void Database::materialize_view() const noexcept {
+  TASKPROC_PROFILE_SCOPE("database.materialize_view");
+  materialize_rows();
+  if (view_hydrated_)
+    return;
+
+  // Rows of a view are distinct, so parts rebuild disjoint `hydrated_` slots
+  const size_t size = view_rows_.size();
+  const size_t parts = size < parallel_threshold_ ? 1 : pool_->size();
+  view_.resize(size);
+  pool_->parallel_for(parts, [this, size, parts](size_t part) {
+    for (size_t i = size * part / parts; i < size * (part + 1) / parts; ++i) {
+      view_[i] = task_at(view_rows_[i]);
+    }
+  });
+  view_hydrated_ = true;
+}
+
+namespace {
+/// Widest key range sorted by counting; wider priority ranges use the comparison sort
+constexpr std::int64_t MAX_COUNTING_KEYS = std::int64_t{1} << 16;
+
+/// Pages below 1/TOP_K_FRACTION of the view are selected with a heap instead of a full radix sort
+constexpr size_t TOP_K_FRACTION = 16;
+
+/// Row with its packed sort key and base-order position; the view order sorts by (key, tie)
+struct SortEntry {
+  std::uint64_t key;
+  std::uint32_t tie;
+  std::uint32_t row;
+};
+
+// Post: `entries` stably ordered by (key, tie), which must fit in `key_bits` and `tie_bits` bits
+void radix_sort(std::span<SortEntry> entries, unsigned key_bits, unsigned tie_bits) {
+  std::vector<SortEntry> scratch(entries.size());
+  SortEntry *from = entries.data();
+  SortEntry *to = scratch.data();
+  auto pass = [&from, &to, size = entries.size()](auto digit) {
+    std::array<size_t, 257> start{};
+    for (const SortEntry *entry = from; entry != from + size; ++entry) {
+      ++start[digit(*entry) + 1];
+    }
+    if (std::find(start.begin() + 1, start.end(), size) != start.end())
+      return; // every entry shares this digit
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    for (const SortEntry *entry = from; entry != from + size; ++entry) {
+      to[start[digit(*entry)]++] = *entry;
+    }
+    std::swap(from, to);
+  };
+
+  // Least significant digit first: the tie-break, then the key
+  for (unsigned shift = 0; shift < tie_bits; shift += 8) {
+    pass([shift](const SortEntry &entry) { return (entry.tie >> shift) & 0xFF; });
+  }
+  for (unsigned shift = 0; shift < key_bits; shift += 8) {
+    pass([shift](const SortEntry &entry) { return static_cast<size_t>((entry.key >> shift) & 0xFF); });
+  }
+  if (from != entries.data())
+    std::copy(from, from + entries.size(), entries.data());
+}
+
+// Pre: `entries` is sorted by `less` within each range [bounds[i], bounds[i + 1]).
+// Post: `entries` is sorted by `less`; ranges are merged pairwise, each round in parallel.
+template <typename Less>
+void merge_parts(std::vector<SortEntry> &entries, std::vector<size_t> bounds, const Less &less, ThreadPool &pool) {
+  std::vector<SortEntry> scratch(entries.size());
+  while (bounds.size() > 2) {
+    const size_t runs = bounds.size() - 1;
+    pool.parallel_for((runs + 1) / 2, [&](size_t pair) {
+      const size_t first = bounds[2 * pair];
+      const size_t middle = bounds[std::min(2 * pair + 1, runs)];
+      const size_t last = bounds[std::min(2 * pair + 2, runs)];
+      auto from = entries.begin();
+      std::merge(from + first, from + middle, from + middle, from + last, scratch.begin() + first, less);
+    });
+
+    std::vector<size_t> merged;
+    for (size_t i = 0; i < bounds.size(); i += 2) {
+      merged.push_back(bounds[i]);
+    }
+    if (runs % 2 == 1)
+      merged.push_back(bounds.back());
+    bounds = std::move(merged);
+    entries.swap(scratch);
+  }
+}
+
+/**
+ * Appends one normalized field per sort to every entry's key, most significant first.
+ * Each field maps a row to an order-preserving value (descending keys are flipped);
+ * exact fields use the fewest bits that cover the values present in the entries.
+ */
+class KeyPacker {
+public:
+  KeyPacker(const TaskColumns &columns, std::vector<SortEntry> &entries) noexcept :
+      columns_(columns), entries_(entries) {}
+
+  unsigned used_bits() const noexcept { return used_; }
+
+  // Post: true if `sort` was packed exactly; false if it only left a prefix (title) or did not fit
+  bool pack(const SortSpec &sort) {
+    const bool ascending = sort.direction == SortDirection::Ascending;
+    switch (sort.field) {
+    case SortField::Priority: {
+      const std::int32_t *priority = columns_.priority.data();
+      auto [low, high] = value_range([priority](std::uint32_t row) { return priority[row]; });
+      return append(span_bits(high - low), [=](std::uint32_t row) {
+        return static_cast<std::uint64_t>(ascending ? priority[row] - low : high - priority[row]);
+      });
+    }
+    case SortField::Status: {
+      const std::vector<std::uint32_t> rank = columns_.status_rank();
+      const std::uint64_t top = rank.size() - 1;
+      const std::uint32_t *status = columns_.status.data();
+      return append(span_bits(top), [&rank, status, top, ascending](std::uint32_t row) {
+        return ascending ? rank[status[row]] : top - rank[status[row]];
+      });
+    }
+    case SortField::CreatedDate:
+    case SortField::DueDate: {
+      // A missing date takes the value after every real one, so it sorts last either way
+      const std::int32_t *days = sort.field == SortField::CreatedDate ? columns_.created_day.data()
+                                                                       : columns_.due_day.data();
+      auto [low, high] = value_range([days](std::uint32_t row) { return days[row]; }, true);
+      const std::uint64_t missing = static_cast<std::uint64_t>(high - low) + 1;
+      return append(span_bits(missing), [=](std::uint32_t row) {
+        if (days[row] == NO_DATE)
+          return missing;
+        return static_cast<std::uint64_t>(ascending ? days[row] - low : high - days[row]);
+      });
+    }
+    case SortField::Title: {
+      // Big-endian byte prefix: orders like the full string except between equal prefixes
+      const unsigned bits = 64 - used_;
+      if (bits > 0) {
+        append(bits, [this, bits, ascending](std::uint32_t row) {
+          const std::uint64_t prefix = title_prefix(row);
+          return (ascending ? prefix : ~prefix) >> (64 - bits);
+        });
       }
-    };
-  case FilterField::Title:
-    return [filter](const Task *t) {
-      std::string target = filter.value;
-      switch (filter.op) {
-      case FilterOp::Equal:
-        return t->title == target;
-      case FilterOp::NotEqual:
-        return t->title != target;
-      default:
+      return false;
+    }
+    default: {
+      // Ordinals follow ID order
+      const std::uint64_t top = columns_.size() - 1;
+      return append(span_bits(top), [top, ascending](std::uint32_t row) { return ascending ? row : top - row; });
+    }
+    }
+  }
+
+private:
+  static unsigned span_bits(std::int64_t span) noexcept {
+    return static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(span)));
+  }
+
+  // Post: [min, max] of `value` over the entries (skipping NO_DATE if `skip_missing`); {0, 0} if none
+  template <typename Value>
+  std::pair<std::int64_t, std::int64_t> value_range(const Value &value, bool skip_missing = false) const {
+    std::int64_t low = INT64_MAX;
+    std::int64_t high = INT64_MIN;
+    for (const SortEntry &entry : entries_) {
+      const std::int32_t v = value(entry.row);
+      if (skip_missing && v == NO_DATE)
+        continue;
+      low = std::min<std::int64_t>(low, v);
+      high = std::max<std::int64_t>(high, v);
+    }
+    return low > high ? std::pair<std::int64_t, std::int64_t>{0, 0} : std::pair{low, high};
+  }
+
+  std::uint64_t title_prefix(std::uint32_t row) const noexcept {
+    const std::string_view title = columns_.text(columns_.title[row]);
+    std::uint64_t prefix = 0;
+    for (size_t i = 0; i < 8; ++i) {
+      prefix = (prefix << 8) | (i < title.size() ? static_cast<unsigned char>(title[i]) : 0u);
+    }
+    return prefix;
+  }
+
+  // Post: true and `width` bits of `value` appended if they fit in the key; false (unchanged) otherwise
+  template <typename Value>
+  bool append(unsigned width, const Value &value) {
+    if (width > 64 - used_)
+      return false;
+    for (SortEntry &entry : entries_) {
+      entry.key = (width == 64 ? 0 : entry.key << width) | value(entry.row);
+    }
+    used_ += width;
+    return true;
+  }
+
+  const TaskColumns &columns_;
+  std::vector<SortEntry> &entries_;
+  unsigned used_{0};
+};
+
+// Post: `rows` stably ordered by `bucket(row)`, which must be below `buckets` for every row
+template <typename Bucket>
+void bucket_sort(std::vector<std::uint32_t> &rows, size_t buckets, const Bucket &bucket) {
+  std::vector<size_t> start(buckets + 1, 0);
+  for (std::uint32_t row : rows) {
+    ++start[bucket(row) + 1];
+  }
+  std::partial_sum(start.begin(), start.end(), start.begin());
+
+  std::vector<std::uint32_t> sorted(rows.size());
+  for (std::uint32_t row : rows) {
+    sorted[start[bucket(row)]++] = row;
+  }
+  rows.swap(sorted);
+}
+} // anonymous namespace
+
+void Database::materialize_rows() const {
+  if (!view_stale_)
+    return;
+
+  view_rows_ = view_set_.to_vector();
+  order_rows(view_rows_, view_rows_.size());
+  view_stale_ = false;
+  view_hydrated_ = false; // task pointers are rebuilt by materialize_view on demand
+}
+
+void Database::order_rows(std::vector<std::uint32_t> &rows, size_t count) const {
+  if (sort_chain_.empty() && base_rank_.empty())
+    return; // ordinal order is the view order
+  count = std::min(count, rows.size());
+
+  // Few distinct keys: stable counting passes from the oldest sort to the newest (LSD radix order)
+  const bool countable = !sort_chain_.empty() && std::all_of(sort_chain_.begin(), sort_chain_.end(), [](auto &s) {
+    return s.field == SortField::Priority || s.field == SortField::Status;
+  });
+  if (countable) {
+    if (!base_rank_.empty()) {
+      const std::vector<std::uint32_t> &rank = base_rank_;
+      std::sort(rows.begin(), rows.end(), [&rank](std::uint32_t a, std::uint32_t b) { return rank[a] < rank[b]; });
+    }
+    // A pass that declines leaves `rows` in some order, which the total order below does not depend on
+    if (std::all_of(sort_chain_.begin(), sort_chain_.end(), [&](const SortSpec &s) { return counting_sort(rows, s); }))
+      return;
+  }
+
+  packed_sort(rows, count);
+}
+
+void Database::packed_sort(std::vector<std::uint32_t> &rows, size_t count) const {
+  if (rows.size() <= 1)
+    return;
+
+  const std::vector<std::uint32_t> &rank = base_rank_;
+  std::vector<SortEntry> entries(rows.size());
+  std::uint32_t max_tie = 0;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const std::uint32_t tie = rank.empty() ? rows[i] : rank[rows[i]];
+    entries[i] = SortEntry{0, tie, rows[i]};
+    max_tie = std::max(max_tie, tie);
+  }
+
+  // Newest sort is the primary key, so it takes the most significant bits
+  KeyPacker packer{columns_, entries};
+  bool exact = true;
+  for (auto it = sort_chain_.rbegin(); it != sort_chain_.rend() && exact; ++it) {
+    exact = packer.pack(*it);
+  }
+
+  // Full comparison for entries whose packed keys are equal.
+  // Newest sort is the primary key; ties fall through to older sorts, then to the base order
+  std::vector<std::function<bool(std::uint32_t, std::uint32_t)>> keys;
+  if (!exact) {
+    for (auto it = sort_chain_.rbegin(); it != sort_chain_.rend(); ++it) {
+      keys.push_back(make_comparator(*it));
+    }
+  }
+  auto tied_less = [&keys](const SortEntry &x, const SortEntry &y) {
+    for (const auto &key : keys) {
+      if (key(x.row, y.row))
+        return true;
+      if (key(y.row, x.row))
         return false;
+    }
+    return x.tie < y.tie;
+  };
+
+  auto entry_less = [&tied_less](const SortEntry &x, const SortEntry &y) {
+    return x.key != y.key ? x.key < y.key : tied_less(x, y);
+  };
+  // Radix sort, then settle each run of equal packed keys that reaches the first `count` entries
+  auto sort_range = [&](std::span<SortEntry> range, size_t count) {
+    radix_sort(range, packer.used_bits(), static_cast<unsigned>(std::bit_width(max_tie)));
+    for (size_t first = 0; !exact && first < count;) {
+      size_t last = first + 1;
+      while (last < range.size() && range[last].key == range[first].key) {
+        ++last;
       }
-    };
-  case FilterField::CreatedDate:
-    return [filter](const Task *t) {
-      std::string target = filter.value;
-      switch (filter.op) {
-      case FilterOp::Equal:
-        return t->created_date == target;
-      case FilterOp::NotEqual:
-        return t->created_date != target;
-      default:
-        return false;
+      if (last - first > 1) {
+        auto begin = range.begin();
+        if (last > count)
+          std::partial_sort(begin + first, begin + count, begin + last, tied_less);
+        else
+          std::sort(begin + first, begin + last, tied_less);
       }
+      first = last;
+    }
+  };
+
+  const size_t size = entries.size();
+  count = std::min(count, size);
+  if (count < size / TOP_K_FRACTION) {
+    // Small page: bounded heap, comparing packed keys first
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), entry_less);
+  } else if (size >= parallel_threshold_ && pool_->size() > 1) {
+    // Parallel merge sort over the total order (key, full comparison, base position):
+    // it yields exactly the sequential result, so stability is preserved
+    const size_t parts = pool_->size();
+    std::vector<size_t> bounds(parts + 1);
+    for (size_t part = 0; part <= parts; ++part) {
+      bounds[part] = size * part / parts;
+    }
+    pool_->parallel_for(parts, [&](size_t part) {
+      std::span<SortEntry> range(entries.data() + bounds[part], bounds[part + 1] - bounds[part]);
+      sort_range(range, range.size());
+    });
+    merge_parts(entries, std::move(bounds), entry_less, *pool_);
+  } else {
+    sort_range(entries, count);
+  }
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+bool Database::counting_sort(std::vector<std::uint32_t> &rows, const SortSpec &sort) const {
+  const bool ascending = sort.direction == SortDirection::Ascending;
+
+  if (sort.field == SortField::Priority) {
+    if (rows.empty())
+      return true;
+    const std::int32_t *priority = columns_.priority.data();
+    auto [lo, hi] = std::minmax_element(rows.begin(), rows.end(), [priority](std::uint32_t a, std::uint32_t b) {
+      return priority[a] < priority[b];
+    });
+    const std::int64_t low = priority[*lo];
+    const std::int64_t high = priority[*hi];
+    if (high - low >= MAX_COUNTING_KEYS)
+      return false;
+    bucket_sort(rows, static_cast<size_t>(high - low + 1), [priority, low, high, ascending](std::uint32_t row) {
+      return static_cast<size_t>(ascending ? priority[row] - low : high - priority[row]);
+    });
+    return true;
+  }
+
+  if (sort.field == SortField::Status) {
+    // Buckets follow the lexicographic rank of the dictionary codes
+    const std::vector<std::uint32_t> rank = columns_.status_rank();
+    const size_t buckets = rank.size();
+    const std::uint32_t *status = columns_.status.data();
+    bucket_sort(rows, buckets, [&rank, status, buckets, ascending](std::uint32_t row) {
+      const size_t r = rank[status[row]];
+      return ascending ? r : buckets - 1 - r;
+    });
+    return true;
+  }
+  return false;
+}
+
+const Task *Database::task_at(std::uint32_t row) const {
+  auto &task = hydrated_[row];
+  if (!task)
+    task = std::make_unique<Task>(columns_.task(row));
+  return task.get();
+}
+
+std::optional<std::uint32_t> Database::ordinal_of(int id) const noexcept {
+  if (!id_rows_.empty()) {
+    const std::int64_t slot = std::int64_t{id} - id_base_;
+    if (slot < 0 || static_cast<std::uint64_t>(slot) >= id_rows_.size() || id_rows_[slot] == NO_ROW)
+      return std::nullopt;
+    return id_rows_[slot];
+  }
+  auto it = std::lower_bound(columns_.id.begin(), columns_.id.end(), id);
+  if (it == columns_.id.end() || *it != id)
+    return std::nullopt;
+  return static_cast<std::uint32_t>(it - columns_.id.begin());
+}
+
+std::function<bool(std::uint32_t, std::uint32_t)> Database::make_comparator(const SortSpec &sort) const {
+  const bool ascending = sort.direction == SortDirection::Ascending;
+  const TaskColumns &c = columns_;
+
+  // Wrap a per-row key accessor into an ascending/descending comparator
+  auto by = [ascending](auto key) -> std::function<bool(std::uint32_t, std::uint32_t)> {
+    if (ascending)
+      return [key](std::uint32_t a, std::uint32_t b) { return key(a) < key(b); };
+    return [key](std::uint32_t a, std::uint32_t b) { return key(b) < key(a); };
+  };
+
+  switch (sort.field) {
+  case SortField::Priority:
+    return by([&c](std::uint32_t row) { return c.priority[row]; });
+  case SortField::Title:
+    return by([&c](std::uint32_t row) { return c.text(c.title[row]); });
+  case SortField::Status:
+    // Compare dictionary codes through their lexicographic rank
+    return by([&c, rank = c.status_rank()](std::uint32_t row) { return rank[c.status[row]]; });
+  case SortField::CreatedDate:
+  case SortField::DueDate: {
+    // Day numbers; a missing or invalid date sorts last in either direction
+    const std::int32_t *days = sort.field == SortField::CreatedDate ? c.created_day.data() : c.due_day.data();
+    return [days, ascending](std::uint32_t a, std::uint32_t b) {
+      const std::int32_t x = days[a];
+      const std::int32_t y = days[b];
+      if (x == NO_DATE || y == NO_DATE)
+        return x != NO_DATE && y == NO_DATE;
+      return ascending ? x < y : y < x;
     };
+  }
   default:
-    return [](const Task *) { return true; };
-  }
-
-  // TODO: Handle optional fields (due_date, assignee, description)
-  //
-  //   Example for DueDate + LessThan:
-  //     std::string date = filter.value;
-  //     return [date](const Task* t) {
-  //       if (!t->due_date.has_value()) return false;  // No date = doesn't match
-  //       return *t->due_date < date;
-  //     };
-  //
+    // Ordinals follow ID order
+    return by([](std::uint32_t row) { return row; });
+  }
 }
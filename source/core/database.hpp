@@ -1,13 +1,21 @@
 #pragma once
 #include "io/view_storage.hpp"
+#include "row_bitmap.hpp"
 #include "task.hpp"
+#include "task_columns.hpp"
+#include "text_index.hpp"
+#include "thread_pool.hpp"
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
+struct FilterExpr;
+
 // ============================================================================
 // Filter Specification Types
 // ============================================================================
@@ -66,6 +74,15 @@ struct SortSpec {
       field(field_), direction(direction_) {}
 };
 
+/// Rows changed by `Database::reload`, classified by ID.
+struct ReloadDelta {
+  size_t inserted{0}; ///< IDs only in the new tasks
+  size_t updated{0};  ///< IDs in both whose content differs
+  size_t deleted{0};  ///< IDs no longer present
+
+  bool empty() const noexcept { return inserted == 0 && updated == 0 && deleted == 0; }
+};
+
 // ============================================================================
 // Statistics Types
 // ============================================================================
@@ -85,6 +102,32 @@ struct StatusStats {
   size_t total() const noexcept { return todo_count + in_progress_count + done_count + other_count; }
 };
 
+/// Field the rows of `Database::group_stats` are grouped by
+enum class GroupField {
+  Status,      ///< one group per status
+  Assignee,    ///< one group per assignee; tasks without one share the empty key
+  Tag,         ///< one group per tag, counting every task carrying it; untagged tasks share the empty key
+  CreatedMonth ///< one group per `YYYY-MM` of `created_date`; invalid dates share the empty key
+};
+
+/// Aggregates `Database::group_stats` reports (every one is computed in the same pass)
+enum class Aggregate { Count, AveragePriority, Overdue, MinDue, MaxDue };
+
+/**
+ * @brief Aggregates of one group of the current view.
+ *
+ * Overdue follows `Database::overdue_count`; the due-date bounds only consider
+ * tasks with a valid due date.
+ */
+struct GroupStats {
+  std::string key;                    ///< group value; empty for tasks without one
+  size_t count{0};                    ///< tasks in the group
+  double average_priority{0.0};       ///< mean priority of those tasks
+  size_t overdue_count{0};            ///< tasks due before `today` and not done
+  std::optional<std::string> min_due; ///< earliest due date (YYYY-MM-DD), if any task has one
+  std::optional<std::string> max_due; ///< latest due date (YYYY-MM-DD), if any task has one
+};
+
 // ============================================================================
 // Database Class
 // ============================================================================
@@ -93,8 +136,15 @@ struct StatusStats {
  * @brief In-memory task database with filtering, sorting, and query capabilities.
  *
  * The Database maintains:
- * - Canonical storage: all loaded tasks indexed by ID
- * - Current view: filtered/sorted subset of tasks
+ * - Canonical storage: dense per-field columns in ID order, used directly by
+ *   filters, sorts and aggregates. Status, assignee, dates and tags are
+ *   interned; titles and descriptions live in one arena released per load
+ * - Task objects: rebuilt from the columns on first access through
+ *   `current_view()` / `get_task_by_id()`, then cached until the next load
+ * - Current view: a bitmap of row ordinals plus the sorts applied to it; the
+ *   ordered task list is only materialized when `current_view()` is read
+ * - Primary index: ID -> row ordinal, a flat direct-indexed table while IDs are
+ *   dense (the common, mostly sequential case), binary search otherwise
  * - Secondary indices: for efficient status and tag lookups
  *
  * Responsibilities:
@@ -103,24 +153,95 @@ struct StatusStats {
  * - Apply sorting (reorders current view)
  * - Compute aggregations and statistics
  *
+ * Views of at least `parallel_threshold` rows are filtered, sorted, rebuilt
+ * into tasks and aggregated on a thread pool, split at bitmap chunk
+ * boundaries; results are identical to the sequential ones.
+ *
  * @note View operations (filter/sort) do not mutate the canonical task store.
  * @note Not thread-safe; caller must synchronize access if needed.
  */
 class Database {
 private:
-  /// Canonical store (unchanged by filters/sorts), indexed by task ID
-  std::map<int, Task> tasks_;
+  /// Canonical store (unchanged by filters/sorts); row ordinals follow ID order
+  TaskColumns columns_;
 
-  /// Current view: non-owning pointers to tasks in the canonical store
-  std::vector<const Task *> view_;
+  /// Ordinal -> Task rebuilt from `columns_` on first access (null until then); addresses are stable
+  mutable std::vector<std::unique_ptr<Task>> hydrated_;
 
-  /// Secondary index: status -> tasks with that status
-  std::unordered_map<std::string, std::vector<const Task *>> status_index_;
+  /// Rows in the current view (authoritative membership; filters operate on it)
+  RowBitmap view_set_;
 
-  /// Secondary index: tag -> tasks containing that tag
-  std::unordered_map<std::string, std::vector<const Task *>> tag_index_;
+  /// Sorts applied since the last reset, oldest first (at most one per field).
+  /// The view order is lexicographic in (newest key, ..., oldest key, base rank),
+  /// which equals applying the sorts one after another as stable sorts.
+  std::vector<SortSpec> sort_chain_;
+
+  /// Ordinal -> position of an explicitly restored order (empty: the base order is the ordinal)
+  std::vector<std::uint32_t> base_rank_;
+
+  /// Current view order as row ordinals, materialized lazily from the members above
+  mutable std::vector<std::uint32_t> view_rows_;
+
+  /// Current view: non-owning pointers to tasks in the canonical store (mirrors `view_rows_`)
+  mutable std::vector<const Task *> view_;
+
+  /// True when `view_rows_`/`view_` no longer reflect `view_set_` and the sort chain
+  mutable bool view_stale_{false};
+
+  /// True when `view_` holds the tasks of `view_rows_` (ID-only readers skip rebuilding tasks)
+  mutable bool view_hydrated_{true};
+
+  /// Secondary index: status code (`columns_.statuses`) -> rows with that status
+  std::vector<RowBitmap> status_index_;
+
+  /// Secondary index: tag code (`columns_.tags`) -> rows of tasks containing that tag
+  std::vector<RowBitmap> tag_index_;
+
+  /// Primary index: row of ID `id_base_ + i` at slot `i` (NO_ROW for gaps); empty when IDs are too sparse
+  std::vector<std::uint32_t> id_rows_;
+
+  /// Smallest loaded ID (slot 0 of `id_rows_`)
+  int id_base_{0};
+
+  /// Word index over titles and descriptions, built by the first text search (null until then)
+  std::unique_ptr<TextIndex> text_index_;
+
+  /// Workers for large views (not owned)
+  ThreadPool *pool_{&ThreadPool::shared()};
+
+  /// Views with fewer rows than this run on the calling thread
+  size_t parallel_threshold_;
 
 public:
+  /// `id_rows_` slot of an ID that is not loaded
+  static constexpr std::uint32_t NO_ROW = UINT32_MAX;
+
+  /// The direct ID index is kept while the ID range spans at most this many slots per task
+  static constexpr size_t ID_INDEX_SPREAD = 4;
+
+  /// status_stats counts codes with per-code scan masks up to this many statuses, and per row beyond
+  static constexpr size_t MAX_SCANNED_CODES = 8;
+
+  /// Default row count from which view operations run on the pool
+  static constexpr size_t DEFAULT_PARALLEL_THRESHOLD = size_t{1} << 17;
+
+  /**
+   * @param parallel_threshold Smallest view (in rows) worth splitting across `ThreadPool::shared()`.
+   */
+  explicit Database(size_t parallel_threshold = DEFAULT_PARALLEL_THRESHOLD) noexcept :
+      parallel_threshold_(parallel_threshold) {}
+
+  /**
+   * @brief Run view operations of at least `threshold` rows on `pool`.
+   * @pre `pool` outlives the database (or the next call).
+   * @post A pool of one worker, or a view below `threshold`, keeps everything on the calling thread.
+   * @throws none (noexcept).
+   */
+  void set_parallelism(ThreadPool &pool, size_t threshold = DEFAULT_PARALLEL_THRESHOLD) noexcept {
+    pool_ = &pool;
+    parallel_threshold_ = threshold;
+  }
+
   // ==========================================================================
   // Data Loading
   // ==========================================================================
@@ -129,16 +250,47 @@ public:
    * @brief Load tasks into the database, replacing any existing data.
    *
    * @pre `tasks` contains valid Task objects (caller-validated).
-   * @post `tasks_` contains all tasks indexed by ID.
-   * @post `view_` contains pointers to all tasks in insertion order.
+   * @post The columns hold one row per distinct ID, in ID order (for a repeated ID the last task wins).
+   * @post `view_` contains pointers to all tasks in ID order.
    * @post Secondary indices are rebuilt.
    * @post Previous filters/sorts are cleared.
-   * @throws none (noexcept move semantics).
+   * @throws std::bad_alloc if storage cannot be allocated.
+   * @note `tasks` is consumed: pass it as an rvalue. Each task is released as soon as its row is
+   *       appended to the columns (reserved once, to the exact text size), so peak memory stays
+   *       near one copy of the data.
    *
-   * @param tasks Vector of tasks to load (moved into storage).
+   * @param tasks Vector of tasks to load.
    */
   void load(std::vector<Task> tasks);
 
+  /**
+   * @brief Replace the tasks with `tasks`, keeping the view that `history` produced.
+   *
+   * Old and new tasks are matched by ID and compared by `content_hash`. Rows
+   * whose content did not change keep their view membership; only inserted and
+   * updated rows are run through the filters of `history` (those after its last
+   * reset). The sort order is re-derived from the sorts of `history`, so
+   * changed and new rows land where a full replay would put them.
+   *
+   * @pre `history` is the action sequence that produced the current view.
+   * @post The columns and indices hold `tasks` as `load(tasks)` would, and the view
+   *       equals `load(tasks)` followed by `replay_history(history)`.
+   * @post With an empty delta nothing changes, and pointers stay valid; otherwise
+   *       pointers previously returned by the database are invalidated.
+   * @throws std::bad_alloc if storage cannot be allocated.
+   * @note `tasks` is consumed, as by `load`.
+   *
+   * @return Counts of inserted, updated and deleted IDs.
+   */
+  ReloadDelta reload(std::vector<Task> tasks, const std::vector<ViewAction> &history);
+
+  /**
+   * @brief Drop every task, index and view, releasing the text arena in one shot.
+   * @post `empty()`; pointers previously returned by the database are invalidated.
+   * @throws none (noexcept).
+   */
+  void clear() noexcept;
+
   // ==========================================================================
   // View Management
   // ==========================================================================
@@ -147,9 +299,10 @@ public:
    * @brief Reset the current view to include all loaded tasks.
    *
    * @pre Database may be empty or contain tasks.
-   * @post `view_` contains pointers to all tasks in `tasks_`, ordered by ID.
+   * @post `view_` contains pointers to all loaded tasks, ordered by ID.
    * @post Clears any active filters.
    * @throws none (noexcept).
+   * @note O(rows / 65536): the view becomes a run of full bitmap containers.
    */
   void reset_view() noexcept;
 
@@ -164,11 +317,29 @@ public:
    * @post `view_` contains only tasks matching the filter predicate.
    * @post Order within view is preserved.
    * @throws none (invalid filters are logged and ignored).
+   * @note `status=value` is answered by intersecting with `status_index_`.
    *
    * @param filter The filter specification to apply.
    */
   void apply_filter(const FilterSpec &filter);
 
+  /**
+   * @brief Apply a compound boolean filter to narrow the current view.
+   *
+   * Operands answerable from the status index (`status=value`,
+   * `status IN (...)`) are combined as bitmap AND/OR/AND-NOT; all remaining
+   * operands of a node are compiled once, ordered by estimated selectivity and
+   * cost, and evaluated in a single short-circuiting pass over the rows left.
+   * A single term takes the specialized `apply_filter(const FilterSpec &)` path.
+   *
+   * @pre `expr` is a well-formed FilterExpr (see ExpressionParser::parse_filter_expr).
+   * @post `view_` contains only tasks matching `expr`; order within view is preserved.
+   * @throws std::invalid_argument / std::out_of_range if a numeric value does not parse.
+   *
+   * @param expr The filter expression to apply.
+   */
+  void apply_filter(const FilterExpr &expr);
+
   /**
    * @brief Apply a sort to reorder the current view.
    *
@@ -182,12 +353,26 @@ public:
    */
   void apply_sort(const SortSpec &sort);
 
+  /**
+   * @brief Reorder the current view by several keys, primary key first.
+   *
+   * @pre `keys` are valid sort specifications (e.g. from ExpressionParser::parse_sort_keys).
+   * @post Same order as applying `keys` last-to-first with `apply_sort(const SortSpec &)`:
+   *       each key breaks the ties of the ones before it, and remaining ties keep the previous order.
+   * @throws std::bad_alloc if the sort chain cannot grow.
+   *
+   * @param keys Sort keys, most significant first.
+   */
+  void apply_sort(const std::vector<SortSpec> &keys);
+
   /**
    * @brief Filter current view to tasks containing a specific tag.
    *
    * @pre `tag` is a non-empty tag string.
    * @post `view_` contains only tasks whose `tags` vector includes `tag`.
-   * @throws none (noexcept).
+   * @post Order within view is preserved.
+   * @throws std::bad_alloc if the intersection cannot be allocated.
+   * @note Answered from `tag_index_`; cost follows the number of tagged rows, not the view size.
    *
    * @param tag The tag to filter by.
    */
@@ -205,9 +390,17 @@ public:
   /**
    * @brief Filter current view by text search in title and description.
    *
-   * @pre `text` is the search string (case-insensitive substring match).
-   * @post `view_` contains only tasks where `text` appears in title or description.
-   * @throws none (noexcept).
+   * `text` is split into words as TextIndex::words does; a task matches when
+   * every word occurs, case-insensitively, as a substring of its title or
+   * description (any word in either field).
+   *
+   * @pre `text` is the search string.
+   * @post `view_` contains only matching tasks; order within view is preserved.
+   * @post A text without words leaves the view unchanged.
+   * @throws std::bad_alloc if the index or the result cannot be allocated.
+   * @note The first search over more than a small fraction of the rows builds
+   *       `text_index()`; every search after that only intersects posting lists.
+   *       Smaller views are scanned directly.
    *
    * @param text The text to search for.
    */
@@ -226,6 +419,30 @@ public:
    */
   void replay_history(const std::vector<ViewAction> &actions) noexcept;
 
+  /**
+   * @brief Restore a previously materialized view from its task IDs.
+   *
+   * @pre Database contains loaded tasks.
+   * @post On success: `view_` holds the tasks with the given IDs, in the given order.
+   * @post On failure (an ID is not loaded): `view_` is unchanged.
+   * @throws none (noexcept).
+   *
+   * @param task_ids IDs of the tasks in view order.
+   * @return true if every ID was found and the view was restored.
+   */
+  bool restore_view(const std::vector<int> &task_ids) noexcept;
+
+  /// Index used by `search_text`; nullptr until the first search or `set_text_index`.
+  const TextIndex *text_index() const noexcept { return text_index_.get(); }
+
+  /**
+   * @brief Adopt an index built earlier for the same dataset (e.g. read from a cache).
+   * @post On success: `text_index()` is `index`; on failure the database is unchanged.
+   * @throws std::bad_alloc if the index cannot be stored.
+   * @return false if `index` does not cover exactly the loaded rows.
+   */
+  bool set_text_index(TextIndex index);
+
   // ==========================================================================
   // Data Access
   // ==========================================================================
@@ -240,7 +457,41 @@ public:
    *
    * @return Const reference to vector of task pointers.
    */
-  const std::vector<const Task *> &current_view() const noexcept { return view_; }
+  const std::vector<const Task *> &current_view() const noexcept {
+    materialize_view();
+    return view_;
+  }
+
+  /**
+   * @brief IDs of the tasks in the current view, in view order.
+   *
+   * @post Same IDs as `current_view()`, without rebuilding any Task object.
+   * @throws std::bad_alloc if the result cannot be allocated.
+   */
+  std::vector<int> current_view_ids() const;
+
+  /**
+   * @brief Tasks at positions `[offset, offset + limit)` of the current view.
+   *
+   * @post Same tasks, in the same order, as that slice of `current_view()`; empty past the end.
+   * @throws std::bad_alloc if the page cannot be allocated.
+   * @note While the view order is stale, ties the packed sort keys leave are only
+   *       resolved within the first `offset + limit` rows, and only the tasks on the
+   *       page are rebuilt.
+   *
+   * @param offset Number of view positions to skip.
+   * @param limit Maximum number of tasks to return.
+   */
+  std::vector<const Task *> view_page(size_t offset, size_t limit) const;
+
+  /**
+   * @brief Every task in canonical storage, in ID order (ignores the view).
+   *
+   * @post Rebuilds the tasks not yet rebuilt, on the pool for large datasets.
+   * @throws std::bad_alloc if the tasks cannot be allocated.
+   * @note Returned pointers remain valid until next `load()` call.
+   */
+  std::vector<const Task *> all_tasks() const;
 
   /**
    * @brief Get a task by ID.
@@ -264,7 +515,7 @@ public:
    *
    * @return Total task count.
    */
-  size_t total_task_count() const noexcept { return tasks_.size(); }
+  size_t total_task_count() const noexcept { return columns_.size(); }
 
   /**
    * @brief Get number of tasks in current view.
@@ -275,7 +526,7 @@ public:
    *
    * @return Current view task count.
    */
-  size_t view_task_count() const noexcept { return view_.size(); }
+  size_t view_task_count() const noexcept { return view_set_.cardinality(); }
 
   /**
    * @brief Check if database is empty.
@@ -286,7 +537,7 @@ public:
    *
    * @return True if empty, false otherwise.
    */
-  bool empty() const noexcept { return tasks_.empty(); }
+  bool empty() const noexcept { return columns_.size() == 0; }
 
   // ==========================================================================
   // Aggregations and Statistics
@@ -318,12 +569,14 @@ public:
    * @brief Count overdue tasks in current view.
    *
    * A task is overdue if:
-   * - It has a `due_date` value
+   * - It has a valid `due_date` value
    * - `due_date < today_iso`
    * - `status != "done"`
    *
+   * Dates are compared as the day numbers parsed at load time.
+   *
    * @pre `today_iso` is a valid ISO 8601 date string (YYYY-MM-DD).
-   * @post Returns count of overdue tasks.
+   * @post Returns count of overdue tasks (0 if `today_iso` is not a valid date).
    * @throws none (noexcept, invalid dates are skipped).
    *
    * @param today_iso Current date in ISO 8601 format for comparison.
@@ -331,17 +584,82 @@ public:
    */
   size_t overdue_count(std::string_view today_iso) const noexcept;
 
+  /**
+   * @brief Count, priority average, overdue count and due-date bounds of the current view per group.
+   *
+   * Rows are mapped to groups through the dictionary codes of the grouped
+   * column (a code -> month table for `CreatedMonth`), so one pass over the
+   * view fills a flat array of accumulators. Large views are split into
+   * parts that each fill their own array, merged afterwards.
+   *
+   * @pre `today_iso` is the reference date for overdue counts (YYYY-MM-DD).
+   * @post One entry per non-empty group, ordered by key with the empty key last.
+   * @post Counts add up to `view_task_count()`, except for `Tag` where a task counts once per tag.
+   * @post Overdue counts are 0 if `today_iso` is not a valid date.
+   * @throws std::bad_alloc if the accumulators cannot be allocated.
+   *
+   * @param field Field to group by.
+   * @param today_iso Current date in ISO 8601 format.
+   * @return Aggregates per group.
+   */
+  std::vector<GroupStats> group_stats(GroupField field, std::string_view today_iso) const;
+
 private:
   // ==========================================================================
   // Internal Helpers
   // ==========================================================================
 
-  /// Rebuild secondary indices after loading tasks
-  void rebuild_indices() noexcept;
+  /// Fill the columns from `tasks[order[i]]` (ascending, distinct IDs), then rebuild the indices
+  void store(std::vector<Task> tasks, const std::vector<std::uint32_t> &order);
+
+  /// Rebuild secondary indices (ordinal postings) after loading tasks
+  void rebuild_indices();
+
+  /// Apply `actions` to the current view as they come, without the reset `replay_history` starts with
+  void apply_actions(const std::vector<ViewAction> &actions) noexcept;
+
+  /// Narrow the view to its members that are also in `rows` (bitmap intersection)
+  void intersect_view(const RowBitmap &rows);
+
+  /// Rows of `domain` matching `expr`, combining indexed operands as bitmaps
+  RowBitmap evaluate(const FilterExpr &expr, const RowBitmap &domain) const;
+
+  /// Rows of the status index matching an indexable term or IN list
+  RowBitmap status_rows(const FilterExpr &expr) const;
+
+  /// Number of parts `rows` is split into: 1 below the threshold, else up to one per worker
+  size_t part_count(const RowBitmap &rows) const noexcept;
+
+  /// Call `body(part, first_chunk, last_chunk)` for each of `parts` consecutive chunk ranges of `rows`, on the pool
+  template <typename F>
+  void for_each_part(const RowBitmap &rows, size_t parts, const F &body) const;
+
+  /// Members of `rows` matching `pred`, compacted per part in parallel for large sets
+  template <typename Pred>
+  RowBitmap filter_rows(const RowBitmap &rows, const Pred &pred) const;
+
+  /// Rebuild `view_rows_`/`view_` from `view_set_` and the sort chain if they are stale
+  void materialize_view() const noexcept;
+
+  /// Rebuild only `view_rows_` (ordered ordinals) if stale
+  void materialize_rows() const;
+
+  /// Reorder `rows` (ordinal order) so its first `count` entries are the first `count` in view order
+  void order_rows(std::vector<std::uint32_t> &rows, size_t count) const;
+
+  /// Order `rows` by per-row keys packed into 64 bits (radix sort); ties those keys cannot
+  /// resolve (title prefixes, keys that did not fit) are compared in full within the first `count` rows
+  void packed_sort(std::vector<std::uint32_t> &rows, size_t count) const;
+
+  /// Stable counting sort of `rows` by a priority/status key; false (rows unchanged) for other keys or wide ranges
+  bool counting_sort(std::vector<std::uint32_t> &rows, const SortSpec &sort) const;
+
+  /// Task at `row`, rebuilt from the columns on first access. @pre `row < columns_.size()`.
+  const Task *task_at(std::uint32_t row) const;
 
-  /// Helper to create a comparator function for the given SortSpec
-  std::function<bool(const Task *, const Task *)> make_comparator(const SortSpec &sort) const;
+  /// Row ordinal of the task with `id`, if loaded (direct index, or binary search over the sorted ID column)
+  std::optional<std::uint32_t> ordinal_of(int id) const noexcept;
 
-  /// Helper to create a predicate function for the given FilterSpec
-  std::function<bool(const Task *)> make_predicate(const FilterSpec &filter) const;
+  /// Helper to create a row-ordinal comparator for the given SortSpec
+  std::function<bool(std::uint32_t, std::uint32_t)> make_comparator(const SortSpec &sort) const;
 };
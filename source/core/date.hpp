@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// ============================================================================
+// Compact calendar dates (days since 1970-01-01)
+// ============================================================================
+
+/// Day number stored for tasks without a (valid) date; sorts before every real date.
+inline constexpr std::int32_t NO_DATE = std::numeric_limits<std::int32_t>::min();
+
+/**
+ * @brief Convert a proleptic Gregorian civil date to days since 1970-01-01.
+ * @pre `month` in [1, 12], `day` in [1, 31].
+ * @post Returns the day number (negative before the epoch).
+ */
+constexpr std::int32_t days_from_civil(int year, unsigned month, unsigned day) noexcept {
+  // Howard Hinnant's days_from_civil algorithm
+  year -= month <= 2;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(year - era * 400);
+  const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int>(doe) - 719468;
+}
+
+/// Civil date of a day number (inverse of days_from_civil)
+struct CivilDate {
+  int year;
+  unsigned month; ///< 1..12
+  unsigned day;   ///< 1..31
+};
+
+/**
+ * @brief Convert days since 1970-01-01 back to a proleptic Gregorian civil date.
+ * @pre `days != NO_DATE`.
+ */
+constexpr CivilDate civil_from_days(std::int32_t days) noexcept {
+  // Howard Hinnant's civil_from_days algorithm
+  days += 719468;
+  const int era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+  const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+  return {static_cast<int>(yoe) + era * 400 + (month <= 2), month, day};
+}
+
+/**
+ * @brief Parse a `YYYY-MM-DD` date (an optional time suffix such as "T10:00:00Z" is ignored).
+ * @pre none
+ * @post Returns the day number, or std::nullopt if `text` is not a valid calendar date.
+ * @throws none (noexcept).
+ */
+constexpr std::optional<std::int32_t> parse_iso_date(std::string_view text) noexcept {
+  if (text.size() < 10 || text[4] != '-' || text[7] != '-')
+    return std::nullopt;
+  if (text.size() > 10 && text[10] != 'T' && text[10] != ' ')
+    return std::nullopt;
+
+  auto digits = [&](size_t pos, size_t len, int &out) {
+    out = 0;
+    for (size_t i = pos; i < pos + len; ++i) {
+      if (text[i] < '0' || text[i] > '9')
+        return false;
+      out = out * 10 + (text[i] - '0');
+    }
+    return true;
+  };
+
+  int year = 0, month = 0, day = 0;
+  if (!digits(0, 4, year) || !digits(5, 2, month) || !digits(8, 2, day))
+    return std::nullopt;
+  if (month < 1 || month > 12 || day < 1)
+    return std::nullopt;
+
+  constexpr int month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  const int max_day = month == 2 && leap ? 29 : month_days[month - 1];
+  if (day > max_day)
+    return std::nullopt;
+
+  return days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+}
+
+/**
+ * @brief Format a day number as `YYYY-MM-DD` (or `YYYY-MM` when `month_only`).
+ * @pre `days != NO_DATE` and the year lies in [0, 9999].
+ */
+inline std::string format_iso_date(std::int32_t days, bool month_only = false) {
+  const CivilDate date = civil_from_days(days);
+  std::string text = std::to_string(date.year);
+  text.insert(0, text.size() < 4 ? 4 - text.size() : 0, '0');
+  text += date.month < 10 ? "-0" : "-";
+  text += std::to_string(date.month);
+  if (!month_only) {
+    text += date.day < 10 ? "-0" : "-";
+    text += std::to_string(date.day);
+  }
+  return text;
+}
+
+/// Parse a date, mapping anything that is not a valid date to NO_DATE.
+constexpr std::int32_t to_day_number(std::string_view text) noexcept { return parse_iso_date(text).value_or(NO_DATE); }
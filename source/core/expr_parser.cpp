@@ -1,6 +1,213 @@
 #include "expr_parser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <iostream>
 
+namespace {
+bool is_space(char c) noexcept { return c == ' ' || c == '\t'; }
+
+void skip_ws(std::string_view &rest) noexcept {
+  while (!rest.empty() && is_space(rest.front())) {
+    rest.remove_prefix(1);
+  }
+}
+
+// Pre: `rest` starts at a token boundary.
+// Post: returns true if `rest` starts with keyword `kw` followed by whitespace, "(" or the end.
+bool at_keyword(std::string_view rest, std::string_view kw) noexcept {
+  if (!rest.starts_with(kw))
+    return false;
+  return rest.size() == kw.size() || is_space(rest[kw.size()]) || rest[kw.size()] == '(';
+}
+
+bool consume_keyword(std::string_view &rest, std::string_view kw) noexcept {
+  skip_ws(rest);
+  if (!at_keyword(rest, kw))
+    return false;
+  rest.remove_prefix(kw.size());
+  return true;
+}
+
+bool consume_char(std::string_view &rest, char c) noexcept {
+  skip_ws(rest);
+  if (rest.empty() || rest.front() != c)
+    return false;
+  rest.remove_prefix(1);
+  return true;
+}
+
+std::string_view trim_trailing(std::string_view s) noexcept {
+  while (!s.empty() && is_space(s.back())) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+TaskField task_field(FilterField field) noexcept {
+  switch (field) {
+  case FilterField::Id:
+    return TaskField::Id;
+  case FilterField::Title:
+    return TaskField::Title;
+  case FilterField::Status:
+    return TaskField::Status;
+  case FilterField::Priority:
+    return TaskField::Priority;
+  case FilterField::CreatedDate:
+    return TaskField::CreatedDate;
+  case FilterField::DueDate:
+    return TaskField::DueDate;
+  case FilterField::Assignee:
+    return TaskField::Assignee;
+  case FilterField::Description:
+    return TaskField::Description;
+  }
+  return TaskField::Id;
+}
+
+TaskField task_field(SortField field) noexcept {
+  switch (field) {
+  case SortField::Id:
+    return TaskField::Id;
+  case SortField::Title:
+    return TaskField::Title;
+  case SortField::Status:
+    return TaskField::Status;
+  case SortField::Priority:
+    return TaskField::Priority;
+  case SortField::CreatedDate:
+    return TaskField::CreatedDate;
+  case SortField::DueDate:
+    return TaskField::DueDate;
+  }
+  return TaskField::Id;
+}
+
+std::string_view field_name(FilterField field) noexcept {
+  switch (field) {
+  case FilterField::Id:
+    return "id";
+  case FilterField::Title:
+    return "title";
+  case FilterField::Status:
+    return "status";
+  case FilterField::Priority:
+    return "priority";
+  case FilterField::CreatedDate:
+    return "created_date";
+  case FilterField::DueDate:
+    return "due_date";
+  case FilterField::Assignee:
+    return "assignee";
+  case FilterField::Description:
+    return "description";
+  }
+  return "";
+}
+
+std::string_view field_name(SortField field) noexcept {
+  switch (field) {
+  case SortField::Id:
+    return "id";
+  case SortField::Title:
+    return "title";
+  case SortField::Status:
+    return "status";
+  case SortField::Priority:
+    return "priority";
+  case SortField::CreatedDate:
+    return "created_date";
+  case SortField::DueDate:
+    return "due_date";
+  }
+  return "";
+}
+
+std::string_view op_symbol(FilterOp op) noexcept {
+  switch (op) {
+  case FilterOp::Equal:
+    return "=";
+  case FilterOp::NotEqual:
+    return "!=";
+  case FilterOp::GreaterThan:
+    return ">";
+  case FilterOp::GreaterThanOrEqual:
+    return ">=";
+  case FilterOp::LessThan:
+    return "<";
+  case FilterOp::LessThanOrEqual:
+    return "<=";
+  }
+  return "";
+}
+
+// Quoted as parse_value reads it back: exactly `value`, keywords and separators included
+void append_quoted(std::string &out, std::string_view value) {
+  out.push_back('"');
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out.push_back('\\');
+    out.push_back(c);
+  }
+  out.push_back('"');
+}
+
+void append_expr(std::string &out, const FilterExpr &expr) {
+  // AND/OR children are parenthesized, so a nested group is read back as one child
+  auto append_child = [&out](const FilterExpr &child) {
+    const bool group = child.kind == FilterExprKind::And || child.kind == FilterExprKind::Or;
+    if (group)
+      out.push_back('(');
+    append_expr(out, child);
+    if (group)
+      out.push_back(')');
+  };
+
+  switch (expr.kind) {
+  case FilterExprKind::Term:
+    out += field_name(expr.terms.front().field);
+    out += op_symbol(expr.terms.front().op);
+    append_quoted(out, expr.terms.front().value);
+    break;
+  case FilterExprKind::In:
+    out += field_name(expr.terms.front().field);
+    out += " IN (";
+    for (size_t i = 0; i < expr.terms.size(); ++i) {
+      out += i ? ", " : "";
+      append_quoted(out, expr.terms[i].value);
+    }
+    out.push_back(')');
+    break;
+  case FilterExprKind::And:
+  case FilterExprKind::Or:
+    for (size_t i = 0; i < expr.children.size(); ++i) {
+      if (i)
+        out += expr.kind == FilterExprKind::And ? " AND " : " OR ";
+      append_child(expr.children[i]);
+    }
+    break;
+  case FilterExprKind::Not:
+    out += "NOT ";
+    append_child(expr.children.front());
+    break;
+  }
+}
+
+// Post: true if `value` suits `field`: ID and priority literals must be whole 32-bit integers (reported otherwise)
+bool valid_literal(FilterField field, std::string_view value) noexcept {
+  if (field != FilterField::Id && field != FilterField::Priority)
+    return true;
+  std::int32_t parsed = 0;
+  const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+  if (ec == std::errc() && end == value.data() + value.size())
+    return true;
+  std::cerr << "[Parser] Error: Expected an integer, got: " << value << "\n";
+  return false;
+}
+} // anonymous namespace
+
 std::optional<FilterSpec> ExpressionParser::parse_filter(std::string_view expr) noexcept {
   if (expr.empty()) {
     std::cerr << "[Parser] Error: Empty filter expression\n";
@@ -42,10 +249,207 @@ std::optional<FilterSpec> ExpressionParser::parse_filter(std::string_view expr)
     return std::nullopt;
   }
 
+  if (!valid_literal(*field, value_str))
+    return std::nullopt;
+
   // Step 4: Construct FilterSpec
   return FilterSpec{*field, op, std::string(value_str)};
 }
 
+std::optional<FilterExpr> ExpressionParser::parse_filter_expr(std::string_view expr) noexcept {
+  try {
+    std::string_view rest = expr;
+    skip_ws(rest);
+    if (rest.empty()) {
+      std::cerr << "[Parser] Error: Empty filter expression\n";
+      return std::nullopt;
+    }
+
+    auto result = parse_or(rest, 0);
+    if (!result)
+      return std::nullopt;
+
+    skip_ws(rest);
+    if (!rest.empty()) {
+      std::cerr << "[Parser] Error: Unexpected input near: " << rest << "\n";
+      return std::nullopt;
+    }
+    return result;
+  } catch (const std::exception &e) {
+    std::cerr << "[Parser] Error: " << e.what() << "\n";
+    return std::nullopt;
+  }
+}
+
+std::optional<FilterExpr> ExpressionParser::parse_or(std::string_view &rest, int depth) {
+  auto first = parse_and(rest, depth);
+  if (!first)
+    return std::nullopt;
+
+  std::vector<FilterExpr> children;
+  children.push_back(std::move(*first));
+  while (consume_keyword(rest, "OR")) {
+    auto next = parse_and(rest, depth);
+    if (!next)
+      return std::nullopt;
+    children.push_back(std::move(*next));
+  }
+
+  if (children.size() == 1)
+    return std::move(children.front());
+  return FilterExpr::any_of(std::move(children));
+}
+
+std::optional<FilterExpr> ExpressionParser::parse_and(std::string_view &rest, int depth) {
+  auto first = parse_unary(rest, depth);
+  if (!first)
+    return std::nullopt;
+
+  std::vector<FilterExpr> children;
+  children.push_back(std::move(*first));
+  while (consume_keyword(rest, "AND")) {
+    auto next = parse_unary(rest, depth);
+    if (!next)
+      return std::nullopt;
+    children.push_back(std::move(*next));
+  }
+
+  if (children.size() == 1)
+    return std::move(children.front());
+  return FilterExpr::all_of(std::move(children));
+}
+
+std::optional<FilterExpr> ExpressionParser::parse_unary(std::string_view &rest, int depth) {
+  // Every NOT and group nests the tree (and the recursion) one level deeper, so both are bounded here
+  skip_ws(rest);
+  if (depth >= MAX_NESTING && (at_keyword(rest, "NOT") || rest.starts_with('('))) {
+    std::cerr << "[Parser] Error: Expression nested deeper than " << MAX_NESTING << " levels\n";
+    return std::nullopt;
+  }
+
+  if (consume_keyword(rest, "NOT")) {
+    auto child = parse_unary(rest, depth + 1);
+    if (!child)
+      return std::nullopt;
+    return FilterExpr::negate(std::move(*child));
+  }
+
+  if (consume_char(rest, '(')) {
+    auto inner = parse_or(rest, depth + 1);
+    if (!inner)
+      return std::nullopt;
+    if (!consume_char(rest, ')')) {
+      std::cerr << "[Parser] Error: Missing closing parenthesis\n";
+      return std::nullopt;
+    }
+    return inner;
+  }
+
+  return parse_term(rest, depth);
+}
+
+std::optional<FilterExpr> ExpressionParser::parse_term(std::string_view &rest, int depth) {
+  skip_ws(rest);
+  size_t len = 0;
+  while (len < rest.size() && (std::isalnum(static_cast<unsigned char>(rest[len])) || rest[len] == '_')) {
+    ++len;
+  }
+  std::string_view field_str = rest.substr(0, len);
+  rest.remove_prefix(len);
+  if (field_str.empty()) {
+    std::cerr << "[Parser] Error: Expected a field name near: " << rest << "\n";
+    return std::nullopt;
+  }
+
+  auto field = parse_filter_field(field_str);
+  if (!field) {
+    std::cerr << "[Parser] Error: Unknown field: " << field_str << "\n";
+    return std::nullopt;
+  }
+
+  // field IN (v1, v2, ...)
+  if (consume_keyword(rest, "IN")) {
+    if (!consume_char(rest, '(')) {
+      std::cerr << "[Parser] Error: Expected '(' after IN\n";
+      return std::nullopt;
+    }
+    std::vector<std::string> values;
+    do {
+      auto value = parse_value(rest, depth, true);
+      if (!value || !valid_literal(*field, *value))
+        return std::nullopt;
+      values.push_back(std::move(*value));
+    } while (consume_char(rest, ','));
+    if (!consume_char(rest, ')')) {
+      std::cerr << "[Parser] Error: Missing ')' after IN list\n";
+      return std::nullopt;
+    }
+    return FilterExpr::in(*field, values);
+  }
+
+  // field op value (operator detected at the front, longest first)
+  skip_ws(rest);
+  auto op_result = find_operator(rest.substr(0, 2));
+  if (!op_result || op_result->second != 0) {
+    std::cerr << "[Parser] Error: No valid operator found after: " << field_str << "\n";
+    return std::nullopt;
+  }
+  auto op = op_result->first;
+  rest.remove_prefix(op == FilterOp::Equal || op == FilterOp::GreaterThan || op == FilterOp::LessThan ? 1 : 2);
+
+  auto value = parse_value(rest, depth, false);
+  if (!value || !valid_literal(*field, *value))
+    return std::nullopt;
+  return FilterExpr::term(FilterSpec{*field, op, std::move(*value)});
+}
+
+std::optional<std::string> ExpressionParser::parse_value(std::string_view &rest, int depth, bool in_list) {
+  skip_ws(rest);
+
+  // Quoted value: everything up to the closing quote, with \" and \\ escapes
+  if (!rest.empty() && rest.front() == '"') {
+    std::string value;
+    for (size_t i = 1; i < rest.size(); ++i) {
+      if (rest[i] == '\\' && i + 1 < rest.size()) {
+        value += rest[++i];
+      } else if (rest[i] == '"') {
+        rest.remove_prefix(i + 1);
+        return value;
+      } else {
+        value += rest[i];
+      }
+    }
+    std::cerr << "[Parser] Error: Unterminated quoted value\n";
+    return std::nullopt;
+  }
+
+  // Unquoted value: stop at a top-level AND/OR, or at the end of the enclosing group/list
+  size_t i = 0;
+  int nested = 0;
+  for (; i < rest.size(); ++i) {
+    const char c = rest[i];
+    if (c == '(') {
+      ++nested;
+    } else if (c == ')') {
+      if (nested > 0)
+        --nested;
+      else if (depth > 0 || in_list)
+        break;
+    } else if (c == ',' && in_list && nested == 0) {
+      break;
+    } else if (is_space(c) && nested == 0) {
+      std::string_view after = rest.substr(i);
+      skip_ws(after);
+      if (at_keyword(after, "AND") || at_keyword(after, "OR"))
+        break;
+    }
+  }
+
+  std::string value(trim_trailing(rest.substr(0, i)));
+  rest.remove_prefix(i);
+  return value;
+}
+
 std::optional<SortSpec> ExpressionParser::parse_sort(std::string_view expr) noexcept {
   if (expr.empty()) {
     std::cerr << "[Parser] Error: Empty sort expression\n";
@@ -85,6 +489,76 @@ std::optional<SortSpec> ExpressionParser::parse_sort(std::string_view expr) noex
   return SortSpec{*field, direction};
 }
 
+std::optional<std::vector<SortSpec>> ExpressionParser::parse_sort_keys(std::string_view expr) noexcept {
+  try {
+    std::vector<SortSpec> keys;
+    for (;;) {
+      const size_t comma = expr.find(',');
+      std::string_view key = expr.substr(0, comma);
+      skip_ws(key);
+      auto spec = parse_sort(trim_trailing(key));
+      if (!spec)
+        return std::nullopt;
+      keys.push_back(*spec);
+
+      if (comma == std::string_view::npos)
+        return keys;
+      expr.remove_prefix(comma + 1);
+    }
+  } catch (const std::bad_alloc &) {
+    return std::nullopt;
+  }
+}
+
+std::optional<GroupField> ExpressionParser::parse_group_field(std::string_view field) noexcept {
+  if (field == "status")
+    return GroupField::Status;
+  if (field == "assignee")
+    return GroupField::Assignee;
+  if (field == "tag")
+    return GroupField::Tag;
+  if (field == "created_month")
+    return GroupField::CreatedMonth;
+  std::cerr << "[Parser] Error: Unknown group-by field: " << field << "\n";
+  return std::nullopt;
+}
+
+std::optional<std::vector<Aggregate>> ExpressionParser::parse_aggregates(std::string_view expr) noexcept {
+  try {
+    std::vector<Aggregate> aggregates;
+    for (;;) {
+      const size_t comma = expr.find(',');
+      std::string_view name = expr.substr(0, comma);
+      skip_ws(name);
+      name = trim_trailing(name);
+
+      std::optional<Aggregate> aggregate;
+      if (name == "count")
+        aggregate = Aggregate::Count;
+      else if (name == "avg_priority")
+        aggregate = Aggregate::AveragePriority;
+      else if (name == "overdue")
+        aggregate = Aggregate::Overdue;
+      else if (name == "min_due")
+        aggregate = Aggregate::MinDue;
+      else if (name == "max_due")
+        aggregate = Aggregate::MaxDue;
+      if (!aggregate) {
+        std::cerr << "[Parser] Error: Unknown aggregate: " << name << "\n";
+        return std::nullopt;
+      }
+      if (std::find(aggregates.begin(), aggregates.end(), *aggregate) == aggregates.end())
+        aggregates.push_back(*aggregate);
+
+      if (comma == std::string_view::npos)
+        return aggregates;
+      expr.remove_prefix(comma + 1);
+    }
+  } catch (const std::bad_alloc &) {
+    return std::nullopt;
+  }
+}
+
 std::optional<FilterField> ExpressionParser::parse_filter_field(std::string_view field) noexcept {
   if (field == "id")
     return FilterField::Id;
@@ -158,3 +632,74 @@ std::optional<std::pair<FilterOp, size_t>> ExpressionParser::find_operator(std::
 
   return std::nullopt;
 }
+
+std::string ExpressionParser::to_string(const FilterExpr &expr) {
+  std::string out;
+  append_expr(out, expr);
+  return out;
+}
+
+std::string ExpressionParser::to_string(const std::vector<SortSpec> &keys) {
+  std::string out;
+  for (const auto &key : keys) {
+    out += out.empty() ? "" : ", ";
+    out += field_name(key.field);
+    if (key.direction == SortDirection::Descending)
+      out += " desc";
+  }
+  return out;
+}
+
+TaskFields ExpressionParser::fields_of(const FilterExpr &expr) noexcept {
+  TaskFields fields;
+  for (const auto &term : expr.terms) {
+    fields |= task_field(term.field);
+  }
+  for (const auto &child : expr.children) {
+    fields |= fields_of(child);
+  }
+  return fields;
+}
+
+TaskFields ExpressionParser::fields_of(const std::vector<SortSpec> &keys) noexcept {
+  TaskFields fields;
+  for (const auto &key : keys) {
+    fields |= task_field(key.field);
+  }
+  return fields;
+}
+
+TaskFields ExpressionParser::fields_of(GroupField field) noexcept {
+  switch (field) {
+  case GroupField::Status:
+    return TaskField::Status;
+  case GroupField::Assignee:
+    return TaskField::Assignee;
+  case GroupField::Tag:
+    return TaskField::Tags;
+  case GroupField::CreatedMonth:
+    return TaskField::CreatedDate;
+  }
+  return TaskFields::all();
+}
+
+TaskFields ExpressionParser::fields_of(const ViewAction &action) noexcept {
+  switch (action.type) {
+  case ViewOpType::Filter:
+    if (auto expr = parse_filter_expr(action.payload))
+      return fields_of(*expr);
+    break;
+  case ViewOpType::Sort:
+    if (auto keys = parse_sort_keys(action.payload))
+      return fields_of(*keys);
+    break;
+  case ViewOpType::FindByTag:
+    return TaskField::Tags;
+  case ViewOpType::Search:
+    return TaskField::Title | TaskField::Description;
+  case ViewOpType::Load:
+  case ViewOpType::ResetFilters:
+    return TaskFields();
+  }
+  return TaskFields::all(); // an action that does not parse is replayed on every field
+}
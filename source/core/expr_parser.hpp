@@ -1,7 +1,12 @@
 #pragma once
 #include "database.hpp"
+#include "filter_expr.hpp"
+#include "task_fields.hpp"
+#include "view_action.hpp"
 #include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 /**
  * @brief Parser for filter and sort expressions.
@@ -11,6 +16,9 @@
  */
 class ExpressionParser {
 public:
+  /// Deepest nesting of NOTs and parenthesized groups parse_filter_expr accepts
+  static constexpr int MAX_NESTING = 256;
+
   /**
    * @brief Parse a filter expression string into FilterSpec.
    *
@@ -39,6 +47,35 @@ public:
    */
   static std::optional<FilterSpec> parse_filter(std::string_view expr) noexcept;
 
+  /**
+   * @brief Parse a boolean filter expression into a FilterExpr tree.
+   *
+   * Grammar (keywords are uppercase and whitespace-delimited):
+   * - expr  := and ( OR and )*
+   * - and   := unary ( AND unary )*
+   * - unary := NOT unary | "(" expr ")" | term
+   * - term  := field op value | field IN "(" value ( "," value )* ")"
+   *
+   * Values run until the next AND/OR keyword (or the closing parenthesis of an
+   * enclosing group) and may contain spaces; double-quote a value to use the
+   * keywords, parentheses or commas literally (`title="Fix (login) AND deploy"`).
+   * Fields and operators are the same as for parse_filter. NOTs and groups
+   * nest at most MAX_NESTING levels deep.
+   *
+   * Examples:
+   * - "priority>=3"
+   * - "status=todo AND (priority>=4 OR assignee=john)"
+   * - "NOT status IN (done, cancelled)"
+   *
+   * @pre `expr` is a non-empty filter expression string.
+   * @post Returns the expression tree if parse succeeds, std::nullopt if invalid.
+   * @throws none (returns nullopt on error).
+   *
+   * @param expr The filter expression to parse.
+   * @return Optional FilterExpr (nullopt if parse fails).
+   */
+  static std::optional<FilterExpr> parse_filter_expr(std::string_view expr) noexcept;
+
   /**
    * @brief Parse a sort expression string into SortSpec.
    *
@@ -64,6 +101,87 @@ public:
    */
   static std::optional<SortSpec> parse_sort(std::string_view expr) noexcept;
 
+  /**
+   * @brief Parse a comma-separated list of sort keys, primary key first.
+   *
+   * Each key has the `parse_sort` format; later keys break ties of earlier ones.
+   *
+   * Examples:
+   * - "priority desc, due_date asc, id"
+   * - "status"
+   *
+   * @pre `expr` is a non-empty sort expression string.
+   * @post Returns the keys in order if every key parses, std::nullopt otherwise.
+   * @throws none (returns nullopt on error).
+   *
+   * @param expr The sort key list to parse.
+   * @return Optional list of SortSpec (nullopt if parse fails).
+   */
+  static std::optional<std::vector<SortSpec>> parse_sort_keys(std::string_view expr) noexcept;
+
+  /**
+   * @brief Parse the field of `stats --group-by`.
+   *
+   * Supported fields: status, assignee, tag, created_month.
+   *
+   * @post Returns the GroupField, std::nullopt (reported to std::cerr) for an unknown field.
+   * @throws none (returns nullopt on error).
+   */
+  static std::optional<GroupField> parse_group_field(std::string_view field) noexcept;
+
+  /**
+   * @brief Parse the comma-separated aggregate list of `stats --agg`.
+   *
+   * Supported aggregates: count, avg_priority, overdue, min_due, max_due.
+   *
+   * Examples:
+   * - "count, avg_priority"
+   * - "overdue,min_due,max_due"
+   *
+   * @post Returns the aggregates in order (repeats dropped) if every name parses, std::nullopt otherwise.
+   * @throws none (returns nullopt on error).
+   */
+  static std::optional<std::vector<Aggregate>> parse_aggregates(std::string_view expr) noexcept;
+
+  /**
+   * @brief The canonical spelling of `expr`.
+   *
+   * Every value is double-quoted (escaping `"` and `\`) and every nested AND/OR
+   * group parenthesized, so expressions that parse to the same tree are spelled
+   * alike whatever their whitespace or quoting.
+   *
+   * @post `parse_filter_expr(to_string(expr))` returns a tree equal to `expr`.
+   * @throws std::bad_alloc if the string cannot be allocated.
+   */
+  static std::string to_string(const FilterExpr &expr);
+
+  /**
+   * @brief The canonical spelling of `keys`: "field" or "field desc", joined by ", ".
+   * @post `parse_sort_keys(to_string(keys))` returns `keys`.
+   * @throws std::bad_alloc if the string cannot be allocated.
+   */
+  static std::string to_string(const std::vector<SortSpec> &keys);
+
+  /// Task fields the terms of `expr` compare (see TaskFields).
+  static TaskFields fields_of(const FilterExpr &expr) noexcept;
+
+  /// Task fields `keys` sort on.
+  static TaskFields fields_of(const std::vector<SortSpec> &keys) noexcept;
+
+  /// Task field `stats --group-by field` groups on.
+  static TaskFields fields_of(GroupField field) noexcept;
+
+  /**
+   * @brief Task fields replaying `action` reads.
+   *
+   * Filters and sorts read the fields they name, `find-by-tag` the tags and
+   * `search` the title and description.
+   *
+   * @post Every field if the payload does not parse.
+   * @throws none
+   */
+  static TaskFields fields_of(const ViewAction &action) noexcept;
+
 private:
   /// Parse field name to FilterField enum
   static std::optional<FilterField> parse_filter_field(std::string_view field) noexcept;
@@ -73,4 +191,13 @@ private:
 
   /// Detect operator in expression and return {op, position}
   static std::optional<std::pair<FilterOp, size_t>> find_operator(std::string_view expr) noexcept;
+
+  // Recursive-descent helpers for parse_filter_expr; each consumes its input from the front of `rest`
+  static std::optional<FilterExpr> parse_or(std::string_view &rest, int depth);
+  static std::optional<FilterExpr> parse_and(std::string_view &rest, int depth);
+  static std::optional<FilterExpr> parse_unary(std::string_view &rest, int depth);
+  static std::optional<FilterExpr> parse_term(std::string_view &rest, int depth);
+
+  /// Consume a (possibly quoted) value; unquoted values stop at AND/OR, or at ")" / "," when `in_list`/`depth>0`
+  static std::optional<std::string> parse_value(std::string_view &rest, int depth, bool in_list);
 };
@@ -0,0 +1,346 @@
+#include "core/filter_compiler.hpp"
+#include "core/date.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Post: `value` as a whole base-10 integer; a partial match ("4abc") does not parse
+std::int32_t int_literal(std::string_view value) {
+  std::int32_t parsed = 0;
+  const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+  if (ec == std::errc::result_out_of_range)
+    throw std::out_of_range("integer out of range: " + std::string(value));
+  if (ec != std::errc() || end != value.data() + value.size())
+    throw std::invalid_argument("not an integer: " + std::string(value));
+  return parsed;
+}
+
+// Instantiate `Predicate<op>{args...}` for any of the six operators
+template <template <FilterOp> class Predicate, typename... Args>
+CompiledFilter with_any_op(FilterOp op, Args... args) {
+  switch (op) {
+  case FilterOp::Equal:
+    return Predicate<FilterOp::Equal>{args...};
+  case FilterOp::NotEqual:
+    return Predicate<FilterOp::NotEqual>{args...};
+  case FilterOp::GreaterThan:
+    return Predicate<FilterOp::GreaterThan>{args...};
+  case FilterOp::GreaterThanOrEqual:
+    return Predicate<FilterOp::GreaterThanOrEqual>{args...};
+  case FilterOp::LessThan:
+    return Predicate<FilterOp::LessThan>{args...};
+  case FilterOp::LessThanOrEqual:
+    return Predicate<FilterOp::LessThanOrEqual>{args...};
+  }
+  return ConstantPredicate<false>{};
+}
+
+// Instantiate `Predicate<op>{args...}` for == and !=; ordering operators match nothing
+template <template <FilterOp> class Predicate, typename... Args>
+CompiledFilter with_equality_op(FilterOp op, Args... args) {
+  switch (op) {
+  case FilterOp::Equal:
+    return Predicate<FilterOp::Equal>{args...};
+  case FilterOp::NotEqual:
+    return Predicate<FilterOp::NotEqual>{args...};
+  default:
+    return ConstantPredicate<false>{};
+  }
+}
+
+// Default selectivities for columns without statistics
+constexpr double EQUAL_SELECTIVITY = 0.1;
+constexpr double RANGE_SELECTIVITY = 1.0 / 3.0;
+
+// Relative per-row costs: dense integer compare < set lookup < arena text compare
+constexpr double INT_COST = 1.0;
+constexpr double SET_COST = 2.0;
+constexpr double TEXT_COST = 4.0;
+
+double default_selectivity(FilterOp op) noexcept {
+  switch (op) {
+  case FilterOp::Equal:
+    return EQUAL_SELECTIVITY;
+  case FilterOp::NotEqual:
+    return 1.0 - EQUAL_SELECTIVITY;
+  default:
+    return RANGE_SELECTIVITY;
+  }
+}
+
+// Number of rows holding any value in a dictionary-coded column
+double present_rows(const StringDictionary &dictionary) noexcept {
+  double present = 0;
+  for (std::uint32_t code = 0; code < dictionary.size(); ++code) {
+    present += dictionary.count(code);
+  }
+  return present;
+}
+
+// Exact selectivity of `column == value` / `column != value` from dictionary counts
+double code_selectivity(const StringDictionary &dictionary, const FilterSpec &filter, double rows) noexcept {
+  auto code = dictionary.find(filter.value);
+  const double matching = code ? dictionary.count(*code) : 0.0;
+  switch (filter.op) {
+  case FilterOp::Equal:
+    return matching / rows;
+  case FilterOp::NotEqual:
+    return (present_rows(dictionary) - matching) / rows;
+  default:
+    return 0.0;
+  }
+}
+
+CompiledExpr make_leaf(FilterExprKind kind, CompiledFilter leaf, double selectivity, double cost) {
+  return CompiledExpr{kind, std::move(leaf), {}, std::clamp(selectivity, 0.0, 1.0), cost};
+}
+
+CompiledExpr compile_term(const FilterSpec &filter, const TaskColumns &columns) {
+  CompiledFilter leaf = compile_filter(filter, columns);
+  const double n = static_cast<double>(std::max<size_t>(columns.size(), 1));
+
+  if (std::holds_alternative<ConstantPredicate<true>>(leaf))
+    return make_leaf(FilterExprKind::Term, std::move(leaf), 1.0, 0.0);
+  if (std::holds_alternative<ConstantPredicate<false>>(leaf))
+    return make_leaf(FilterExprKind::Term, std::move(leaf), 0.0, 0.0);
+
+  switch (filter.field) {
+  case FilterField::Id:
+    if (filter.op == FilterOp::Equal || filter.op == FilterOp::NotEqual) {
+      // IDs are unique
+      const double selectivity = filter.op == FilterOp::Equal ? 1.0 / n : 1.0 - 1.0 / n;
+      return make_leaf(FilterExprKind::Term, std::move(leaf), selectivity, INT_COST);
+    }
+    return make_leaf(FilterExprKind::Term, std::move(leaf), default_selectivity(filter.op), INT_COST);
+  case FilterField::Status:
+    return make_leaf(FilterExprKind::Term, std::move(leaf), code_selectivity(columns.statuses, filter, n), INT_COST);
+  case FilterField::Assignee:
+    return make_leaf(FilterExprKind::Term, std::move(leaf), code_selectivity(columns.assignees, filter, n), INT_COST);
+  case FilterField::Title:
+  case FilterField::Description:
+    return make_leaf(FilterExprKind::Term, std::move(leaf), default_selectivity(filter.op), TEXT_COST);
+  case FilterField::CreatedDate:
+  case FilterField::DueDate:
+    // Day numbers or raw-string codes: either way a dense integer compare
+    if (!parse_iso_date(filter.value)) {
+      const StringDictionary &dictionary =
+          filter.field == FilterField::CreatedDate ? columns.created_dates : columns.due_dates;
+      return make_leaf(FilterExprKind::Term, std::move(leaf), code_selectivity(dictionary, filter, n), INT_COST);
+    }
+    return make_leaf(FilterExprKind::Term, std::move(leaf), default_selectivity(filter.op), INT_COST);
+  default:
+    return make_leaf(FilterExprKind::Term, std::move(leaf), default_selectivity(filter.op), INT_COST);
+  }
+}
+
+// `field IN (...)` is `field = v1 OR field = v2 ...`; coded and integer fields get a set lookup
+CompiledExpr compile_in(const FilterExpr &expr, const TaskColumns &columns) {
+  if (expr.terms.empty())
+    return make_leaf(FilterExprKind::In, ConstantPredicate<false>{}, 0.0, 0.0);
+
+  const double n = static_cast<double>(std::max<size_t>(columns.size(), 1));
+  const FilterField field = expr.terms.front().field;
+
+  if (field == FilterField::Status || field == FilterField::Assignee) {
+    const StringDictionary &dictionary = field == FilterField::Status ? columns.statuses : columns.assignees;
+    CodeSetPredicate predicate{field == FilterField::Status ? columns.status.data() : columns.assignee.data(),
+                               std::vector<bool>(dictionary.size(), false)};
+    double matching = 0;
+    for (const auto &term : expr.terms) {
+      auto code = dictionary.find(term.value);
+      if (code && !predicate.members[*code]) {
+        predicate.members[*code] = true;
+        matching += dictionary.count(*code);
+      }
+    }
+    return make_leaf(FilterExprKind::In, std::move(predicate), matching / n, SET_COST);
+  }
+
+  if (field == FilterField::Id || field == FilterField::Priority) {
+    IntSetPredicate predicate{field == FilterField::Id ? columns.id.data() : columns.priority.data(), {}};
+    for (const auto &term : expr.terms) {
+      predicate.members.push_back(int_literal(term.value));
+    }
+    std::sort(predicate.members.begin(), predicate.members.end());
+    predicate.members.erase(std::unique(predicate.members.begin(), predicate.members.end()), predicate.members.end());
+
+    const double per_value = field == FilterField::Id ? 1.0 / n : EQUAL_SELECTIVITY;
+    const double selectivity = per_value * static_cast<double>(predicate.members.size());
+    return make_leaf(FilterExprKind::In, std::move(predicate), selectivity, SET_COST);
+  }
+
+  std::vector<FilterExpr> alternatives;
+  for (const auto &term : expr.terms) {
+    alternatives.push_back(FilterExpr::term(term));
+  }
+  return compile_expr(FilterExpr::any_of(std::move(alternatives)), columns);
+}
+} // anonymous namespace
+
+CompiledFilter compile_filter(const FilterSpec &filter, const TaskColumns &columns) {
+  const std::string_view value = filter.value;
+
+  switch (filter.field) {
+  case FilterField::Id:
+    return with_any_op<IntColumnPredicate>(filter.op, columns.id.data(), int_literal(value));
+  case FilterField::Priority:
+    return with_any_op<IntColumnPredicate>(filter.op, columns.priority.data(), int_literal(value));
+  case FilterField::Status:
+    // A status that was never interned matches no row
+    return with_equality_op<CodeColumnPredicate>(
+        filter.op, columns.status.data(), columns.statuses.find(value).value_or(TaskColumns::NO_VALUE));
+  case FilterField::Assignee:
+    return with_equality_op<CodeColumnPredicate>(
+        filter.op, columns.assignee.data(), columns.assignees.find(value).value_or(TaskColumns::NO_VALUE));
+  case FilterField::Title:
+    return with_equality_op<TextColumnPredicate>(filter.op, &columns, columns.title.data(), value);
+  case FilterField::Description:
+    return with_equality_op<TextColumnPredicate>(filter.op, &columns, columns.description.data(), value);
+  case FilterField::CreatedDate:
+  case FilterField::DueDate: {
+    // A date compares as a day number; any other value can only equal the raw string
+    const bool created = filter.field == FilterField::CreatedDate;
+    if (auto day = parse_iso_date(value)) {
+      const int32_t *days = (created ? columns.created_day : columns.due_day).data();
+      return with_any_op<DateColumnPredicate>(filter.op, days, *day);
+    }
+    const StringDictionary &dictionary = created ? columns.created_dates : columns.due_dates;
+    return with_equality_op<CodeColumnPredicate>(filter.op,
+                                                 (created ? columns.created_date : columns.due_date).data(),
+                                                 dictionary.find(value).value_or(TaskColumns::NO_VALUE));
+  }
+  default:
+    return ConstantPredicate<true>{};
+  }
+}
+
+// ============================================================================
+// Compiled Expressions
+// ============================================================================
+
+bool CompiledExpr::operator()(std::uint32_t row) const noexcept {
+  switch (kind) {
+  case FilterExprKind::And:
+    for (const auto &child : children) {
+      if (!child(row))
+        return false;
+    }
+    return true;
+  case FilterExprKind::Or:
+    for (const auto &child : children) {
+      if (child(row))
+        return true;
+    }
+    return false;
+  case FilterExprKind::Not:
+    return !children.front()(row);
+  default:
+    return std::visit([row](const auto &predicate) { return predicate(row); }, leaf);
+  }
+}
+
+bool CompiledExpr::maskable() const noexcept {
+  if (kind == FilterExprKind::And || kind == FilterExprKind::Or || kind == FilterExprKind::Not)
+    return std::all_of(children.begin(), children.end(), [](const CompiledExpr &child) { return child.maskable(); });
+  return std::visit(
+      []<typename Predicate>(const Predicate &) {
+        if constexpr (MaskablePredicate<Predicate>)
+          return Predicate::maskable();
+        else
+          return false;
+      },
+      leaf);
+}
+
+void CompiledExpr::mask(std::uint32_t first, std::uint32_t count, std::uint64_t *words) const {
+  const size_t used = (count + 63) / 64;
+  switch (kind) {
+  case FilterExprKind::And:
+  case FilterExprKind::Or: {
+    const bool is_and = kind == FilterExprKind::And;
+    children.front().mask(first, count, words);
+    std::vector<std::uint64_t> scratch(used);
+    for (size_t i = 1; i < children.size(); ++i) {
+      // Nothing left for the other children of an AND to reject
+      if (is_and && std::all_of(words, words + used, [](std::uint64_t word) { return word == 0; }))
+        return;
+      children[i].mask(first, count, scratch.data());
+      for (size_t w = 0; w < used; ++w) {
+        words[w] = is_and ? words[w] & scratch[w] : words[w] | scratch[w];
+      }
+    }
+    return;
+  }
+  case FilterExprKind::Not:
+    children.front().mask(first, count, words);
+    for (size_t w = 0; w < used; ++w) {
+      words[w] = ~words[w];
+    }
+    if (count % 64 != 0)
+      words[used - 1] &= (std::uint64_t{1} << (count % 64)) - 1;
+    return;
+  default:
+    std::visit(
+        [first, count, words]<typename Predicate>(const Predicate &predicate) {
+          if constexpr (MaskablePredicate<Predicate>)
+            predicate.mask(first, count, words);
+        },
+        leaf);
+  }
+}
+
+CompiledExpr compile_expr(const FilterExpr &expr, const TaskColumns &columns) {
+  switch (expr.kind) {
+  case FilterExprKind::Term:
+    return compile_term(expr.terms.front(), columns);
+
+  case FilterExprKind::In:
+    return compile_in(expr, columns);
+
+  case FilterExprKind::Not: {
+    CompiledExpr child = compile_expr(expr.children.front(), columns);
+    CompiledExpr node{FilterExprKind::Not, {}, {}, 1.0 - child.selectivity, child.cost};
+    node.children.push_back(std::move(child));
+    return node;
+  }
+
+  case FilterExprKind::And:
+  case FilterExprKind::Or: {
+    const bool is_and = expr.kind == FilterExprKind::And;
+    CompiledExpr node{expr.kind, {}, {}, is_and ? 1.0 : 0.0, 0.0};
+    for (const auto &child : expr.children) {
+      node.children.push_back(compile_expr(child, columns));
+    }
+
+    // AND: run first the child that rejects the most rows per unit of cost ((1 - s) / c, descending).
+    // OR: run first the child that accepts the most rows per unit of cost (s / c, descending).
+    // Zero-cost children (constants) have no ratio: they go first, the most decisive of them leading.
+    // The rest compare cross-multiplied, which is exact for positive costs; ties keep their order.
+    std::stable_sort(
+        node.children.begin(), node.children.end(), [is_and](const CompiledExpr &a, const CompiledExpr &b) {
+          const double decisive_a = is_and ? 1.0 - a.selectivity : a.selectivity;
+          const double decisive_b = is_and ? 1.0 - b.selectivity : b.selectivity;
+          const bool free_a = a.cost == 0.0;
+          const bool free_b = b.cost == 0.0;
+          if (free_a != free_b)
+            return free_a;
+          if (free_a)
+            return decisive_a > decisive_b;
+          return decisive_a * b.cost > decisive_b * a.cost;
+        });
+
+    // Expected cost: each child only runs on rows the previous children did not decide
+    double undecided = 1.0;
+    for (const auto &child : node.children) {
+      node.cost += undecided * child.cost;
+      undecided *= is_and ? child.selectivity : 1.0 - child.selectivity;
+    }
+    node.selectivity = is_and ? undecided : 1.0 - undecided;
+    return node;
+  }
+  }
+  return make_leaf(FilterExprKind::Term, ConstantPredicate<true>{}, 1.0, 0.0);
+}
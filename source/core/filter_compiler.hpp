@@ -0,0 +1,244 @@
+#pragma once
+#include "database.hpp"
+#include "date.hpp"
+#include "filter_expr.hpp"
+#include "scan_kernels.hpp"
+#include "task_columns.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// ============================================================================
+// Compiled Filter Predicates
+// ============================================================================
+//
+// A FilterSpec is compiled once per apply_filter call: its value is parsed up
+// front and the (field, op) pair selects one of the concrete predicate types
+// below. Each type is a small, non-allocating functor over row ordinals whose
+// comparison is fixed at compile time, so a loop instantiated for it (via
+// std::visit on CompiledFilter) has no per-row dispatch or string copies.
+// Fixed-width column predicates can also `mask` a block of consecutive rows
+// with the vectorized scan kernels, which dense chunks of a view use instead.
+
+/// Comparison functor for a FilterOp, resolved at compile time
+template <FilterOp Op>
+struct CompareOp {
+  template <typename A, typename B>
+  constexpr bool operator()(const A &a, const B &b) const noexcept {
+    if constexpr (Op == FilterOp::Equal)
+      return a == b;
+    else if constexpr (Op == FilterOp::NotEqual)
+      return a != b;
+    else if constexpr (Op == FilterOp::GreaterThan)
+      return a > b;
+    else if constexpr (Op == FilterOp::GreaterThanOrEqual)
+      return a >= b;
+    else if constexpr (Op == FilterOp::LessThan)
+      return a < b;
+    else
+      return a <= b;
+  }
+};
+
+/// ScanOp of a FilterOp
+constexpr ScanOp scan_op(FilterOp op) noexcept {
+  switch (op) {
+  case FilterOp::Equal:
+    return ScanOp::Equal;
+  case FilterOp::NotEqual:
+    return ScanOp::NotEqual;
+  case FilterOp::GreaterThan:
+    return ScanOp::Greater;
+  case FilterOp::GreaterThanOrEqual:
+    return ScanOp::GreaterEqual;
+  case FilterOp::LessThan:
+    return ScanOp::Less;
+  default:
+    return ScanOp::LessEqual;
+  }
+}
+
+/**
+ * @brief A predicate that can also test a block of consecutive rows at once.
+ *
+ * `mask(first, count, words)` writes the match bits of rows `[first, first + count)`
+ * as ScanKernels::compare does; it is only called when `maskable()` holds.
+ */
+template <typename P>
+concept MaskablePredicate = requires(const P &predicate, std::uint32_t row, std::uint64_t *words) {
+  { predicate.maskable() } -> std::convertible_to<bool>;
+  predicate.mask(row, row, words);
+};
+
+/// Integer column compared against a constant (id, priority)
+template <FilterOp Op>
+struct IntColumnPredicate {
+  const std::int32_t *column;
+  std::int32_t target;
+
+  bool operator()(std::uint32_t row) const noexcept { return CompareOp<Op>{}(column[row], target); }
+
+  static constexpr bool maskable() noexcept { return true; }
+  void mask(std::uint32_t first, std::uint32_t count, std::uint64_t *words) const noexcept {
+    scan_kernels().compare(column + first, count, scan_op(Op), target, std::nullopt, words);
+  }
+};
+
+/// Day-number column compared against a date; a missing or invalid date (`NO_DATE`) never matches
+template <FilterOp Op>
+struct DateColumnPredicate {
+  const std::int32_t *column;
+  std::int32_t target;
+
+  bool operator()(std::uint32_t row) const noexcept {
+    return column[row] != NO_DATE && CompareOp<Op>{}(column[row], target);
+  }
+
+  static constexpr bool maskable() noexcept { return true; }
+  void mask(std::uint32_t first, std::uint32_t count, std::uint64_t *words) const noexcept {
+    scan_kernels().compare(column + first, count, scan_op(Op), target, NO_DATE, words);
+  }
+};
+
+/// Dictionary-coded column compared for (in)equality; a missing value never matches
+template <FilterOp Op>
+struct CodeColumnPredicate {
+  const std::uint32_t *column;
+  std::uint32_t target;
+
+  bool operator()(std::uint32_t row) const noexcept {
+    return column[row] != TaskColumns::NO_VALUE && CompareOp<Op>{}(column[row], target);
+  }
+
+  static constexpr bool maskable() noexcept { return true; }
+  void mask(std::uint32_t first, std::uint32_t count, std::uint64_t *words) const noexcept {
+    scan_kernels().compare(code_lanes(column + first),
+                           count,
+                           scan_op(Op),
+                           static_cast<std::int32_t>(target),
+                           static_cast<std::int32_t>(TaskColumns::NO_VALUE),
+                           words);
+  }
+};
+
+/// Arena text column compared for (in)equality; a missing optional never matches
+template <FilterOp Op>
+struct TextColumnPredicate {
+  const TaskColumns *columns;
+  const TaskColumns::TextSpan *column;
+  std::string_view target;
+
+  bool operator()(std::uint32_t row) const noexcept {
+    return column[row].length != TaskColumns::NO_VALUE && CompareOp<Op>{}(columns->text(column[row]), target);
+  }
+};
+
+/// Dictionary-coded column tested for membership in a set of codes (`IN` lists)
+struct CodeSetPredicate {
+  const std::uint32_t *column;
+  std::vector<bool> members; ///< indexed by code; codes past the end are not members
+
+  bool operator()(std::uint32_t row) const noexcept {
+    const std::uint32_t code = column[row];
+    return code < members.size() && members[code];
+  }
+};
+
+/// Integer column tested for membership in a sorted set of values (`IN` lists)
+struct IntSetPredicate {
+  const std::int32_t *column;
+  std::vector<std::int32_t> members; ///< sorted, unique
+
+  bool operator()(std::uint32_t row) const noexcept {
+    return std::binary_search(members.begin(), members.end(), column[row]);
+  }
+};
+
+/// Predicate with a fixed result (unsupported field/op combinations, unfiltered fields)
+template <bool Result>
+struct ConstantPredicate {
+  bool operator()(std::uint32_t) const noexcept { return Result; }
+
+  static constexpr bool maskable() noexcept { return true; }
+  void mask(std::uint32_t, std::uint32_t count, std::uint64_t *words) const noexcept {
+    std::fill_n(words, count / 64, Result ? ~std::uint64_t{0} : 0);
+    if (count % 64 != 0)
+      words[count / 64] = Result ? (std::uint64_t{1} << (count % 64)) - 1 : 0;
+  }
+};
+
+/// One of the concrete predicate types; visit it once and run the specialized loop
+using CompiledFilter = std::variant<ConstantPredicate<true>,
+                                    ConstantPredicate<false>,
+                                    IntColumnPredicate<FilterOp::Equal>,
+                                    IntColumnPredicate<FilterOp::NotEqual>,
+                                    IntColumnPredicate<FilterOp::GreaterThan>,
+                                    IntColumnPredicate<FilterOp::GreaterThanOrEqual>,
+                                    IntColumnPredicate<FilterOp::LessThan>,
+                                    IntColumnPredicate<FilterOp::LessThanOrEqual>,
+                                    DateColumnPredicate<FilterOp::Equal>,
+                                    DateColumnPredicate<FilterOp::NotEqual>,
+                                    DateColumnPredicate<FilterOp::GreaterThan>,
+                                    DateColumnPredicate<FilterOp::GreaterThanOrEqual>,
+                                    DateColumnPredicate<FilterOp::LessThan>,
+                                    DateColumnPredicate<FilterOp::LessThanOrEqual>,
+                                    CodeColumnPredicate<FilterOp::Equal>,
+                                    CodeColumnPredicate<FilterOp::NotEqual>,
+                                    TextColumnPredicate<FilterOp::Equal>,
+                                    TextColumnPredicate<FilterOp::NotEqual>,
+                                    CodeSetPredicate,
+                                    IntSetPredicate>;
+
+/**
+ * @brief Compile `filter` against the given storage.
+ *
+ * @post Returns a predicate over row ordinals equivalent to `filter`.
+ * @throws std::invalid_argument / std::out_of_range if a numeric value does not parse.
+ * @note The result references `filter.value` and `columns`; it must not outlive them.
+ */
+CompiledFilter compile_filter(const FilterSpec &filter, const TaskColumns &columns);
+
+// ============================================================================
+// Compiled Filter Expressions
+// ============================================================================
+//
+// A FilterExpr is compiled into a tree whose leaves are CompiledFilter
+// predicates. Every node carries an estimated selectivity (fraction of rows
+// that match) and per-row cost; AND/OR children are ordered so that the
+// cheapest, most decisive child runs first and evaluation short-circuits.
+// The whole tree is then evaluated once per row in a single pass over the view.
+
+/**
+ * @brief Compiled boolean filter expression.
+ *
+ * - Term/In: `leaf` is the predicate, `children` is empty.
+ * - And/Or: `children` ordered for short-circuiting.
+ * - Not: `children` holds exactly one node.
+ */
+struct CompiledExpr {
+  FilterExprKind kind;
+  CompiledFilter leaf;
+  std::vector<CompiledExpr> children;
+  double selectivity; ///< estimated fraction of rows matching, in [0, 1]
+  double cost;        ///< estimated relative per-row evaluation cost
+
+  bool operator()(std::uint32_t row) const noexcept;
+
+  /// Whether every leaf is a MaskablePredicate, so the whole tree can `mask` a block of rows.
+  bool maskable() const noexcept;
+
+  /// Match bits of rows `[first, first + count)`, combining the leaves' masks word by word. @pre `maskable()`.
+  void mask(std::uint32_t first, std::uint32_t count, std::uint64_t *words) const;
+};
+
+/**
+ * @brief Compile `expr` against the given storage.
+ *
+ * @post Returns a tree equivalent to `expr` with AND/OR children reordered for short-circuiting.
+ * @throws std::invalid_argument / std::out_of_range if a numeric value does not parse.
+ * @note The result references the values in `expr` and `columns`; it must not outlive them.
+ */
+CompiledExpr compile_expr(const FilterExpr &expr, const TaskColumns &columns);
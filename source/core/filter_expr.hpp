@@ -0,0 +1,55 @@
+#pragma once
+#include "database.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Node kinds of a boolean filter expression
+enum class FilterExprKind {
+  Term, ///< single `field op value` comparison
+  In,   ///< `field IN (v1, v2, ...)`
+  And,  ///< all children match
+  Or,   ///< at least one child matches
+  Not   ///< the single child does not match
+};
+
+/**
+ * @brief Boolean filter expression tree.
+ *
+ * Produced by ExpressionParser::parse_filter_expr from expressions such as
+ * `status IN (todo, in-progress) AND NOT (priority<3 OR assignee=bob)`.
+ *
+ * - Term: `terms` holds exactly one FilterSpec.
+ * - In: `terms` holds one `field = value` FilterSpec per listed value.
+ * - And/Or: `children` holds two or more sub-expressions.
+ * - Not: `children` holds exactly one sub-expression.
+ */
+struct FilterExpr {
+  FilterExprKind kind;
+  std::vector<FilterSpec> terms;
+  std::vector<FilterExpr> children;
+
+  static FilterExpr term(FilterSpec spec) { return FilterExpr{FilterExprKind::Term, {std::move(spec)}, {}}; }
+
+  static FilterExpr in(FilterField field, const std::vector<std::string> &values) {
+    FilterExpr expr{FilterExprKind::In, {}, {}};
+    for (const auto &value : values) {
+      expr.terms.emplace_back(field, FilterOp::Equal, value);
+    }
+    return expr;
+  }
+
+  static FilterExpr all_of(std::vector<FilterExpr> children) {
+    return FilterExpr{FilterExprKind::And, {}, std::move(children)};
+  }
+
+  static FilterExpr any_of(std::vector<FilterExpr> children) {
+    return FilterExpr{FilterExprKind::Or, {}, std::move(children)};
+  }
+
+  static FilterExpr negate(FilterExpr child) {
+    FilterExpr expr{FilterExprKind::Not, {}, {}};
+    expr.children.push_back(std::move(child));
+    return expr;
+  }
+};
@@ -0,0 +1,215 @@
+#include "core/profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+namespace {
+
+double milliseconds(std::chrono::nanoseconds duration) noexcept {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double microseconds(std::chrono::nanoseconds duration) noexcept {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+// Post: `bytes` with a binary unit, e.g. "12.3 MiB"
+std::string format_bytes(std::uint64_t bytes) {
+  static constexpr const char *UNITS[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  auto value = static_cast<double>(bytes);
+  size_t unit = 0;
+  while (value >= 1024 && unit + 1 < std::size(UNITS)) {
+    value /= 1024;
+    ++unit;
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", value, UNITS[unit]);
+  return text;
+}
+
+// Post: `text` written as a JSON string literal
+void write_json_string(std::ostream &out, std::string_view text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      out << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF] << "0123456789abcdef"[c & 0xF];
+    else
+      out << c;
+  }
+  out << '"';
+}
+} // anonymous namespace
+
+Profiler &Profiler::instance() noexcept {
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::start(bool trace) {
+  const std::lock_guard lock(mutex_);
+  trace_ = trace;
+  phases_.clear();
+  phase_index_.clear();
+  counters_.clear();
+  events_.clear();
+  session_begin_ = Clock::now();
+  session_end_ = session_begin_;
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stop() noexcept {
+  const std::lock_guard lock(mutex_);
+  if (enabled_.exchange(false, std::memory_order_relaxed))
+    session_end_ = Clock::now();
+}
+
+void Profiler::record(std::string_view name, Clock::time_point begin, Clock::time_point end, Allocations allocated) {
+  const std::lock_guard lock(mutex_);
+  if (!enabled())
+    return; // stopped while the scope ran
+
+  auto [it, inserted] = phase_index_.try_emplace(name, phases_.size());
+  if (inserted)
+    phases_.push_back(Phase{name, 0, {}, 0, 0, begin});
+  Phase &phase = phases_[it->second];
+  ++phase.calls;
+  phase.total += end - begin;
+  phase.allocations += allocated.count;
+  phase.allocated_bytes += allocated.bytes;
+  phase.first_begin = std::min(phase.first_begin, begin);
+
+  if (trace_)
+    events_.push_back(Event{name, begin, end, thread_number()});
+}
+
+void Profiler::count(std::string_view name, std::uint64_t n) {
+  const std::lock_guard lock(mutex_);
+  if (!enabled())
+    return;
+  auto it = std::find_if(counters_.begin(), counters_.end(), [name](const auto &counter) { return counter.first == name; });
+  if (it == counters_.end())
+    counters_.emplace_back(name, n);
+  else
+    it->second += n;
+}
+
+std::vector<Profiler::Phase> Profiler::phases() const {
+  std::vector<Phase> phases;
+  {
+    const std::lock_guard lock(mutex_);
+    phases = phases_;
+  }
+  // Scopes are recorded when they end, so enclosing phases are moved back before the phases they contain
+  std::stable_sort(
+      phases.begin(), phases.end(), [](const Phase &a, const Phase &b) { return a.first_begin < b.first_begin; });
+  return phases;
+}
+
+std::vector<std::pair<std::string_view, std::uint64_t>> Profiler::counters() const {
+  const std::lock_guard lock(mutex_);
+  return counters_;
+}
+
+void Profiler::report(std::ostream &out) const {
+  Clock::time_point begin;
+  Clock::time_point end;
+  {
+    const std::lock_guard lock(mutex_);
+    begin = session_begin_;
+    end = enabled() ? Clock::now() : session_end_;
+  }
+  const auto wall = end - begin;
+  const auto phase_list = phases();
+  const auto counter_list = counters();
+
+  size_t name_width = 5;
+  for (const auto &phase : phase_list) {
+    name_width = std::max(name_width, phase.name.size());
+  }
+  for (const auto &counter : counter_list) {
+    name_width = std::max(name_width, counter.first.size());
+  }
+
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::fixed << std::setprecision(2);
+  out << "Profile: " << milliseconds(wall) << " ms wall (phase times are inclusive)\n";
+  out << std::left << std::setw(static_cast<int>(name_width + 2)) << "phase" << std::right << std::setw(8) << "calls"
+      << std::setw(12) << "ms" << std::setw(9) << "% wall";
+  if (counts_allocations())
+    out << std::setw(12) << "allocs" << std::setw(14) << "allocated";
+  out << "\n";
+  for (const auto &phase : phase_list) {
+    const double share =
+        wall.count() > 0 ? 100.0 * static_cast<double>(phase.total.count()) / static_cast<double>(wall.count()) : 0.0;
+    out << std::left << std::setw(static_cast<int>(name_width + 2)) << phase.name << std::right << std::setw(8)
+        << phase.calls << std::setw(12) << milliseconds(phase.total) << std::setw(8) << std::setprecision(1) << share
+        << "%" << std::setprecision(2);
+    if (counts_allocations())
+      out << std::setw(12) << phase.allocations << std::setw(14) << format_bytes(phase.allocated_bytes);
+    out << "\n";
+  }
+  if (!counter_list.empty()) {
+    out << std::left << std::setw(static_cast<int>(name_width + 2)) << "counter" << std::right << std::setw(8)
+        << "value" << "\n";
+    for (const auto &[name, value] : counter_list) {
+      out << std::left << std::setw(static_cast<int>(name_width + 2)) << name << std::right << std::setw(8) << value
+          << "\n";
+    }
+  }
+  if (!compiled_in())
+    out << "(built without TASKPROC_PROFILING: no phases were instrumented)\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void Profiler::write_trace(std::ostream &out) const {
+  const std::lock_guard lock(mutex_);
+  const Clock::time_point end = enabled() ? Clock::now() : session_end_;
+
+  // Complete ("X") events per scope, then one counter ("C") event per counter at the end of the session
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::fixed << std::setprecision(3);
+  out << "{\"traceEvents\":[";
+  const char *separator = "\n";
+  for (const auto &event : events_) {
+    out << separator << "{\"name\":";
+    write_json_string(out, event.name);
+    out << ",\"cat\":\"taskproc\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+        << ",\"ts\":" << microseconds(event.begin - session_begin_) << ",\"dur\":" << microseconds(event.end - event.begin)
+        << "}";
+    separator = ",\n";
+  }
+  for (const auto &[name, value] : counters_) {
+    out << separator << "{\"name\":";
+    write_json_string(out, name);
+    out << ",\"cat\":\"taskproc\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << microseconds(end - session_begin_)
+        << ",\"args\":{\"value\":" << value << "}}";
+    separator = ",\n";
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+std::uint32_t Profiler::thread_number() noexcept {
+  static std::atomic<std::uint32_t> next{0};
+  thread_local const std::uint32_t number = next.fetch_add(1, std::memory_order_relaxed);
+  return number;
+}
+
+ScopedTimer::~ScopedTimer() {
+  if (!active_)
+    return;
+  const auto end = Profiler::Clock::now();
+  const auto allocated = Profiler::Allocations::of_this_thread();
+  try {
+    Profiler::instance().record(
+        name_, begin_, end, {allocated.count - allocated_.count, allocated.bytes - allocated_.bytes});
+  } catch (const std::exception &) {
+    // A sample lost to a failed allocation must not escape a destructor
+  }
+}
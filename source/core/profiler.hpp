@@ -0,0 +1,168 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Process-wide collector of scoped phase timings and counters behind `--profile`.
+ *
+ * Hot paths are instrumented with TASKPROC_PROFILE_SCOPE("phase") and
+ * TASKPROC_PROFILE_COUNT("counter", n). With the TASKPROC_PROFILING build
+ * option off those macros expand to nothing, so no instrumentation remains;
+ * with it on, a disabled profiler costs one relaxed atomic load per scope.
+ *
+ * A phase aggregates every scope of the same name: calls, inclusive wall time,
+ * and, in builds with the TASKPROC_PROFILE_ALLOCATIONS option, the heap
+ * allocations made on the scope's own thread (work handed to the thread pool is
+ * timed by its caller but allocates on the workers). That option replaces the
+ * global `operator new`, so every allocation of the process pays for the count;
+ * it is off by default. Optionally
+ * every scope is also kept as a Chrome trace event ("chrome://tracing",
+ * Perfetto).
+ *
+ * @note Thread-safety: every member is thread-safe.
+ */
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Aggregate of every scope with one name
+  struct Phase {
+    std::string_view name;
+    std::uint64_t calls{0};
+    std::chrono::nanoseconds total{0}; ///< inclusive wall time, summed over calls
+    std::uint64_t allocations{0};      ///< heap allocations on the scope's thread
+    std::uint64_t allocated_bytes{0};
+    Clock::time_point first_begin{}; ///< start of the earliest call
+  };
+
+  /// Heap allocations made so far by the calling thread (zero unless counts_allocations())
+  struct Allocations {
+    std::uint64_t count{0};
+    std::uint64_t bytes{0};
+
+    static Allocations of_this_thread() noexcept;
+  };
+
+  /// True if the build has the instrumentation (the TASKPROC_PROFILING option).
+  static constexpr bool compiled_in() noexcept {
+#ifdef TASKPROC_PROFILING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// True if the build counts heap allocations (the TASKPROC_PROFILE_ALLOCATIONS option).
+  static constexpr bool counts_allocations() noexcept {
+#if defined(TASKPROC_PROFILING) && defined(TASKPROC_PROFILE_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// The process-wide profiler.
+  static Profiler &instance() noexcept;
+
+  /**
+   * @brief Discard what was collected and start collecting.
+   * @param trace Also keep one event per scope for `write_trace`.
+   */
+  void start(bool trace);
+
+  /// Stop collecting; what was collected stays readable.
+  void stop() noexcept;
+
+  bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /// Add one completed scope of `name` (a string literal) to its phase.
+  void record(std::string_view name, Clock::time_point begin, Clock::time_point end, Allocations allocated);
+
+  /// Add `n` to the counter `name` (a string literal).
+  void count(std::string_view name, std::uint64_t n);
+
+  /// Phases in order of their first call.
+  std::vector<Phase> phases() const;
+
+  /// Counters in order of their first increment.
+  std::vector<std::pair<std::string_view, std::uint64_t>> counters() const;
+
+  /// Print a table of the phases (calls, time, share of the session, allocations) and the counters.
+  void report(std::ostream &out) const;
+
+  /**
+   * @brief Write the collected scopes as Chrome trace-event JSON.
+   * @pre `start(true)` began the session (otherwise only the counters are written).
+   */
+  void write_trace(std::ostream &out) const;
+
+private:
+  struct Event {
+    std::string_view name;
+    Clock::time_point begin;
+    Clock::time_point end;
+    std::uint32_t thread;
+  };
+
+  std::atomic<bool> enabled_{false};
+  mutable std::mutex mutex_;
+  bool trace_{false};
+  Clock::time_point session_begin_{};
+  Clock::time_point session_end_{}; ///< when stopped
+  std::vector<Phase> phases_;                                 ///< in order of first call
+  std::unordered_map<std::string_view, size_t> phase_index_; ///< name -> position in phases_
+  std::vector<std::pair<std::string_view, std::uint64_t>> counters_;
+  std::vector<Event> events_;
+
+  /// Small stable number of the calling thread, for trace events
+  static std::uint32_t thread_number() noexcept;
+};
+
+/**
+ * @brief Times its own lifetime into the Profiler phase `name`, if profiling is enabled.
+ * @note Use through TASKPROC_PROFILE_SCOPE so that builds without profiling drop it.
+ */
+class ScopedTimer {
+public:
+  explicit ScopedTimer(std::string_view name) noexcept : name_(name), active_(Profiler::instance().enabled()) {
+    if (active_) {
+      allocated_ = Profiler::Allocations::of_this_thread();
+      begin_ = Profiler::Clock::now();
+    }
+  }
+
+  ~ScopedTimer();
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  std::string_view name_;
+  bool active_;
+  Profiler::Allocations allocated_;
+  Profiler::Clock::time_point begin_;
+};
+
+#define TASKPROC_PROFILE_CONCAT_(a, b) a##b
+#define TASKPROC_PROFILE_CONCAT(a, b) TASKPROC_PROFILE_CONCAT_(a, b)
+
+#ifdef TASKPROC_PROFILING
+/// Time the rest of the enclosing block as phase `name` (a string literal).
+#define TASKPROC_PROFILE_SCOPE(name) const ScopedTimer TASKPROC_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+/// Add `n` to the counter `name` (a string literal) if profiling is enabled.
+#define TASKPROC_PROFILE_COUNT(name, n)                                                                                \
+  do {                                                                                                                 \
+    if (Profiler::instance().enabled())                                                                                \
+      Profiler::instance().count(name, static_cast<std::uint64_t>(n));                                                 \
+  } while (0)
+#else
+#define TASKPROC_PROFILE_SCOPE(name) static_cast<void>(0)
+#define TASKPROC_PROFILE_COUNT(name, n) static_cast<void>(0)
+#endif
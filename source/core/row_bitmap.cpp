@@ -0,0 +1,358 @@
+#include "core/row_bitmap.hpp"
+#include <algorithm>
+#include <iterator>
+
+// ============================================================================
+// Containers
+// ============================================================================
+
+bool RowBitmap::Container::contains(std::uint16_t low) const noexcept {
+  switch (kind) {
+  case Kind::Array:
+    return std::binary_search(array.begin(), array.end(), low);
+  case Kind::Bitmap:
+    return (words[low >> 6] >> (low & 63)) & 1u;
+  case Kind::Full:
+    return low < cardinality;
+  }
+  return false;
+}
+
+std::uint16_t RowBitmap::Container::max() const noexcept {
+  switch (kind) {
+  case Kind::Array:
+    return array.back();
+  case Kind::Bitmap:
+    for (std::uint32_t w = WORDS; w-- > 0;) {
+      if (words[w] != 0)
+        return static_cast<std::uint16_t>((w << 6) + 63 - std::countl_zero(words[w]));
+    }
+    return 0;
+  case Kind::Full:
+    return static_cast<std::uint16_t>(cardinality - 1);
+  }
+  return 0;
+}
+
+std::vector<std::uint64_t> RowBitmap::to_words(const Container &c) {
+  std::vector<std::uint64_t> words(WORDS, 0);
+  switch (c.kind) {
+  case Kind::Array:
+    for (std::uint16_t low : c.array) {
+      words[low >> 6] |= std::uint64_t{1} << (low & 63);
+    }
+    break;
+  case Kind::Bitmap:
+    words = c.words;
+    break;
+  case Kind::Full:
+    std::fill_n(words.begin(), c.cardinality / 64, ~std::uint64_t{0});
+    if (c.cardinality % 64 != 0)
+      words[c.cardinality / 64] = (std::uint64_t{1} << (c.cardinality % 64)) - 1;
+    break;
+  }
+  return words;
+}
+
+RowBitmap::Container RowBitmap::from_array(std::uint16_t key, std::vector<std::uint16_t> array) {
+  Container c{key, Kind::Array, static_cast<std::uint32_t>(array.size()), {}, {}};
+  if (array.empty())
+    return c;
+
+  // A contiguous prefix needs no storage
+  if (array.back() == array.size() - 1) {
+    c.kind = Kind::Full;
+    return c;
+  }
+  if (array.size() > ARRAY_MAX) {
+    c.array = std::move(array);
+    return from_words(key, to_words(c));
+  }
+  c.array = std::move(array);
+  return c;
+}
+
+RowBitmap::Container RowBitmap::from_words(std::uint16_t key, std::vector<std::uint64_t> words) {
+  Container c{key, Kind::Bitmap, 0, {}, {}};
+  std::uint32_t highest = 0;
+  for (std::uint32_t w = 0; w < WORDS; ++w) {
+    if (words[w] != 0) {
+      c.cardinality += static_cast<std::uint32_t>(std::popcount(words[w]));
+      highest = (w << 6) + 63 - static_cast<std::uint32_t>(std::countl_zero(words[w]));
+    }
+  }
+
+  if (c.cardinality == 0) {
+    c.kind = Kind::Array;
+  } else if (highest + 1 == c.cardinality) {
+    c.kind = Kind::Full;
+  } else if (c.cardinality <= ARRAY_MAX) {
+    c.kind = Kind::Array;
+    c.array.reserve(c.cardinality);
+    for (std::uint32_t w = 0; w < WORDS; ++w) {
+      for (std::uint64_t word = words[w]; word != 0; word &= word - 1) {
+        c.array.push_back(static_cast<std::uint16_t>((w << 6) | std::countr_zero(word)));
+      }
+    }
+  } else {
+    c.words = std::move(words);
+  }
+  return c;
+}
+
+RowBitmap::Container RowBitmap::intersect(const Container &a, const Container &b) {
+  if (b.kind == Kind::Full && a.kind != Kind::Full)
+    return intersect(b, a);
+
+  if (a.kind == Kind::Full) {
+    // Keep the members of `b` below the prefix length
+    switch (b.kind) {
+    case Kind::Full:
+      return Container{a.key, Kind::Full, std::min(a.cardinality, b.cardinality), {}, {}};
+    case Kind::Array: {
+      auto end = std::lower_bound(b.array.begin(), b.array.end(), a.cardinality);
+      return from_array(a.key, std::vector<std::uint16_t>(b.array.begin(), end));
+    }
+    case Kind::Bitmap: {
+      auto words = to_words(a);
+      for (std::uint32_t w = 0; w < WORDS; ++w) {
+        words[w] &= b.words[w];
+      }
+      return from_words(a.key, std::move(words));
+    }
+    }
+  }
+
+  if (a.kind == Kind::Array && b.kind == Kind::Array) {
+    std::vector<std::uint16_t> result;
+    result.reserve(std::min(a.array.size(), b.array.size()));
+    std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result));
+    return from_array(a.key, std::move(result));
+  }
+
+  if (a.kind == Kind::Array || b.kind == Kind::Array) {
+    // Probe the bitmap for each array member
+    const Container &sparse = a.kind == Kind::Array ? a : b;
+    const Container &dense = a.kind == Kind::Array ? b : a;
+    std::vector<std::uint16_t> result;
+    result.reserve(sparse.array.size());
+    for (std::uint16_t low : sparse.array) {
+      if (dense.contains(low))
+        result.push_back(low);
+    }
+    return from_array(a.key, std::move(result));
+  }
+
+  std::vector<std::uint64_t> words(WORDS);
+  for (std::uint32_t w = 0; w < WORDS; ++w) {
+    words[w] = a.words[w] & b.words[w];
+  }
+  return from_words(a.key, std::move(words));
+}
+
+RowBitmap::Container RowBitmap::unite(const Container &a, const Container &b) {
+  if (a.kind == Kind::Full && b.max() < a.cardinality)
+    return a;
+  if (b.kind == Kind::Full && a.max() < b.cardinality)
+    return b;
+
+  if (a.kind == Kind::Array && b.kind == Kind::Array && a.array.size() + b.array.size() <= ARRAY_MAX) {
+    std::vector<std::uint16_t> result;
+    result.reserve(a.array.size() + b.array.size());
+    std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result));
+    return from_array(a.key, std::move(result));
+  }
+
+  auto words = to_words(a);
+  if (b.kind == Kind::Array) {
+    for (std::uint16_t low : b.array) {
+      words[low >> 6] |= std::uint64_t{1} << (low & 63);
+    }
+  } else {
+    const auto other = b.kind == Kind::Bitmap ? b.words : to_words(b);
+    for (std::uint32_t w = 0; w < WORDS; ++w) {
+      words[w] |= other[w];
+    }
+  }
+  return from_words(a.key, std::move(words));
+}
+
+RowBitmap::Container RowBitmap::subtract(const Container &a, const Container &b) {
+  if (a.kind == Kind::Array) {
+    std::vector<std::uint16_t> result;
+    result.reserve(a.array.size());
+    for (std::uint16_t low : a.array) {
+      if (!b.contains(low))
+        result.push_back(low);
+    }
+    return from_array(a.key, std::move(result));
+  }
+
+  auto words = to_words(a);
+  if (b.kind == Kind::Array) {
+    for (std::uint16_t low : b.array) {
+      words[low >> 6] &= ~(std::uint64_t{1} << (low & 63));
+    }
+  } else {
+    const auto other = b.kind == Kind::Bitmap ? b.words : to_words(b);
+    for (std::uint32_t w = 0; w < WORDS; ++w) {
+      words[w] &= ~other[w];
+    }
+  }
+  return from_words(a.key, std::move(words));
+}
+
+// ============================================================================
+// RowBitmap
+// ============================================================================
+
+RowBitmap RowBitmap::all(std::uint32_t rows) {
+  RowBitmap result;
+  for (std::uint32_t key = 0; rows > 0; ++key) {
+    const std::uint32_t count = std::min(rows, CHUNK);
+    result.containers_.push_back(Container{static_cast<std::uint16_t>(key), Kind::Full, count, {}, {}});
+    rows -= count;
+  }
+  return result;
+}
+
+RowBitmap RowBitmap::from_sorted(const std::vector<std::uint32_t> &rows) {
+  RowBitmap result;
+  for (std::uint32_t row : rows) {
+    result.append(row);
+  }
+  return result;
+}
+
+void RowBitmap::append(std::uint32_t row) {
+  const auto key = static_cast<std::uint16_t>(row >> 16);
+  const auto low = static_cast<std::uint16_t>(row & 0xFFFF);
+  if (containers_.empty() || containers_.back().key != key)
+    containers_.push_back(Container{key, Kind::Array, 0, {}, {}});
+
+  Container &c = containers_.back();
+  if (c.cardinality > 0 && c.max() == low)
+    return;
+
+  switch (c.kind) {
+  case Kind::Array:
+    c.array.push_back(low);
+    ++c.cardinality;
+    if (c.cardinality > ARRAY_MAX) {
+      c.words = to_words(c);
+      c.array = {};
+      c.kind = Kind::Bitmap;
+    }
+    break;
+  case Kind::Full:
+    if (low == c.cardinality) {
+      ++c.cardinality;
+      break;
+    }
+    c.words = to_words(c);
+    c.kind = Kind::Bitmap;
+    [[fallthrough]];
+  case Kind::Bitmap:
+    c.words[low >> 6] |= std::uint64_t{1} << (low & 63);
+    ++c.cardinality;
+    break;
+  }
+}
+
+void RowBitmap::append(RowBitmap &&tail) {
+  if (containers_.empty()) {
+    containers_ = std::move(tail.containers_);
+  } else {
+    containers_.insert(containers_.end(),
+                       std::make_move_iterator(tail.containers_.begin()),
+                       std::make_move_iterator(tail.containers_.end()));
+  }
+  tail.containers_.clear();
+}
+
+bool RowBitmap::contains(std::uint32_t row) const noexcept {
+  const auto key = static_cast<std::uint16_t>(row >> 16);
+  auto it = std::lower_bound(
+      containers_.begin(), containers_.end(), key, [](const Container &c, std::uint16_t k) { return c.key < k; });
+  return it != containers_.end() && it->key == key && it->contains(static_cast<std::uint16_t>(row & 0xFFFF));
+}
+
+size_t RowBitmap::cardinality() const noexcept {
+  size_t total = 0;
+  for (const auto &c : containers_) {
+    total += c.cardinality;
+  }
+  return total;
+}
+
+RowBitmap &RowBitmap::operator&=(const RowBitmap &other) {
+  std::vector<Container> result;
+  auto a = containers_.begin();
+  auto b = other.containers_.begin();
+  while (a != containers_.end() && b != other.containers_.end()) {
+    if (a->key < b->key) {
+      ++a;
+    } else if (b->key < a->key) {
+      ++b;
+    } else {
+      Container c = intersect(*a, *b);
+      if (c.cardinality > 0)
+        result.push_back(std::move(c));
+      ++a;
+      ++b;
+    }
+  }
+  containers_ = std::move(result);
+  return *this;
+}
+
+RowBitmap &RowBitmap::operator|=(const RowBitmap &other) {
+  std::vector<Container> result;
+  result.reserve(containers_.size() + other.containers_.size());
+  auto a = containers_.begin();
+  auto b = other.containers_.begin();
+  while (a != containers_.end() || b != other.containers_.end()) {
+    if (b == other.containers_.end() || (a != containers_.end() && a->key < b->key)) {
+      result.push_back(std::move(*a++));
+    } else if (a == containers_.end() || b->key < a->key) {
+      result.push_back(*b++);
+    } else {
+      result.push_back(unite(*a, *b));
+      ++a;
+      ++b;
+    }
+  }
+  containers_ = std::move(result);
+  return *this;
+}
+
+RowBitmap &RowBitmap::operator-=(const RowBitmap &other) {
+  std::vector<Container> result;
+  result.reserve(containers_.size());
+  auto b = other.containers_.begin();
+  for (auto &c : containers_) {
+    while (b != other.containers_.end() && b->key < c.key) {
+      ++b;
+    }
+    if (b == other.containers_.end() || b->key != c.key) {
+      result.push_back(std::move(c));
+      continue;
+    }
+    Container diff = subtract(c, *b);
+    if (diff.cardinality > 0)
+      result.push_back(std::move(diff));
+  }
+  containers_ = std::move(result);
+  return *this;
+}
+
+bool RowBitmap::operator==(const RowBitmap &other) const {
+  return cardinality() == other.cardinality() && to_vector() == other.to_vector();
+}
+
+std::vector<std::uint32_t> RowBitmap::to_vector() const {
+  std::vector<std::uint32_t> rows;
+  rows.reserve(cardinality());
+  for_each([&rows](std::uint32_t row) { rows.push_back(row); });
+  return rows;
+}
@@ -0,0 +1,216 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compressed set of row ordinals (roaring-style).
+ *
+ * The 32-bit ordinal space is split into chunks of 2^16 values keyed by the
+ * high 16 bits. Each non-empty chunk is stored in the cheapest of three
+ * container kinds:
+ * - Array: sorted 16-bit low halves, for sparse chunks (up to 4096 values)
+ * - Bitmap: 1024 64-bit words, for dense chunks
+ * - Full: the contiguous prefix `[0, cardinality)`, no storage at all
+ *
+ * Intersection, union and difference work container by container, so their
+ * cost follows the number of stored values, not the ordinal range; `all(n)`
+ * (an unfiltered view) costs one Full container per 65536 rows.
+ *
+ * @note Not thread-safe for writes; concurrent reads are safe.
+ */
+class RowBitmap {
+public:
+  static constexpr std::uint32_t CHUNK = 1u << 16;  ///< Ordinals per chunk
+  static constexpr std::uint32_t WORDS = CHUNK / 64; ///< 64-bit words in a chunk's bitmap
+
+  RowBitmap() = default;
+
+  /// The set `{0, ..., rows - 1}`.
+  static RowBitmap all(std::uint32_t rows);
+
+  /// The set of `rows`. @pre `rows` is ascending (duplicates are ignored).
+  static RowBitmap from_sorted(const std::vector<std::uint32_t> &rows);
+
+  /**
+   * @brief Add `row` while building a set in ascending order.
+   * @pre `row` is not smaller than any member (adding the current maximum again is a no-op).
+   */
+  void append(std::uint32_t row);
+
+  bool contains(std::uint32_t row) const noexcept;
+
+  /// Number of members (sum of cached container cardinalities).
+  size_t cardinality() const noexcept;
+
+  bool empty() const noexcept { return containers_.empty(); }
+  void clear() noexcept { containers_.clear(); }
+
+  /// Intersection.
+  RowBitmap &operator&=(const RowBitmap &other);
+
+  /// Union.
+  RowBitmap &operator|=(const RowBitmap &other);
+
+  /// Difference (members of `*this` that are not in `other`).
+  RowBitmap &operator-=(const RowBitmap &other);
+
+  /// Same members.
+  bool operator==(const RowBitmap &other) const;
+
+  /// Call `f(row)` for every member in ascending order.
+  template <typename F>
+  void for_each(F &&f) const {
+    for_each_in(0, containers_.size(), f);
+  }
+
+  /// Members for which `pred(row)` holds.
+  template <typename Pred>
+  RowBitmap filter(const Pred &pred) const {
+    return filter_in(0, containers_.size(), pred);
+  }
+
+  /// Number of non-empty 2^16-row chunks; ranges of chunks partition the set for parallel work.
+  size_t chunk_count() const noexcept { return containers_.size(); }
+
+  /// Call `f(row)` for every member of chunks `[first, last)` in ascending order. @pre `last <= chunk_count()`.
+  template <typename F>
+  void for_each_in(size_t first, size_t last, F &&f) const {
+    for (size_t i = first; i < last; ++i) {
+      const Container &c = containers_[i];
+      const std::uint32_t high = std::uint32_t{c.key} << 16;
+      switch (c.kind) {
+      case Kind::Array:
+        for (std::uint16_t low : c.array) {
+          f(high | low);
+        }
+        break;
+      case Kind::Bitmap:
+        for (std::uint32_t w = 0; w < WORDS; ++w) {
+          for (std::uint64_t word = c.words[w]; word != 0; word &= word - 1) {
+            f(high | (w << 6) | static_cast<std::uint32_t>(std::countr_zero(word)));
+          }
+        }
+        break;
+      case Kind::Full:
+        for (std::uint32_t low = 0; low < c.cardinality; ++low) {
+          f(high | low);
+        }
+        break;
+      }
+    }
+  }
+
+  /// Members of chunks `[first, last)` for which `pred(row)` holds. @pre `last <= chunk_count()`.
+  template <typename Pred>
+  RowBitmap filter_in(size_t first, size_t last, const Pred &pred) const {
+    RowBitmap result;
+    for_each_in(first, last, [&](std::uint32_t row) {
+      if (pred(row))
+        result.append(row);
+    });
+    return result;
+  }
+
+  /**
+   * @brief Members of chunks `[first, last)` matching `pred`, testing dense chunks a block at a time.
+   *
+   * For a Bitmap or Full chunk, `pred.mask(base, count, words)` must write the match bits of rows
+   * `[base, base + count)` to `words` (bit `i % 64` of word `i / 64`, zero past `count`); the
+   * result is intersected with the chunk's members. Array chunks call `pred(row)` per member.
+   *
+   * @pre `last <= chunk_count()`; `pred.mask` and `pred(row)` agree on every row.
+   */
+  template <typename Pred>
+  RowBitmap filter_masked_in(size_t first, size_t last, const Pred &pred) const {
+    RowBitmap result;
+    for (size_t i = first; i < last; ++i) {
+      const Container &c = containers_[i];
+      const std::uint32_t high = std::uint32_t{c.key} << 16;
+      Container matched;
+      if (c.kind == Kind::Array) {
+        std::vector<std::uint16_t> kept;
+        for (std::uint16_t low : c.array) {
+          if (pred(high | low))
+            kept.push_back(low);
+        }
+        matched = from_array(c.key, std::move(kept));
+      } else {
+        std::vector<std::uint64_t> words(WORDS, 0);
+        pred.mask(high, block_rows(c), words.data());
+        if (c.kind == Kind::Bitmap) {
+          for (std::uint32_t w = 0; w < WORDS; ++w) {
+            words[w] &= c.words[w];
+          }
+        }
+        matched = from_words(c.key, std::move(words));
+      }
+      if (matched.cardinality != 0)
+        result.containers_.push_back(std::move(matched));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Visit the members of chunks `[first, last)` a chunk at a time, for block-wise reductions.
+   *
+   * A Bitmap or Full chunk calls `dense(base, count, words)` for rows `[base, base + count)`, with
+   * `words` their membership bits, or null when every one of them is a member (Full); an Array
+   * chunk calls `sparse(row)` for each member. @pre `last <= chunk_count()`.
+   */
+  template <typename Dense, typename Sparse>
+  void visit_in(size_t first, size_t last, Dense &&dense, Sparse &&sparse) const {
+    for (size_t i = first; i < last; ++i) {
+      const Container &c = containers_[i];
+      const std::uint32_t high = std::uint32_t{c.key} << 16;
+      if (c.kind == Kind::Array) {
+        for (std::uint16_t low : c.array) {
+          sparse(high | low);
+        }
+      } else {
+        dense(high, block_rows(c), c.kind == Kind::Bitmap ? c.words.data() : nullptr);
+      }
+    }
+  }
+
+  /**
+   * @brief Move every member of `tail` to the end of this set.
+   * @pre Every member of `tail` lies in a later chunk than every member of `*this`
+   *      (as with the results of `filter_in` over consecutive chunk ranges).
+   */
+  void append(RowBitmap &&tail);
+
+  /// Members in ascending order.
+  std::vector<std::uint32_t> to_vector() const;
+
+private:
+  static constexpr std::uint32_t ARRAY_MAX = 4096; ///< beyond this an array is larger than a bitmap
+
+  enum class Kind : std::uint8_t { Array, Bitmap, Full };
+
+  struct Container {
+    std::uint16_t key{0};
+    Kind kind{Kind::Array};
+    std::uint32_t cardinality{0};
+    std::vector<std::uint16_t> array; ///< Array: sorted low halves
+    std::vector<std::uint64_t> words; ///< Bitmap: WORDS words
+
+    bool contains(std::uint16_t low) const noexcept;
+    std::uint16_t max() const noexcept;
+  };
+
+  /// Rows a dense (Bitmap or Full) container spans from its chunk base: up to and including its maximum
+  static std::uint32_t block_rows(const Container &c) noexcept {
+    return c.kind == Kind::Full ? c.cardinality : std::uint32_t{c.max()} + 1;
+  }
+
+  std::vector<Container> containers_; ///< sorted by key, never empty containers
+
+  static std::vector<std::uint64_t> to_words(const Container &c);
+  static Container from_words(std::uint16_t key, std::vector<std::uint64_t> words);
+  static Container from_array(std::uint16_t key, std::vector<std::uint16_t> array);
+  static Container intersect(const Container &a, const Container &b);
+  static Container unite(const Container &a, const Container &b);
+  static Container subtract(const Container &a, const Container &b);
+};
@@ -0,0 +1,303 @@
+#include "core/scan_kernels.hpp"
+#include <algorithm>
+#include <bit>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TASKPROC_HAVE_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TASKPROC_HAVE_NEON 1
+#endif
+
+namespace {
+constexpr std::uint32_t WORD_BITS = 64;
+
+template <ScanOp Op>
+constexpr bool holds(std::int32_t value, std::int32_t target) noexcept {
+  if constexpr (Op == ScanOp::Equal)
+    return value == target;
+  else if constexpr (Op == ScanOp::NotEqual)
+    return value != target;
+  else if constexpr (Op == ScanOp::Less)
+    return value < target;
+  else if constexpr (Op == ScanOp::LessEqual)
+    return value <= target;
+  else if constexpr (Op == ScanOp::Greater)
+    return value > target;
+  else
+    return value >= target;
+}
+
+/// Ops computed as the complement of another: NotEqual (of Equal), LessEqual (of Greater), GreaterEqual (of Less)
+template <ScanOp Op>
+constexpr bool NEGATED = Op == ScanOp::NotEqual || Op == ScanOp::LessEqual || Op == ScanOp::GreaterEqual;
+
+/// Call `scan.template operator()<Op>()` for the runtime `op`
+template <typename Scan>
+void with_op(ScanOp op, const Scan &scan) {
+  switch (op) {
+  case ScanOp::Equal:
+    return scan.template operator()<ScanOp::Equal>();
+  case ScanOp::NotEqual:
+    return scan.template operator()<ScanOp::NotEqual>();
+  case ScanOp::Less:
+    return scan.template operator()<ScanOp::Less>();
+  case ScanOp::LessEqual:
+    return scan.template operator()<ScanOp::LessEqual>();
+  case ScanOp::Greater:
+    return scan.template operator()<ScanOp::Greater>();
+  case ScanOp::GreaterEqual:
+    return scan.template operator()<ScanOp::GreaterEqual>();
+  }
+}
+
+// ============================================================================
+// Portable Kernels
+// ============================================================================
+
+template <ScanOp Op>
+void compare_scalar_op(const std::int32_t *column,
+                       std::uint32_t count,
+                       std::int32_t target,
+                       std::optional<std::int32_t> missing,
+                       std::uint64_t *words) noexcept {
+  const bool skip = missing.has_value();
+  const std::int32_t absent = missing.value_or(0);
+  for (std::uint32_t base = 0; base < count; base += WORD_BITS) {
+    const std::uint32_t n = std::min(WORD_BITS, count - base);
+    std::uint64_t word = 0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+      const std::int32_t value = column[base + i];
+      word |= std::uint64_t{holds<Op>(value, target) && !(skip && value == absent)} << i;
+    }
+    words[base / WORD_BITS] = word;
+  }
+}
+
+void compare_scalar(const std::int32_t *column,
+                    std::uint32_t count,
+                    ScanOp op,
+                    std::int32_t target,
+                    std::optional<std::int32_t> missing,
+                    std::uint64_t *words) noexcept {
+  with_op(op, [&]<ScanOp Op>() { compare_scalar_op<Op>(column, count, target, missing, words); });
+}
+
+std::int64_t masked_sum_scalar(const std::int32_t *column, std::uint32_t count, const std::uint64_t *words) noexcept {
+  std::int64_t sum = 0;
+  if (words == nullptr) {
+    for (std::uint32_t i = 0; i < count; ++i) {
+      sum += column[i];
+    }
+    return sum;
+  }
+  for (std::uint32_t w = 0; w * WORD_BITS < count; ++w) {
+    for (std::uint64_t word = words[w]; word != 0; word &= word - 1) {
+      sum += column[w * WORD_BITS + static_cast<std::uint32_t>(std::countr_zero(word))];
+    }
+  }
+  return sum;
+}
+
+size_t count_and_scalar(const std::uint64_t *a, const std::uint64_t *b, size_t words) noexcept {
+  size_t count = 0;
+  for (size_t w = 0; w < words; ++w) {
+    count += static_cast<size_t>(std::popcount(b == nullptr ? a[w] : a[w] & b[w]));
+  }
+  return count;
+}
+
+constexpr ScanKernels SCALAR_KERNELS{compare_scalar, masked_sum_scalar, count_and_scalar, "scalar"};
+
+// ============================================================================
+// AVX2 Kernels (x86-64, selected at run time)
+// ============================================================================
+
+#ifdef TASKPROC_HAVE_AVX2
+/// Eight lanes compared at once; the movemask of the comparison gives one bit per lane
+template <ScanOp Op>
+__attribute__((target("avx2"))) void compare_avx2_op(const std::int32_t *column,
+                                                     std::uint32_t count,
+                                                     std::int32_t target,
+                                                     std::optional<std::int32_t> missing,
+                                                     std::uint64_t *words) noexcept {
+  const __m256i targets = _mm256_set1_epi32(target);
+  const __m256i absents = _mm256_set1_epi32(missing.value_or(0));
+  const bool skip = missing.has_value();
+  const std::uint32_t blocks = count / WORD_BITS;
+  for (std::uint32_t block = 0; block < blocks; ++block) {
+    const std::int32_t *values = column + block * WORD_BITS;
+    std::uint64_t word = 0;
+    for (std::uint32_t lane = 0; lane < WORD_BITS; lane += 8) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + lane));
+      __m256i hit;
+      if constexpr (Op == ScanOp::Equal || Op == ScanOp::NotEqual)
+        hit = _mm256_cmpeq_epi32(v, targets);
+      else if constexpr (Op == ScanOp::Greater || Op == ScanOp::LessEqual)
+        hit = _mm256_cmpgt_epi32(v, targets);
+      else
+        hit = _mm256_cmpgt_epi32(targets, v);
+      auto bits = static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+      if constexpr (NEGATED<Op>)
+        bits ^= 0xFFu;
+      if (skip)
+        bits &= ~static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, absents))));
+      word |= std::uint64_t{bits & 0xFFu} << lane;
+    }
+    words[block] = word;
+  }
+  if (count % WORD_BITS != 0)
+    compare_scalar_op<Op>(column + blocks * WORD_BITS, count % WORD_BITS, target, missing, words + blocks);
+}
+
+void compare_avx2(const std::int32_t *column,
+                  std::uint32_t count,
+                  ScanOp op,
+                  std::int32_t target,
+                  std::optional<std::int32_t> missing,
+                  std::uint64_t *words) noexcept {
+  with_op(op, [&]<ScanOp Op>() { compare_avx2_op<Op>(column, count, target, missing, words); });
+}
+
+/// Eight lanes at a time, widened to four 64-bit sums; masked-out lanes are zeroed first
+__attribute__((target("avx2"))) std::int64_t masked_sum_avx2(const std::int32_t *column,
+                                                             std::uint32_t count,
+                                                             const std::uint64_t *words) noexcept {
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  __m256i sums = _mm256_setzero_si256();
+  const std::uint32_t groups = count / 8;
+  for (std::uint32_t group = 0; group < groups; ++group) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(column + group * 8));
+    if (words != nullptr) {
+      const auto bits = static_cast<std::int32_t>((words[group / 8] >> (group % 8 * 8)) & 0xFFu);
+      if (bits == 0)
+        continue;
+      const __m256i selected = _mm256_and_si256(_mm256_set1_epi32(bits), lane_bits);
+      v = _mm256_and_si256(v, _mm256_cmpeq_epi32(selected, lane_bits));
+    }
+    sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+  }
+
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sums);
+  std::int64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  for (std::uint32_t i = groups * 8; i < count; ++i) {
+    if (words == nullptr || (words[i / WORD_BITS] >> (i % WORD_BITS) & 1) != 0)
+      sum += column[i];
+  }
+  return sum;
+}
+
+/// Same loop as the portable one, compiled so that std::popcount is the POPCNT instruction
+__attribute__((target("avx2,popcnt"))) size_t count_and_avx2(const std::uint64_t *a,
+                                                             const std::uint64_t *b,
+                                                             size_t words) noexcept {
+  size_t count = 0;
+  for (size_t w = 0; w < words; ++w) {
+    count += static_cast<size_t>(std::popcount(b == nullptr ? a[w] : a[w] & b[w]));
+  }
+  return count;
+}
+
+constexpr ScanKernels AVX2_KERNELS{compare_avx2, masked_sum_avx2, count_and_avx2, "avx2"};
+#endif
+
+// ============================================================================
+// NEON Kernels (AArch64, always available)
+// ============================================================================
+
+#ifdef TASKPROC_HAVE_NEON
+/// Four lanes compared at once; lane masks ANDed with their bit weights and summed give one bit per lane
+template <ScanOp Op>
+void compare_neon_op(const std::int32_t *column,
+                     std::uint32_t count,
+                     std::int32_t target,
+                     std::optional<std::int32_t> missing,
+                     std::uint64_t *words) noexcept {
+  static constexpr std::uint32_t WEIGHTS[4] = {1, 2, 4, 8};
+  const uint32x4_t weights = vld1q_u32(WEIGHTS);
+  const int32x4_t targets = vdupq_n_s32(target);
+  const int32x4_t absents = vdupq_n_s32(missing.value_or(0));
+  const bool skip = missing.has_value();
+  const std::uint32_t blocks = count / WORD_BITS;
+  for (std::uint32_t block = 0; block < blocks; ++block) {
+    const std::int32_t *values = column + block * WORD_BITS;
+    std::uint64_t word = 0;
+    for (std::uint32_t lane = 0; lane < WORD_BITS; lane += 4) {
+      const int32x4_t v = vld1q_s32(values + lane);
+      uint32x4_t hit;
+      if constexpr (Op == ScanOp::Equal || Op == ScanOp::NotEqual)
+        hit = vceqq_s32(v, targets);
+      else if constexpr (Op == ScanOp::Greater || Op == ScanOp::LessEqual)
+        hit = vcgtq_s32(v, targets);
+      else
+        hit = vcltq_s32(v, targets);
+      if constexpr (NEGATED<Op>)
+        hit = vmvnq_u32(hit);
+      if (skip)
+        hit = vbicq_u32(hit, vceqq_s32(v, absents));
+      word |= std::uint64_t{vaddvq_u32(vandq_u32(hit, weights))} << lane;
+    }
+    words[block] = word;
+  }
+  if (count % WORD_BITS != 0)
+    compare_scalar_op<Op>(column + blocks * WORD_BITS, count % WORD_BITS, target, missing, words + blocks);
+}
+
+void compare_neon(const std::int32_t *column,
+                  std::uint32_t count,
+                  ScanOp op,
+                  std::int32_t target,
+                  std::optional<std::int32_t> missing,
+                  std::uint64_t *words) noexcept {
+  with_op(op, [&]<ScanOp Op>() { compare_neon_op<Op>(column, count, target, missing, words); });
+}
+
+/// Four lanes at a time, pairwise-accumulated into two 64-bit sums; masked-out lanes are zeroed first
+std::int64_t masked_sum_neon(const std::int32_t *column, std::uint32_t count, const std::uint64_t *words) noexcept {
+  static constexpr std::uint32_t WEIGHTS[4] = {1, 2, 4, 8};
+  const uint32x4_t weights = vld1q_u32(WEIGHTS);
+  int64x2_t sums = vdupq_n_s64(0);
+  const std::uint32_t groups = count / 4;
+  for (std::uint32_t group = 0; group < groups; ++group) {
+    int32x4_t v = vld1q_s32(column + group * 4);
+    if (words != nullptr) {
+      const auto bits = static_cast<std::uint32_t>((words[group / 16] >> (group % 16 * 4)) & 0xFu);
+      if (bits == 0)
+        continue;
+      v = vandq_s32(v, vreinterpretq_s32_u32(vtstq_u32(vdupq_n_u32(bits), weights)));
+    }
+    sums = vpadalq_s32(sums, v);
+  }
+
+  std::int64_t sum = vaddvq_s64(sums);
+  for (std::uint32_t i = groups * 4; i < count; ++i) {
+    if (words == nullptr || (words[i / WORD_BITS] >> (i % WORD_BITS) & 1) != 0)
+      sum += column[i];
+  }
+  return sum;
+}
+
+// std::popcount is already the vector CNT instruction here
+constexpr ScanKernels NEON_KERNELS{compare_neon, masked_sum_neon, count_and_scalar, "neon"};
+#endif
+
+const ScanKernels &detect_kernels() noexcept {
+#if defined(TASKPROC_HAVE_AVX2)
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+    return AVX2_KERNELS;
+#elif defined(TASKPROC_HAVE_NEON)
+  return NEON_KERNELS;
+#endif
+  return SCALAR_KERNELS;
+}
+} // anonymous namespace
+
+const ScanKernels &scan_kernels() noexcept {
+  static const ScanKernels &kernels = detect_kernels();
+  return kernels;
+}
+
+const ScanKernels &scalar_scan_kernels() noexcept { return SCALAR_KERNELS; }
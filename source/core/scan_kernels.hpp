@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/// Comparison a scan kernel applies between each column value and the target
+enum class ScanOp : std::uint8_t { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+/**
+ * @brief Block-wise column kernels behind the dense filter and aggregation paths.
+ *
+ * Each kernel works on `count` consecutive values of one fixed-width column and
+ * on match bitmaps laid out like a RowBitmap chunk: bit `i % 64` of word
+ * `i / 64` stands for value `i`. The table picked by `scan_kernels()` uses the
+ * widest instruction set the CPU supports (AVX2 on x86-64, NEON on AArch64)
+ * and falls back to portable loops; every table gives identical results.
+ */
+struct ScanKernels {
+  /**
+   * @brief Match bitmap of `column[0, count)` against `target`.
+   * @post Bit `i` of `words` is set iff `column[i] op target` holds and `column[i] != missing`,
+   *       for `i < count`; the `(count + 63) / 64` words are overwritten, bits past `count` are zero.
+   */
+  void (*compare)(const std::int32_t *column,
+                  std::uint32_t count,
+                  ScanOp op,
+                  std::int32_t target,
+                  std::optional<std::int32_t> missing,
+                  std::uint64_t *words) noexcept;
+
+  /// Sum of `column[i]` over the `i < count` whose bit is set in `words` (every `i` if `words` is null).
+  std::int64_t (*masked_sum)(const std::int32_t *column, std::uint32_t count, const std::uint64_t *words) noexcept;
+
+  /// Set bits of `a[0, words) & b[0, words)` (of `a` alone if `b` is null).
+  size_t (*count_and)(const std::uint64_t *a, const std::uint64_t *b, size_t words) noexcept;
+
+  /// Instruction set: "avx2", "neon" or "scalar".
+  std::string_view isa;
+};
+
+/// The fastest kernels this CPU runs, detected on first use.
+const ScanKernels &scan_kernels() noexcept;
+
+/// The portable kernels (reference results for tests and benchmarks).
+const ScanKernels &scalar_scan_kernels() noexcept;
+
+/// Dictionary codes viewed as the signed lanes the kernels compare (only (in)equality is meaningful).
+inline const std::int32_t *code_lanes(const std::uint32_t *codes) noexcept {
+  return reinterpret_cast<const std::int32_t *>(codes); // signed and unsigned variants may alias
+}
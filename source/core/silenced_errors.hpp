@@ -0,0 +1,20 @@
+#pragma once
+#include <iostream>
+
+/**
+ * @brief Discards what std::cerr receives while alive.
+ *
+ * For expressions parsed again ahead of (or after) the command that reports
+ * their errors and warnings, so each is reported once.
+ */
+class SilencedErrors {
+public:
+  SilencedErrors() noexcept : saved_(std::cerr.rdbuf(nullptr)) {}
+  ~SilencedErrors() { std::cerr.rdbuf(saved_); }
+
+  SilencedErrors(const SilencedErrors &) = delete;
+  SilencedErrors &operator=(const SilencedErrors &) = delete;
+
+private:
+  std::streambuf *saved_;
+};
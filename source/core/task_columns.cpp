@@ -0,0 +1,244 @@
+#include "core/task_columns.hpp"
+#include "core/date.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+// Arena chunk size when nothing was reserved (the resource grows geometrically from here)
+constexpr size_t DEFAULT_ARENA_BYTES = 64 * 1024;
+
+// Word-at-a-time multiply/xor-shift mixing; fields are length-prefixed so their boundaries count
+class ContentHasher {
+private:
+  std::uint64_t state_{0x9E3779B97F4A7C15ull};
+
+  void mix(std::uint64_t value) noexcept {
+    state_ = (state_ ^ value) * 0xFF51AFD7ED558CCDull;
+    state_ ^= state_ >> 32;
+  }
+
+public:
+  void add(std::int64_t value) noexcept { mix(static_cast<std::uint64_t>(value)); }
+
+  void add(std::string_view text) noexcept {
+    mix(text.size());
+    size_t i = 0;
+    for (; i + 8 <= text.size(); i += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, text.data() + i, 8);
+      mix(word);
+    }
+    std::uint64_t tail = 0;
+    if (i < text.size())
+      std::memcpy(&tail, text.data() + i, text.size() - i);
+    mix(tail);
+  }
+
+  void add(std::optional<std::string_view> text) noexcept {
+    mix(text.has_value());
+    if (text)
+      add(*text);
+  }
+
+  std::uint64_t value() const noexcept { return state_; }
+};
+} // anonymous namespace
+
+std::uint64_t content_hash(const Task &task) noexcept {
+  auto optional = [](const std::optional<std::string> &value) -> std::optional<std::string_view> {
+    if (!value)
+      return std::nullopt;
+    return std::string_view(*value);
+  };
+
+  ContentHasher hasher;
+  hasher.add(std::int64_t{task.id});
+  hasher.add(std::string_view(task.title));
+  hasher.add(std::string_view(task.status));
+  hasher.add(std::int64_t{task.priority});
+  hasher.add(std::string_view(task.created_date));
+  hasher.add(optional(task.description));
+  hasher.add(optional(task.assignee));
+  hasher.add(optional(task.due_date));
+  hasher.add(static_cast<std::int64_t>(task.tags.size()));
+  for (const auto &tag : task.tags) {
+    hasher.add(std::string_view(tag));
+  }
+  return hasher.value();
+}
+
+// ============================================================================
+// StringDictionary
+// ============================================================================
+
+std::uint32_t StringDictionary::intern(std::string_view value) {
+  auto it = codes_.find(value);
+  if (it != codes_.end()) {
+    ++counts_[it->second];
+    return it->second;
+  }
+
+  auto code = static_cast<std::uint32_t>(values_.size());
+  values_.emplace_back(value);
+  counts_.push_back(1);
+  codes_.emplace(values_.back(), code);
+  return code;
+}
+
+std::optional<std::uint32_t> StringDictionary::find(std::string_view value) const noexcept {
+  auto it = codes_.find(value);
+  if (it == codes_.end())
+    return std::nullopt;
+  return it->second;
+}
+
+void StringDictionary::clear() noexcept {
+  values_.clear();
+  counts_.clear();
+  codes_.clear();
+}
+
+// ============================================================================
+// TaskColumns
+// ============================================================================
+
+void TaskColumns::append(const Task &task) {
+  id.push_back(task.id);
+  priority.push_back(task.priority);
+  status.push_back(statuses.intern(task.status));
+  assignee.push_back(task.assignee ? assignees.intern(*task.assignee) : NO_VALUE);
+  created_date.push_back(created_dates.intern(task.created_date));
+  due_date.push_back(task.due_date ? due_dates.intern(*task.due_date) : NO_VALUE);
+  created_day.push_back(to_day_number(task.created_date));
+  due_day.push_back(task.due_date ? to_day_number(*task.due_date) : NO_DATE);
+  if (tag_offsets.empty())
+    tag_offsets.push_back(0); // moved-from columns
+  for (const auto &tag : task.tags) {
+    tag_codes.push_back(tags.intern(tag));
+  }
+  tag_offsets.push_back(static_cast<std::uint32_t>(tag_codes.size()));
+  title.push_back(store(task.title));
+  description.push_back(task.description ? store(*task.description) : TextSpan{});
+}
+
+std::uint64_t TaskColumns::content_hash(std::uint32_t row) const noexcept {
+  auto optional = [](const StringDictionary &dictionary, std::uint32_t code) -> std::optional<std::string_view> {
+    if (code == NO_VALUE)
+      return std::nullopt;
+    return std::string_view(dictionary.value(code));
+  };
+  auto optional_text = [this](TextSpan span) -> std::optional<std::string_view> {
+    if (span.length == NO_VALUE)
+      return std::nullopt;
+    return text(span);
+  };
+
+  ContentHasher hasher;
+  hasher.add(std::int64_t{id[row]});
+  hasher.add(text(title[row]));
+  hasher.add(std::string_view(statuses.value(status[row])));
+  hasher.add(std::int64_t{priority[row]});
+  hasher.add(std::string_view(created_dates.value(created_date[row])));
+  hasher.add(optional_text(description[row]));
+  hasher.add(optional(assignees, assignee[row]));
+  hasher.add(optional(due_dates, due_date[row]));
+  const auto codes = tags_of(row);
+  hasher.add(static_cast<std::int64_t>(codes.size()));
+  for (std::uint32_t code : codes) {
+    hasher.add(std::string_view(tags.value(code)));
+  }
+  return hasher.value();
+}
+
+Task TaskColumns::task(std::uint32_t row) const {
+  auto optional = [](const StringDictionary &dictionary, std::uint32_t code) -> std::optional<std::string> {
+    if (code == NO_VALUE)
+      return std::nullopt;
+    return dictionary.value(code);
+  };
+
+  std::vector<std::string> task_tags;
+  const auto codes = tags_of(row);
+  task_tags.reserve(codes.size());
+  for (std::uint32_t code : codes) {
+    task_tags.push_back(tags.value(code));
+  }
+
+  std::optional<std::string> task_description;
+  if (description[row].length != NO_VALUE)
+    task_description.emplace(text(description[row]));
+
+  return Task(id[row],
+              std::string(text(title[row])),
+              statuses.value(status[row]),
+              priority[row],
+              created_dates.value(created_date[row]),
+              std::move(task_description),
+              optional(assignees, assignee[row]),
+              optional(due_dates, due_date[row]),
+              std::move(task_tags));
+}
+
+void TaskColumns::reserve(size_t rows, size_t text_bytes) {
+  // Size the first arena chunk for all the text, so a load allocates it once
+  if (title.empty() && text_bytes > 0)
+    arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>(text_bytes);
+  id.reserve(rows);
+  priority.reserve(rows);
+  status.reserve(rows);
+  assignee.reserve(rows);
+  created_date.reserve(rows);
+  due_date.reserve(rows);
+  created_day.reserve(rows);
+  due_day.reserve(rows);
+  tag_offsets.reserve(rows + 1);
+  title.reserve(rows);
+  description.reserve(rows);
+}
+
+void TaskColumns::clear() noexcept {
+  id.clear();
+  priority.clear();
+  status.clear();
+  assignee.clear();
+  created_date.clear();
+  due_date.clear();
+  created_day.clear();
+  due_day.clear();
+  tag_offsets.assign(1, 0);
+  tag_codes.clear();
+  title.clear();
+  description.clear();
+  statuses.clear();
+  assignees.clear();
+  created_dates.clear();
+  due_dates.clear();
+  tags.clear();
+  arena_.reset();
+}
+
+std::vector<std::uint32_t> TaskColumns::status_rank() const {
+  std::vector<std::uint32_t> codes(statuses.size());
+  std::iota(codes.begin(), codes.end(), 0u);
+  std::sort(codes.begin(), codes.end(), [this](std::uint32_t a, std::uint32_t b) {
+    return statuses.value(a) < statuses.value(b);
+  });
+
+  std::vector<std::uint32_t> rank(codes.size());
+  for (std::uint32_t r = 0; r < codes.size(); ++r) {
+    rank[codes[r]] = r;
+  }
+  return rank;
+}
+
+TaskColumns::TextSpan TaskColumns::store(std::string_view text) {
+  if (text.empty())
+    return TextSpan{"", 0};
+  if (!arena_)
+    arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>(DEFAULT_ARENA_BYTES);
+
+  auto *data = static_cast<char *>(arena_->allocate(text.size(), 1));
+  std::memcpy(data, text.data(), text.size());
+  return TextSpan{data, static_cast<std::uint32_t>(text.size())};
+}
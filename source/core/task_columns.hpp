@@ -0,0 +1,147 @@
+#pragma once
+#include "task.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Dictionary encoding for a low-cardinality string column.
+ *
+ * Each distinct string gets a dense code in first-seen order; rows then store
+ * the 32-bit code instead of the string. The dictionary also counts how many
+ * times each code was interned, which filters use as an exact selectivity.
+ */
+class StringDictionary {
+private:
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+  };
+
+  std::vector<std::string> values_;
+  std::vector<std::uint32_t> counts_;
+  std::unordered_map<std::string, std::uint32_t, Hash, std::equal_to<>> codes_;
+
+public:
+  /// Return the code for `value`, assigning the next free code if unseen, and count the occurrence.
+  std::uint32_t intern(std::string_view value);
+
+  /// Return the code for `value` if it has been interned.
+  std::optional<std::uint32_t> find(std::string_view value) const noexcept;
+
+  /// String for `code`. @pre `code < size()`.
+  const std::string &value(std::uint32_t code) const noexcept { return values_[code]; }
+
+  /// Number of times `code` was interned. @pre `code < size()`.
+  std::uint32_t count(std::uint32_t code) const noexcept { return counts_[code]; }
+
+  size_t size() const noexcept { return values_.size(); }
+  void clear() noexcept;
+};
+
+/**
+ * @brief Struct-of-arrays storage of every task field.
+ *
+ * Row `i` of every column describes the same task (its "ordinal"). Columns are
+ * contiguous so filters and aggregates walk dense arrays, and together they
+ * hold the whole task, so `task(row)` can rebuild it:
+ * - `id`, `priority`: plain integer arrays
+ * - `status`, `assignee`, `created_date`, `due_date`: codes into per-column
+ *   dictionaries (`NO_VALUE` for a missing optional); repeated values are stored once
+ * - `created_day`, `due_day`: days since epoch (`NO_DATE` when missing/invalid)
+ * - `tag_offsets`/`tag_codes`: each row's tags as a range of `tags` dictionary codes
+ * - `title`, `description`: spans into a monotonic text arena, released in one
+ *   shot by `clear()`
+ *
+ * @note Move-only (spans point into the arena). Not thread-safe for writes;
+ *       concurrent reads are safe.
+ */
+class TaskColumns {
+public:
+  static constexpr std::uint32_t NO_VALUE = std::numeric_limits<std::uint32_t>::max();
+
+  /// Location of a string inside the text arena; `length == NO_VALUE` marks a missing optional.
+  struct TextSpan {
+    const char *data{nullptr};
+    std::uint32_t length{NO_VALUE};
+  };
+
+  std::vector<std::int32_t> id;
+  std::vector<std::int32_t> priority;
+  std::vector<std::uint32_t> status;
+  std::vector<std::uint32_t> assignee;
+  std::vector<std::uint32_t> created_date;
+  std::vector<std::uint32_t> due_date;
+  std::vector<std::int32_t> created_day;
+  std::vector<std::int32_t> due_day;
+  std::vector<std::uint32_t> tag_offsets{0}; ///< row `i` owns `tag_codes[tag_offsets[i], tag_offsets[i + 1])`
+  std::vector<std::uint32_t> tag_codes;
+  std::vector<TextSpan> title;
+  std::vector<TextSpan> description;
+
+  StringDictionary statuses;
+  StringDictionary assignees;
+  StringDictionary created_dates;
+  StringDictionary due_dates;
+  StringDictionary tags;
+
+  TaskColumns() = default;
+  TaskColumns(TaskColumns &&) noexcept = default;
+  TaskColumns &operator=(TaskColumns &&) noexcept = default;
+
+  /**
+   * @brief Append `task` as the next row.
+   * @post `size()` grows by one and every column holds the task's values at the new ordinal.
+   */
+  void append(const Task &task);
+
+  /// Reserve capacity for `rows` rows in every column and `text_bytes` bytes of title/description text.
+  void reserve(size_t rows, size_t text_bytes = 0);
+
+  /// Drop all rows and dictionaries, and release the text arena in one shot.
+  void clear() noexcept;
+
+  size_t size() const noexcept { return id.size(); }
+
+  /// Text of a span (empty view for a missing optional).
+  std::string_view text(TextSpan span) const noexcept {
+    return span.length == NO_VALUE ? std::string_view{} : std::string_view(span.data, span.length);
+  }
+
+  /// Tag codes of `row`, in the task's order. @pre `row < size()`.
+  std::span<const std::uint32_t> tags_of(std::uint32_t row) const noexcept {
+    return std::span(tag_codes).subspan(tag_offsets[row], tag_offsets[row + 1] - tag_offsets[row]);
+  }
+
+  /// Rebuild the task stored at `row`. @pre `row < size()`.
+  Task task(std::uint32_t row) const;
+
+  /**
+   * @brief 64-bit hash of every field of the task at `row`. @pre `row < size()`.
+   * @post Equals `content_hash(task(row))`; a missing optional hashes differently from an empty one.
+   */
+  std::uint64_t content_hash(std::uint32_t row) const noexcept;
+
+  /**
+   * @brief Rank of each status code in lexicographic order of the status strings.
+   * @post `status_rank()[code]` orders codes the same way their strings compare.
+   */
+  std::vector<std::uint32_t> status_rank() const;
+
+private:
+  /// Title/description bytes; grows in chunks and never moves, so spans stay valid until `clear()`
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+
+  TextSpan store(std::string_view text);
+};
+
+/// Hash of every field of `task`, as `TaskColumns::content_hash` computes it for a stored row.
+std::uint64_t content_hash(const Task &task) noexcept;
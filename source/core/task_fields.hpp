@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+/// Fields of a Task (the CSV columns and JSON keys of the input formats)
+enum class TaskField : std::uint16_t {
+  Id = 1 << 0,
+  Title = 1 << 1,
+  Status = 1 << 2,
+  Priority = 1 << 3,
+  CreatedDate = 1 << 4,
+  Description = 1 << 5,
+  Assignee = 1 << 6,
+  DueDate = 1 << 7,
+  Tags = 1 << 8
+};
+
+/**
+ * @brief A set of Task fields: the columns a command reads (a projection).
+ *
+ * Readers given a projection still validate every row as they would without
+ * one (a row with an invalid id or an empty title/status is skipped either
+ * way), but leave the string fields outside it empty: empty strings,
+ * std::nullopt and no tags. The integer fields `id` and `priority` are always
+ * decoded, so every projection contains `Id`.
+ */
+class TaskFields {
+public:
+  /// Only `Id`
+  constexpr TaskFields() noexcept = default;
+
+  constexpr TaskFields(TaskField field) noexcept : bits_(ID_BIT | static_cast<std::uint16_t>(field)) {}
+
+  /// Every field (no projection)
+  static constexpr TaskFields all() noexcept {
+    TaskFields fields;
+    fields.bits_ = ALL_BITS;
+    return fields;
+  }
+
+  constexpr bool has(TaskField field) const noexcept { return (bits_ & static_cast<std::uint16_t>(field)) != 0; }
+
+  /// True if every field of `other` is in this set
+  constexpr bool contains(TaskFields other) const noexcept { return (other.bits_ & ~bits_) == 0; }
+
+  constexpr bool is_all() const noexcept { return bits_ == ALL_BITS; }
+
+  constexpr TaskFields &operator|=(TaskFields other) noexcept {
+    bits_ |= other.bits_;
+    return *this;
+  }
+
+  friend constexpr TaskFields operator|(TaskFields a, TaskFields b) noexcept { return a |= b; }
+
+  friend constexpr bool operator==(TaskFields a, TaskFields b) noexcept = default;
+
+private:
+  static constexpr std::uint16_t ID_BIT = static_cast<std::uint16_t>(TaskField::Id);
+  static constexpr std::uint16_t ALL_BITS = (static_cast<std::uint16_t>(TaskField::Tags) << 1) - 1;
+
+  std::uint16_t bits_{ID_BIT};
+};
+
+constexpr TaskFields operator|(TaskField a, TaskField b) noexcept { return TaskFields(a) | TaskFields(b); }
@@ -0,0 +1,167 @@
+#include "core/text_index.hpp"
+#include "io/binary_io.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+bool is_word_byte(unsigned char c) noexcept {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+char fold(unsigned char c) noexcept { return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c); }
+
+std::uint32_t trigram_at(std::string_view term, size_t i) noexcept {
+  return std::uint32_t{static_cast<unsigned char>(term[i])} << 16 |
+         std::uint32_t{static_cast<unsigned char>(term[i + 1])} << 8 | static_cast<unsigned char>(term[i + 2]);
+}
+
+// Post: `f(word)` for each case-folded word of `text`; `word` is reused between calls
+template <typename F>
+void for_each_word(std::string_view text, std::string &word, F &&f) {
+  for (size_t i = 0; i < text.size();) {
+    while (i < text.size() && !is_word_byte(static_cast<unsigned char>(text[i]))) {
+      ++i;
+    }
+    word.clear();
+    while (i < text.size() && is_word_byte(static_cast<unsigned char>(text[i]))) {
+      word.push_back(fold(static_cast<unsigned char>(text[i++])));
+    }
+    if (!word.empty())
+      f(word);
+  }
+}
+} // anonymous namespace
+
+TextIndex TextIndex::build(const TaskColumns &columns) {
+  TextIndex index;
+  index.rows_ = static_cast<std::uint32_t>(columns.size());
+
+  // Rows are visited in ordinal order, so appending keeps every posting list ascending
+  std::string word;
+  auto add = [&index](std::uint32_t row) {
+    return [&index, row](const std::string &term) {
+      const std::uint32_t code = index.terms_.intern(term);
+      if (code == index.postings_.size())
+        index.postings_.emplace_back();
+      index.postings_[code].append(row); // a repeat of the term in the same row is a no-op
+    };
+  };
+  for (std::uint32_t row = 0; row < index.rows_; ++row) {
+    for_each_word(columns.text(columns.title[row]), word, add(row));
+    if (columns.description[row].length != TaskColumns::NO_VALUE)
+      for_each_word(columns.text(columns.description[row]), word, add(row));
+  }
+
+  index.index_trigrams();
+  return index;
+}
+
+std::vector<std::string> TextIndex::words(std::string_view text) {
+  std::vector<std::string> result;
+  std::string word;
+  for_each_word(text, word, [&result](const std::string &w) { result.push_back(w); });
+  return result;
+}
+
+std::string TextIndex::fold(std::string_view text) {
+  std::string folded(text);
+  for (char &c : folded) {
+    c = ::fold(static_cast<unsigned char>(c));
+  }
+  return folded;
+}
+
+RowBitmap TextIndex::rows_containing(std::string_view word) const {
+  std::vector<std::uint32_t> candidates;
+  if (word.size() < 3) {
+    candidates.resize(terms_.size());
+    for (std::uint32_t code = 0; code < candidates.size(); ++code) {
+      candidates[code] = code;
+    }
+  } else {
+    // Terms holding every trigram of `word`, intersecting the shortest lists first
+    std::vector<const std::vector<std::uint32_t> *> lists;
+    for (size_t i = 0; i + 3 <= word.size(); ++i) {
+      auto it = trigrams_.find(trigram_at(word, i));
+      if (it == trigrams_.end())
+        return {};
+      lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](auto *a, auto *b) { return a->size() < b->size(); });
+
+    candidates = *lists.front();
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+      auto end = std::set_intersection(
+          candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), candidates.begin());
+      candidates.erase(end, candidates.end());
+    }
+  }
+
+  // Trigrams can match out of order; confirm the substring on the (few) candidate terms
+  RowBitmap rows;
+  for (std::uint32_t code : candidates) {
+    if (terms_.value(code).find(word) != std::string::npos)
+      rows |= postings_[code];
+  }
+  return rows;
+}
+
+void TextIndex::serialize(ByteWriter &out) const {
+  out.put(rows_);
+  out.put(static_cast<std::uint32_t>(terms_.size()));
+  for (std::uint32_t code = 0; code < terms_.size(); ++code) {
+    out.put_string(terms_.value(code));
+    const std::vector<std::uint32_t> rows = postings_[code].to_vector();
+    out.put_varint(rows.size());
+    std::uint32_t previous = 0;
+    for (std::uint32_t row : rows) {
+      out.put_varint(row - previous);
+      previous = row;
+    }
+  }
+}
+
+TextIndex TextIndex::deserialize(ByteReader &in) {
+  TextIndex index;
+  index.rows_ = in.get<std::uint32_t>();
+  const auto term_count = in.get<std::uint32_t>();
+  // Every term takes at least 6 bytes; reject counts the data cannot possibly hold
+  if (term_count > in.remaining() / 6)
+    throw std::runtime_error("Corrupt text index: implausible term count");
+
+  index.postings_.resize(term_count);
+  std::vector<std::uint32_t> rows;
+  for (std::uint32_t code = 0; code < term_count; ++code) {
+    if (index.terms_.intern(in.get_string()) != code)
+      throw std::runtime_error("Corrupt text index: repeated term");
+
+    const std::uint64_t count = in.get_varint();
+    if (count > index.rows_)
+      throw std::runtime_error("Corrupt text index: implausible posting count");
+    rows.clear();
+    std::uint64_t row = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+      const std::uint64_t delta = in.get_varint();
+      row += delta;
+      if ((i > 0 && delta == 0) || row >= index.rows_)
+        throw std::runtime_error("Corrupt text index: posting out of range");
+      rows.push_back(static_cast<std::uint32_t>(row));
+    }
+    index.postings_[code] = RowBitmap::from_sorted(rows);
+  }
+
+  index.index_trigrams();
+  return index;
+}
+
+void TextIndex::index_trigrams() {
+  trigrams_.clear();
+  for (std::uint32_t code = 0; code < terms_.size(); ++code) {
+    const std::string &term = terms_.value(code);
+    for (size_t i = 0; i + 3 <= term.size(); ++i) {
+      auto &codes = trigrams_[trigram_at(term, i)];
+      if (codes.empty() || codes.back() != code) // a trigram repeated within the term
+        codes.push_back(code);
+    }
+  }
+}
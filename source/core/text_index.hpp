@@ -0,0 +1,70 @@
+#pragma once
+#include "row_bitmap.hpp"
+#include "task_columns.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class ByteReader;
+class ByteWriter;
+
+/**
+ * @brief Case-folded inverted index over task titles and descriptions.
+ *
+ * Text is split into words at every byte that is not an ASCII letter or
+ * digit; ASCII letters are folded to lower case and bytes >= 0x80 are kept as
+ * word bytes, so UTF-8 sequences stay inside their word. Each distinct word
+ * (term) maps to a posting list of the rows containing it, and every trigram
+ * of a term maps to the terms containing that trigram.
+ *
+ * A query word has no separators, so wherever it occurs in a text it lies
+ * inside one term: its rows are the union of the postings of the terms that
+ * contain it. Those terms are found by intersecting the term lists of the
+ * word's trigrams (or by scanning the vocabulary for words shorter than three
+ * bytes), so no title or description is read at query time.
+ *
+ * @note Immutable once built; concurrent reads are safe.
+ */
+class TextIndex {
+public:
+  /// Index the title and description of every row of `columns`.
+  static TextIndex build(const TaskColumns &columns);
+
+  /// The case-folded words of `text`, in order (repeats included).
+  static std::vector<std::string> words(std::string_view text);
+
+  /// `text` with ASCII letters folded to lower case, as words are folded.
+  static std::string fold(std::string_view text);
+
+  /**
+   * @brief Rows whose title or description contains `word` (case-insensitively).
+   * @pre `word` is one of the strings returned by `words()`.
+   */
+  RowBitmap rows_containing(std::string_view word) const;
+
+  /// Number of rows the index was built over.
+  std::uint32_t row_count() const noexcept { return rows_; }
+
+  /// Number of distinct terms.
+  size_t term_count() const noexcept { return terms_.size(); }
+
+  /// Append the terms and delta-encoded posting lists to `out` (trigrams are rebuilt on read).
+  void serialize(ByteWriter &out) const;
+
+  /**
+   * @brief Decode an index written by `serialize`.
+   * @throws std::runtime_error if the data is truncated or inconsistent.
+   */
+  static TextIndex deserialize(ByteReader &in);
+
+private:
+  std::uint32_t rows_{0};
+  StringDictionary terms_;                                             ///< term -> code, first-seen order
+  std::vector<RowBitmap> postings_;                                    ///< term code -> rows
+  std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> trigrams_; ///< packed trigram -> ascending term codes
+
+  /// Rebuild `trigrams_` from `terms_`.
+  void index_trigrams();
+};
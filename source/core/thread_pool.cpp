@@ -0,0 +1,72 @@
+#include "core/thread_pool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+
+ThreadPool::ThreadPool(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  workers_.reserve(threads);
+  try {
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this]() { work(); });
+    }
+  } catch (...) {
+    // Stop the workers that did start before propagating
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+    throw;
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  available_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::default_threads() noexcept { return std::max(1u, std::thread::hardware_concurrency()); }
+
+size_t ThreadPool::configured_threads() noexcept {
+  const char *env = std::getenv("TASKPROC_THREADS");
+  if (env == nullptr)
+    return default_threads();
+
+  const std::string_view text(env);
+  size_t threads = 0;
+  auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), threads);
+  if (ec != std::errc{} || end != text.data() + text.size() || threads == 0)
+    return default_threads();
+  return threads;
+}
+
+ThreadPool &ThreadPool::shared() {
+  static ThreadPool pool(configured_threads());
+  return pool;
+}
+
+void ThreadPool::work() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(mutex_);
+      available_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty())
+        return; // stopping and drained
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed-size pool of worker threads running queued jobs in FIFO order.
+ *
+ * @note `submit` and `parallel_for` are thread-safe. Do not block on pool
+ *       results from inside a pool job: a job that waits for jobs queued
+ *       behind it can deadlock a saturated pool.
+ */
+class ThreadPool {
+private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable available_;
+  bool stopping_{false};
+
+public:
+  /**
+   * @brief Start `threads` workers.
+   * @post `size() == max(threads, 1)`.
+   * @throws std::system_error if a thread cannot be started.
+   */
+  explicit ThreadPool(size_t threads = default_threads());
+
+  /// Finishes the queued jobs, then joins every worker.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Number of worker threads.
+  size_t size() const noexcept { return workers_.size(); }
+
+  /// Hardware concurrency, or 1 if unknown.
+  static size_t default_threads() noexcept;
+
+  /// `TASKPROC_THREADS` if it holds a positive integer, otherwise `default_threads()`.
+  static size_t configured_threads() noexcept;
+
+  /// Process-wide pool of `configured_threads()` workers, created on first use.
+  static ThreadPool &shared();
+
+  /**
+   * @brief Queue `job` and return a future for its result.
+   * @post The future holds the result, or the exception `job` threw.
+   */
+  template <typename F>
+  auto submit(F &&job) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    // std::function needs a copyable target; share the move-only packaged_task
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+    std::future<Result> result = task->get_future();
+    {
+      std::lock_guard lock(mutex_);
+      jobs_.emplace_back([task]() { (*task)(); });
+    }
+    available_.notify_one();
+    return result;
+  }
+
+  /**
+   * @brief Run `body(i)` for every `i` in `[0, count)` and wait for all of them.
+   * @post Every call has finished.
+   * @throws The first exception (by index) thrown by `body`, after all calls finished.
+   * @note With `count <= 1` or a single worker, runs inline on the calling thread.
+   */
+  template <typename F>
+  void parallel_for(size_t count, const F &body) {
+    if (count <= 1 || size() <= 1) {
+      for (size_t i = 0; i < count; ++i) {
+        body(i);
+      }
+      return;
+    }
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      pending.push_back(submit([&body, i]() { body(i); }));
+    }
+
+    std::exception_ptr first_error;
+    for (auto &done : pending) {
+      try {
+        done.get();
+      } catch (...) {
+        if (!first_error)
+          first_error = std::current_exception();
+      }
+    }
+    if (first_error)
+      std::rethrow_exception(first_error);
+  }
+
+private:
+  void work();
+};
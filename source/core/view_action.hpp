@@ -1,3 +1,4 @@
+#pragma once
 #include <optional>
 #include <string>
 #include <string_view>
@@ -13,7 +14,8 @@ enum class ViewOpType {
   Filter,       ///< apply filter expression
   Sort,         ///< apply sort expression
   ResetFilters, ///< reset/clear filters
-  FindByTag     ///< filter by tag
+  FindByTag,    ///< filter by tag
+  Search        ///< full-text search in title and description
 };
 
 /**
@@ -45,6 +47,8 @@ inline std::string to_string(ViewOpType t) noexcept {
     return "reset-filters";
   case ViewOpType::FindByTag:
     return "find-by-tag";
+  case ViewOpType::Search:
+    return "search";
   }
   return "unknown";
 }
@@ -65,5 +69,7 @@ inline std::optional<ViewOpType> view_op_type_from_string(std::string_view s) no
     return ViewOpType::ResetFilters;
   if (s == "find-by-tag")
     return ViewOpType::FindByTag;
+  if (s == "search")
+    return ViewOpType::Search;
   return std::nullopt;
 }
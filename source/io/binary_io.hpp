@@ -0,0 +1,133 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// ============================================================================
+// Little helpers for the project's binary cache files (host byte order).
+// ============================================================================
+
+/**
+ * @brief Append-only byte buffer with fixed-width and length-prefixed encoders.
+ */
+class ByteWriter {
+private:
+  std::string buffer_;
+
+public:
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void put(T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer_.append(bytes, sizeof(T));
+  }
+
+  /// Write a u32 length prefix followed by the raw bytes.
+  void put_string(std::string_view s) {
+    put(static_cast<std::uint32_t>(s.size()));
+    buffer_.append(s);
+  }
+
+  void put_raw(std::string_view bytes) { buffer_.append(bytes); }
+
+  /// Write `value` as a LEB128 varint (7 bits per byte, low bits first).
+  void put_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(value));
+  }
+
+  const std::string &data() const noexcept { return buffer_; }
+  size_t size() const noexcept { return buffer_.size(); }
+  void clear() noexcept { buffer_.clear(); }
+  void reserve(size_t n) { buffer_.reserve(n); }
+};
+
+/**
+ * @brief Bounds-checked cursor over a byte range produced by ByteWriter.
+ *
+ * @throws std::runtime_error from every accessor if the input is truncated.
+ */
+class ByteReader {
+private:
+  std::string_view data_;
+  size_t pos_{0};
+
+public:
+  explicit ByteReader(std::string_view data) noexcept : data_(data) {}
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  T get() {
+    require(sizeof(T));
+    T value;
+    std::memcpy(&value, data_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  /// Read a u32 length prefix and return a view of the following bytes (no copy).
+  std::string_view get_string() {
+    auto len = get<std::uint32_t>();
+    return get_raw(len);
+  }
+
+  std::string_view get_raw(size_t len) {
+    require(len);
+    std::string_view out = data_.substr(pos_, len);
+    pos_ += len;
+    return out;
+  }
+
+  /// Read a LEB128 varint written by `ByteWriter::put_varint`.
+  std::uint64_t get_varint() {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      const auto byte = get<std::uint8_t>();
+      value |= std::uint64_t{byte & 0x7Fu} << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+    throw std::runtime_error("Malformed varint in binary data");
+  }
+
+  size_t position() const noexcept { return pos_; }
+  size_t remaining() const noexcept { return data_.size() - pos_; }
+  bool at_end() const noexcept { return pos_ == data_.size(); }
+
+private:
+  void require(size_t n) const {
+    if (data_.size() - pos_ < n)
+      throw std::runtime_error("Unexpected end of binary data");
+  }
+};
+
+// ============================================================================
+// FNV-1a (64-bit), for the checksums, entry names and fingerprints stored in
+// those files. Unlike std::hash it gives the same value on every platform and
+// in every run, which is what lets a later process trust what an earlier wrote.
+// ============================================================================
+
+/// Hash of the empty input; the starting value for `fnv1a(hash, bytes)`.
+constexpr std::uint64_t FNV1A_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+/// Fold `bytes` into the running hash `hash`.
+inline void fnv1a(std::uint64_t &hash, std::string_view bytes) noexcept {
+  for (unsigned char c : bytes) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+}
+
+/// Hash of `bytes` alone.
+inline std::uint64_t fnv1a(std::string_view bytes) noexcept {
+  std::uint64_t hash = FNV1A_OFFSET_BASIS;
+  fnv1a(hash, bytes);
+  return hash;
+}
@@ -0,0 +1,118 @@
+#include "io/chunked_task_writer.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <exception>
+#include <future>
+#include <span>
+
+namespace {
+// Post: bytes of the field values of `task`, before any escaping
+size_t value_bytes(const Task &task) noexcept {
+  size_t bytes = task.title.size() + task.status.size() + task.created_date.size() + 24; // two integers
+  for (const auto &field : {&task.description, &task.assignee, &task.due_date}) {
+    bytes += field->has_value() ? (*field)->size() : 0;
+  }
+  for (const auto &tag : task.tags) {
+    bytes += tag.size() + 4;
+  }
+  return bytes;
+}
+
+/// Futures of the chunks being formatted; waits for them all before the buffers they fill go away.
+class PendingChunks {
+public:
+  PendingChunks() = default;
+  PendingChunks(const PendingChunks &) = delete;
+  PendingChunks &operator=(const PendingChunks &) = delete;
+  ~PendingChunks() {
+    for (auto &chunk : chunks_) {
+      if (chunk.valid())
+        chunk.wait();
+    }
+  }
+
+  void add(std::future<void> chunk) { chunks_.push_back(std::move(chunk)); }
+
+  // Post: every chunk finished; throws the first error among them
+  void wait_all() {
+    std::exception_ptr first_error;
+    for (auto &chunk : chunks_) {
+      try {
+        chunk.get();
+      } catch (...) {
+        if (!first_error)
+          first_error = std::current_exception();
+      }
+    }
+    chunks_.clear();
+    if (first_error)
+      std::rethrow_exception(first_error);
+  }
+
+private:
+  std::vector<std::future<void>> chunks_;
+};
+} // anonymous namespace
+
+void append_int(std::string &out, long long value) {
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, result.ptr);
+}
+
+ChunkedTaskWriter::ChunkedTaskWriter(ThreadPool &pool, size_t rows_per_chunk) noexcept :
+    pool_(&pool), rows_per_chunk_(std::max<size_t>(rows_per_chunk, 1)) {}
+
+void ChunkedTaskWriter::format_chunk(const std::vector<const Task *> &tasks, size_t chunk, std::string &out) const {
+  const size_t first = chunk * rows_per_chunk_;
+  const size_t last = std::min(tasks.size(), first + rows_per_chunk_);
+
+  size_t bytes = 0;
+  for (size_t i = first; i < last; ++i) {
+    bytes += value_bytes(*tasks[i]) + row_overhead();
+  }
+  out.clear();
+  out.reserve(bytes + bytes / 16 + 64); // headroom for escapes, the header and the footer
+
+  if (first == 0)
+    append_header(out, tasks.size());
+  for (size_t i = first; i < last; ++i) {
+    append_task(out, *tasks[i], i);
+  }
+  if (last == tasks.size())
+    append_footer(out, tasks.size());
+}
+
+void ChunkedTaskWriter::write_tasks(const std::vector<const Task *> &tasks, OutputSink &sink) const {
+  const size_t chunks = std::max<size_t>((tasks.size() + rows_per_chunk_ - 1) / rows_per_chunk_, 1);
+
+  // One worker (or one chunk): format and write chunk by chunk, reusing one buffer
+  if (chunks == 1 || pool_->size() <= 1) {
+    std::string buffer;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      format_chunk(tasks, chunk, buffer);
+      sink.write(std::span(&buffer, 1));
+    }
+    return;
+  }
+
+  // Format wave k + 1 into one buffer set while the sink writes wave k from the other
+  const size_t wave = pool_->size();
+  std::array<std::vector<std::string>, 2> buffers{std::vector<std::string>(wave), std::vector<std::string>(wave)};
+  PendingChunks pending;
+  auto launch = [this, &tasks, &pending, wave, chunks](size_t first_chunk, std::vector<std::string> &out) {
+    for (size_t chunk = first_chunk; chunk < std::min(chunks, first_chunk + wave); ++chunk) {
+      std::string *buffer = &out[chunk - first_chunk];
+      pending.add(pool_->submit([this, &tasks, chunk, buffer]() { format_chunk(tasks, chunk, *buffer); }));
+    }
+  };
+
+  launch(0, buffers[0]);
+  for (size_t first_chunk = 0, current = 0; first_chunk < chunks; first_chunk += wave, current ^= 1) {
+    pending.wait_all();
+    if (first_chunk + wave < chunks)
+      launch(first_chunk + wave, buffers[current ^ 1]);
+    sink.write(std::span(buffers[current].data(), std::min(wave, chunks - first_chunk)));
+  }
+}
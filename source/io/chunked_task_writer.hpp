@@ -0,0 +1,61 @@
+#pragma once
+#include "../core/task.hpp"
+#include "../core/thread_pool.hpp"
+#include "writer.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Base of the export writers: formats rows in parallel chunks, writes them in order.
+ *
+ * The task list is cut into chunks of `rows_per_chunk` tasks. Each chunk is
+ * appended into its own buffer, reserved up front from the tasks' field sizes,
+ * so formatting never goes through `std::ostream` and rarely reallocates.
+ * Chunks are formatted on a thread pool one wave (one chunk per worker) at a
+ * time; while the sink writes a wave, the next one is being formatted into a
+ * second set of buffers, so memory stays bounded by two waves whatever the
+ * size of the export.
+ *
+ * Derived classes supply the document syntax: a header, one task at a time,
+ * and a footer.
+ *
+ * @note `write_tasks` is const and may run concurrently on different task lists.
+ */
+class ChunkedTaskWriter : public ITaskWriter {
+public:
+  /// Tasks per chunk: a few hundred KiB of output per buffer
+  static constexpr size_t DEFAULT_ROWS_PER_CHUNK = 4096;
+
+  /**
+   * @param pool Pool that formats the chunks (must outlive the writer).
+   * @param rows_per_chunk Tasks formatted into one buffer (at least 1).
+   */
+  explicit ChunkedTaskWriter(ThreadPool &pool = ThreadPool::shared(),
+                             size_t rows_per_chunk = DEFAULT_ROWS_PER_CHUNK) noexcept;
+
+  void write_tasks(const std::vector<const Task *> &tasks, OutputSink &sink) const final;
+
+protected:
+  /// Append what precedes the first task of a document holding `count` tasks.
+  virtual void append_header(std::string &out, size_t count) const = 0;
+
+  /// Append `task`, the task at position `index` of the document.
+  virtual void append_task(std::string &out, const Task &task, size_t index) const = 0;
+
+  /// Append what follows the last task of a document holding `count` tasks.
+  virtual void append_footer(std::string &out, size_t count) const = 0;
+
+  /// Bytes of syntax (separators, quotes, key names) one task adds beyond its field values.
+  virtual size_t row_overhead() const noexcept = 0;
+
+private:
+  ThreadPool *pool_;
+  size_t rows_per_chunk_;
+
+  /// Format chunk `chunk` of `tasks` into `out` (with the header or footer at the ends).
+  void format_chunk(const std::vector<const Task *> &tasks, size_t chunk, std::string &out) const;
+};
+
+/// Append the decimal digits of `value` to `out`.
+void append_int(std::string &out, long long value);
@@ -1,4 +1,5 @@
 #include "io/csv_reader.hpp"
+#include "core/profiler.hpp"
 #include "core/task.hpp"
 #include <csv.h>
 #include <iostream>
@@ -23,7 +24,8 @@ std::vector<std::string> split_tags(std::string tags_field) {
 
 bool CSVReader::can_handle(std::string_view filepath) const { return filepath.ends_with(".csv"); }
 
-std::vector<Task> CSVReader::read_tasks(std::string_view filepath) {
+std::vector<Task> CSVReader::read_tasks(std::string_view filepath, TaskFields) {
+  TASKPROC_PROFILE_SCOPE("reader.csv");
   // Enable trimming and double-quote escaping (comma separator, double-quote as
   // quote char) Template parameters: column count, trim policy, quote policy
   constexpr int CSV_COLUMNS = 9;
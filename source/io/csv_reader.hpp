@@ -14,17 +14,21 @@
  * - `tags` is returned as a single field; callers should expect a comma-
  *   separated tag string in that field (the reader does not split tags for you).
  *
+ * The parser materializes every column, so `fields` is ignored: every field
+ * is decoded (which the projection contract allows).
+ *
  * @copydoc ITaskReader::read_tasks
  *
  * Error and format-specific behavior:
  * - @throws io::error::can_not_open_file if the file cannot be opened.
  * - Malformed rows are typically skipped; individual row parse errors do not
  *   necessarily cause the entire read to fail (see implementation for details).
- * - @note Thread-safety: caller should assume this is not thread-safe unless
- *   otherwise documented.
+ * - @note Thread-safety: `read_tasks` calls may run concurrently; the reader
+ *   keeps no per-call state.
  */
 class CSVReader : public ITaskReader {
 public:
   bool can_handle(std::string_view filepath) const override;
-  std::vector<Task> read_tasks(std::string_view filepath) override;
+  using ITaskReader::read_tasks;
+  std::vector<Task> read_tasks(std::string_view filepath, TaskFields) override;
 };
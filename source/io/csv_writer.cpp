@@ -0,0 +1,70 @@
+#include "io/csv_writer.hpp"
+
+namespace {
+bool is_blank(char c) noexcept { return c == ' ' || c == '\t'; }
+
+// Post: `value` appended as one CSV field, quoted only if the readers would otherwise misread it
+void append_field(std::string &out, std::string_view value) {
+  const bool quote = value.find_first_of(",\"\r\n") != std::string_view::npos ||
+                     (!value.empty() && (is_blank(value.front()) || is_blank(value.back())));
+  if (!quote) {
+    out.append(value);
+    return;
+  }
+
+  out.push_back('"');
+  for (size_t quote_at; (quote_at = value.find('"')) != std::string_view::npos;) {
+    out.append(value.substr(0, quote_at + 1));
+    out.push_back('"');
+    value.remove_prefix(quote_at + 1);
+  }
+  out.append(value);
+  out.push_back('"');
+}
+
+void append_optional(std::string &out, const std::optional<std::string> &value) {
+  if (value)
+    append_field(out, *value);
+}
+} // anonymous namespace
+
+bool CSVWriter::can_handle(std::string_view filepath) const { return filepath.ends_with(".csv"); }
+
+void CSVWriter::append_header(std::string &out, size_t) const {
+  out.append("id,title,status,priority,created_date,description,assignee,due_date,tags\n");
+}
+
+void CSVWriter::append_task(std::string &out, const Task &task, size_t) const {
+  append_int(out, task.id);
+  out.push_back(',');
+  append_field(out, task.title);
+  out.push_back(',');
+  append_field(out, task.status);
+  out.push_back(',');
+  append_int(out, task.priority);
+  out.push_back(',');
+  append_field(out, task.created_date);
+  out.push_back(',');
+  append_optional(out, task.description);
+  out.push_back(',');
+  append_optional(out, task.assignee);
+  out.push_back(',');
+  append_optional(out, task.due_date);
+  out.push_back(',');
+
+  if (task.tags.size() == 1) {
+    append_field(out, task.tags.front());
+  } else if (!task.tags.empty()) {
+    // The joined list holds commas, so it is always quoted
+    out.push_back('"');
+    for (size_t i = 0; i < task.tags.size(); ++i) {
+      if (i > 0)
+        out.push_back(',');
+      for (char c : task.tags[i]) {
+        out.append(c == '"' ? 2 : 1, c);
+      }
+    }
+    out.push_back('"');
+  }
+  out.push_back('\n');
+}
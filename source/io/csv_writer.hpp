@@ -0,0 +1,32 @@
+#pragma once
+#include "chunked_task_writer.hpp"
+#include <string>
+#include <string_view>
+
+/**
+ * @brief CSV writer producing the format CSVReader and ParallelCSVReader accept.
+ *
+ * Format specifics:
+ * - Header row: id,title,status,priority,created_date,description,assignee,due_date,tags
+ * - Comma separator, `\n` line endings.
+ * - A field is quoted only when it needs to be: when it holds a comma, a
+ *   double quote (doubled inside the quotes), a line break, or leading or
+ *   trailing blanks the readers would trim. Fields with line breaks read back
+ *   only through ParallelCSVReader.
+ * - Unset optional fields are empty; `tags` is one comma-separated field.
+ *
+ * @copydoc ITaskWriter::write_tasks
+ */
+class CSVWriter : public ChunkedTaskWriter {
+public:
+  using ChunkedTaskWriter::ChunkedTaskWriter;
+
+  bool can_handle(std::string_view filepath) const override;
+  std::string_view format_name() const noexcept override { return "csv"; }
+
+protected:
+  void append_header(std::string &out, size_t count) const override;
+  void append_task(std::string &out, const Task &task, size_t index) const override;
+  void append_footer(std::string &, size_t) const override {}
+  size_t row_overhead() const noexcept override { return 16; }
+};
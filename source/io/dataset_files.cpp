@@ -0,0 +1,96 @@
+#include "io/dataset_files.hpp"
+#include "io/binary_io.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <glob.h>
+
+namespace {
+template <typename T>
+void fnv1a_value(std::uint64_t &hash, T value) noexcept {
+  fnv1a(hash, std::string_view(reinterpret_cast<const char *>(&value), sizeof(value)));
+}
+
+bool is_pattern(std::string_view spec) noexcept { return spec.find_first_of("*?[") != std::string_view::npos; }
+
+std::vector<std::filesystem::path> directory_files(const std::filesystem::path &dir) {
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    std::error_code type_ec;
+    if (it->is_regular_file(type_ec))
+      files.push_back(it->path());
+  }
+  if (ec)
+    throw std::runtime_error("Failed to list directory " + dir.string() + ": " + ec.message());
+  return files;
+}
+
+std::vector<std::filesystem::path> pattern_files(const std::string &pattern) {
+  glob_t matches{};
+  const int status = ::glob(pattern.c_str(), GLOB_NOSORT, nullptr, &matches);
+  if (status != 0 && status != GLOB_NOMATCH) {
+    ::globfree(&matches);
+    throw std::runtime_error("Failed to expand pattern: " + pattern);
+  }
+
+  std::vector<std::filesystem::path> files;
+  try {
+    for (size_t i = 0; i < matches.gl_pathc; ++i) {
+      std::error_code ec;
+      std::filesystem::path path(matches.gl_pathv[i]);
+      if (std::filesystem::is_regular_file(path, ec))
+        files.push_back(std::move(path));
+    }
+  } catch (...) {
+    ::globfree(&matches);
+    throw;
+  }
+  ::globfree(&matches);
+  return files;
+}
+} // anonymous namespace
+
+bool is_sharded_dataset(std::string_view spec) noexcept {
+  if (is_pattern(spec))
+    return true;
+  try {
+    std::error_code ec;
+    return std::filesystem::is_directory(std::filesystem::path(spec), ec);
+  } catch (...) {
+    return false;
+  }
+}
+
+std::vector<std::filesystem::path> dataset_files(std::string_view spec) {
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+  if (is_pattern(spec))
+    files = pattern_files(std::string(spec));
+  else if (std::filesystem::is_directory(std::filesystem::path(spec), ec))
+    files = directory_files(std::filesystem::path(spec));
+  else
+    return {std::filesystem::path(spec)};
+
+  // glob(3) and directory iteration order depend on the locale and the file system
+  std::sort(files.begin(), files.end());
+  files.erase(std::unique(files.begin(), files.end()), files.end());
+  return files;
+}
+
+SourceFingerprint combine_fingerprints(std::string_view spec, const std::vector<SourceFingerprint> &files) {
+  SourceFingerprint combined{std::string(spec), 0, 0};
+  std::uint64_t hash = FNV1A_OFFSET_BASIS;
+  for (const auto &file : files) {
+    combined.size += file.size;
+    fnv1a(hash, file.path);
+    fnv1a(hash, std::string_view("\0", 1));
+    fnv1a_value(hash, static_cast<std::uint64_t>(file.size));
+    fnv1a_value(hash, file.mtime);
+  }
+  combined.mtime = static_cast<std::int64_t>(hash);
+  return combined;
+}
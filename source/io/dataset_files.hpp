@@ -0,0 +1,53 @@
+#pragma once
+#include "source_fingerprint.hpp"
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief One file of a sharded dataset, as last read.
+ *
+ * Kept per file so that an incremental reload re-reads only the shards whose
+ * fingerprint changed, taking the rows of the others from memory.
+ */
+struct Shard {
+  SourceFingerprint source;
+  std::vector<int> ids; ///< IDs of every task read from the file, including ones a later shard overrides
+};
+
+/**
+ * @brief True if `spec` names a sharded dataset: a directory or a glob pattern.
+ *
+ * A pattern is a path with `*`, `?` or `[` in it (see glob(7)); anything else
+ * is a single tasks file.
+ *
+ * @throws none (noexcept).
+ */
+bool is_sharded_dataset(std::string_view spec) noexcept;
+
+/**
+ * @brief Files of the dataset named by `spec`, sorted by path.
+ *
+ * A directory contributes the regular files directly inside it; a glob
+ * pattern the regular files it matches; a plain path itself (whether or not
+ * it exists, so the reader reports a missing file). Shards are loaded in this
+ * order, so it also decides which row wins an ID conflict (see DataManager).
+ *
+ * @post Paths are in ascending lexicographic order without duplicates.
+ * @throws std::runtime_error if a directory cannot be listed or a pattern cannot be expanded.
+ */
+std::vector<std::filesystem::path> dataset_files(std::string_view spec);
+
+/**
+ * @brief Fingerprint of a whole sharded dataset, from the fingerprints of its files.
+ *
+ * The result has `spec` as its path, the total size, and in place of a
+ * modification time a hash of every file's path, size and time, so it changes
+ * whenever a shard is added, removed or modified. Caches keyed on a
+ * SourceFingerprint (snapshots, materialized views) thereby work unchanged
+ * for sharded datasets.
+ *
+ * @pre `files` is in `dataset_files` order.
+ * @throws std::bad_alloc if the path cannot be copied.
+ */
+SourceFingerprint combine_fingerprints(std::string_view spec, const std::vector<SourceFingerprint> &files);
@@ -1,56 +1,25 @@
 #include "io/json_reader.hpp"
-#include "core/task.hpp"
-#include <fstream>
+#include "core/profiler.hpp"
+#include "io/json_task_parser.hpp"
+#include "io/mapped_file.hpp"
+#include <filesystem>
 #include <iostream>
-#include <nlohmann/json.hpp>
+#include <string>
 #include <string_view>
 #include <vector>
 
-using json = nlohmann::json;
-
 bool JSONReader::can_handle(std::string_view filepath) const { return filepath.ends_with(".json"); }
 
-std::vector<Task> JSONReader::read_tasks(std::string_view filepath) {
-  std::ifstream file{std::string(filepath)};
-  json tasks_json = json::parse(file);
+std::vector<Task> JSONReader::read_tasks(std::string_view filepath, TaskFields fields) {
+  TASKPROC_PROFILE_SCOPE("reader.json");
+  const MappedFile file{std::filesystem::path(filepath)};
 
   std::vector<Task> tasks;
+  std::vector<std::string> warnings;
+  parse_json_tasks(file.view(), JsonLayout::Array, tasks, warnings, fields);
 
-  for (const auto &task_json : tasks_json) {
-    int id = task_json.value("id", 0);
-    if (id < 1) {
-      std::cerr << "Error while processing task: Invalid ID, must be greater "
-                   "than 0\n";
-      continue;
-    }
-    std::string title = task_json.value("title", "");
-    std::string status = task_json.value("status", "");
-    if (title.empty() || status.empty()) {
-      std::cerr << "Error while processing task: Invalid title or status\n";
-      continue;
-    }
-    int priority = task_json.value("priority", 1);
-    std::string created_date = task_json.value("created_date", "");
-    std::string description = task_json.value("description", "");
-    std::string assignee = task_json.value("assignee", "");
-    std::string due_date = task_json.value("due_date", "");
-    std::vector<std::string> tags;
-    if (task_json.contains("tags") && task_json.at("tags").is_array()) {
-      for (const auto &tag : task_json["tags"]) {
-        tags.emplace_back(tag.get<std::string>());
-      }
-    }
-
-    tasks.emplace_back(id,
-                       std::move(title),
-                       std::move(status),
-                       priority,
-                       std::move(created_date),
-                       std::move(description),
-                       std::move(assignee),
-                       std::move(due_date),
-                       std::move(tags));
+  for (const auto &warning : warnings) {
+    std::cerr << warning << "\n";
   }
-
   return tasks;
 }
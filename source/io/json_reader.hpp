@@ -5,7 +5,11 @@
 #include <vector>
 
 /**
- * @brief JSON reader implementation using nlohmann::json.
+ * @brief JSON reader implementation using the nlohmann::json SAX parser.
+ *
+ * The file is memory-mapped and streamed through parse_json_tasks, so no
+ * document tree is built: each task is constructed as its object closes.
+ * String values outside a projection are dropped as soon as they are parsed.
  *
  * Format specifics:
  * - Expects a top-level JSON array of task objects.
@@ -37,14 +41,16 @@
  * @copydoc ITaskReader::read_tasks
  *
  * Error and format-specific behavior:
- * - The reader will typically skip malformed task objects (missing required fields
- *   or invalid id) and continue parsing the rest of the array.
- * - Parsing or I/O failures may throw exceptions (e.g. from nlohmann::json or std::ifstream).
- * - @note Thread-safety: caller should assume this is not thread-safe unless
- *   otherwise documented.
+ * - The reader skips task objects with missing required fields or an invalid id
+ *   (with a warning) and continues parsing the rest of the array.
+ * - @throws std::runtime_error if the file cannot be opened, is not valid JSON,
+ *   is not an array of objects, or a known field holds the wrong type.
+ * - @note Thread-safety: `read_tasks` calls may run concurrently; the reader
+ *   keeps no per-call state.
  */
 class JSONReader : public ITaskReader {
 public:
   bool can_handle(std::string_view filepath) const override;
-  std::vector<Task> read_tasks(std::string_view filepath) override;
+  using ITaskReader::read_tasks;
+  std::vector<Task> read_tasks(std::string_view filepath, TaskFields fields) override;
 };
@@ -0,0 +1,247 @@
+#include "io/json_task_parser.hpp"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <utility>
+
+using json = nlohmann::json;
+
+namespace {
+/// Fields of the task object being parsed
+struct PendingTask {
+  int id{0};
+  int priority{1};
+  std::string title;
+  std::string status;
+  std::string created_date;
+  std::string description;
+  std::string assignee;
+  std::string due_date;
+  std::vector<std::string> tags;
+  bool has_title{false}; ///< title is non-empty (it is only kept if projected)
+  bool has_status{false};
+};
+
+/**
+ * SAX handler tracking container depth. The task object sits at `record_depth_`
+ * (1 inside a top-level array, 0 for a bare object); its fields are one level
+ * deeper and tag strings two levels deeper. Anything else nested is skipped.
+ */
+class TaskHandler : public nlohmann::json_sax<json> {
+private:
+  std::vector<Task> &tasks_;
+  std::vector<std::string> &warnings_;
+  JsonLayout layout_;
+  TaskFields fields_;
+  size_t record_depth_;
+  size_t depth_{0};
+  std::string key_;
+  bool in_tags_{false};
+  PendingTask pending_;
+
+public:
+  TaskHandler(JsonLayout layout, TaskFields fields, std::vector<Task> &tasks, std::vector<std::string> &warnings) :
+      tasks_(tasks), warnings_(warnings), layout_(layout), fields_(fields),
+      record_depth_(layout == JsonLayout::Array ? 1 : 0) {}
+
+  bool null() override {
+    value_position();
+    if (in_tag())
+      wrong_type("tags");
+    return true;
+  }
+
+  bool boolean(bool) override {
+    value_position();
+    if (in_tag())
+      wrong_type("tags");
+    if (in_field() && is_known_field(key_))
+      wrong_type(key_);
+    return true;
+  }
+
+  bool number_integer(number_integer_t value) override {
+    number(static_cast<int>(value));
+    return true;
+  }
+
+  bool number_unsigned(number_unsigned_t value) override {
+    number(static_cast<int>(value));
+    return true;
+  }
+
+  bool number_float(number_float_t value, const string_t &) override {
+    number(static_cast<int>(value));
+    return true;
+  }
+
+  bool string(string_t &value) override {
+    value_position();
+    if (in_tag()) {
+      if (fields_.has(TaskField::Tags))
+        pending_.tags.push_back(std::move(value));
+    } else if (in_field()) {
+      if (key_ == "title")
+        pending_.has_title = !value.empty();
+      else if (key_ == "status")
+        pending_.has_status = !value.empty();
+      if (auto [field, projected] = string_field(); field) {
+        if (projected)
+          *field = std::move(value);
+      } else if (is_known_field(key_)) {
+        wrong_type(key_);
+      }
+    }
+    return true;
+  }
+
+  bool binary(binary_t &) override {
+    value_position();
+    return true;
+  }
+
+  bool start_object(std::size_t) override {
+    if (depth_ == 0 && layout_ == JsonLayout::Array)
+      throw std::runtime_error("expected a JSON array of tasks");
+    if (depth_ == record_depth_)
+      pending_ = PendingTask{};
+    else
+      nested();
+    ++depth_;
+    return true;
+  }
+
+  bool key(string_t &value) override {
+    if (depth_ == record_depth_ + 1)
+      key_ = std::move(value);
+    return true;
+  }
+
+  bool end_object() override {
+    --depth_;
+    if (depth_ == record_depth_)
+      finish();
+    return true;
+  }
+
+  bool start_array(std::size_t) override {
+    if (depth_ == 0 && layout_ == JsonLayout::Object)
+      throw std::runtime_error("expected a JSON task object");
+    if (depth_ == record_depth_)
+      throw std::runtime_error("expected a JSON task object in the array");
+    if (in_field() && key_ == "tags") {
+      pending_.tags.clear();
+      in_tags_ = true;
+    } else {
+      nested();
+    }
+    ++depth_;
+    return true;
+  }
+
+  bool end_array() override {
+    --depth_;
+    if (in_tags_ && depth_ == record_depth_ + 1)
+      in_tags_ = false;
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+    throw std::runtime_error(std::string("invalid JSON: ") + ex.what());
+  }
+
+private:
+  // Fields whose type is checked; a non-array `tags` is ignored like an unknown key
+  static bool is_known_field(std::string_view key) noexcept {
+    return key == "id" || key == "priority" || key == "title" || key == "status" ||
+           key == "created_date" || key == "description" || key == "assignee" || key == "due_date";
+  }
+
+  [[noreturn]] static void wrong_type(const std::string &key) {
+    throw std::runtime_error("task field '" + key + "' has the wrong type");
+  }
+
+  /// A value directly under the task object
+  bool in_field() const noexcept { return depth_ == record_depth_ + 1; }
+
+  /// An element of the task's tags array
+  bool in_tag() const noexcept { return in_tags_ && depth_ == record_depth_ + 2; }
+
+  // Rejects a scalar where the top-level container or a task object belongs
+  void value_position() const {
+    if (depth_ == 0)
+      throw std::runtime_error(layout_ == JsonLayout::Array ? "expected a JSON array of tasks"
+                                                            : "expected a JSON task object");
+    if (depth_ == record_depth_)
+      throw std::runtime_error("expected a JSON task object in the array");
+  }
+
+  // Pre: a container opens below a task object, other than the tags array.
+  void nested() const {
+    if (in_tag())
+      wrong_type("tags");
+    if (in_field() && is_known_field(key_))
+      wrong_type(key_);
+  }
+
+  // Post: the string field named by the current key (nullptr if none), and whether it is projected.
+  std::pair<std::string *, bool> string_field() noexcept {
+    if (key_ == "title")
+      return {&pending_.title, fields_.has(TaskField::Title)};
+    if (key_ == "status")
+      return {&pending_.status, fields_.has(TaskField::Status)};
+    if (key_ == "created_date")
+      return {&pending_.created_date, fields_.has(TaskField::CreatedDate)};
+    if (key_ == "description")
+      return {&pending_.description, fields_.has(TaskField::Description)};
+    if (key_ == "assignee")
+      return {&pending_.assignee, fields_.has(TaskField::Assignee)};
+    if (key_ == "due_date")
+      return {&pending_.due_date, fields_.has(TaskField::DueDate)};
+    return {nullptr, false};
+  }
+
+  void number(int value) {
+    value_position();
+    if (in_tag())
+      wrong_type("tags");
+    if (!in_field())
+      return;
+
+    if (key_ == "id")
+      pending_.id = value;
+    else if (key_ == "priority")
+      pending_.priority = value;
+    else if (is_known_field(key_))
+      wrong_type(key_);
+  }
+
+  void finish() {
+    if (pending_.id < 1) {
+      warnings_.emplace_back("Error while processing task: Invalid ID, must be greater than 0");
+      return;
+    }
+    if (!pending_.has_title || !pending_.has_status) {
+      warnings_.emplace_back("Error while processing task: Invalid title or status");
+      return;
+    }
+    tasks_.emplace_back(pending_.id,
+                        std::move(pending_.title),
+                        std::move(pending_.status),
+                        pending_.priority,
+                        std::move(pending_.created_date),
+                        std::move(pending_.description),
+                        std::move(pending_.assignee),
+                        std::move(pending_.due_date),
+                        std::move(pending_.tags));
+  }
+};
+} // anonymous namespace
+
+void parse_json_tasks(std::string_view text,
+                      JsonLayout layout,
+                      std::vector<Task> &tasks,
+                      std::vector<std::string> &warnings,
+                      TaskFields fields) {
+  TaskHandler handler(layout, fields, tasks, warnings);
+  json::sax_parse(text.begin(), text.end(), &handler);
+}
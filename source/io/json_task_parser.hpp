@@ -0,0 +1,34 @@
+#pragma once
+#include "../core/task.hpp"
+#include "../core/task_fields.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Top-level shape of a JSON text holding tasks
+enum class JsonLayout {
+  Array, ///< One array of task objects (a .json document)
+  Object ///< A single task object (one NDJSON line)
+};
+
+/**
+ * @brief Build tasks straight from JSON text with a SAX parser, without a document tree.
+ *
+ * Each task object is turned into a `Task` as soon as its closing brace is seen,
+ * so memory beyond the output is bounded by one record. Field rules match the
+ * JSONReader format: `id`, `title` and `status` are required; `priority`
+ * defaults to 1; `tags` is read when it is an array of strings; unknown keys
+ * (including nested values) are skipped; a `null` value counts as absent.
+ * String fields outside `fields` are checked and then dropped (see TaskFields).
+ *
+ * @pre `text` holds one complete JSON value laid out as `layout`.
+ * @post Valid tasks are appended to `tasks` in document order; one message per
+ *       skipped task (id < 1, empty title or status) is appended to `warnings`.
+ * @throws std::runtime_error on malformed JSON, on a top level that does not
+ *         match `layout`, or on a known field holding the wrong type.
+ */
+void parse_json_tasks(std::string_view text,
+                      JsonLayout layout,
+                      std::vector<Task> &tasks,
+                      std::vector<std::string> &warnings,
+                      TaskFields fields = TaskFields::all());
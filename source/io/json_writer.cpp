@@ -0,0 +1,121 @@
+#include "io/json_writer.hpp"
+
+namespace {
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+bool needs_escape(unsigned char c) noexcept { return c < 0x20 || c == '"' || c == '\\'; }
+
+// Post: `value` appended as a quoted JSON string; runs without escapes are copied whole
+void append_string(std::string &out, std::string_view value) {
+  out.push_back('"');
+  size_t run = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    const auto c = static_cast<unsigned char>(value[i]);
+    if (!needs_escape(c))
+      continue;
+    out.append(value.substr(run, i - run));
+    run = i + 1;
+    switch (c) {
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\\':
+      out.append("\\\\");
+      break;
+    case '\n':
+      out.append("\\n");
+      break;
+    case '\r':
+      out.append("\\r");
+      break;
+    case '\t':
+      out.append("\\t");
+      break;
+    default:
+      out.append("\\u00");
+      out.push_back(HEX_DIGITS[c >> 4]);
+      out.push_back(HEX_DIGITS[c & 0xF]);
+    }
+  }
+  out.append(value.substr(run));
+  out.push_back('"');
+}
+
+/// Layout of one task object: pretty (JSONWriter) or compact (NDJSONWriter)
+struct ObjectStyle {
+  std::string_view open;      ///< Before the first key
+  std::string_view key_break; ///< Before every key but the first, after the comma
+  std::string_view colon;     ///< Between a key and its value
+  std::string_view comma;     ///< Between two tags
+  std::string_view close;     ///< After the last value
+};
+
+constexpr ObjectStyle PRETTY{"  {\n    ", "\n    ", ": ", ", ", "\n  }"};
+constexpr ObjectStyle COMPACT{"{", "", ":", ",", "}"};
+
+void append_task_object(std::string &out, const Task &task, const ObjectStyle &style) {
+  bool first = true;
+  auto key = [&out, &style, &first](std::string_view name) {
+    if (!first) {
+      out.push_back(',');
+      out.append(style.key_break);
+    }
+    first = false;
+    out.push_back('"');
+    out.append(name);
+    out.push_back('"');
+    out.append(style.colon);
+  };
+  auto optional = [&out, &key](std::string_view name, const std::optional<std::string> &value) {
+    if (value) {
+      key(name);
+      append_string(out, *value);
+    }
+  };
+
+  out.append(style.open);
+  key("id");
+  append_int(out, task.id);
+  key("title");
+  append_string(out, task.title);
+  key("status");
+  append_string(out, task.status);
+  key("priority");
+  append_int(out, task.priority);
+  key("created_date");
+  append_string(out, task.created_date);
+  optional("description", task.description);
+  optional("assignee", task.assignee);
+  optional("due_date", task.due_date);
+  key("tags");
+  out.push_back('[');
+  for (size_t i = 0; i < task.tags.size(); ++i) {
+    if (i > 0)
+      out.append(style.comma);
+    append_string(out, task.tags[i]);
+  }
+  out.push_back(']');
+  out.append(style.close);
+}
+} // anonymous namespace
+
+bool JSONWriter::can_handle(std::string_view filepath) const { return filepath.ends_with(".json"); }
+
+void JSONWriter::append_header(std::string &out, size_t count) const { out.append(count == 0 ? "[" : "[\n"); }
+
+void JSONWriter::append_task(std::string &out, const Task &task, size_t index) const {
+  if (index > 0)
+    out.append(",\n");
+  append_task_object(out, task, PRETTY);
+}
+
+void JSONWriter::append_footer(std::string &out, size_t count) const { out.append(count == 0 ? "]\n" : "\n]\n"); }
+
+bool NDJSONWriter::can_handle(std::string_view filepath) const {
+  return filepath.ends_with(".jsonl") || filepath.ends_with(".ndjson");
+}
+
+void NDJSONWriter::append_task(std::string &out, const Task &task, size_t) const {
+  append_task_object(out, task, COMPACT);
+  out.push_back('\n');
+}
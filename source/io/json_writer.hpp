@@ -0,0 +1,52 @@
+#pragma once
+#include "chunked_task_writer.hpp"
+#include <string>
+#include <string_view>
+
+/**
+ * @brief JSON writer producing the pretty-printed array format JSONReader accepts.
+ *
+ * Format specifics:
+ * - A top-level array with one object per task, indented by two spaces.
+ * - Fields in the order id, title, status, priority, created_date,
+ *   description, assignee, due_date, tags; unset optional fields are omitted
+ *   and `tags` is always an array.
+ * - Strings are escaped per RFC 8259 (`"`, `\`, and control characters);
+ *   other bytes, including UTF-8 sequences, are copied unchanged.
+ *
+ * @copydoc ITaskWriter::write_tasks
+ */
+class JSONWriter : public ChunkedTaskWriter {
+public:
+  using ChunkedTaskWriter::ChunkedTaskWriter;
+
+  bool can_handle(std::string_view filepath) const override;
+  std::string_view format_name() const noexcept override { return "json"; }
+
+protected:
+  void append_header(std::string &out, size_t count) const override;
+  void append_task(std::string &out, const Task &task, size_t index) const override;
+  void append_footer(std::string &out, size_t count) const override;
+  size_t row_overhead() const noexcept override { return 160; }
+};
+
+/**
+ * @brief Writer for newline-delimited JSON (`.jsonl`, `.ndjson`), as NDJSONReader accepts.
+ *
+ * One compact task object per line, with the same fields and escaping as JSONWriter.
+ *
+ * @copydoc ITaskWriter::write_tasks
+ */
+class NDJSONWriter : public ChunkedTaskWriter {
+public:
+  using ChunkedTaskWriter::ChunkedTaskWriter;
+
+  bool can_handle(std::string_view filepath) const override;
+  std::string_view format_name() const noexcept override { return "ndjson"; }
+
+protected:
+  void append_header(std::string &, size_t) const override {}
+  void append_task(std::string &out, const Task &task, size_t index) const override;
+  void append_footer(std::string &, size_t) const override {}
+  size_t row_overhead() const noexcept override { return 120; }
+};
@@ -0,0 +1,83 @@
+#include "io/mapped_file.hpp"
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TASKPROC_HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path &filepath) {
+#ifdef TASKPROC_HAVE_MMAP
+  int fd = ::open(filepath.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Failed to open file for mapping: " + filepath.string());
+
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + filepath.string());
+  }
+
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file: " + filepath.string());
+    }
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(addr);
+    mapped_ = true;
+  }
+  ::close(fd);
+#else
+  std::ifstream ifs(filepath, std::ios::binary | std::ios::ate);
+  if (!ifs)
+    throw std::runtime_error("Failed to open file for reading: " + filepath.string());
+  buffer_.resize(static_cast<size_t>(ifs.tellg()));
+  ifs.seekg(0);
+  ifs.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept :
+    data_(std::exchange(other.data_, nullptr)),
+    size_(std::exchange(other.size_, 0)),
+    mapped_(std::exchange(other.mapped_, false)),
+    buffer_(std::move(other.buffer_)) {
+  if (!mapped_ && !buffer_.empty())
+    data_ = buffer_.data();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped_ = std::exchange(other.mapped_, false);
+    buffer_ = std::move(other.buffer_);
+    if (!mapped_ && !buffer_.empty())
+      data_ = buffer_.data();
+  }
+  return *this;
+}
+
+void MappedFile::release() noexcept {
+#ifdef TASKPROC_HAVE_MMAP
+  if (mapped_)
+    ::munmap(const_cast<char *>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  buffer_.clear();
+}
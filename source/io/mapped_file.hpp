@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where the platform allows it.
+ *
+ * On POSIX systems the file is mapped with `mmap`; elsewhere its contents are read
+ * into an owned buffer. Either way `view()` exposes the bytes as a contiguous range.
+ *
+ * @note Move-only. The view is invalidated when the MappedFile is destroyed or moved from.
+ */
+class MappedFile {
+private:
+  const char *data_{nullptr};
+  size_t size_{0};
+  bool mapped_{false};
+  std::vector<char> buffer_; ///< Fallback storage when the file is not mapped
+
+public:
+  /**
+   * @brief Map the file at `filepath`.
+   * @pre `filepath` names a readable regular file.
+   * @post `view()` spans the entire file contents.
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::filesystem::path &filepath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /// Contents of the file (empty for an empty file).
+  std::string_view view() const noexcept { return {data_, size_}; }
+
+  /// Size of the file in bytes.
+  size_t size() const noexcept { return size_; }
+
+private:
+  void release() noexcept;
+};
@@ -0,0 +1,94 @@
+#include "io/ndjson_reader.hpp"
+#include "core/profiler.hpp"
+#include "io/json_task_parser.hpp"
+#include "io/mapped_file.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+struct ChunkResult {
+  std::vector<Task> tasks;
+  std::vector<std::string> warnings;
+};
+
+bool is_blank(std::string_view line) noexcept {
+  return std::all_of(
+      line.begin(), line.end(), [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; });
+}
+
+// Post: offset just past the first '\n' at or after `pos`, or `data.size()`.
+size_t next_line_start(std::string_view data, size_t pos) noexcept {
+  const size_t newline = data.find('\n', pos);
+  return newline == std::string_view::npos ? data.size() : newline + 1;
+}
+
+// Pre: `first` starts a line of `data` and `last` ends one (or is the end of the file).
+void parse_lines(std::string_view data, size_t first, size_t last, TaskFields fields, ChunkResult &result) {
+  for (size_t pos = first; pos < last;) {
+    const size_t end = std::min(next_line_start(data, pos), last);
+    const std::string_view line = data.substr(pos, end - pos);
+    if (!is_blank(line)) {
+      try {
+        parse_json_tasks(line, JsonLayout::Object, result.tasks, result.warnings, fields);
+      } catch (const std::runtime_error &e) {
+        // Line numbers are only counted on the error path
+        const size_t line_number = 1 + std::count(data.begin(), data.begin() + pos, '\n');
+        throw std::runtime_error("line " + std::to_string(line_number) + ": " + e.what());
+      }
+    }
+    pos = end;
+  }
+}
+} // anonymous namespace
+
+NDJSONReader::NDJSONReader(ThreadPool &pool, size_t min_chunk_bytes) noexcept :
+    pool_(&pool), min_chunk_bytes_(std::max<size_t>(min_chunk_bytes, 1)) {}
+
+bool NDJSONReader::can_handle(std::string_view filepath) const {
+  return filepath.ends_with(".jsonl") || filepath.ends_with(".ndjson");
+}
+
+std::vector<Task> NDJSONReader::read_tasks(std::string_view filepath, TaskFields fields) {
+  TASKPROC_PROFILE_SCOPE("reader.ndjson");
+  const MappedFile file{std::filesystem::path(filepath)};
+  std::string_view data = file.view();
+  if (data.starts_with("\xEF\xBB\xBF"))
+    data.remove_prefix(3); // UTF-8 byte order mark
+
+  // 1. Cut at the first line break after each even split point
+  const size_t chunk_count =
+      std::clamp<size_t>(data.size() / min_chunk_bytes_, 1, std::max<size_t>(pool_->size() * 4, 1));
+  const size_t step = data.size() / chunk_count;
+
+  std::vector<size_t> bounds(chunk_count + 1, data.size());
+  bounds[0] = 0;
+  for (size_t i = 1; i < chunk_count; ++i) {
+    bounds[i] = std::max(next_line_start(data, i * step), bounds[i - 1]);
+  }
+
+  // 2. Parse chunks in parallel
+  std::vector<ChunkResult> results(chunk_count);
+  pool_->parallel_for(chunk_count, [&](size_t i) { parse_lines(data, bounds[i], bounds[i + 1], fields, results[i]); });
+
+  // 3. Merge in file order
+  size_t total = 0;
+  for (const auto &result : results) {
+    total += result.tasks.size();
+    for (const auto &warning : result.warnings) {
+      std::cerr << warning << "\n";
+    }
+  }
+  if (results.size() == 1)
+    return std::move(results.front().tasks); // nothing to merge
+
+  std::vector<Task> tasks;
+  tasks.reserve(total);
+  for (auto &result : results) {
+    std::move(result.tasks.begin(), result.tasks.end(), std::back_inserter(tasks));
+    std::vector<Task>().swap(result.tasks); // release the moved-from shells chunk by chunk
+  }
+  return tasks;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "../core/task.hpp"
+#include "../core/thread_pool.hpp"
+#include "reader.hpp"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Multi-threaded reader for newline-delimited JSON (`.jsonl`, `.ndjson`).
+ *
+ * Format specifics:
+ * - One task object per line, with the same fields as the JSONReader format.
+ * - Blank lines are ignored; `\r\n` line endings are accepted.
+ *
+ * JSON strings cannot hold a raw newline, so the file is cut into chunks at
+ * line breaks without scanning for quotes. Chunks are parsed with the SAX
+ * parser on a thread pool and merged in file order.
+ *
+ * @copydoc ITaskReader::read_tasks
+ *
+ * Error and format-specific behavior:
+ * - Lines with a missing title/status or an invalid id are skipped with a warning.
+ * - @throws std::runtime_error naming the line if the file cannot be opened, a
+ *   line is not a JSON object, or a known field holds the wrong type.
+ * - @note Thread-safety: `read_tasks` calls may run concurrently (they share the pool).
+ */
+class NDJSONReader : public ITaskReader {
+public:
+  /// Bytes per chunk below which a file is not split further
+  static constexpr size_t DEFAULT_MIN_CHUNK_BYTES = size_t{1} << 20;
+
+  /**
+   * @param pool Pool that parses the chunks (must outlive the reader).
+   * @param min_chunk_bytes Smallest chunk worth handing to a worker.
+   */
+  explicit NDJSONReader(ThreadPool &pool = ThreadPool::shared(),
+                        size_t min_chunk_bytes = DEFAULT_MIN_CHUNK_BYTES) noexcept;
+
+  bool can_handle(std::string_view filepath) const override;
+  using ITaskReader::read_tasks;
+  std::vector<Task> read_tasks(std::string_view filepath, TaskFields fields) override;
+
+private:
+  ThreadPool *pool_;
+  size_t min_chunk_bytes_;
+};
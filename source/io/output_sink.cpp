@@ -0,0 +1,100 @@
+#include "io/output_sink.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define TASKPROC_HAVE_WRITEV 1
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+#endif
+
+#ifdef TASKPROC_HAVE_WRITEV
+FileSink::FileSink(const std::filesystem::path &path) : path_(path) {
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0)
+    throw std::runtime_error("Failed to open file for writing: " + path.string() + ": " + std::strerror(errno));
+}
+
+FileSink::~FileSink() {
+  if (fd_ >= 0)
+    ::close(fd_);
+}
+
+void FileSink::write(std::span<const std::string> buffers) {
+  if (fd_ < 0)
+    throw std::runtime_error("Write to closed file: " + path_.string());
+
+  std::vector<iovec> pending;
+  pending.reserve(buffers.size());
+  for (const std::string &buffer : buffers) {
+    if (!buffer.empty())
+      pending.push_back(iovec{const_cast<char *>(buffer.data()), buffer.size()});
+  }
+
+  // A short write leaves the rest of the batch (possibly mid-buffer) for the next call
+  size_t first = 0;
+  while (first < pending.size()) {
+    const int count = static_cast<int>(std::min<size_t>(pending.size() - first, IOV_MAX));
+    const ssize_t written = ::writev(fd_, pending.data() + first, count);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written < 0)
+      throw std::runtime_error("Failed to write " + path_.string() + ": " + std::strerror(errno));
+
+    auto left = static_cast<size_t>(written);
+    for (; first < pending.size() && left >= pending[first].iov_len; ++first) {
+      left -= pending[first].iov_len;
+    }
+    if (left > 0) {
+      pending[first].iov_base = static_cast<char *>(pending[first].iov_base) + left;
+      pending[first].iov_len -= left;
+    }
+  }
+}
+
+void FileSink::close() {
+  const int fd = std::exchange(fd_, -1);
+  if (fd >= 0 && ::close(fd) != 0)
+    throw std::runtime_error("Failed to close " + path_.string() + ": " + std::strerror(errno));
+}
+#else
+FileSink::FileSink(const std::filesystem::path &path) : path_(path) {
+  out_.rdbuf()->pubsetbuf(nullptr, 0); // buffers are already large; skip the extra copy
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_)
+    throw std::runtime_error("Failed to open file for writing: " + path.string());
+}
+
+FileSink::~FileSink() = default;
+
+void FileSink::write(std::span<const std::string> buffers) {
+  for (const std::string &buffer : buffers) {
+    out_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+  if (!out_)
+    throw std::runtime_error("Failed to write " + path_.string());
+}
+
+void FileSink::close() {
+  out_.close();
+  if (!out_)
+    throw std::runtime_error("Failed to close " + path_.string());
+}
+#endif
+
+void StreamSink::write(std::span<const std::string> buffers) {
+  for (const std::string &buffer : buffers) {
+    out_->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+  if (!*out_)
+    throw std::runtime_error("Failed to write output stream");
+}
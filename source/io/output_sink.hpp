@@ -0,0 +1,65 @@
+#pragma once
+#include "writer.hpp"
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+#include <span>
+#include <string>
+
+/**
+ * @brief OutputSink writing to a file, created or truncated on construction.
+ *
+ * On POSIX systems each batch of buffers goes to the kernel in one `writev`
+ * call (or a few, past `IOV_MAX`); elsewhere it is written through an
+ * unbuffered std::ofstream.
+ *
+ * @note Not copyable or thread-safe. A failed export leaves whatever prefix was written.
+ */
+class FileSink : public OutputSink {
+private:
+  std::filesystem::path path_;
+#if defined(__unix__) || defined(__APPLE__)
+  int fd_{-1};
+#else
+  std::ofstream out_;
+#endif
+
+public:
+  /**
+   * @brief Open `path` for writing.
+   * @post The file exists and is empty.
+   * @throws std::runtime_error if the file cannot be created.
+   */
+  explicit FileSink(const std::filesystem::path &path);
+
+  /// Closes the file (errors are ignored; call `close()` to see them).
+  ~FileSink() override;
+
+  FileSink(const FileSink &) = delete;
+  FileSink &operator=(const FileSink &) = delete;
+
+  void write(std::span<const std::string> buffers) override;
+
+  /**
+   * @brief Close the file, reporting a failed final flush.
+   * @post The file is closed; further writes throw.
+   * @throws std::runtime_error if closing fails.
+   */
+  void close();
+};
+
+/**
+ * @brief OutputSink appending to a std::ostream (e.g. std::cout when piping).
+ *
+ * Each buffer is passed to `std::ostream::write` whole.
+ */
+class StreamSink : public OutputSink {
+private:
+  std::ostream *out_;
+
+public:
+  /// @param out Stream to write to (must outlive the sink).
+  explicit StreamSink(std::ostream &out) noexcept : out_(&out) {}
+
+  void write(std::span<const std::string> buffers) override;
+};
@@ -0,0 +1,258 @@
+#include "io/parallel_csv_reader.hpp"
+#include "core/profiler.hpp"
+#include "io/mapped_file.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+enum Column : size_t { Id, Title, Status, Priority, CreatedDate, Description, Assignee, DueDate, Tags, COLUMN_COUNT };
+
+constexpr std::array<std::string_view, COLUMN_COUNT> COLUMN_NAMES{
+    "id", "title", "status", "priority", "created_date", "description", "assignee", "due_date", "tags"};
+
+/// Field position of each required column in a record
+using ColumnMap = std::array<size_t, COLUMN_COUNT>;
+
+struct ChunkResult {
+  std::vector<Task> tasks;
+  std::vector<std::string> warnings;
+};
+
+std::string_view trim(std::string_view s) noexcept {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+// Pre: `raw` is one field as it appears in the file.
+// Post: trimmed, and if the field is wrapped in quotes, unwrapped with "" collapsed to ".
+std::string field_value(std::string_view raw) {
+  raw = trim(raw);
+  if (raw.size() < 2 || raw.front() != '"' || raw.back() != '"')
+    return std::string(raw);
+
+  raw = raw.substr(1, raw.size() - 2);
+  std::string value;
+  value.reserve(raw.size());
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] == '"' && i + 1 < raw.size() && raw[i + 1] == '"')
+      ++i;
+    value += raw[i];
+  }
+  return value;
+}
+
+// Post: true if the field's value (see field_value) is empty, decided without unescaping it.
+bool field_empty(std::string_view raw) noexcept {
+  raw = trim(raw);
+  return raw.empty() || raw == "\"\"";
+}
+
+// Post: integer value of the field; an empty field is 0.
+int parse_int(std::string_view raw, Column column) {
+  const std::string value = field_value(raw);
+  if (value.empty())
+    return 0;
+
+  int result = 0;
+  auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+  if (ec != std::errc{} || end != value.data() + value.size())
+    throw std::runtime_error("invalid integer '" + value + "' in column '" + std::string(COLUMN_NAMES[column]) + "'");
+  return result;
+}
+
+// Pre: `tags_field` is the unescaped tags string, for example "tag1,tag2,tag3".
+// Post: comma-separated tokens; a trailing comma does not add an empty tag (as std::getline).
+std::vector<std::string> split_tags(std::string_view tags_field) {
+  std::vector<std::string> tags;
+  while (!tags_field.empty()) {
+    const size_t comma = tags_field.find(',');
+    tags.emplace_back(tags_field.substr(0, comma));
+    if (comma == std::string_view::npos)
+      break;
+    tags_field.remove_prefix(comma + 1);
+  }
+  return tags;
+}
+
+// Pre: `in_quotes` is the quote state at `pos`.
+// Post: offset just past the first unquoted '\n' at or after `pos`, or `data.size()`.
+size_t next_record_start(std::string_view data, size_t pos, bool in_quotes) noexcept {
+  for (; pos < data.size(); ++pos) {
+    const char c = data[pos];
+    if (c == '"')
+      in_quotes = !in_quotes;
+    else if (c == '\n' && !in_quotes)
+      return pos + 1;
+  }
+  return data.size();
+}
+
+// Post: `fields` holds the raw fields of `record`, split at unquoted commas.
+void split_fields(std::string_view record, std::vector<std::string_view> &fields) {
+  fields.clear();
+  bool in_quotes = false;
+  size_t start = 0;
+  for (size_t i = 0; i < record.size(); ++i) {
+    if (record[i] == '"')
+      in_quotes = !in_quotes;
+    else if (record[i] == ',' && !in_quotes) {
+      fields.push_back(record.substr(start, i - start));
+      start = i + 1;
+    }
+  }
+  fields.push_back(record.substr(start));
+}
+
+// Post: `record` without its line terminator ('\n' or "\r\n").
+std::string_view strip_terminator(std::string_view record) noexcept {
+  if (!record.empty() && record.back() == '\n')
+    record.remove_suffix(1);
+  if (!record.empty() && record.back() == '\r')
+    record.remove_suffix(1);
+  return record;
+}
+
+ColumnMap map_columns(std::string_view header) {
+  std::vector<std::string_view> fields;
+  split_fields(header, fields);
+
+  ColumnMap columns{};
+  for (size_t c = 0; c < COLUMN_COUNT; ++c) {
+    auto it = std::find_if(fields.begin(), fields.end(), [name = COLUMN_NAMES[c]](std::string_view field) {
+      return field_value(field) == name;
+    });
+    if (it == fields.end())
+      throw std::runtime_error("missing column in CSV header: " + std::string(COLUMN_NAMES[c]));
+    columns[c] = static_cast<size_t>(it - fields.begin());
+  }
+  return columns;
+}
+
+// Pre: `chunk` starts at a record boundary and ends at one (or at the end of the file).
+// Post: fields outside `projection` are validated but never unescaped or copied.
+void parse_chunk(std::string_view chunk, const ColumnMap &columns, TaskFields projection, ChunkResult &result) {
+  std::vector<std::string_view> fields;
+  auto field = [&fields, &columns](Column column) {
+    const size_t index = columns[column];
+    return index < fields.size() ? fields[index] : std::string_view{};
+  };
+  auto value = [&field, projection](Column column, TaskField task_field) {
+    return projection.has(task_field) ? field_value(field(column)) : std::string();
+  };
+  auto optional_value = [&field, projection](Column column, TaskField task_field) -> std::optional<std::string> {
+    if (!projection.has(task_field))
+      return std::nullopt;
+    return field_value(field(column));
+  };
+
+  size_t pos = 0;
+  while (pos < chunk.size()) {
+    const size_t end = next_record_start(chunk, pos, false);
+    const std::string_view record = strip_terminator(chunk.substr(pos, end - pos));
+    pos = end;
+    if (trim(record).empty())
+      continue;
+
+    split_fields(record, fields);
+
+    // Integers are parsed before validation, so a malformed number fails the read even on a skipped row
+    const int id = parse_int(field(Id), Id);
+    const int priority = std::max(parse_int(field(Priority), Priority), 1);
+    if (id < 1) {
+      result.warnings.emplace_back("Error while processing task: Invalid ID, must be greater than 0");
+      continue;
+    }
+    if (field_empty(field(Title)) || field_empty(field(Status))) {
+      result.warnings.emplace_back("Error while processing task: Invalid title or status");
+      continue;
+    }
+
+    result.tasks.emplace_back(id,
+                              value(Title, TaskField::Title),
+                              value(Status, TaskField::Status),
+                              priority,
+                              value(CreatedDate, TaskField::CreatedDate),
+                              optional_value(Description, TaskField::Description),
+                              optional_value(Assignee, TaskField::Assignee),
+                              optional_value(DueDate, TaskField::DueDate),
+                              projection.has(TaskField::Tags) ? split_tags(field_value(field(Tags)))
+                                                              : std::vector<std::string>{});
+  }
+}
+} // anonymous namespace
+
+ParallelCSVReader::ParallelCSVReader(ThreadPool &pool, size_t min_chunk_bytes) noexcept :
+    pool_(&pool), min_chunk_bytes_(std::max<size_t>(min_chunk_bytes, 1)) {}
+
+bool ParallelCSVReader::can_handle(std::string_view filepath) const { return filepath.ends_with(".csv"); }
+
+std::vector<Task> ParallelCSVReader::read_tasks(std::string_view filepath, TaskFields fields) {
+  TASKPROC_PROFILE_SCOPE("reader.parallel_csv");
+  const MappedFile file{std::filesystem::path(filepath)};
+  std::string_view data = file.view();
+  if (data.starts_with("\xEF\xBB\xBF"))
+    data.remove_prefix(3); // UTF-8 byte order mark
+
+  // 1. Header
+  const size_t header_end = next_record_start(data, 0, false);
+  const std::string_view header = strip_terminator(data.substr(0, header_end));
+  if (trim(header).empty())
+    throw std::runtime_error("CSV file has no header: " + std::string(filepath));
+  const ColumnMap columns = map_columns(header);
+  const std::string_view body = data.substr(header_end);
+
+  // 2. Cut the body into chunks; the quote parity before each cut tells whether it lies inside a field
+  const size_t chunk_count =
+      std::clamp<size_t>(body.size() / min_chunk_bytes_, 1, std::max<size_t>(pool_->size() * 4, 1));
+  const size_t step = body.size() / chunk_count;
+
+  std::vector<unsigned char> odd_quotes(chunk_count, 0);
+  pool_->parallel_for(chunk_count, [&](size_t i) {
+    const size_t first = i * step;
+    const size_t last = i + 1 == chunk_count ? body.size() : first + step;
+    odd_quotes[i] = std::count(body.begin() + first, body.begin() + last, '"') % 2;
+  });
+
+  std::vector<size_t> bounds(chunk_count + 1, body.size());
+  bounds[0] = 0;
+  bool in_quotes = false;
+  for (size_t i = 1; i < chunk_count; ++i) {
+    in_quotes ^= odd_quotes[i - 1] != 0;
+    bounds[i] = std::max(next_record_start(body, i * step, in_quotes), bounds[i - 1]);
+  }
+
+  // 3. Parse chunks in parallel
+  std::vector<ChunkResult> results(chunk_count);
+  pool_->parallel_for(chunk_count, [&](size_t i) {
+    parse_chunk(body.substr(bounds[i], bounds[i + 1] - bounds[i]), columns, fields, results[i]);
+  });
+
+  // 4. Merge in file order
+  size_t total = 0;
+  for (const auto &result : results) {
+    total += result.tasks.size();
+    for (const auto &warning : result.warnings) {
+      std::cerr << warning << "\n";
+    }
+  }
+  if (results.size() == 1)
+    return std::move(results.front().tasks); // nothing to merge
+
+  std::vector<Task> tasks;
+  tasks.reserve(total);
+  for (auto &result : results) {
+    std::move(result.tasks.begin(), result.tasks.end(), std::back_inserter(tasks));
+    std::vector<Task>().swap(result.tasks); // release the moved-from shells chunk by chunk
+  }
+  return tasks;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "../core/task.hpp"
+#include "../core/thread_pool.hpp"
+#include "reader.hpp"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Multi-threaded CSV reader over a memory-mapped file.
+ *
+ * Accepts the same input as CSVReader (header row naming the columns
+ * id,title,status,priority,created_date,description,assignee,due_date,tags in
+ * any order, extra columns ignored; comma separator; double-quote escaping;
+ * spaces/tabs trimmed) and applies the same row validation: rows with
+ * `id < 1` or an empty title/status are skipped with a warning and
+ * `priority < 1` is clamped to 1; `tags` is split on commas. Unlike
+ * CSVReader, quoted fields may span lines.
+ *
+ * The body is cut into chunks at record boundaries found from the quote
+ * parity of each chunk (counted in parallel), so a newline inside quotes never
+ * splits a record. Chunks are parsed on a thread pool and merged in file
+ * order; warnings are reported in file order after the merge. Fields outside
+ * a projection are located (the record still has to be split) but neither
+ * unescaped nor copied.
+ *
+ * @copydoc ITaskReader::read_tasks
+ *
+ * Error and format-specific behavior:
+ * - @throws std::runtime_error if the file cannot be opened, has no header,
+ *   lacks a required column, or an integer field does not parse.
+ * - @note Thread-safety: `read_tasks` calls may run concurrently (they share the pool).
+ */
+class ParallelCSVReader : public ITaskReader {
+public:
+  /// Bytes per chunk below which a file is not split further
+  static constexpr size_t DEFAULT_MIN_CHUNK_BYTES = size_t{1} << 20;
+
+  /**
+   * @param pool Pool that parses the chunks (must outlive the reader).
+   * @param min_chunk_bytes Smallest chunk worth handing to a worker.
+   */
+  explicit ParallelCSVReader(ThreadPool &pool = ThreadPool::shared(),
+                             size_t min_chunk_bytes = DEFAULT_MIN_CHUNK_BYTES) noexcept;
+
+  bool can_handle(std::string_view filepath) const override;
+  using ITaskReader::read_tasks;
+  std::vector<Task> read_tasks(std::string_view filepath, TaskFields fields) override;
+
+private:
+  ThreadPool *pool_;
+  size_t min_chunk_bytes_;
+};
@@ -1,12 +1,15 @@
 #pragma once
 #include "../core/task.hpp"
+#include "../core/task_fields.hpp"
 #include <string_view>
 #include <vector>
 
 /**
  * @brief Abstract interface for task file readers.
  *
- * Implementations parse a file and produce Task objects.
+ * Implementations parse a file and produce Task objects. `read_tasks` must be
+ * safe to call concurrently on one instance: the shards of a dataset are read
+ * in parallel (see DataManager::read_dataset).
  */
 class ITaskReader {
 public:
@@ -24,7 +27,17 @@ public:
    * @param filepath Path to the input file.
    * @return Vector of parsed Task objects.
    */
-  virtual std::vector<Task> read_tasks(std::string_view filepath) = 0;
+  std::vector<Task> read_tasks(std::string_view filepath) { return read_tasks(filepath, TaskFields::all()); }
+
+  /**
+   * @brief Parse tasks from the file at `filepath`, decoding only `fields`.
+   * @pre As for `read_tasks(filepath)`.
+   * @post Returns the same tasks as `read_tasks(filepath)`, except that string fields
+   *       outside `fields` may be left empty (see TaskFields). Implementations skip
+   *       those fields without copying them where their format allows.
+   * @throws As for `read_tasks(filepath)`.
+   */
+  virtual std::vector<Task> read_tasks(std::string_view filepath, TaskFields fields) = 0;
 
   /**
    * @brief Check whether this reader can handle `filepath` (e.g. by extension).
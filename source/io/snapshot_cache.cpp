@@ -0,0 +1,285 @@
+#include "io/snapshot_cache.hpp"
+#include "core/profiler.hpp"
+#include "io/binary_io.hpp"
+#include "io/mapped_file.hpp"
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+constexpr char SNAPSHOT_MAGIC[8] = {'T', 'P', 'S', 'N', 'A', 'P', '\0', '\0'};
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+constexpr char TEXT_INDEX_MAGIC[8] = {'T', 'P', 'T', 'E', 'X', 'T', '\0', '\0'};
+constexpr std::uint32_t TEXT_INDEX_VERSION = 1;
+constexpr char SHARDS_MAGIC[8] = {'T', 'P', 'S', 'H', 'A', 'R', 'D', '\0'};
+constexpr std::uint32_t SHARDS_VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+void put_optional(ByteWriter &out, const std::optional<std::string> &value) {
+  out.put(static_cast<std::uint8_t>(value.has_value()));
+  if (value)
+    out.put_string(*value);
+}
+
+// Post: the string, or (if `keep` is false) an empty one; the string is skipped without a copy either way.
+std::string get_string(ByteReader &in, bool keep) {
+  const std::string_view value = in.get_string();
+  return keep ? std::string(value) : std::string();
+}
+
+std::optional<std::string> get_optional(ByteReader &in, bool keep) {
+  if (in.get<std::uint8_t>() == 0)
+    return std::nullopt;
+  const std::string_view value = in.get_string();
+  return keep ? std::optional<std::string>(value) : std::nullopt;
+}
+
+void write_header(ByteWriter &out, const char (&magic)[8], std::uint32_t version, const SourceFingerprint &source) {
+  out.put_raw(std::string_view(magic, sizeof(magic)));
+  out.put(version);
+  out.put(BYTE_ORDER_MARK);
+  out.put_string(source.path);
+  out.put(static_cast<std::uint64_t>(source.size));
+  out.put(source.mtime);
+}
+
+// Pre: `in` is positioned at the start of the file.
+// Post: the fingerprint recorded in a `magic`/`version` header, std::nullopt for another header;
+//       `in` is positioned past it.
+std::optional<SourceFingerprint> read_source(ByteReader &in, const char (&magic)[8], std::uint32_t version) {
+  if (in.get_raw(sizeof(magic)) != std::string_view(magic, sizeof(magic)))
+    return std::nullopt;
+  if (in.get<std::uint32_t>() != version)
+    return std::nullopt;
+  if (in.get<std::uint32_t>() != BYTE_ORDER_MARK)
+    return std::nullopt;
+
+  SourceFingerprint stored;
+  stored.path = std::string(in.get_string());
+  stored.size = in.get<std::uint64_t>();
+  stored.mtime = in.get<std::int64_t>();
+  return stored;
+}
+
+// Pre: `in` is positioned at the start of the file.
+// Post: returns true if the header is `magic`/`version` and was built from `source`; `in` is positioned past it.
+bool read_header(ByteReader &in, const char (&magic)[8], std::uint32_t version, const SourceFingerprint &source) {
+  return read_source(in, magic, version) == source;
+}
+
+// Post: `target` holds `data`, written to a temporary file first and renamed over it.
+void write_atomically(const std::filesystem::path &target, const ByteWriter &data) {
+  const auto tmp = target.string() + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      throw std::runtime_error("Failed to open temp file for writing: " + tmp);
+    ofs.write(data.data().data(), static_cast<std::streamsize>(data.size()));
+    if (!ofs)
+      throw std::runtime_error("Failed to write file: " + tmp);
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp, target, ec);
+  if (ec)
+    throw std::runtime_error("Failed to commit file: " + ec.message());
+}
+} // anonymous namespace
+
+void SnapshotCache::write(const SourceFingerprint &source, const std::vector<const Task *> &tasks) const {
+  TASKPROC_PROFILE_SCOPE("snapshot.write");
+  const std::filesystem::path target_path = path();
+  const auto tmp = target_path.string() + ".tmp";
+
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      throw std::runtime_error("Failed to open temp snapshot file for writing: " + tmp);
+
+    ByteWriter out;
+    out.reserve(FLUSH_THRESHOLD + 4096);
+    write_header(out, SNAPSHOT_MAGIC, SNAPSHOT_VERSION, source);
+    out.put(static_cast<std::uint64_t>(tasks.size()));
+
+    for (const Task *task : tasks) {
+      out.put(static_cast<std::int32_t>(task->id));
+      out.put(static_cast<std::int32_t>(task->priority));
+      out.put_string(task->title);
+      out.put_string(task->status);
+      out.put_string(task->created_date);
+      put_optional(out, task->description);
+      put_optional(out, task->assignee);
+      put_optional(out, task->due_date);
+      out.put(static_cast<std::uint32_t>(task->tags.size()));
+      for (const auto &tag : task->tags) {
+        out.put_string(tag);
+      }
+
+      if (out.size() >= FLUSH_THRESHOLD) {
+        ofs.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+        out.clear();
+      }
+    }
+    ofs.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+    if (!ofs)
+      throw std::runtime_error("Failed to write snapshot file: " + tmp);
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp, target_path, ec);
+  if (ec)
+    throw std::runtime_error("Failed to commit snapshot file: " + ec.message());
+}
+
+std::optional<std::vector<Task>> SnapshotCache::read(const SourceFingerprint &source, TaskFields fields) const {
+  TASKPROC_PROFILE_SCOPE("snapshot.read");
+  const std::filesystem::path target_path = path();
+  std::error_code ec;
+  if (!std::filesystem::exists(target_path, ec))
+    return std::nullopt;
+
+  MappedFile file(target_path);
+  ByteReader in(file.view());
+  if (!read_header(in, SNAPSHOT_MAGIC, SNAPSHOT_VERSION, source))
+    return std::nullopt;
+
+  const auto count = in.get<std::uint64_t>();
+  // Every record is at least 27 bytes; reject counts the file cannot possibly hold
+  if (count > in.remaining() / 27)
+    throw std::runtime_error("Corrupt snapshot: implausible task count");
+
+  std::vector<Task> tasks;
+  tasks.reserve(count);
+  for (std::uint64_t i = 0; i < count; ++i) {
+    int id = in.get<std::int32_t>();
+    int priority = in.get<std::int32_t>();
+    std::string title = get_string(in, fields.has(TaskField::Title));
+    std::string status = get_string(in, fields.has(TaskField::Status));
+    std::string created_date = get_string(in, fields.has(TaskField::CreatedDate));
+    auto description = get_optional(in, fields.has(TaskField::Description));
+    auto assignee = get_optional(in, fields.has(TaskField::Assignee));
+    auto due_date = get_optional(in, fields.has(TaskField::DueDate));
+    const auto tag_count = in.get<std::uint32_t>();
+    if (tag_count > in.remaining() / sizeof(std::uint32_t))
+      throw std::runtime_error("Corrupt snapshot: implausible tag count");
+    std::vector<std::string> tags;
+    if (fields.has(TaskField::Tags)) {
+      tags.resize(tag_count);
+      for (auto &tag : tags) {
+        tag = in.get_string();
+      }
+    } else {
+      for (std::uint32_t t = 0; t < tag_count; ++t) {
+        in.get_string();
+      }
+    }
+
+    tasks.emplace_back(id,
+                       std::move(title),
+                       std::move(status),
+                       priority,
+                       std::move(created_date),
+                       std::move(description),
+                       std::move(assignee),
+                       std::move(due_date),
+                       std::move(tags));
+  }
+
+  if (!in.at_end())
+    throw std::runtime_error("Corrupt snapshot: trailing data");
+
+  return tasks;
+}
+
+std::optional<SourceFingerprint> SnapshotCache::source() const {
+  const std::filesystem::path target_path = path();
+  std::error_code ec;
+  if (!std::filesystem::exists(target_path, ec))
+    return std::nullopt;
+
+  MappedFile file(target_path);
+  ByteReader in(file.view());
+  return read_source(in, SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
+}
+
+void SnapshotCache::write_text_index(const SourceFingerprint &source, const TextIndex &index) const {
+  ByteWriter out;
+  write_header(out, TEXT_INDEX_MAGIC, TEXT_INDEX_VERSION, source);
+  index.serialize(out);
+  write_atomically(text_index_path(), out);
+}
+
+std::optional<TextIndex> SnapshotCache::read_text_index(const SourceFingerprint &source) const {
+  const std::filesystem::path target_path = text_index_path();
+  std::error_code ec;
+  if (!std::filesystem::exists(target_path, ec))
+    return std::nullopt;
+
+  MappedFile file(target_path);
+  ByteReader in(file.view());
+  if (!read_header(in, TEXT_INDEX_MAGIC, TEXT_INDEX_VERSION, source))
+    return std::nullopt;
+
+  TextIndex index = TextIndex::deserialize(in);
+  if (!in.at_end())
+    throw std::runtime_error("Corrupt text index: trailing data");
+  return index;
+}
+
+void SnapshotCache::write_shards(const SourceFingerprint &source, const std::vector<Shard> &shards) const {
+  ByteWriter out;
+  write_header(out, SHARDS_MAGIC, SHARDS_VERSION, source);
+  out.put(static_cast<std::uint64_t>(shards.size()));
+  for (const auto &shard : shards) {
+    out.put_string(shard.source.path);
+    out.put(static_cast<std::uint64_t>(shard.source.size));
+    out.put(shard.source.mtime);
+    out.put(static_cast<std::uint64_t>(shard.ids.size()));
+    for (int id : shard.ids) {
+      out.put(static_cast<std::int32_t>(id));
+    }
+  }
+  write_atomically(shards_path(), out);
+}
+
+std::optional<std::vector<Shard>> SnapshotCache::read_shards(const SourceFingerprint &source) const {
+  const std::filesystem::path target_path = shards_path();
+  std::error_code ec;
+  if (!std::filesystem::exists(target_path, ec))
+    return std::nullopt;
+
+  MappedFile file(target_path);
+  ByteReader in(file.view());
+  if (!read_header(in, SHARDS_MAGIC, SHARDS_VERSION, source))
+    return std::nullopt;
+
+  const auto count = in.get<std::uint64_t>();
+  // Every shard is at least 28 bytes; reject counts the file cannot possibly hold
+  if (count > in.remaining() / 28)
+    throw std::runtime_error("Corrupt shard list: implausible shard count");
+  std::vector<Shard> shards(count);
+  for (auto &shard : shards) {
+    shard.source.path = std::string(in.get_string());
+    shard.source.size = in.get<std::uint64_t>();
+    shard.source.mtime = in.get<std::int64_t>();
+    const auto id_count = in.get<std::uint64_t>();
+    if (id_count > in.remaining() / sizeof(std::int32_t))
+      throw std::runtime_error("Corrupt shard list: implausible ID count");
+    shard.ids.resize(id_count);
+    for (auto &id : shard.ids) {
+      id = in.get<std::int32_t>();
+    }
+  }
+  if (!in.at_end())
+    throw std::runtime_error("Corrupt shard list: trailing data");
+  return shards;
+}
+
+void SnapshotCache::clear() const noexcept {
+  std::error_code ec;
+  std::filesystem::remove(storage_dir_ / snapshot_filename_, ec);
+  std::filesystem::remove(text_index_path(), ec);
+  std::filesystem::remove(shards_path(), ec);
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "../core/task.hpp"
+#include "../core/task_fields.hpp"
+#include "../core/text_index.hpp"
+#include "dataset_files.hpp"
+#include "source_fingerprint.hpp"
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Versioned binary snapshot of the parsed tasks of a source file.
+ *
+ * The snapshot lives next to the view storage file ("./.taskproc.snapshot") and
+ * records the SourceFingerprint of the file it was built from. Reading it back
+ * is a linear decode of a memory-mapped buffer, which is much cheaper than
+ * re-running the CSV/JSON reader on every CLI invocation.
+ *
+ * Layout (host byte order): magic, version, byte-order mark, fingerprint,
+ * task count, then one record per task (fixed-width ints followed by
+ * length-prefixed strings; optionals carry a presence byte).
+ *
+ * The TextIndex built by the first search is cached the same way in
+ * "./.taskproc.textindex": the same header (with its own magic), then the
+ * serialized index. The Shard list of a sharded dataset (one fingerprint and
+ * ID list per file, for incremental reloads) is kept in "./.taskproc.shards",
+ * keyed on the fingerprint of the whole dataset.
+ *
+ * @note Thread-safety: not thread-safe.
+ */
+class SnapshotCache {
+private:
+  // Storage config (storage_dir_ is captured at construction time, like ViewStorage)
+  std::filesystem::path storage_dir_{std::filesystem::current_path()};
+  std::string snapshot_filename_{".taskproc.snapshot"};
+  std::string text_index_filename_{".taskproc.textindex"};
+  std::string shards_filename_{".taskproc.shards"};
+
+public:
+  SnapshotCache() = default;
+
+  /**
+   * @brief Write a snapshot of `tasks` keyed on `source`, replacing any previous one atomically.
+   * @pre `source` fingerprints the file `tasks` were parsed from.
+   * @post On success: a subsequent `read(source)` returns the same tasks in the same order.
+   * @post On failure: the previous snapshot file is unchanged.
+   * @throws std::runtime_error on I/O errors.
+   */
+  void write(const SourceFingerprint &source, const std::vector<const Task *> &tasks) const;
+
+  /**
+   * @brief Rehydrate the tasks stored in the snapshot if it matches `source`.
+   * @pre none
+   * @post Returns the stored tasks if a snapshot exists, has the current version and
+   *       was built from a file with exactly this fingerprint; std::nullopt otherwise.
+   *       String fields outside `fields` are skipped in the mapped file, not copied
+   *       (see TaskFields).
+   * @throws std::runtime_error if the snapshot file exists but is truncated or corrupt.
+   */
+  std::optional<std::vector<Task>> read(const SourceFingerprint &source,
+                                        TaskFields fields = TaskFields::all()) const;
+
+  /**
+   * @brief Fingerprint of the file the stored snapshot was built from.
+   * @post std::nullopt if there is no snapshot file, or it has another version.
+   * @throws std::runtime_error if the snapshot file exists but is truncated.
+   */
+  std::optional<SourceFingerprint> source() const;
+
+  /**
+   * @brief Write `index` keyed on `source`, replacing any previous one atomically.
+   * @pre `index` was built over the tasks parsed from the file `source` fingerprints.
+   * @post On success: a subsequent `read_text_index(source)` returns an equal index.
+   * @throws std::runtime_error on I/O errors.
+   */
+  void write_text_index(const SourceFingerprint &source, const TextIndex &index) const;
+
+  /**
+   * @brief Read the cached text index if it was built from a file with exactly this fingerprint.
+   * @post std::nullopt if there is no index file, or it has another version or fingerprint.
+   * @throws std::runtime_error if the index file exists but is truncated or corrupt.
+   */
+  std::optional<TextIndex> read_text_index(const SourceFingerprint &source) const;
+
+  /**
+   * @brief Write the shards of the dataset `source` fingerprints, replacing any previous list atomically.
+   * @post On success: a subsequent `read_shards(source)` returns equal shards in the same order.
+   * @throws std::runtime_error on I/O errors.
+   */
+  void write_shards(const SourceFingerprint &source, const std::vector<Shard> &shards) const;
+
+  /**
+   * @brief Read the shard list if it was written for a dataset with exactly this fingerprint.
+   * @post std::nullopt if there is no shard file, or it has another version or fingerprint.
+   * @throws std::runtime_error if the shard file exists but is truncated or corrupt.
+   */
+  std::optional<std::vector<Shard>> read_shards(const SourceFingerprint &source) const;
+
+  /**
+   * @brief Remove the snapshot, text index and shard files (if any).
+   * @post No snapshot, text index or shard file exists in the storage directory.
+   * @throws none (noexcept).
+   */
+  void clear() const noexcept;
+
+  /// Full path of the snapshot file.
+  std::filesystem::path path() const { return storage_dir_ / snapshot_filename_; }
+
+  /// Full path of the text index file.
+  std::filesystem::path text_index_path() const { return storage_dir_ / text_index_filename_; }
+
+  /// Full path of the shard list file.
+  std::filesystem::path shards_path() const { return storage_dir_ / shards_filename_; }
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <system_error>
+
+/**
+ * @brief Identity of a tasks source file: path, size and modification time.
+ *
+ * Two fingerprints compare equal when the path is the same and the file has
+ * neither grown/shrunk nor been touched since, which is what cached data
+ * derived from the file (snapshots, materialized views) is keyed on.
+ */
+struct SourceFingerprint {
+  std::string path;
+  std::uintmax_t size{0};
+  std::int64_t mtime{0}; ///< `last_write_time` ticks since the file clock epoch
+
+  bool operator==(const SourceFingerprint &) const = default;
+
+  /**
+   * @brief Fingerprint the file at `filepath` as it is on disk right now.
+   * @pre none
+   * @post Returns a fingerprint if the file exists and can be stat'ed, std::nullopt otherwise.
+   * @throws none (noexcept).
+   */
+  static std::optional<SourceFingerprint> of(const std::filesystem::path &filepath) noexcept {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filepath, ec);
+    if (ec)
+      return std::nullopt;
+    auto mtime = std::filesystem::last_write_time(filepath, ec);
+    if (ec)
+      return std::nullopt;
+    try {
+      return SourceFingerprint{filepath.string(), size, static_cast<std::int64_t>(mtime.time_since_epoch().count())};
+    } catch (...) {
+      return std::nullopt;
+    }
+  }
+};
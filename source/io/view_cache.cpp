@@ -0,0 +1,229 @@
+#include "io/view_cache.hpp"
+#include "core/expr_parser.hpp"
+#include "core/profiler.hpp"
+#include "core/silenced_errors.hpp"
+#include "core/text_index.hpp"
+#include "io/binary_io.hpp"
+#include "io/mapped_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace {
+constexpr char CACHE_MAGIC[8] = {'T', 'P', 'V', 'C', 'A', 'C', 'H', 'E'};
+constexpr std::uint32_t CACHE_VERSION = 2; // 2: filters and sorts keyed on their parsed spelling
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+static_assert(sizeof(int) == sizeof(std::int32_t), "view cache stores task IDs as 32-bit integers");
+} // anonymous namespace
+
+std::vector<ViewAction> ViewCache::normalize(const std::vector<ViewAction> &history) {
+  auto last_reset = std::find_if(history.rbegin(), history.rend(), [](const ViewAction &action) {
+    return action.type == ViewOpType::ResetFilters;
+  });
+
+  // Payloads are parsed again here; the command that recorded them already reported any warning
+  const SilencedErrors silenced;
+  std::vector<ViewAction> actions;
+  for (auto it = last_reset.base(); it != history.end(); ++it) {
+    switch (it->type) {
+    case ViewOpType::Load:
+    case ViewOpType::ResetFilters:
+      break;
+    case ViewOpType::Filter: {
+      // The parsed tree, not the text, decides the view; one that does not parse filters nothing
+      auto expr = ExpressionParser::parse_filter_expr(it->payload);
+      actions.push_back({it->type, expr ? ExpressionParser::to_string(*expr) : it->payload});
+      break;
+    }
+    case ViewOpType::Sort: {
+      auto keys = ExpressionParser::parse_sort_keys(it->payload);
+      actions.push_back({it->type, keys ? ExpressionParser::to_string(*keys) : it->payload});
+      break;
+    }
+    case ViewOpType::FindByTag:
+      actions.push_back(*it); // tags match exactly
+      break;
+    case ViewOpType::Search: {
+      std::string words;
+      for (const auto &word : TextIndex::words(it->payload)) {
+        words += words.empty() ? "" : " ";
+        words += word;
+      }
+      actions.push_back({it->type, std::move(words)});
+      break;
+    }
+    }
+  }
+  return actions;
+}
+
+std::optional<std::vector<int>> ViewCache::find(const SourceFingerprint &source,
+                                                const std::vector<ViewAction> &actions) noexcept {
+  TASKPROC_PROFILE_SCOPE("view_cache.lookup");
+  try {
+    return lookup(make_key(source, actions, actions.size()));
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: ignoring view cache: " << e.what() << "\n";
+    return std::nullopt;
+  }
+}
+
+std::optional<ViewCache::Hit> ViewCache::longest_prefix(const SourceFingerprint &source,
+                                                        const std::vector<ViewAction> &actions) noexcept {
+  TASKPROC_PROFILE_SCOPE("view_cache.lookup");
+  try {
+    for (size_t length = actions.size(); length > 0; --length) {
+      if (auto task_ids = lookup(make_key(source, actions, length)))
+        return Hit{length, std::move(*task_ids)};
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: ignoring view cache: " << e.what() << "\n";
+  }
+  return std::nullopt;
+}
+
+void ViewCache::insert(const SourceFingerprint &source,
+                       const std::vector<ViewAction> &actions,
+                       std::vector<int> task_ids) noexcept {
+  TASKPROC_PROFILE_SCOPE("view_cache.insert");
+  if (capacity_ == 0 || actions.empty())
+    return;
+  try {
+    std::string key = make_key(source, actions, actions.size());
+    if (auto it = index_.find(key); it != index_.end()) {
+      touch(it->second); // restored from this entry (or recomputed identically): nothing to rewrite
+      return;
+    }
+    write_entry(key, task_ids);
+    remember(std::move(key), std::move(task_ids));
+  } catch (const std::exception &e) {
+    std::cerr << "Warning: failed to write view cache: " << e.what() << "\n";
+  }
+}
+
+std::string ViewCache::make_key(const SourceFingerprint &source, const std::vector<ViewAction> &actions, size_t length) {
+  ByteWriter out;
+  out.put_string(source.path);
+  out.put(static_cast<std::uint64_t>(source.size));
+  out.put(source.mtime);
+  out.put(static_cast<std::uint32_t>(length));
+  for (size_t i = 0; i < length; ++i) {
+    out.put(static_cast<std::uint8_t>(actions[i].type));
+    out.put_string(actions[i].payload);
+  }
+  return out.data();
+}
+
+std::filesystem::path ViewCache::entry_path(const std::string &key) const {
+  static constexpr char HEX[] = "0123456789abcdef";
+  std::string name(16, '0');
+  std::uint64_t hash = fnv1a(key);
+  for (size_t i = name.size(); i-- > 0; hash >>= 4) {
+    name[i] = HEX[hash & 0xF];
+  }
+  return directory() / (name + ".view");
+}
+
+void ViewCache::touch(std::list<Entry>::iterator it) noexcept { entries_.splice(entries_.begin(), entries_, it); }
+
+std::optional<std::vector<int>> ViewCache::lookup(std::string key) {
+  std::optional<std::vector<int>> task_ids;
+  if (auto it = index_.find(key); it != index_.end()) {
+    touch(it->second);
+    task_ids = it->second->task_ids;
+  } else if (task_ids = read_entry(key); !task_ids) {
+    return std::nullopt;
+  }
+  TASKPROC_PROFILE_COUNT("view_cache.hits", 1);
+
+  // Recency on disk is the file time, so other processes evict by the same order; failing to update it only ages the entry
+  std::error_code ec;
+  std::filesystem::last_write_time(entry_path(key), std::filesystem::file_time_type::clock::now(), ec);
+  if (index_.find(key) == index_.end())
+    remember(std::move(key), *task_ids);
+  return task_ids;
+}
+
+void ViewCache::remember(std::string key, std::vector<int> task_ids) {
+  entries_.push_front(Entry{std::move(key), std::move(task_ids)});
+  index_[entries_.front().key] = entries_.begin();
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+std::optional<std::vector<int>> ViewCache::read_entry(const std::string &key) const noexcept {
+  try {
+    const std::filesystem::path path = entry_path(key);
+    if (!std::filesystem::exists(path))
+      return std::nullopt;
+
+    MappedFile file(path);
+    ByteReader in(file.view());
+    if (in.get_raw(sizeof(CACHE_MAGIC)) != std::string_view(CACHE_MAGIC, sizeof(CACHE_MAGIC)) ||
+        in.get<std::uint32_t>() != CACHE_VERSION || in.get<std::uint32_t>() != BYTE_ORDER_MARK ||
+        in.get_string() != key)
+      return std::nullopt;
+
+    const auto count = in.get<std::uint64_t>();
+    if (count != in.remaining() / sizeof(std::int32_t) || in.remaining() % sizeof(std::int32_t) != 0)
+      return std::nullopt;
+    std::vector<int> task_ids(count);
+    if (count > 0)
+      std::memcpy(task_ids.data(), in.get_raw(count * sizeof(std::int32_t)).data(), count * sizeof(std::int32_t));
+    return task_ids;
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+}
+
+void ViewCache::write_entry(const std::string &key, const std::vector<int> &task_ids) const {
+  ByteWriter out;
+  out.reserve(64 + key.size() + task_ids.size() * sizeof(std::int32_t));
+  out.put_raw(std::string_view(CACHE_MAGIC, sizeof(CACHE_MAGIC)));
+  out.put(CACHE_VERSION);
+  out.put(BYTE_ORDER_MARK);
+  out.put_string(key);
+  out.put(static_cast<std::uint64_t>(task_ids.size()));
+  out.put_raw(std::string_view(reinterpret_cast<const char *>(task_ids.data()), task_ids.size() * sizeof(std::int32_t)));
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory(), ec);
+  if (ec)
+    throw std::runtime_error("Failed to create view cache directory: " + ec.message());
+  const std::filesystem::path target_path = entry_path(key);
+  const auto tmp = target_path.string() + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      throw std::runtime_error("Failed to open temp view cache file for writing: " + tmp);
+    ofs.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+    if (!ofs)
+      throw std::runtime_error("Failed to write view cache file: " + tmp);
+  }
+  std::filesystem::rename(tmp, target_path, ec);
+  if (ec)
+    throw std::runtime_error("Failed to commit view cache file: " + ec.message());
+
+  // Evict the least recently used files (oldest modification time) beyond capacity. Listing the names
+  // needs no stat, so the times are only read once there is something to evict
+  std::vector<std::filesystem::path> names;
+  for (const auto &entry : std::filesystem::directory_iterator(directory(), ec)) {
+    if (entry.path().extension() == ".view")
+      names.push_back(entry.path());
+  }
+  if (names.size() <= capacity_)
+    return;
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> files;
+  for (auto &name : names) {
+    const auto time = std::filesystem::last_write_time(name, ec);
+    files.emplace_back(ec ? std::filesystem::file_time_type::min() : time, std::move(name));
+  }
+  std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+  for (size_t i = capacity_; i < files.size(); ++i) {
+    std::filesystem::remove(files[i].second, ec);
+  }
+}
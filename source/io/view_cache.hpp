@@ -0,0 +1,123 @@
+#pragma once
+#include "../core/view_action.hpp"
+#include "source_fingerprint.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Bounded LRU cache of computed views, keyed on a dataset and a normalized action sequence.
+ *
+ * Dashboards re-run the same few pipelines (`filter status=todo`, then
+ * `sort priority desc`, ...) against an unchanged file. Each view computed
+ * for a history is recorded under (SourceFingerprint, `normalize(history)`);
+ * a later history that starts with a recorded sequence restores that view and
+ * only applies the actions after it.
+ *
+ * Entries live in memory (so a `taskproc serve` process hits without I/O) and
+ * on disk as one file per entry in "./.taskproc.viewcache/", so one-shot
+ * processes share them. Each file stores its full key, so a hash collision is
+ * a miss, and its modification time is the recency used for disk eviction.
+ *
+ * Layout of an entry file (host byte order): magic, version, byte-order mark,
+ * fingerprint, action count, (type, payload) per action, view size, task IDs.
+ *
+ * @note Thread-safety: not thread-safe.
+ */
+class ViewCache {
+public:
+  /// Views kept, in memory and on disk, by default
+  static constexpr size_t DEFAULT_CAPACITY = 32;
+
+  /// A cached view for the first `length` actions of a lookup
+  struct Hit {
+    size_t length;
+    std::vector<int> task_ids; ///< IDs of the tasks in the view, in view order
+  };
+
+  /**
+   * @param capacity Maximum number of views kept (least recently used ones are evicted).
+   */
+  explicit ViewCache(size_t capacity = DEFAULT_CAPACITY) noexcept : capacity_(capacity) {}
+
+  /**
+   * @brief The actions that determine the view `history` produces, in a canonical spelling.
+   *
+   * Everything up to the last reset is dropped (it cannot affect the view), as
+   * are Load actions. Filters and sort keys are parsed and spelled again by
+   * ExpressionParser::to_string, so spellings that parse alike share a key and
+   * ones that parse differently (say, an unknown sort direction) do not; a
+   * payload that does not parse is kept as is. Search text becomes its folded
+   * words.
+   *
+   * @post Replaying the result on the full view gives the same view as replaying `history`.
+   * @throws std::bad_alloc if the result cannot be allocated.
+   */
+  static std::vector<ViewAction> normalize(const std::vector<ViewAction> &history);
+
+  /**
+   * @brief The cached view of exactly `actions` computed on `source`.
+   * @pre `actions` is normalized.
+   * @post A hit becomes the most recently used entry.
+   * @throws none (an unreadable entry file is a miss).
+   */
+  std::optional<std::vector<int>> find(const SourceFingerprint &source, const std::vector<ViewAction> &actions) noexcept;
+
+  /**
+   * @brief The cached view of the longest non-empty prefix of `actions` computed on `source`.
+   * @pre `actions` is normalized.
+   * @post A hit becomes the most recently used entry.
+   * @throws none (an unreadable entry file is a miss).
+   */
+  std::optional<Hit> longest_prefix(const SourceFingerprint &source, const std::vector<ViewAction> &actions) noexcept;
+
+  /**
+   * @brief Record `task_ids` as the view `actions` produce on `source`.
+   * @pre `actions` is normalized and non-empty.
+   * @post The entry is the most recently used one; beyond `capacity` the least recently used are evicted.
+   * @throws none (failures to write the entry file are reported to std::cerr and leave it memory-only).
+   */
+  void insert(const SourceFingerprint &source, const std::vector<ViewAction> &actions, std::vector<int> task_ids) noexcept;
+
+  /// Directory holding the entry files.
+  std::filesystem::path directory() const { return storage_dir_ / directory_name_; }
+
+private:
+  struct Entry {
+    std::string key;
+    std::vector<int> task_ids;
+  };
+
+  size_t capacity_;
+  std::list<Entry> entries_;                                          ///< most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_; ///< key -> entry
+
+  // Storage config (storage_dir_ is captured at construction time, like ViewStorage)
+  std::filesystem::path storage_dir_{std::filesystem::current_path()};
+  std::string directory_name_{".taskproc.viewcache"};
+
+  /// Serialized (fingerprint, first `length` actions): the identity of an entry
+  static std::string make_key(const SourceFingerprint &source, const std::vector<ViewAction> &actions, size_t length);
+
+  /// Entry file of `key`, named by its stable hash
+  std::filesystem::path entry_path(const std::string &key) const;
+
+  /// Make `it` the most recently used entry in memory
+  void touch(std::list<Entry>::iterator it) noexcept;
+
+  /// View of the entry `key`, from memory or its file (which is then kept in memory too)
+  std::optional<std::vector<int>> lookup(std::string key);
+
+  /// Add an entry in memory, evicting beyond capacity
+  void remember(std::string key, std::vector<int> task_ids);
+
+  /// Task IDs of the entry file of `key`; std::nullopt if absent, foreign or corrupt
+  std::optional<std::vector<int>> read_entry(const std::string &key) const noexcept;
+
+  /// Atomically write the entry file of `key`, then remove the least recently used files beyond capacity
+  void write_entry(const std::string &key, const std::vector<int> &task_ids) const;
+};
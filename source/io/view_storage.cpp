@@ -1,31 +1,74 @@
 #include "io/view_storage.hpp"
+#include "core/profiler.hpp"
+#include "io/binary_io.hpp"
+#include "io/mapped_file.hpp"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <cstring>
 #include <system_error>
+#include <utility>
 
 using json = nlohmann::json;
 
+namespace {
+constexpr char VIEW_MAGIC[8] = {'T', 'P', 'V', 'I', 'E', 'W', '\0', '\0'};
+constexpr std::uint32_t VIEW_VERSION = 1;
+constexpr char LOG_MAGIC[8] = {'T', 'P', 'V', 'L', 'O', 'G', '\0', '\0'};
+constexpr std::uint32_t LOG_VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr size_t RECORD_HEADER_SIZE = sizeof(std::uint32_t) + sizeof(std::uint64_t); // body size, checksum
+static_assert(sizeof(int) == sizeof(std::int32_t), "view file stores task IDs as 32-bit integers");
+} // anonymous namespace
+
 void ViewStorage::set_filepath(const std::filesystem::path &filepath) noexcept {
+  pending_ops_.clear(); // a new file supersedes every unlogged change
+  pending_ops_.push_back(LogOp{LogOp::Kind::SetFilepath, {ViewOpType::Load, filepath.string()}});
   current_filepath_ = filepath;
   history_.clear();
+  materialized_view_.reset();
 }
 
-void ViewStorage::push_action(ViewAction action) noexcept { history_.emplace_back(std::move(action)); }
+void ViewStorage::push_action(ViewAction action) noexcept {
+  pending_ops_.push_back(LogOp{LogOp::Kind::PushAction, action});
+  history_.emplace_back(std::move(action));
+  materialized_view_.reset();
+}
 
 const std::vector<ViewAction> &ViewStorage::history() const noexcept { return history_; }
 
+std::uint64_t ViewStorage::history_hash() const noexcept {
+  std::uint64_t hash = FNV1A_OFFSET_BASIS;
+  for (const auto &action : history_) {
+    fnv1a(hash, to_string(action.type));
+    fnv1a(hash, std::string_view("\0", 1));
+    fnv1a(hash, action.payload);
+    fnv1a(hash, std::string_view("\0", 1));
+  }
+  return hash;
+}
+
+void ViewStorage::set_materialized_view(MaterializedView view) noexcept { materialized_view_ = std::move(view); }
+
+const MaterializedView *ViewStorage::materialized_view() const noexcept {
+  return materialized_view_ ? &*materialized_view_ : nullptr;
+}
+
 void ViewStorage::clear() noexcept {
-  std::filesystem::path target_path = storage_dir_ / storage_filename_;
   std::error_code ec;
-  std::filesystem::remove(target_path, ec);
+  std::filesystem::remove(log_file_path(), ec);
+  std::filesystem::remove(view_file_path(), ec);
   current_filepath_.reset();
   history_.clear();
+  materialized_view_.reset();
+  pending_ops_.clear();
+  log_size_ = 0;
+  log_records_ = 0;
 }
 
 void ViewStorage::clear_history() noexcept {
-  history_.clear();
+  discard_history();
 
   // Persist the cleared history to disk while keeping filepath
   if (current_filepath_.has_value()) {
@@ -39,30 +82,196 @@ void ViewStorage::clear_history() noexcept {
   }
 }
 
+void ViewStorage::discard_history() noexcept {
+  if (!history_.empty())
+    pending_ops_.push_back(LogOp{LogOp::Kind::ClearHistory, {ViewOpType::ResetFilters, ""}});
+  history_.clear();
+  materialized_view_.reset();
+}
+
 void ViewStorage::persist() {
+  TASKPROC_PROFILE_SCOPE("storage.persist");
   if (!current_filepath_.has_value()) {
     throw std::runtime_error("Cannot persist: no filepath set");
   }
 
-  // build JSON
-  json json_data;
-  json_data["filepath"] = current_filepath_->string();
-  json_data["history"] = json::array();
+  // The view file goes first: if the log write below fails, its hash no longer
+  // matches the history on disk and it is simply ignored on the next load.
+  persist_materialized_view();
+
+  // Append to the log only while the file still holds exactly what this instance logged
+  std::error_code ec;
+  const auto on_disk = std::filesystem::file_size(log_file_path(), ec);
+  if (ec || log_size_ == 0 || on_disk != log_size_ || log_records_ >= COMPACT_AFTER_RECORDS)
+    compact_log();
+  else if (!pending_ops_.empty())
+    append_log_record();
+  pending_ops_.clear();
+}
+
+bool ViewStorage::load_from_storage() {
+  TASKPROC_PROFILE_SCOPE("storage.load");
+  const std::filesystem::path target_path = log_file_path();
+
+  if (!std::filesystem::exists(target_path))
+    return false;
+
+  {
+    MappedFile file(target_path);
+    if (!load_log(file.view()))
+      load_legacy_json(target_path);
+  }
+  pending_ops_.clear();
+  if (!current_filepath_.has_value())
+    return false; // only a torn first record: nothing was ever persisted completely
+  materialized_view_ = load_materialized_view();
+
+  return true;
+}
+
+void ViewStorage::persist_materialized_view() const {
+  const std::filesystem::path target_path = view_file_path();
+  std::error_code ec;
+  if (!materialized_view_) {
+    std::filesystem::remove(target_path, ec);
+    return;
+  }
+
+  const MaterializedView &view = *materialized_view_;
+  ByteWriter out;
+  out.reserve(64 + view.source.path.size() + view.task_ids.size() * sizeof(std::int32_t));
+  out.put_raw(std::string_view(VIEW_MAGIC, sizeof(VIEW_MAGIC)));
+  out.put(VIEW_VERSION);
+  out.put(BYTE_ORDER_MARK);
+  out.put(view.history_hash);
+  out.put_string(view.source.path);
+  out.put(static_cast<std::uint64_t>(view.source.size));
+  out.put(view.source.mtime);
+  out.put(static_cast<std::uint64_t>(view.task_ids.size()));
+  out.put_raw(std::string_view(reinterpret_cast<const char *>(view.task_ids.data()),
+                               view.task_ids.size() * sizeof(std::int32_t)));
+
+  const auto tmp = target_path.string() + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      throw std::runtime_error("Failed to open temp view file for writing: " + tmp);
+    ofs.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+    if (!ofs)
+      throw std::runtime_error("Failed to write view file: " + tmp);
+  }
+
+  std::filesystem::rename(tmp, target_path, ec);
+  if (ec)
+    throw std::runtime_error("Failed to commit view file: " + ec.message());
+}
+
+std::optional<MaterializedView> ViewStorage::load_materialized_view() const noexcept {
+  try {
+    const std::filesystem::path target_path = view_file_path();
+    if (!std::filesystem::exists(target_path))
+      return std::nullopt;
+
+    MappedFile file(target_path);
+    ByteReader in(file.view());
+    if (in.get_raw(sizeof(VIEW_MAGIC)) != std::string_view(VIEW_MAGIC, sizeof(VIEW_MAGIC)) ||
+        in.get<std::uint32_t>() != VIEW_VERSION || in.get<std::uint32_t>() != BYTE_ORDER_MARK)
+      return std::nullopt;
+
+    MaterializedView view;
+    view.history_hash = in.get<std::uint64_t>();
+    view.source.path = std::string(in.get_string());
+    view.source.size = in.get<std::uint64_t>();
+    view.source.mtime = in.get<std::int64_t>();
+    const auto count = in.get<std::uint64_t>();
+    if (count != in.remaining() / sizeof(std::int32_t) || in.remaining() % sizeof(std::int32_t) != 0)
+      return std::nullopt;
+    view.task_ids.resize(count);
+    if (count > 0)
+      std::memcpy(view.task_ids.data(), in.get_raw(count * sizeof(std::int32_t)).data(), count * sizeof(std::int32_t));
+    return view;
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+}
+
+std::string ViewStorage::encode_record(const std::vector<LogOp> &ops) {
+  ByteWriter body;
+  body.put(static_cast<std::uint32_t>(ops.size()));
+  for (const auto &op : ops) {
+    body.put(static_cast<std::uint8_t>(op.kind));
+    if (op.kind == LogOp::Kind::PushAction)
+      body.put_string(to_string(op.action.type));
+    if (op.kind != LogOp::Kind::ClearHistory)
+      body.put_string(op.action.payload);
+  }
+
+  ByteWriter record;
+  record.reserve(RECORD_HEADER_SIZE + body.size());
+  record.put(static_cast<std::uint32_t>(body.size()));
+  record.put(fnv1a(body.data()));
+  record.put_raw(body.data());
+  return record.data();
+}
+
+void ViewStorage::apply(LogOp op) {
+  switch (op.kind) {
+  case LogOp::Kind::SetFilepath:
+    current_filepath_ = std::filesystem::path(op.action.payload);
+    history_.clear();
+    break;
+  case LogOp::Kind::PushAction:
+    history_.emplace_back(std::move(op.action));
+    break;
+  case LogOp::Kind::ClearHistory:
+    history_.clear();
+    break;
+  }
+}
+
+void ViewStorage::append_log_record() {
+  const std::string record = encode_record(pending_ops_);
+
+  // Until the append succeeds the tail of the file is unknown, so a failure forces a rewrite
+  const auto valid_size = std::exchange(log_size_, 0);
+  std::ofstream ofs(log_file_path(), std::ios::binary | std::ios::app);
+  if (!ofs)
+    throw std::runtime_error("Failed to open storage file for appending: " + log_file_path().string());
+  ofs.write(record.data(), static_cast<std::streamsize>(record.size()));
+  ofs.flush();
+  if (!ofs)
+    throw std::runtime_error("Failed to append to storage file: " + log_file_path().string());
+
+  log_size_ = valid_size + record.size();
+  ++log_records_;
+  TASKPROC_PROFILE_COUNT("storage.appended_bytes", record.size());
+}
+
+void ViewStorage::compact_log() {
+  TASKPROC_PROFILE_SCOPE("storage.compact");
+  std::vector<LogOp> ops;
+  ops.reserve(history_.size() + 1);
+  ops.push_back(LogOp{LogOp::Kind::SetFilepath, {ViewOpType::Load, current_filepath_->string()}});
   for (const auto &action : history_) {
-    json action_json;
-    action_json["type"] = to_string(action.type);
-    action_json["payload"] = action.payload;
-    json_data["history"].emplace_back(std::move(action_json));
+    ops.push_back(LogOp{LogOp::Kind::PushAction, action});
   }
 
-  // write JSON to file
-  std::filesystem::path target_path = storage_dir_ / storage_filename_;
+  ByteWriter out;
+  out.put_raw(std::string_view(LOG_MAGIC, sizeof(LOG_MAGIC)));
+  out.put(LOG_VERSION);
+  out.put(BYTE_ORDER_MARK);
+  out.put_raw(encode_record(ops));
+
+  log_size_ = 0;
+  const std::filesystem::path target_path = log_file_path();
   const auto tmp = target_path.string() + ".tmp";
   {
     std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
     if (!ofs)
       throw std::runtime_error("Failed to open temp storage file for writing: " + tmp);
-    ofs << json_data.dump(2);
+    ofs.write(out.data().data(), static_cast<std::streamsize>(out.size()));
+    if (!ofs)
+      throw std::runtime_error("Failed to write storage file: " + tmp);
   }
 
   // rename temp file to target file
@@ -70,19 +279,66 @@ void ViewStorage::persist() {
   std::filesystem::rename(tmp, target_path, ec);
   if (ec)
     throw std::runtime_error("Failed to commit storage file: " + ec.message());
-}
 
-bool ViewStorage::load_from_storage() {
-  std::filesystem::path target_path = storage_dir_ / storage_filename_;
+  log_size_ = out.size();
+  log_records_ = 1;
+}
 
-  if (!std::filesystem::exists(target_path))
+bool ViewStorage::load_log(std::string_view bytes) {
+  if (!bytes.starts_with(std::string_view(LOG_MAGIC, sizeof(LOG_MAGIC))))
     return false;
+  ByteReader in(bytes);
+  in.get_raw(sizeof(LOG_MAGIC));
+  if (in.get<std::uint32_t>() != LOG_VERSION || in.get<std::uint32_t>() != BYTE_ORDER_MARK)
+    throw std::runtime_error("Unsupported storage file version or byte order");
+
+  current_filepath_.reset();
+  history_.clear();
+  log_records_ = 0;
+  size_t valid_size = in.position();
+
+  // A record cut short or failing its checksum was torn by a crash: it and anything after it are ignored
+  while (in.remaining() >= RECORD_HEADER_SIZE) {
+    const auto size = in.get<std::uint32_t>();
+    const auto sum = in.get<std::uint64_t>();
+    if (size > in.remaining())
+      break;
+    const std::string_view body = in.get_raw(size);
+    if (fnv1a(body) != sum)
+      break;
 
+    ByteReader record(body);
+    const auto count = record.get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count; ++i) {
+      const auto kind = record.get<std::uint8_t>();
+      if (kind > static_cast<std::uint8_t>(LogOp::Kind::ClearHistory))
+        throw std::runtime_error("Malformed storage record");
+      LogOp op{static_cast<LogOp::Kind>(kind), {ViewOpType::Load, ""}};
+      if (op.kind == LogOp::Kind::PushAction) {
+        const auto type = view_op_type_from_string(record.get_string());
+        if (!type)
+          throw std::runtime_error("Malformed storage record");
+        op.action.type = *type;
+      }
+      if (op.kind != LogOp::Kind::ClearHistory)
+        op.action.payload = std::string(record.get_string());
+      apply(std::move(op));
+    }
+    valid_size = in.position();
+    ++log_records_;
+  }
+
+  // A torn tail is dropped by rewriting the log on the next persist
+  log_size_ = valid_size == bytes.size() ? valid_size : 0;
+  return true;
+}
+
+void ViewStorage::load_legacy_json(const std::filesystem::path &path) {
   json json_data;
   {
-    std::ifstream ifs(target_path);
+    std::ifstream ifs(path);
     if (!ifs)
-      throw std::runtime_error("Failed to open storage file for reading: " + target_path.string());
+      throw std::runtime_error("Failed to open storage file for reading: " + path.string());
     ifs >> json_data;
   }
 
@@ -99,6 +355,6 @@ bool ViewStorage::load_from_storage() {
 
   current_filepath_ = std::filesystem::path(filepath);
   history_ = std::move(history);
-
-  return true;
+  log_size_ = 0; // rewritten as a log by the next persist
+  log_records_ = 0;
 }
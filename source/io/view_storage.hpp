@@ -1,10 +1,24 @@
 #pragma once
 #include "../core/view_action.hpp"
+#include "source_fingerprint.hpp"
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
 #include <vector>
 
+/**
+ * @brief The result of replaying a history, stored so it can be restored without replaying.
+ *
+ * Valid only while both the history (`history_hash`) and the dataset it was
+ * computed on (`source`) are unchanged.
+ */
+struct MaterializedView {
+  std::uint64_t history_hash{0};
+  SourceFingerprint source;
+  std::vector<int> task_ids; ///< IDs of the tasks in the view, in view order
+};
+
 /**
  * @brief Persisted view state: filepath + history of view-modifying commands.
  *
@@ -13,11 +27,45 @@
  * path to the last-loaded tasks file and an ordered list of view-modifying
  * actions that should be replayed on top of the file to reconstruct the
  * current view.
+ *
+ * The storage file is an append-only log: each `persist()` appends one
+ * checksummed record holding the changes made since the previous one (set
+ * filepath, push action, clear history), so a command costs one small write
+ * whatever the history length. A record torn by a crash fails its checksum and
+ * is ignored on load, leaving the state of the previous `persist()`. The log is
+ * rewritten atomically (temp file and rename) as a single record of the whole
+ * state every COMPACT_AFTER_RECORDS records, after a torn record, and when
+ * another process changed the file (the last writer wins).
+ *
+ * Layout (host byte order): magic, version, byte-order mark, then records of
+ * body size, FNV-1a checksum of the body, and a body of an operation count
+ * followed by (kind, [action type,] string) per operation.
+ *
+ * Alongside the history, the resulting view itself may be stored as a compact
+ * binary array of task IDs ("./.taskproc.storage.view"), so that callers can
+ * skip the replay when neither the history nor the dataset changed.
  */
 class ViewStorage {
+public:
+  /// Records appended before the log is compacted into one
+  static constexpr size_t COMPACT_AFTER_RECORDS = 128;
+
 private:
+  /// A change to the state, as recorded in the log
+  struct LogOp {
+    enum class Kind : std::uint8_t { SetFilepath, PushAction, ClearHistory };
+    Kind kind;
+    ViewAction action; ///< payload is the path for SetFilepath; unused for ClearHistory
+  };
+
   std::optional<std::filesystem::path> current_filepath_;
   std::vector<ViewAction> history_;
+  std::optional<MaterializedView> materialized_view_;
+
+  // Log state: the changes not yet appended, and the part of the file known to hold this state
+  std::vector<LogOp> pending_ops_;
+  std::uintmax_t log_size_{0}; ///< bytes of valid log on disk (0: the log must be rewritten)
+  size_t log_records_{0};      ///< records in the log since it was last compacted
 
   // Storage config (storage_dir_ is captured at contstruction time)
   std::filesystem::path storage_dir_{std::filesystem::current_path()};
@@ -59,6 +107,32 @@ public:
    */
   const std::vector<ViewAction> &history() const noexcept;
 
+  /**
+   * @brief Stable 64-bit hash of the current history (type and payload of every action).
+   * @pre none
+   * @post Equal histories hash equal across processes and runs.
+   * @throws none (noexcept).
+   */
+  std::uint64_t history_hash() const noexcept;
+
+  /**
+   * @brief Record the view produced by the current history (in-memory).
+   * @pre `view.history_hash == history_hash()`.
+   * @post `materialized_view()` returns `view` until the history or filepath changes.
+   * @throws none (noexcept).
+   * @note Does not persist automatically; call `persist()` to save to disk.
+   */
+  void set_materialized_view(MaterializedView view) noexcept;
+
+  /**
+   * @brief Get the recorded view for the current history (if any).
+   * @pre none
+   * @post Returns the stored view, or nullptr if none is recorded.
+   * @throws none (noexcept).
+   * @note The pointer is owned by this ViewStorage and invalidated by any mutation.
+   */
+  const MaterializedView *materialized_view() const noexcept;
+
   /**
    * @brief Clear in-memory filepath and history.
    * @pre none
@@ -70,16 +144,25 @@ public:
   /**
    * @brief Clear in-memory history.
    * @pre none
-   * @post history() is empty.
+   * @post history() is empty and no materialized view is recorded.
    * @throws none (noexcept).
    */
   void clear_history() noexcept;
 
+  /**
+   * @brief Clear in-memory history without persisting it (unlike `clear_history`).
+   * @post history() is empty and no materialized view is recorded; the files are untouched.
+   * @throws none (noexcept).
+   */
+  void discard_history() noexcept;
+
   /**
    * @brief Persist the current in-memory state to the storage file atomically.
    * @pre Called when caller wants to save state.
-   * @post On success: storage file contains JSON with `filepath` and `history`.
-   * @post On failure: storage file is unchanged.
+   * @post On success: the storage log replays to `filepath` and `history` (one record is
+   *       appended, or the log is compacted), and the view file holds the materialized
+   *       view (or is removed if none is recorded).
+   * @post On failure: loading the storage file gives the previously persisted state.
    * @throws std::runtime_error on I/O errors.
    */
   void persist();
@@ -87,10 +170,41 @@ public:
   /**
    * @brief Load state from the storage file into memory.
    * @pre Storage file may or may not exist.
-   * @post On success: in-memory state reflects storage and returns true.
+   * @post On success: in-memory state reflects storage and returns true. A materialized
+   *       view is restored too if its file is present and intact.
    * @post If storage missing: no change and returns false.
    * @throws std::runtime_error on I/O errors or malformed storage.
+   * @note A storage file written as JSON by earlier versions is read too, and rewritten
+   *       as a log by the next `persist()`.
    * @return true if a value was loaded, false if file absent.
    */
   bool load_from_storage();
+
+private:
+  std::filesystem::path log_file_path() const { return storage_dir_ / storage_filename_; }
+  std::filesystem::path view_file_path() const { return storage_dir_ / (storage_filename_ + ".view"); }
+
+  /// Atomically write (or remove, if none is recorded) the materialized view file.
+  void persist_materialized_view() const;
+
+  /// Read the materialized view file; std::nullopt if absent, foreign or corrupt.
+  std::optional<MaterializedView> load_materialized_view() const noexcept;
+
+  /// Append `pending_ops_` to the log as one record.
+  void append_log_record();
+
+  /// Atomically replace the log with a single record of the whole state.
+  void compact_log();
+
+  /// Replay the records of a log file; false if `bytes` is not a log.
+  bool load_log(std::string_view bytes);
+
+  /// Replay the JSON storage format of earlier versions.
+  void load_legacy_json(const std::filesystem::path &path);
+
+  /// Encoded record holding `ops`.
+  static std::string encode_record(const std::vector<LogOp> &ops);
+
+  /// Apply one logged change to the in-memory state.
+  void apply(LogOp op);
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include "../core/task.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Destination of formatted export output.
+ *
+ * Receives the output as a few large buffers, in order, so implementations can
+ * hand each batch to the OS in one call.
+ */
+class OutputSink {
+public:
+  virtual ~OutputSink() = default;
+
+  /**
+   * @brief Append `buffers`, in order, to the output.
+   * @post Every byte of every buffer was written.
+   * @throws std::runtime_error on I/O errors (the output may hold a prefix of the data).
+   */
+  virtual void write(std::span<const std::string> buffers) = 0;
+};
+
+/**
+ * @brief Abstract interface for task file writers (the counterpart of ITaskReader).
+ *
+ * Implementations format Task objects into a file format that the matching
+ * reader accepts.
+ */
+class ITaskWriter {
+public:
+  virtual ~ITaskWriter() = default;
+
+  /**
+   * @brief Write `tasks`, in order, to `sink`.
+   * @pre Every pointer in `tasks` is valid for the duration of the call.
+   * @post `sink` received one complete document holding every task.
+   * @throws std::runtime_error on I/O errors reported by `sink`.
+   *
+   * @param tasks Tasks to write (for example `DataManager::current_view()`).
+   * @param sink Destination of the formatted output.
+   */
+  virtual void write_tasks(const std::vector<const Task *> &tasks, OutputSink &sink) const = 0;
+
+  /**
+   * @brief Check whether this writer produces the format of `filepath` (e.g. by extension).
+   * @pre `filepath` is a filename or path.
+   * @post returns true if this writer recognizes the file format.
+   */
+  virtual bool can_handle(std::string_view filepath) const = 0;
+
+  /// Short name of the format, as accepted by `export --format` (e.g. "csv").
+  virtual std::string_view format_name() const noexcept = 0;
+};
@@ -1,7 +1,32 @@
+#include "cli/batch_runner.hpp"
+#include "cli/command_server.hpp"
+#include "cli/commands.hpp"
 #include "cli/parser.hpp"
 #include "core/data_manager.hpp"
+#include <csignal>
 #include <iostream>
 
+namespace {
+void stop_server(int) { CommandServer::request_stop(); }
+
+int serve() {
+  try {
+    CommandServer server;
+    DataManager data_manager;
+
+    // SIGINT/SIGTERM end the loop normally, so the socket file is removed on the way out
+    std::signal(SIGINT, stop_server);
+    std::signal(SIGTERM, stop_server);
+    std::cerr << "Serving on " << server.socket_path().string() << " (stop with 'taskproc stop')\n";
+    server.serve(data_manager);
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
+} // anonymous namespace
+
 int main(int argc, char *argv[]) {
   // Parse command line arguments
   auto parsed = CommandParser::parse(argc, argv);
@@ -21,95 +46,40 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
-  DataManager data_manager;
+  if (parsed.command == Command::Serve)
+    return serve();
 
-  // Dispatch to appropriate command handler
-  switch (parsed.command) {
-  case Command::Load: {
-    std::cout << "Loading tasks from: " << parsed.args[0] << "\n";
-    bool result = data_manager.load_from_file(parsed.args[0]);
-    if (!result) {
-      std::cerr << "Failed to load tasks from file: " << parsed.args[0] << "\n";
+  // A batch script is read here, so a server can run it even if it comes from our stdin
+  std::vector<std::string> request(argv + 1, argv + argc);
+  std::optional<std::string> script;
+  if (parsed.command == Command::Batch) {
+    script = BatchRunner::read_script(parsed);
+    if (!script)
       return 1;
-    }
-    std::cout << "Tasks loaded successfully\n";
-    break;
-  }
-  case Command::Reload: {
-    std::cout << "Reloading from last file\n";
-    bool result = data_manager.reload_tasks();
-    if (!result) {
-      std::cerr << "Failed to reload tasks\n";
-      return 1;
-    } else {
-      std::cout << "Tasks reloaded successfully\n";
-    }
-    break;
+    request = {"batch", "-c", *script};
+    if (parsed.profile)
+      request.push_back("--profile");
+    if (!parsed.profile_trace.empty())
+      request.insert(request.end(), {"--profile-trace", parsed.profile_trace});
   }
-  case Command::Status:
-    std::cout << "Current dataset status:\n";
-    // TODO: Implement status command handler
-    break;
-  case Command::Clear:
-    std::cout << "Clearing current view\n";
-    data_manager.reset_view();
-    break;
-  case Command::List: {
-    const auto &view = data_manager.current_view();
-    std::cout << "Current view:\n";
-
-    if (view.empty()) {
-      std::cout << "No tasks in current view\n";
-      break;
-    }
-
-    std::cout << "Current tasks (" << view.size() << "):\n";
-    std::cout << "-------------------------\n";
 
-    for (const auto &task : view) {
-      std::cout << *task << "\n";
+  // A running server already holds the tasks in memory: forward the command to it
+  try {
+    const auto reply = CommandClient::send(request);
+    if (reply) {
+      std::cout << reply->out;
+      std::cerr << reply->err;
+      return reply->exit_code;
     }
-
-    break;
-  }
-  case Command::Sort: {
-    std::cout << "Sorting current view\n";
-    std::string sort_expr;
-
-    if (parsed.args.empty()) {
-      sort_expr = "id asc";
-    } else {
-      sort_expr = parsed.args[0];
-      for (size_t i = 1; i < parsed.args.size(); ++i) {
-        sort_expr += " " + parsed.args[i];
-      }
-    }
-    std::cout << "Sorting tasks by: " << sort_expr << "\n";
-    bool result = data_manager.apply_sort(sort_expr);
-    if (!result) {
-      std::cerr << "Failed to sort tasks\n";
-      return 1;
-    } else {
-      std::cout << "Tasks sorted successfully\n";
-    }
-    break;
-  }
-  case Command::Filter: {
-    std::cout << "Filtering current view\n";
-    bool result = data_manager.apply_filter(parsed.args[0]);
-    if (!result) {
-      std::cerr << "Failed to filter tasks\n";
-      return 1;
-    } else {
-      std::cout << "Tasks filtered successfully\n";
-    }
-    break;
-  }
-
-  default:
-    // Invalid command
-    break;
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
   }
 
-  return 0;
+  // Loading and replaying the stored session is part of the profile
+  const ProfileSession profile(parsed);
+  DataManager data_manager(command_fields(parsed), command_session(parsed));
+  if (script)
+    return BatchRunner::run(data_manager, *script);
+  return run_command(data_manager, parsed);
 }
@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// Small RAII helper for a temporary directory used as the process CWD, for tests of code that keeps
+// its files there (view storage, snapshot, view cache, server socket).
+// On construction it creates a temp directory and switches CWD to it.
+// On destruction it restores the previous CWD and removes the temp directory.
+struct TempCwd {
+  std::filesystem::path dir;
+  std::filesystem::path prev;
+  TempCwd() {
+    static std::atomic<unsigned> created{0};
+    prev = std::filesystem::current_path();
+    dir = std::filesystem::temp_directory_path() /
+          ("taskproc_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+           std::to_string(created++));
+    std::filesystem::create_directories(dir);
+    std::filesystem::current_path(dir);
+  }
+  ~TempCwd() {
+    std::error_code ec;
+    std::filesystem::current_path(prev, ec);
+    std::filesystem::remove_all(dir, ec);
+  }
+  TempCwd(const TempCwd &) = delete;
+  TempCwd &operator=(const TempCwd &) = delete;
+};
@@ -0,0 +1,150 @@
+#include "cli/batch_runner.hpp"
+#include "cli/commands.hpp"
+#include "io/view_storage.hpp"
+#include "temp_cwd.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+void write_sample_csv(const std::filesystem::path &path) {
+  std::ofstream ofs(path);
+  ofs << "id,title,status,priority,created_date,description,assignee,due_date,tags\n";
+  ofs << "1,Fix login,todo,5,2024-01-01,,,,bug\n";
+  ofs << "2,Write docs,done,2,2024-01-02,,,,\n";
+  ofs << "3,Login page,todo,3,2024-01-03,,,,\n";
+  ofs << "4,Deploy,todo,1,2024-01-04,,,,ops\n";
+}
+
+std::vector<int> view_ids(const DataManager &data_manager) {
+  std::vector<int> ids;
+  for (const Task *task : data_manager.current_view()) {
+    ids.push_back(task->id);
+  }
+  return ids;
+}
+
+std::vector<ViewAction> stored_history() {
+  ViewStorage storage;
+  REQUIRE(storage.load_from_storage());
+  return storage.history();
+}
+} // anonymous namespace
+
+// ============================================================================
+// BatchRunner Tests
+// ============================================================================
+
+TEST_CASE("BatchRunner splits script lines", "[cli][batch]") {
+  using Args = std::vector<std::string>;
+
+  REQUIRE(BatchRunner::split_line("filter status=todo") == Args{"filter", "status=todo"});
+  REQUIRE(BatchRunner::split_line("  sort\t\"priority desc, id\"  ") == Args{"sort", "priority desc, id"});
+  REQUIRE(BatchRunner::split_line(R"(filter "title=say \"hi\" \\ bye")") == Args{"filter", R"(title=say "hi" \ bye)"});
+  REQUIRE(BatchRunner::split_line("list # show what is left") == Args{"list"});
+  REQUIRE(BatchRunner::split_line("tag=a#b") == Args{"tag=a#b"}); // '#' inside an argument is kept
+
+  REQUIRE(BatchRunner::split_line("")->empty());
+  REQUIRE(BatchRunner::split_line("   # comment only")->empty());
+  REQUIRE(!BatchRunner::split_line("filter \"status=todo").has_value());
+}
+
+TEST_CASE("BatchRunner runs a script against one DataManager", "[cli][batch]") {
+  TempCwd tmp;
+  write_sample_csv("tasks.csv");
+
+  SECTION("Consecutive filters are fused but recorded one by one") {
+    DataManager data_manager;
+    const std::string script = "# nightly\n"
+                               "load tasks.csv\n"
+                               "\n"
+                               "filter status=todo\n"
+                               "filter priority>=2\n"
+                               "sort \"priority desc\"\n"
+                               "list\n";
+    REQUIRE(BatchRunner::run(data_manager, script) == 0);
+    REQUIRE(view_ids(data_manager) == std::vector<int>{1, 3});
+
+    const std::vector<ViewAction> history = stored_history();
+    REQUIRE(history.size() == 3);
+    REQUIRE(history[0].type == ViewOpType::Filter);
+    REQUIRE(history[0].payload == "status=todo");
+    REQUIRE(history[1].payload == "priority>=2");
+    REQUIRE(history[2].type == ViewOpType::Sort);
+
+    // The persisted state is what the next process restores
+    DataManager restarted;
+    REQUIRE(view_ids(restarted) == std::vector<int>{1, 3});
+  }
+
+  SECTION("An unquoted compound filter is applied whole") {
+    DataManager data_manager;
+    REQUIRE(BatchRunner::run(data_manager,
+                             "load tasks.csv\n"
+                             "filter status=todo AND priority>=3\n"
+                             "filter id=1 OR id=3 OR id=4\n") == 0);
+    REQUIRE(view_ids(data_manager) == std::vector<int>{1, 3});
+
+    const std::vector<ViewAction> history = stored_history();
+    REQUIRE(history.size() == 2);
+    REQUIRE(history[0].payload == "status=todo AND priority>=3");
+    REQUIRE(history[1].payload == "id=1 OR id=3 OR id=4");
+
+    // As in one-shot mode, where the shell splits the expression the same way
+    const ParsedArgs parsed = CommandParser::parse({"filter", "status=todo", "AND", "priority>=3"});
+    REQUIRE(parsed.is_valid());
+    DataManager one_shot;
+    REQUIRE(one_shot.load_from_file("tasks.csv"));
+    REQUIRE(run_command(one_shot, parsed) == 0);
+    REQUIRE(view_ids(one_shot) == std::vector<int>{1, 3});
+  }
+
+  SECTION("A syntax error anywhere runs nothing") {
+    DataManager data_manager;
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter \"status=todo\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter bogus===\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter priority>=abc\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter priority IN (1, x)\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nbatch other.txt\n") == 1);
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nstop\n") == 1);
+
+    REQUIRE(data_manager.view_task_count() == 0);
+    REQUIRE(!std::filesystem::exists(".taskproc.storage"));
+  }
+
+  SECTION("Execution stops at the first failing command and keeps what ran") {
+    DataManager data_manager;
+    REQUIRE(BatchRunner::run(data_manager, "load tasks.csv\nfilter status=todo\nload missing.csv\nsort id\n") == 1);
+
+    REQUIRE(view_ids(data_manager) == std::vector<int>{1, 3, 4});
+    const std::vector<ViewAction> history = stored_history();
+    REQUIRE(history.size() == 1);
+    REQUIRE(history[0].payload == "status=todo");
+  }
+}
+
+TEST_CASE("DataManager batch mode writes the storage once", "[core][data_manager][batch]") {
+  TempCwd tmp;
+  write_sample_csv("tasks.csv");
+
+  DataManager data_manager;
+  data_manager.begin_batch();
+  REQUIRE(data_manager.load_from_file("tasks.csv"));
+  REQUIRE(data_manager.apply_filters({"status=todo", "priority<=1"}));
+  REQUIRE(data_manager.apply_sort("id desc"));
+  REQUIRE(!std::filesystem::exists(".taskproc.storage"));
+
+  data_manager.end_batch();
+  REQUIRE(std::filesystem::exists(".taskproc.storage"));
+  REQUIRE(view_ids(data_manager) == std::vector<int>{4});
+  REQUIRE(stored_history().size() == 3);
+
+  SECTION("An invalid expression applies none of the filters") {
+    REQUIRE(!data_manager.apply_filters({"status=todo", "bogus==="}));
+    REQUIRE(stored_history().size() == 3);
+  }
+}
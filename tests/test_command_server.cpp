@@ -0,0 +1,176 @@
+#include "cli/command_server.hpp"
+#include "temp_cwd.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+void write_sample_csv(const std::filesystem::path &path) {
+  std::ofstream ofs(path);
+  ofs << "id,title,status,priority,created_date,description,assignee,due_date,tags\n";
+  ofs << "1,Fix login,todo,5,2024-01-01,,,,bug\n";
+  ofs << "2,Write docs,done,2,2024-01-02,,,,\n";
+  ofs << "3,Login page,todo,3,2024-01-03,,,,\n";
+}
+
+CommandReply send(const std::vector<std::string> &args) {
+  auto reply = CommandClient::send(args);
+  REQUIRE(reply.has_value());
+  return *reply;
+}
+} // anonymous namespace
+
+TEST_CASE("CommandClient without a server", "[cli][server]") {
+  TempCwd tmp;
+
+  SECTION("No socket file") { REQUIRE(!CommandClient::send({"list"}).has_value()); }
+
+  SECTION("Stale socket file left by a dead server") {
+    // Bind a socket nobody listens on
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::string(CommandServer::DEFAULT_SOCKET).copy(address.sun_path, sizeof(address.sun_path) - 1);
+    REQUIRE(::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0);
+    ::close(fd);
+
+    REQUIRE(!CommandClient::send({"list"}).has_value());
+
+    // A new server replaces the stale file
+    CommandServer server;
+    REQUIRE(std::filesystem::exists(server.socket_path()));
+  }
+}
+
+TEST_CASE("CommandServer runs forwarded commands against one resident DataManager", "[cli][server]") {
+  TempCwd tmp;
+  write_sample_csv("tasks.csv");
+
+  auto server = std::make_unique<CommandServer>();
+  REQUIRE_THROWS_AS(CommandServer(), std::runtime_error); // one server per socket
+
+  DataManager data_manager;
+  std::thread serving([&server, &data_manager]() { server->serve(data_manager); });
+
+  CommandReply loaded = send({"load", "tasks.csv"});
+  CommandReply filtered = send({"filter", "status=todo"});
+  CommandReply listed = send({"list"});
+  CommandReply paged = send({"list", "--limit", "1", "--offset", "1"});
+  CommandReply invalid = send({"filter"});
+  CommandReply nested = send({"serve"});
+
+  // A connection that sends a truncated request gets no reply and does not stop the server
+  {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::string(CommandServer::DEFAULT_SOCKET).copy(address.sun_path, sizeof(address.sun_path) - 1);
+    REQUIRE(::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0);
+    const char partial[] = {8, 0, 0, 0, 1};
+    REQUIRE(::send(fd, partial, sizeof(partial), 0) == sizeof(partial));
+    ::close(fd);
+  }
+  CommandReply after_garbage = send({"list"});
+
+  CommandReply stopped = send({"stop"});
+  serving.join();
+  server.reset();
+
+  REQUIRE(loaded.exit_code == 0);
+  REQUIRE(loaded.out.find("Tasks loaded successfully") != std::string::npos);
+  REQUIRE(filtered.exit_code == 0);
+
+  REQUIRE(listed.exit_code == 0);
+  REQUIRE(listed.out.find("Current tasks (2)") != std::string::npos);
+  REQUIRE(listed.out.find("Fix login") != std::string::npos);
+  REQUIRE(listed.out.find("Write docs") == std::string::npos);
+
+  REQUIRE(paged.out.find("Showing 2-2") != std::string::npos);
+  REQUIRE(paged.out.find("Login page") != std::string::npos);
+
+  REQUIRE(invalid.exit_code == 1);
+  REQUIRE(invalid.err.find("requires a filter expression") != std::string::npos);
+  REQUIRE(nested.exit_code == 1);
+  REQUIRE(after_garbage.out == listed.out);
+  REQUIRE(stopped.exit_code == 0);
+
+  // The socket is gone, and the state the server persisted is what the next process sees
+  REQUIRE(!std::filesystem::exists(CommandServer::DEFAULT_SOCKET));
+  REQUIRE(!CommandClient::send({"list"}).has_value());
+  DataManager restarted;
+  REQUIRE(restarted.view_task_count() == 2);
+}
+
+TEST_CASE("CommandServer picks up edits to the tasks file", "[cli][server]") {
+  TempCwd tmp;
+  write_sample_csv("tasks.csv");
+  auto append_task = [](const std::string &row) {
+    std::ofstream ofs("tasks.csv", std::ios::app);
+    ofs << row << "\n";
+  };
+
+  auto server = std::make_unique<CommandServer>();
+  DataManager data_manager;
+  std::thread serving([&server, &data_manager]() { server->serve(data_manager); });
+
+  CommandReply loaded = send({"load", "tasks.csv"});
+  CommandReply filtered = send({"filter", "status=todo"});
+  append_task("4,Deploy,todo,1,2024-01-04,,,,");
+  CommandReply listed = send({"list"});
+  // An explicit incremental reload still reports what changed, rather than finding it applied
+  append_task("5,Release,todo,2,2024-01-05,,,,");
+  CommandReply reloaded = send({"reload", "--incremental"});
+  CommandReply stopped = send({"stop"});
+  serving.join();
+  server.reset();
+
+  REQUIRE(loaded.exit_code == 0);
+  REQUIRE(filtered.exit_code == 0);
+  REQUIRE(listed.exit_code == 0);
+  REQUIRE(listed.out.find("Current tasks (3)") != std::string::npos);
+  REQUIRE(listed.out.find("Deploy") != std::string::npos);
+  REQUIRE(reloaded.out.find("1 inserted, 0 updated, 0 deleted") != std::string::npos);
+  REQUIRE(stopped.exit_code == 0);
+
+  // The server and a new process agree
+  DataManager restarted;
+  REQUIRE(restarted.view_task_count() == 4);
+}
+
+TEST_CASE("CommandServer survives a request that would overflow the parser", "[cli][server]") {
+  TempCwd tmp;
+  write_sample_csv("tasks.csv");
+
+  auto server = std::make_unique<CommandServer>();
+  DataManager data_manager;
+  std::thread serving([&server, &data_manager]() { server->serve(data_manager); });
+
+  const std::string deep = std::string(100000, '(') + "status=todo" + std::string(100000, ')');
+  std::string negated_script = "filter \"";
+  for (int i = 0; i < 100000; ++i) {
+    negated_script += "NOT ";
+  }
+  negated_script += "status=todo\"";
+
+  CommandReply loaded = send({"load", "tasks.csv"});
+  CommandReply nested = send({"filter", deep});
+  CommandReply negated = send({"batch", "-c", negated_script});
+  CommandReply listed = send({"list"});
+  CommandReply stopped = send({"stop"});
+  serving.join();
+  server.reset();
+
+  REQUIRE(loaded.exit_code == 0);
+  REQUIRE(nested.exit_code == 1);
+  REQUIRE(nested.err.find("nested deeper than") != std::string::npos);
+  REQUIRE(negated.exit_code == 1);
+  REQUIRE(listed.exit_code == 0);
+  REQUIRE(listed.out.find("Current tasks (3)") != std::string::npos);
+  REQUIRE(stopped.exit_code == 0);
+}
@@ -1,8 +1,15 @@
+#include "cli/commands.hpp"
 #include "core/data_manager.hpp"
+#include "temp_cwd.hpp"
 #include <catch2/catch_test_macros.hpp>
 
 #include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 // RAII helper to ensure temp files are removed even if the test aborts.
 struct TempFile {
@@ -16,10 +23,11 @@ struct TempFile {
 
 // Verify DataManager load/reload/select behavior
 TEST_CASE("DataManager load and reload", "[core][data_manager]") {
+  TempCwd tmp; // DataManager keeps its storage, snapshot and view cache in the CWD
   DataManager dm;
 
   SECTION("load and reload on same instance succeeds") {
-    // Create a minimal CSV file the CSVReader can parse
+    // Create a minimal CSV file the CSV reader can parse
     auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_test.csv";
     TempFile tf(tmp_csv);
 
@@ -56,7 +64,7 @@ TEST_CASE("DataManager load and reload", "[core][data_manager]") {
   }
 
   SECTION("DataManager reload across instances (simulates separate processes)") {
-    // Create a minimal CSV file the CSVReader can parse
+    // Create a minimal CSV file the CSV reader can parse
     auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_test.csv";
     TempFile tf(tmp_csv);
 
@@ -78,4 +86,290 @@ TEST_CASE("DataManager load and reload", "[core][data_manager]") {
     DataManager dm_new;
     REQUIRE(dm_new.reload_tasks());
   }
+
+  SECTION("incremental reload keeps the view and applies the changed rows") {
+    auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_delta_test.csv";
+    TempFile tf(tmp_csv);
+    auto write_csv = [&tmp_csv](const std::string &rows) {
+      std::ofstream ofs(tmp_csv, std::ios::trunc);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n" << rows;
+    };
+
+    write_csv("1,One,todo,1,,,,2024-01-01,\n2,Two,done,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n");
+    REQUIRE(dm.load_from_file(tmp_csv.string()));
+    REQUIRE(dm.apply_filter("status=todo"));
+    REQUIRE(dm.apply_sort("priority desc"));
+    REQUIRE(dm.view_task_count() == 2);
+
+    // Task 1 is deleted, task 2 becomes todo, task 4 is new
+    write_csv("2,Two,todo,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n4,Four,todo,9,,,,2024-01-01,\n");
+    ReloadDelta delta;
+    REQUIRE(dm.reload_incremental(&delta));
+    REQUIRE(delta.inserted == 1);
+    REQUIRE(delta.updated == 1);
+    REQUIRE(delta.deleted == 1);
+
+    std::vector<int> ids;
+    for (const Task *task : dm.current_view()) {
+      ids.push_back(task->id);
+    }
+    REQUIRE(ids == std::vector<int>{4, 3, 2});
+
+    // A new process restores the same view for the changed file
+    DataManager restarted;
+    REQUIRE(restarted.view_task_count() == 3);
+    REQUIRE(restarted.current_view().front()->id == 4);
+  }
+
+  SECTION("a repeated pipeline restores the cached view") {
+    auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_cache_test.csv";
+    TempFile tf(tmp_csv);
+    {
+      std::ofstream ofs(tmp_csv);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+      ofs << "1,One,todo,1,,,,2024-01-01,\n2,Two,done,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n";
+    }
+    auto view_ids = [&dm]() {
+      std::vector<int> ids;
+      for (const Task *task : dm.current_view()) {
+        ids.push_back(task->id);
+      }
+      return ids;
+    };
+
+    REQUIRE(dm.load_from_file(tmp_csv.string()));
+    REQUIRE(dm.apply_filter("status=todo"));
+    REQUIRE(dm.apply_sort("priority desc"));
+    REQUIRE(view_ids() == std::vector<int>{3, 1});
+
+    // Same pipeline, spelled differently: both steps are cache hits and give the same view
+    dm.reset_view();
+    REQUIRE(dm.apply_filter("  status=todo "));
+    REQUIRE(dm.apply_sort("priority descending"));
+    REQUIRE(view_ids() == std::vector<int>{3, 1});
+
+    REQUIRE(dm.apply_sort("priority"));
+    REQUIRE(view_ids() == std::vector<int>{1, 3});
+  }
+
+  SECTION("a new process restores the view from its cache entry without replaying") {
+    auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_restore_test.csv";
+    TempFile tf(tmp_csv);
+    {
+      std::ofstream ofs(tmp_csv);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+      ofs << "1,One,todo,1,,,,2024-01-01,\n2,Two,done,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n";
+    }
+    REQUIRE(dm.load_from_file(tmp_csv.string()));
+    REQUIRE(dm.apply_filter("status=todo"));
+    REQUIRE(dm.apply_sort("priority desc"));
+
+    // The view is written once, as a cache entry, not also next to the storage file
+    REQUIRE(!std::filesystem::exists(".taskproc.storage.view"));
+
+    std::ostringstream err;
+    std::streambuf *saved = std::cerr.rdbuf(err.rdbuf());
+    DataManager restarted;
+    std::cerr.rdbuf(saved);
+    REQUIRE(err.str().find("Replaying") == std::string::npos);
+    REQUIRE(restarted.view_task_count() == 2);
+    REQUIRE(restarted.current_view().front()->id == 3);
+  }
+
+  SECTION("a lookalike cached pipeline does not stand in for one that parses differently") {
+    // Two copies of one dataset: their fingerprints differ, so each starts with an empty cache
+    auto first_csv = std::filesystem::temp_directory_path() / "taskproc_dm_cache_a.csv";
+    auto second_csv = std::filesystem::temp_directory_path() / "taskproc_dm_cache_b.csv";
+    TempFile first_tf(first_csv);
+    TempFile second_tf(second_csv);
+    for (const auto &path : {first_csv, second_csv}) {
+      std::ofstream ofs(path);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+      ofs << "1,a  b,todo,3,,,,2024-01-01,\n2,a b,todo,2,,,,2024-01-01,\n3,a  b,todo,1,,,,2024-01-01,\n";
+    }
+    auto run = [&dm](const std::string &filter, const std::string &sort) {
+      dm.reset_view();
+      REQUIRE(dm.apply_filter(filter));
+      REQUIRE(dm.apply_sort(sort));
+      std::vector<int> ids;
+      for (const Task *task : dm.current_view()) {
+        ids.push_back(task->id);
+      }
+      return ids;
+    };
+
+    // The inner double space is part of the value; an unknown direction ("  desc") sorts ascending
+    const std::vector<std::pair<std::string, std::string>> spaced{{"title=a  b", "priority desc"},
+                                                                  {"status=todo", "priority  desc"}};
+    const std::vector<std::pair<std::string, std::string>> lookalike{{"title=a b", "priority desc"},
+                                                                     {"status=todo", "priority desc"}};
+    for (size_t i = 0; i < spaced.size(); ++i) {
+      // Cold on one copy, warm (after the lookalike is cached) on the other, in both orders
+      REQUIRE(dm.load_from_file(first_csv.string()));
+      const auto spaced_cold = run(spaced[i].first, spaced[i].second);
+      const auto lookalike_warm = run(lookalike[i].first, lookalike[i].second);
+      REQUIRE(dm.load_from_file(second_csv.string()));
+      const auto lookalike_cold = run(lookalike[i].first, lookalike[i].second);
+      const auto spaced_warm = run(spaced[i].first, spaced[i].second);
+
+      REQUIRE(spaced_cold != lookalike_cold);
+      REQUIRE(spaced_warm == spaced_cold);
+      REQUIRE(lookalike_warm == lookalike_cold);
+    }
+  }
+
+  SECTION("a projected session decodes missing fields on demand") {
+    auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_projection_test.csv";
+    TempFile tf(tmp_csv);
+    {
+      std::ofstream ofs(tmp_csv);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+      ofs << "1,One,todo,1,first,,,2024-01-01,bug\n2,Two,done,2,second,,,2024-01-01,\n3,Three,todo,3,third,,,2024-01-01,bug\n";
+    }
+    REQUIRE(dm.load_from_file(tmp_csv.string()));
+    REQUIRE(dm.apply_filter("status=todo"));
+
+    // A new process asking for priorities only restores the view without titles
+    DataManager projected(TaskField::Priority);
+    REQUIRE(projected.loaded_fields() == TaskFields(TaskField::Priority));
+    REQUIRE(projected.view_task_count() == 2);
+    REQUIRE(projected.current_view().front()->title.empty());
+
+    // Tags are decoded before the tag filter runs, and the view carries over
+    REQUIRE(projected.filter_by_tag("bug"));
+    REQUIRE(projected.loaded_fields().is_all());
+    REQUIRE(projected.view_task_count() == 2);
+    REQUIRE(projected.current_view().front()->title == "One");
+  }
+
+  SECTION("a sharded dataset loads and reloads shard by shard") {
+    auto dir = std::filesystem::temp_directory_path() / "taskproc_dm_shards_test";
+    std::filesystem::create_directories(dir);
+    TempFile td(dir), a(dir / "a.csv"), b(dir / "b.csv"), c(dir / "c.csv");
+    auto write_shard = [](const std::filesystem::path &path, const std::string &rows) {
+      std::ofstream ofs(path, std::ios::trunc);
+      REQUIRE(ofs.is_open());
+      ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n" << rows;
+    };
+    auto titles = [&dm]() {
+      std::vector<std::string> out;
+      for (const Task *task : dm.current_view()) {
+        out.push_back(std::to_string(task->id) + ":" + task->title);
+      }
+      return out;
+    };
+
+    // Task 2 is in both shards; b.csv sorts last, so its row wins
+    write_shard(a.path, "1,One,todo,1,,,,2024-01-01,\n2,Two (a),todo,2,,,,2024-01-01,\n");
+    write_shard(b.path, "2,Two (b),todo,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n");
+    REQUIRE(dm.load_from_file((dir / "*.csv").string()));
+    REQUIRE(dm.apply_sort("priority asc"));
+    REQUIRE(titles() == std::vector<std::string>{"1:One", "2:Two (b)", "3:Three"});
+
+    // b.csv drops task 2, so a.csv's row comes back; c.csv is new
+    write_shard(b.path, "3,Three,todo,3,,,,2024-01-01,\n");
+    write_shard(c.path, "4,Four,todo,4,,,,2024-01-01,\n");
+    ReloadDelta delta;
+    REQUIRE(dm.reload_incremental(&delta));
+    REQUIRE(delta.inserted == 1);
+    REQUIRE(delta.updated == 1);
+    REQUIRE(delta.deleted == 0);
+    REQUIRE(titles() == std::vector<std::string>{"1:One", "2:Two (a)", "3:Three", "4:Four"});
+
+    // A new process restored from the snapshot reloads using the stored shard list
+    DataManager restarted;
+    write_shard(a.path, "1,One!,todo,1,,,,2024-01-01,\n2,Two (a),todo,2,,,,2024-01-01,\n");
+    REQUIRE(restarted.reload_incremental(&delta));
+    REQUIRE(delta.updated == 1);
+    REQUIRE(restarted.current_view().front()->title == "One!");
+  }
+}
+
+// Verify export of the view and of the whole dataset
+TEST_CASE("DataManager export", "[core][data_manager]") {
+  TempCwd tmp;
+  DataManager dm;
+  auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_export_test.csv";
+  auto tmp_out = std::filesystem::temp_directory_path() / "taskproc_dm_export_test.jsonl";
+  TempFile in(tmp_csv);
+  TempFile out(tmp_out);
+  {
+    std::ofstream ofs(tmp_csv);
+    ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+    ofs << "1,One,todo,1,,,,2024-01-01,\n2,Two,done,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n";
+  }
+  REQUIRE(dm.load_from_file(tmp_csv.string()));
+  REQUIRE(dm.apply_filter("status=todo"));
+  REQUIRE(dm.apply_sort("priority desc"));
+
+  auto lines = [&tmp_out]() {
+    std::ifstream ifs(tmp_out);
+    std::vector<std::string> result;
+    for (std::string line; std::getline(ifs, line);) {
+      result.push_back(line.substr(0, line.find(',')));
+    }
+    return result;
+  };
+
+  SECTION("The format follows the extension or --format") {
+    REQUIRE(dm.export_tasks(dm.current_view(), tmp_out.string()));
+    REQUIRE(lines() == std::vector<std::string>{R"({"id":3)", R"({"id":1)"});
+
+    REQUIRE(dm.export_tasks(dm.view_page(1, 1), tmp_out.string(), "csv"));
+    REQUIRE(lines() == std::vector<std::string>{"id", "1"});
+
+    REQUIRE(!dm.export_tasks(dm.current_view(), tmp_out.string(), "xml"));
+    REQUIRE(!dm.export_tasks(dm.current_view(), "tasks.txt"));
+  }
+
+  SECTION("All tasks ignore the view") {
+    REQUIRE(dm.all_tasks().size() == 3);
+    REQUIRE(dm.export_tasks(dm.all_tasks(), tmp_out.string()));
+    REQUIRE(lines() == std::vector<std::string>{R"({"id":1)", R"({"id":2)", R"({"id":3)"});
+  }
+}
+
+TEST_CASE("One-shot reload --incremental diffs the file against the previous session", "[core][data_manager]") {
+  TempCwd tmp;
+  auto tmp_csv = std::filesystem::temp_directory_path() / "taskproc_dm_oneshot_reload.csv";
+  TempFile tf(tmp_csv);
+  {
+    std::ofstream ofs(tmp_csv);
+    REQUIRE(ofs.is_open());
+    ofs << "id,title,status,priority,description,assignee,due_date,created_date,tags\n";
+    ofs << "1,One,todo,1,,,,2024-01-01,\n2,Two,done,2,,,,2024-01-01,\n3,Three,todo,3,,,,2024-01-01,\n";
+  }
+  {
+    DataManager first;
+    REQUIRE(first.load_from_file(tmp_csv.string()));
+    REQUIRE(first.apply_filter("status=todo"));
+  }
+  {
+    std::ofstream ofs(tmp_csv, std::ios::app);
+    ofs << "4,Four,todo,4,,,,2024-01-01,\n";
+  }
+
+  // As main() does: the constructor must leave the new row for the reload to find
+  const char *args[] = {"taskproc", "reload", "--incremental"};
+  const ParsedArgs parsed = CommandParser::parse(3, const_cast<char **>(args));
+  REQUIRE(parsed.is_valid());
+  DataManager dm(command_fields(parsed), command_session(parsed));
+  REQUIRE(dm.view_task_count() == 2);
+
+  std::ostringstream out;
+  std::streambuf *saved = std::cout.rdbuf(out.rdbuf());
+  const int exit_code = run_command(dm, parsed);
+  std::cout.rdbuf(saved);
+  REQUIRE(exit_code == 0);
+  REQUIRE(out.str().find("1 inserted, 0 updated, 0 deleted") != std::string::npos);
+  REQUIRE(dm.view_task_count() == 3);
+
+  // Other commands start from the file as it is now
+  const char *list_args[] = {"taskproc", "list"};
+  REQUIRE(command_session(CommandParser::parse(2, const_cast<char **>(list_args))) == SessionStart::Current);
 }
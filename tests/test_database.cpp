@@ -1,6 +1,11 @@
 #include "core/database.hpp"
+#include "core/date.hpp"
+#include "core/expr_parser.hpp"
 #include "core/task.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include <climits>
 
 // ============================================================================
 // Database Basic Operations Tests
@@ -56,6 +61,33 @@ TEST_CASE("Database load and access", "[core][database]") {
     REQUIRE(db.get_task_by_id(1) == nullptr);
     REQUIRE(db.get_task_by_id(2) != nullptr);
   }
+
+  SECTION("ID lookup with gaps, negative and sparse IDs") {
+    // Dense with gaps and a negative ID: direct index, misses inside and outside the range
+    std::vector<Task> dense;
+    for (int id : {-2, 1, 2, 3, 5, 8}) {
+      dense.emplace_back(id, "Task " + std::to_string(id));
+    }
+    db.load(std::move(dense));
+    for (int id : {-2, 1, 2, 3, 5, 8}) {
+      REQUIRE(db.get_task_by_id(id)->id == id);
+    }
+    for (int id : {-3, -1, 0, 4, 6, 7, 9, INT_MIN, INT_MAX}) {
+      REQUIRE(db.get_task_by_id(id) == nullptr);
+    }
+
+    // Sparse: IDs spread far beyond the task count fall back to a binary search
+    std::vector<Task> sparse;
+    for (int id : {INT_MIN, 7, 1000000, INT_MAX}) {
+      sparse.emplace_back(id, "Task " + std::to_string(id));
+    }
+    db.load(std::move(sparse));
+    for (int id : {INT_MIN, 7, 1000000, INT_MAX}) {
+      REQUIRE(db.get_task_by_id(id)->id == id);
+    }
+    REQUIRE(db.get_task_by_id(8) == nullptr);
+    REQUIRE(db.get_task_by_id(-2) == nullptr);
+  }
 }
 
 // ============================================================================
@@ -125,6 +157,126 @@ TEST_CASE("Database filtering", "[core][database]") {
   }
 }
 
+TEST_CASE("Database filtering on id and optional fields", "[core][database]") {
+  Database db;
+
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "One", "todo", 1, "2024-01-01", "first", "alice");
+  tasks.emplace_back(2, "Two", "todo", 2, "2024-01-02", std::nullopt, "bob");
+  tasks.emplace_back(3, "Three", "done", 3, "2024-01-03", "third");
+  db.load(std::move(tasks));
+
+  SECTION("Filter by id range") {
+    db.apply_filter(FilterSpec{FilterField::Id, FilterOp::GreaterThan, "1"});
+    REQUIRE(db.view_task_count() == 2);
+    REQUIRE(db.current_view()[0]->id == 2);
+  }
+
+  SECTION("Filter by assignee") {
+    db.apply_filter(FilterSpec{FilterField::Assignee, FilterOp::Equal, "alice"});
+    REQUIRE(db.view_task_count() == 1);
+    REQUIRE(db.current_view()[0]->id == 1);
+  }
+
+  SECTION("Missing assignee matches neither = nor !=") {
+    db.apply_filter(FilterSpec{FilterField::Assignee, FilterOp::NotEqual, "alice"});
+    REQUIRE(db.view_task_count() == 1);
+    REQUIRE(db.current_view()[0]->id == 2);
+  }
+
+  SECTION("Filter by description") {
+    db.apply_filter(FilterSpec{FilterField::Description, FilterOp::Equal, "third"});
+    REQUIRE(db.view_task_count() == 1);
+    REQUIRE(db.current_view()[0]->id == 3);
+  }
+
+  SECTION("Filter by created date equality") {
+    db.apply_filter(FilterSpec{FilterField::CreatedDate, FilterOp::NotEqual, "2024-01-02"});
+    REQUIRE(db.view_task_count() == 2);
+  }
+
+  SECTION("Unknown status matches nothing") {
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "blocked"});
+    REQUIRE(db.view_task_count() == 0);
+  }
+
+  SECTION("Integer literals must parse whole") {
+    REQUIRE_THROWS_AS(db.apply_filter(FilterSpec{FilterField::Priority, FilterOp::GreaterThanOrEqual, "4abc"}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(db.apply_filter(FilterSpec{FilterField::Id, FilterOp::Equal, "99999999999"}), std::out_of_range);
+    REQUIRE(db.view_task_count() == 3);
+  }
+}
+
+TEST_CASE("Database compound filter expressions", "[core][database]") {
+  Database db;
+
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "One", "todo", 1, "2024-01-01", std::nullopt, "alice");
+  tasks.emplace_back(2, "Two", "in-progress", 4, "2024-01-02", std::nullopt, "bob");
+  tasks.emplace_back(3, "Three", "done", 5, "2024-01-03");
+  tasks.emplace_back(4, "Four", "todo", 5, "2024-01-04", std::nullopt, "bob");
+  tasks.emplace_back(5, "Five", "blocked", 2, "2024-01-05", std::nullopt, "alice");
+  db.load(std::move(tasks));
+
+  auto apply = [&db](std::string_view expr) {
+    auto parsed = ExpressionParser::parse_filter_expr(expr);
+    REQUIRE(parsed.has_value());
+    db.apply_filter(*parsed);
+  };
+  auto view_ids = [&db]() {
+    std::vector<int> ids;
+    for (const Task *task : db.current_view()) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+
+  SECTION("AND") {
+    apply("status=todo AND priority>=5");
+    REQUIRE(view_ids() == std::vector<int>{4});
+  }
+
+  SECTION("OR keeps view order") {
+    apply("assignee=alice OR priority=5");
+    REQUIRE(view_ids() == std::vector<int>{1, 3, 4, 5});
+  }
+
+  SECTION("NOT and parentheses") {
+    apply("NOT (status=todo OR assignee=alice)");
+    REQUIRE(view_ids() == std::vector<int>{2, 3});
+  }
+
+  SECTION("IN on coded, integer and text fields") {
+    apply("status IN (todo, blocked, unknown)");
+    REQUIRE(view_ids() == std::vector<int>{1, 4, 5});
+
+    db.reset_view();
+    apply("priority IN (1, 5)");
+    REQUIRE(view_ids() == std::vector<int>{1, 3, 4});
+
+    db.reset_view();
+    apply("title IN (Two, Five)");
+    REQUIRE(view_ids() == std::vector<int>{2, 5});
+  }
+
+  SECTION("Zero-cost constants mix with costed children") {
+    // Ordering operators on status match nothing: constant children, ordered apart from the others
+    apply("NOT status>a AND priority>=2 AND NOT status>b AND priority<=4 AND NOT assignee>c");
+    REQUIRE(view_ids() == std::vector<int>{2, 5});
+
+    db.reset_view();
+    apply("status>a OR priority=5 OR status>b OR assignee=alice OR status<c");
+    REQUIRE(view_ids() == std::vector<int>{1, 3, 4, 5});
+  }
+
+  SECTION("Expressions narrow the existing view") {
+    apply("priority>1");
+    apply("assignee=bob OR status=done");
+    REQUIRE(view_ids() == std::vector<int>{2, 3, 4});
+  }
+}
+
 // ============================================================================
 // Sort Tests
 // ============================================================================
@@ -234,6 +386,72 @@ TEST_CASE("Database statistics", "[core][database]") {
   }
 }
 
+TEST_CASE("Database group-by statistics", "[core][database]") {
+  Database db;
+
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "Task 1", "todo", 2, "2024-01-05", std::nullopt, "alice", "2024-02-01",
+                     std::vector<std::string>{"bug"});
+  tasks.emplace_back(2, "Task 2", "done", 4, "2024-01-20", std::nullopt, "bob", "2024-01-15",
+                     std::vector<std::string>{"bug", "ui"});
+  tasks.emplace_back(3, "Task 3", "in-progress", 3, "2024-02-03", std::nullopt, "alice", "2024-03-10");
+  tasks.emplace_back(4, "Task 4", "todo", 5, "not a date", std::nullopt, std::nullopt, std::nullopt,
+                     std::vector<std::string>{"ui"});
+  tasks.emplace_back(5, "Task 5", "todo", 1, "2024-02-28", std::nullopt, "alice", "2024-01-10");
+  db.load(std::move(tasks));
+
+  SECTION("By assignee: every aggregate in one pass, missing values last") {
+    auto groups = db.group_stats(GroupField::Assignee, "2024-02-15");
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups[0].key == "alice");
+    REQUIRE(groups[0].count == 3);
+    REQUIRE(groups[0].average_priority == 2.0);
+    REQUIRE(groups[0].overdue_count == 2); // tasks 1 and 5
+    REQUIRE(groups[0].min_due == "2024-01-10");
+    REQUIRE(groups[0].max_due == "2024-03-10");
+    REQUIRE(groups[1].key == "bob");
+    REQUIRE(groups[1].overdue_count == 0); // done
+    REQUIRE(groups[2].key.empty());
+    REQUIRE(groups[2].count == 1);
+    REQUIRE(!groups[2].min_due.has_value());
+  }
+
+  SECTION("By status, within the current view") {
+    db.apply_filter(FilterSpec{FilterField::Priority, FilterOp::GreaterThanOrEqual, "2"});
+    auto groups = db.group_stats(GroupField::Status, "2024-02-15");
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups[0].key == "done");
+    REQUIRE(groups[1].key == "in-progress");
+    REQUIRE(groups[2].key == "todo");
+    REQUIRE(groups[2].count == 2);
+    REQUIRE(groups[2].average_priority == 3.5);
+  }
+
+  SECTION("By tag: a task counts once per tag") {
+    auto groups = db.group_stats(GroupField::Tag, "2024-02-15");
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups[0].key == "bug");
+    REQUIRE(groups[0].count == 2);
+    REQUIRE(groups[1].key == "ui");
+    REQUIRE(groups[1].count == 2);
+    REQUIRE(groups[2].key.empty());
+    REQUIRE(groups[2].count == 2);
+  }
+
+  SECTION("By created month; an invalid today counts nothing overdue") {
+    auto groups = db.group_stats(GroupField::CreatedMonth, "yesterday");
+    REQUIRE(groups.size() == 3);
+    REQUIRE(groups[0].key == "2024-01");
+    REQUIRE(groups[0].count == 2);
+    REQUIRE(groups[1].key == "2024-02");
+    REQUIRE(groups[1].count == 2);
+    REQUIRE(groups[2].key.empty());
+    for (const auto &group : groups) {
+      REQUIRE(group.overdue_count == 0);
+    }
+  }
+}
+
 // ============================================================================
 // Tag Filter Tests
 // ============================================================================
@@ -274,30 +492,798 @@ TEST_CASE("Database tag filtering", "[core][database]") {
 
   db.load(std::move(tasks));
 
-  // TODO: uncomment filter_by_tag tests
-  // SECTION("Filter by tag 'urgent'") {
-  //   db.filter_by_tag("urgent");
-  //   REQUIRE(db.view_task_count() == 2);
-  //   for (const auto *task : db.current_view()) {
-  //     bool has_urgent = false;
-  //     for (const auto &tag : task->tags) {
-  //       if (tag == "urgent") {
-  //         has_urgent = true;
-  //         break;
-  //       }
-  //     }
-  //     REQUIRE(has_urgent);
-  //   }
-  // }
-
-  // SECTION("Filter by tag 'feature'") {
-  //   db.filter_by_tag("feature");
-  //   REQUIRE(db.view_task_count() == 2);
-  // }
-
-  // SECTION("Filter no tags") {
-  //   db.filter_no_tags();
-  //   REQUIRE(db.view_task_count() == 1);
-  //   REQUIRE(db.current_view()[0]->tags.empty());
-  // }
+  SECTION("Filter by tag 'urgent'") {
+    db.filter_by_tag("urgent");
+    REQUIRE(db.view_task_count() == 2);
+    for (const auto *task : db.current_view()) {
+      bool has_urgent = false;
+      for (const auto &tag : task->tags) {
+        if (tag == "urgent") {
+          has_urgent = true;
+          break;
+        }
+      }
+      REQUIRE(has_urgent);
+    }
+  }
+
+  SECTION("Filter by tag 'feature'") {
+    db.filter_by_tag("feature");
+    REQUIRE(db.view_task_count() == 2);
+  }
+
+  SECTION("Filter by unknown tag") {
+    db.filter_by_tag("missing");
+    REQUIRE(db.view_task_count() == 0);
+  }
+
+  SECTION("Filter no tags") {
+    db.filter_no_tags();
+    REQUIRE(db.view_task_count() == 1);
+    REQUIRE(db.current_view()[0]->tags.empty());
+  }
+
+  SECTION("Tag filter keeps a sorted view's order") {
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Descending});
+    db.filter_by_tag("feature");
+    REQUIRE(db.view_task_count() == 2);
+    REQUIRE(db.current_view()[0]->id == 4);
+    REQUIRE(db.current_view()[1]->id == 2);
+  }
+
+  SECTION("Tag and status filters compose") {
+    db.filter_by_tag("urgent");
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "todo"});
+    REQUIRE(db.view_task_count() == 2);
+    db.filter_by_tag("bug");
+    REQUIRE(db.view_task_count() == 1);
+    REQUIRE(db.current_view()[0]->id == 1);
+  }
+}
+
+// ============================================================================
+// Text Search Tests
+// ============================================================================
+
+TEST_CASE("Database text search", "[core][database]") {
+  Database db;
+
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "Fix login bug", "todo", 5, "2024-01-01", "Crash after password reset");
+  tasks.emplace_back(2, "Login page", "done", 2, "2024-01-02");
+  tasks.emplace_back(3, "Write docs", "todo", 3, "2024-01-03", "Document the LOGIN flow");
+  tasks.emplace_back(4, "Password policy", "todo", 4, "2024-01-04");
+  db.load(std::move(tasks));
+
+  auto view_ids = [&db]() {
+    std::vector<int> ids;
+    for (const Task *task : db.current_view()) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+
+  SECTION("The first search builds the index") {
+    REQUIRE(db.text_index() == nullptr);
+    db.search_text("login");
+    REQUIRE(db.text_index() != nullptr);
+    REQUIRE(view_ids() == std::vector<int>{1, 2, 3});
+  }
+
+  SECTION("Every word must match, in title or description") {
+    db.search_text("LOGIN password");
+    REQUIRE(view_ids() == std::vector<int>{1});
+  }
+
+  SECTION("Words match as substrings and searches narrow the view") {
+    db.search_text("pass");
+    REQUIRE(view_ids() == std::vector<int>{1, 4});
+    db.search_text("pol");
+    REQUIRE(view_ids() == std::vector<int>{4});
+  }
+
+  SECTION("Order of a sorted view is preserved") {
+    db.apply_sort(SortSpec(SortField::Priority, SortDirection::Descending));
+    db.search_text("login");
+    REQUIRE(view_ids() == std::vector<int>{1, 3, 2});
+  }
+
+  SECTION("A text without words leaves the view unchanged") {
+    db.search_text(" - ");
+    REQUIRE(db.view_task_count() == 4);
+  }
+
+  SECTION("Replay applies recorded searches") {
+    db.replay_history({ViewAction{ViewOpType::Filter, "status=todo"}, ViewAction{ViewOpType::Search, "login"}});
+    REQUIRE(view_ids() == std::vector<int>{1, 3});
+  }
+
+  SECTION("An index is only adopted for the same number of rows") {
+    TaskColumns other;
+    other.append(Task(1, "Only row", "todo", 1));
+    REQUIRE(!db.set_text_index(TextIndex::build(other)));
+    REQUIRE(db.text_index() == nullptr);
+  }
+
+  SECTION("Loading drops the index") {
+    db.search_text("login");
+    db.load(std::vector<Task>{Task(7, "Other", "todo", 1)});
+    REQUIRE(db.text_index() == nullptr);
+  }
+}
+
+TEST_CASE("Database text search scans small views", "[core][database]") {
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 400; ++id) {
+    tasks.emplace_back(id, id % 2 == 0 ? "Fix LOGIN" : "Write docs", id <= 3 ? "blocked" : "todo", 1, "2024-01-01");
+  }
+  Database db;
+  db.load(std::move(tasks));
+
+  db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "blocked"});
+  db.search_text("logi");
+  REQUIRE(db.text_index() == nullptr);
+  REQUIRE(db.view_task_count() == 1);
+  REQUIRE(db.current_view()[0]->id == 2);
+
+  // The same search over the whole view builds the index and agrees
+  db.reset_view();
+  db.search_text("logi");
+  REQUIRE(db.text_index() != nullptr);
+  REQUIRE(db.view_task_count() == 200);
+}
+
+// ============================================================================
+// Index Planner Tests
+// ============================================================================
+
+TEST_CASE("Database answers indexed filters on any view shape", "[core][database]") {
+  Database db;
+
+  // 100 tasks: status cycles todo/done/in-progress/blocked, every 10th task is tagged "rare"
+  const std::vector<std::string> statuses{"todo", "done", "in-progress", "blocked"};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 100; ++id) {
+    std::vector<std::string> tags;
+    if (id % 10 == 0)
+      tags = {"rare", "rare"}; // a repeated tag must not duplicate the row
+    tasks.emplace_back(id,
+                       "Task " + std::to_string(id),
+                       statuses[id % 4],
+                       id % 5 + 1,
+                       "2024-01-01",
+                       std::nullopt,
+                       std::nullopt,
+                       std::nullopt,
+                       tags);
+  }
+  db.load(std::move(tasks));
+
+  auto view_ids = [&db]() {
+    std::vector<int> ids;
+    for (const Task *task : db.current_view()) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+
+  SECTION("Full view") {
+    db.filter_by_tag("rare");
+    REQUIRE(view_ids() == std::vector<int>{10, 20, 30, 40, 50, 60, 70, 80, 90, 100});
+  }
+
+  SECTION("Narrowed, ordered view (intersection)") {
+    db.apply_filter(FilterSpec{FilterField::Id, FilterOp::GreaterThan, "35"});
+    db.filter_by_tag("rare");
+    REQUIRE(view_ids() == std::vector<int>{40, 50, 60, 70, 80, 90, 100});
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "todo"});
+    REQUIRE(view_ids() == std::vector<int>{40, 60, 80, 100}); // id % 4 == 0
+  }
+
+  SECTION("Small view (scan)") {
+    db.apply_filter(FilterSpec{FilterField::Id, FilterOp::LessThanOrEqual, "12"});
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "done"});
+    REQUIRE(view_ids() == std::vector<int>{1, 5, 9});
+  }
+
+  SECTION("Reordered view (bitmap) keeps order") {
+    db.apply_sort(SortSpec{SortField::Id, SortDirection::Descending});
+    db.filter_by_tag("rare");
+    REQUIRE(view_ids() == std::vector<int>{100, 90, 80, 70, 60, 50, 40, 30, 20, 10});
+  }
+
+  SECTION("AND with a status operand narrows through the index") {
+    db.apply_filter(FilterExpr::all_of({FilterExpr::term({FilterField::Priority, FilterOp::GreaterThan, "3"}),
+                                        FilterExpr::term({FilterField::Status, FilterOp::Equal, "todo"})}));
+    for (const Task *task : db.current_view()) {
+      REQUIRE(task->status == "todo");
+      REQUIRE(task->priority > 3);
+    }
+    REQUIRE(db.view_task_count() == 10); // id % 4 == 0 and id % 5 >= 3
+  }
+
+  SECTION("Unknown status empties the view") {
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "archived"});
+    REQUIRE(db.view_task_count() == 0);
+  }
+}
+
+TEST_CASE("Database bitmap view with lazily ordered rows", "[core][database]") {
+  Database db;
+
+  const std::vector<std::string> statuses{"todo", "done", "in-progress"};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 60; ++id) {
+    tasks.emplace_back(id, "Task " + std::to_string(id % 7), statuses[id % 3], id % 5 + 1, "2024-01-01");
+  }
+  db.load(tasks);
+
+  auto view_ids = [&db]() {
+    std::vector<int> ids;
+    for (const Task *task : db.current_view()) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+
+  SECTION("Sorts and filters compose like successive stable sorts") {
+    db.apply_sort(SortSpec{SortField::Title, SortDirection::Ascending});
+    db.apply_filter(FilterSpec{FilterField::Priority, FilterOp::GreaterThan, "2"});
+    db.apply_sort(SortSpec{SortField::Status, SortDirection::Descending});
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Ascending});
+
+    std::vector<Task> expected;
+    for (const auto &task : tasks) {
+      if (task.priority > 2)
+        expected.push_back(task);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const Task &a, const Task &b) { return a.title < b.title; });
+    std::stable_sort(
+        expected.begin(), expected.end(), [](const Task &a, const Task &b) { return a.status > b.status; });
+    std::stable_sort(
+        expected.begin(), expected.end(), [](const Task &a, const Task &b) { return a.priority < b.priority; });
+
+    std::vector<int> expected_ids;
+    for (const auto &task : expected) {
+      expected_ids.push_back(task.id);
+    }
+    REQUIRE(db.view_task_count() == expected_ids.size());
+    REQUIRE(view_ids() == expected_ids);
+  }
+
+  SECTION("Re-sorting a field replaces its earlier sort") {
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Ascending});
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Descending});
+    auto ids = view_ids();
+    REQUIRE(db.current_view().front()->priority == 5);
+    REQUIRE(ids.front() == 4); // ties keep ID order
+  }
+
+  SECTION("OR over indexed and scanned operands") {
+    db.apply_filter(*ExpressionParser::parse_filter_expr("status IN (done, in-progress) AND NOT id>10 OR id=30"));
+    REQUIRE(view_ids() == std::vector<int>{1, 2, 4, 5, 7, 8, 10, 30});
+  }
+
+  SECTION("Restored order survives filters and reset clears it") {
+    REQUIRE(db.restore_view({9, 3, 6, 12, 1}));
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "todo"});
+    REQUIRE(view_ids() == std::vector<int>{9, 3, 6, 12});
+
+    db.reset_view();
+    REQUIRE(db.view_task_count() == 60);
+    REQUIRE(view_ids().front() == 1);
+  }
+
+  SECTION("Restoring unknown or duplicate IDs fails") {
+    REQUIRE(!db.restore_view({1, 999}));
+    REQUIRE(!db.restore_view({2, 1, 2}));
+    REQUIRE(db.view_task_count() == 60);
+  }
+}
+
+TEST_CASE("Database columnar storage and clear", "[core][database]") {
+  Database db;
+  std::vector<Task> tasks;
+  tasks.emplace_back(3, "Third", "todo", 2, "someday", "d3", "ann", std::nullopt, std::vector<std::string>{"ops"});
+  tasks.emplace_back(1, "First", "done", 4, "2024-01-01");
+  tasks.emplace_back(3, "Third again", "todo", 5, "someday");
+  db.load(std::move(tasks));
+
+  SECTION("A repeated ID keeps the last task") {
+    REQUIRE(db.total_task_count() == 2);
+    REQUIRE(db.get_task_by_id(3)->title == "Third again");
+    REQUIRE(db.get_task_by_id(3)->tags.empty());
+  }
+
+  SECTION("Rebuilt tasks are shared by every accessor") {
+    REQUIRE(db.current_view_ids() == std::vector<int>{1, 3});
+    const Task *third = db.get_task_by_id(3);
+    REQUIRE(db.current_view()[1] == third);
+
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Descending});
+    REQUIRE(db.current_view_ids() == std::vector<int>{3, 1});
+    REQUIRE(db.current_view()[0] == third);
+  }
+
+  SECTION("Raw created_date strings filter through the interned column") {
+    db.apply_filter(FilterSpec{FilterField::CreatedDate, FilterOp::Equal, "someday"});
+    REQUIRE(db.current_view_ids() == std::vector<int>{3});
+    db.reset_view();
+    db.apply_filter(FilterSpec{FilterField::CreatedDate, FilterOp::NotEqual, "never"});
+    REQUIRE(db.view_task_count() == 2);
+  }
+
+  SECTION("clear empties the database and it can be reloaded") {
+    db.clear();
+    REQUIRE(db.empty());
+    REQUIRE(db.current_view().empty());
+    REQUIRE(db.get_task_by_id(1) == nullptr);
+
+    db.load({Task(5, "Fresh", "todo")});
+    REQUIRE(db.current_view().size() == 1);
+    REQUIRE(db.current_view()[0]->title == "Fresh");
+  }
+}
+
+TEST_CASE("Database date filters, sorts and overdue count", "[core][database]") {
+  Database db;
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "A", "todo", 1, "2024-01-10", std::nullopt, std::nullopt, std::string("2024-02-01"));
+  tasks.emplace_back(2, "B", "done", 1, "2024-01-05", std::nullopt, std::nullopt, std::string("2024-01-15"));
+  tasks.emplace_back(3, "C", "todo", 1, "2024-01-20");
+  tasks.emplace_back(4, "D", "in-progress", 1, "not-a-date", std::nullopt, std::nullopt, std::string("2024-01-20"));
+  tasks.emplace_back(5, "E", "todo", 1, "2024-01-01", std::nullopt, std::nullopt, std::string("soon"));
+  db.load(std::move(tasks));
+
+  auto ids = [&db]() { return db.current_view_ids(); };
+
+  SECTION("Range filters compare day numbers and skip missing dates") {
+    db.apply_filter(FilterSpec{FilterField::DueDate, FilterOp::LessThan, "2024-01-31"});
+    REQUIRE(ids() == std::vector<int>{2, 4});
+
+    db.reset_view();
+    db.apply_filter(*ExpressionParser::parse_filter_expr("created_date>=2024-01-05 AND created_date<=2024-01-10"));
+    REQUIRE(ids() == std::vector<int>{1, 2});
+
+    db.reset_view();
+    db.apply_filter(FilterSpec{FilterField::DueDate, FilterOp::NotEqual, "2024-01-20"});
+    REQUIRE(ids() == std::vector<int>{1, 2});
+  }
+
+  SECTION("A value that is not a date matches the raw string only") {
+    db.apply_filter(FilterSpec{FilterField::DueDate, FilterOp::Equal, "soon"});
+    REQUIRE(ids() == std::vector<int>{5});
+
+    db.reset_view();
+    db.apply_filter(FilterSpec{FilterField::DueDate, FilterOp::LessThan, "soon"});
+    REQUIRE(ids().empty());
+  }
+
+  SECTION("Date sorts put missing dates last in both directions") {
+    db.apply_sort(SortSpec{SortField::DueDate, SortDirection::Ascending});
+    REQUIRE(ids() == std::vector<int>{2, 4, 1, 3, 5});
+
+    db.apply_sort(SortSpec{SortField::DueDate, SortDirection::Descending});
+    REQUIRE(ids() == std::vector<int>{1, 4, 2, 3, 5});
+
+    db.reset_view();
+    db.apply_sort(SortSpec{SortField::CreatedDate, SortDirection::Descending});
+    REQUIRE(ids() == std::vector<int>{3, 1, 2, 5, 4});
+  }
+
+  SECTION("Overdue tasks have a valid past due date and are not done") {
+    REQUIRE(db.overdue_count("2024-01-25") == 1); // task 4; task 2 is done
+    REQUIRE(db.overdue_count("2024-03-01") == 2);
+    REQUIRE(db.overdue_count("2024-01-01") == 0);
+    REQUIRE(db.overdue_count("yesterday") == 0);
+
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "todo"});
+    REQUIRE(db.overdue_count("2024-03-01") == 1);
+  }
+}
+
+TEST_CASE("Database view pages match the fully ordered view", "[core][database]") {
+  // Repeated priorities/statuses so ties exercise the fall-through to older keys and the base order
+  const std::vector<std::string> statuses{"todo", "done", "in-progress", "blocked"};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 500; ++id) {
+    const int priority = id % 7 == 0 ? 100000 + id : 1 + (id * 37) % 5; // a few priorities outside any small range
+    tasks.emplace_back(id, "Task " + std::to_string((id * 53) % 97), statuses[(id * 11) % 4], priority, "2024-01-01");
+  }
+
+  Database db;
+  db.load(std::move(tasks));
+
+  auto page_ids = [&db](size_t offset, size_t limit) {
+    std::vector<int> ids;
+    for (const Task *task : db.view_page(offset, limit)) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+  // Pages are read before the full order is materialized, then compared with a slice of it
+  auto check_pages = [&db, &page_ids]() {
+    const std::vector<std::pair<size_t, size_t>> pages{{0, 10}, {5, 1}, {120, 37}, {490, 50}, {0, 500}, {700, 5}};
+    std::vector<std::vector<int>> seen;
+    for (auto [offset, limit] : pages) {
+      seen.push_back(page_ids(offset, limit));
+    }
+    const std::vector<int> all = db.current_view_ids();
+    for (size_t i = 0; i < pages.size(); ++i) {
+      const size_t first = std::min(pages[i].first, all.size());
+      const size_t last = std::min(first + pages[i].second, all.size());
+      REQUIRE(seen[i] == std::vector<int>(all.begin() + first, all.begin() + last));
+    }
+  };
+
+  SECTION("Unsorted view") {
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::NotEqual, "done"});
+    check_pages();
+  }
+
+  SECTION("Counting sorts on priority and status") {
+    // Narrow to the small priority range so the counting path is taken
+    db.apply_filter(FilterSpec{FilterField::Priority, FilterOp::LessThanOrEqual, "5"});
+    db.apply_sort(SortSpec{SortField::Status, SortDirection::Descending});
+    check_pages();
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Descending});
+    check_pages();
+    REQUIRE(db.view_page(0, 1).front()->priority == 5);
+    db.apply_sort(SortSpec{SortField::Status, SortDirection::Ascending});
+    check_pages();
+  }
+
+  SECTION("A wide priority range falls back to the comparison sort") {
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Descending});
+    check_pages();
+    REQUIRE(db.view_page(0, 1).front()->id == 497);
+  }
+
+  SECTION("Comparison sorts select the top rows only") {
+    db.apply_sort(SortSpec{SortField::Priority, SortDirection::Ascending});
+    db.apply_sort(SortSpec{SortField::Title, SortDirection::Descending});
+    check_pages();
+  }
+
+  SECTION("Restored order as the base of later sorts") {
+    std::vector<int> reversed;
+    for (int id = 500; id >= 1; --id) {
+      reversed.push_back(id);
+    }
+    REQUIRE(db.restore_view(reversed));
+    check_pages();
+    db.apply_sort(SortSpec{SortField::Status, SortDirection::Ascending});
+    check_pages();
+  }
+
+  SECTION("An empty view has empty pages") {
+    db.apply_filter(FilterSpec{FilterField::Status, FilterOp::Equal, "missing"});
+    REQUIRE(db.view_page(0, 10).empty());
+  }
+}
+
+TEST_CASE("Database multi-key sorts match a reference stable sort", "[core][database]") {
+  // Long shared title prefixes, repeated keys and missing dates so packed keys need refinement
+  const std::vector<std::string> statuses{"todo", "done", "in-progress", "blocked"};
+  const std::vector<std::string> titles{"Refactor module", "Refactor modules", "Refactor", "refactor", "Zebra", ""};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 400; ++id) {
+    std::optional<std::string> due;
+    if (id % 3 != 0)
+      due = "2024-0" + std::to_string(1 + id % 9) + "-1" + std::to_string(id % 10);
+    const int priority = id % 11 == 0 ? -5000 * id : 1 + (id * 7) % 5;
+    tasks.emplace_back(id,
+                       titles[(id * 13) % titles.size()] + (id % 4 == 0 ? " " + std::to_string(id % 3) : ""),
+                       statuses[(id * 5) % statuses.size()],
+                       priority,
+                       "2024-01-" + std::to_string(10 + id % 20),
+                       std::nullopt,
+                       std::nullopt,
+                       due);
+  }
+
+  Database db;
+  db.load(tasks);
+
+  // Reference: the stable-sort semantics of applying the keys last-to-first
+  auto reference = [&tasks](std::vector<int> ids, const std::vector<SortSpec> &keys) {
+    auto task_of = [&tasks](int id) -> const Task & { return tasks[static_cast<size_t>(id - 1)]; };
+    for (auto key = keys.rbegin(); key != keys.rend(); ++key) {
+      const bool asc = key->direction == SortDirection::Ascending;
+      auto day = [](const std::optional<std::string> &date) { return date ? to_day_number(*date) : NO_DATE; };
+      std::stable_sort(ids.begin(), ids.end(), [&](int x, int y) {
+        const Task &a = task_of(x);
+        const Task &b = task_of(y);
+        switch (key->field) {
+        case SortField::Priority:
+          return asc ? a.priority < b.priority : b.priority < a.priority;
+        case SortField::Title:
+          return asc ? a.title < b.title : b.title < a.title;
+        case SortField::Status:
+          return asc ? a.status < b.status : b.status < a.status;
+        case SortField::DueDate:
+        case SortField::CreatedDate: {
+          const bool due = key->field == SortField::DueDate;
+          const int32_t p = day(due ? a.due_date : std::optional<std::string>(a.created_date));
+          const int32_t q = day(due ? b.due_date : std::optional<std::string>(b.created_date));
+          if (p == NO_DATE || q == NO_DATE)
+            return p != NO_DATE && q == NO_DATE;
+          return asc ? p < q : q < p;
+        }
+        default:
+          return asc ? x < y : y < x;
+        }
+      });
+    }
+    return ids;
+  };
+
+  const std::vector<std::string> lists{
+      "priority desc, due_date asc, id",
+      "title, priority desc",
+      "title desc, due_date desc, status",
+      "status, title, created_date desc, priority, id desc",
+      "due_date, title desc",
+      "priority, id desc, title",
+  };
+  for (const auto &list : lists) {
+    CAPTURE(list);
+    auto keys = ExpressionParser::parse_sort_keys(list);
+    REQUIRE(keys.has_value());
+
+    db.reset_view();
+    db.apply_filter(FilterSpec{FilterField::Id, FilterOp::NotEqual, "7"});
+    std::vector<int> base = db.current_view_ids();
+
+    db.apply_sort(*keys);
+    std::vector<int> first_page;
+    for (const Task *task : db.view_page(0, 25)) {
+      first_page.push_back(task->id);
+    }
+    const std::vector<int> expected = reference(base, *keys);
+    REQUIRE(db.current_view_ids() == expected);
+    REQUIRE(first_page == std::vector<int>(expected.begin(), expected.begin() + 25));
+
+    // Sorting again on top of this order only reorders within the new keys' ties
+    db.apply_sort(SortSpec{SortField::Status, SortDirection::Descending});
+    std::vector<SortSpec> chained{SortSpec{SortField::Status, SortDirection::Descending}};
+    chained.insert(chained.end(), keys->begin(), keys->end());
+    REQUIRE(db.current_view_ids() == reference(base, chained));
+  }
+
+  SECTION("Keys after a restored order keep it as the final tie-break") {
+    std::vector<int> shuffled;
+    for (int id = 1; id <= 400; ++id) {
+      shuffled.push_back((id * 173) % 400 + 1);
+    }
+    REQUIRE(db.restore_view(shuffled));
+    db.apply_sort(*ExpressionParser::parse_sort_keys("title, due_date desc"));
+    REQUIRE(db.current_view_ids() == reference(shuffled, *ExpressionParser::parse_sort_keys("title, due_date desc")));
+  }
+}
+
+TEST_CASE("Database parallel execution matches sequential results", "[core][database]") {
+  // Enough rows for several bitmap chunks per part
+  const std::vector<std::string> statuses{"todo", "done", "in-progress", "blocked"};
+  const std::vector<std::string> tags{"bug", "ui", "backend"};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 300000; ++id) {
+    std::optional<std::string> due;
+    if (id % 5 != 0)
+      due = "2024-0" + std::to_string(1 + id % 9) + "-1" + std::to_string(id % 10);
+    std::vector<std::string> task_tags;
+    if (id % 4 != 0)
+      task_tags.push_back(tags[static_cast<size_t>(id) % tags.size()]);
+    tasks.emplace_back(id,
+                       "Task " + std::to_string(id * 7 % 1000),
+                       statuses[static_cast<size_t>(id * 31) % statuses.size()],
+                       1 + (id * 13) % 5,
+                       "2024-01-01",
+                       std::nullopt,
+                       std::nullopt,
+                       due,
+                       task_tags);
+  }
+
+  Database sequential;
+  sequential.load(tasks);
+  ThreadPool inline_pool(1);
+  sequential.set_parallelism(inline_pool);
+
+  Database parallel;
+  parallel.load(std::move(tasks));
+  ThreadPool pool(4);
+  parallel.set_parallelism(pool, 1);
+
+  auto both = [&](auto &&operation) {
+    operation(sequential);
+    operation(parallel);
+    REQUIRE(parallel.view_task_count() == sequential.view_task_count());
+    REQUIRE(parallel.current_view_ids() == sequential.current_view_ids());
+  };
+
+  SECTION("Filters compact per part") {
+    both([](Database &db) { db.apply_filter(FilterSpec{FilterField::Priority, FilterOp::GreaterThan, "2"}); });
+    both([](Database &db) {
+      db.apply_filter(*ExpressionParser::parse_filter_expr("status=todo OR (due_date<2024-04-01 AND title!=Task 1)"));
+    });
+    both([](Database &db) { db.filter_no_tags(); });
+    REQUIRE(parallel.view_task_count() > 0);
+  }
+
+  SECTION("Sorts merge to the sequential order") {
+    both([](Database &db) { db.apply_filter(FilterSpec{FilterField::Status, FilterOp::NotEqual, "blocked"}); });
+    for (const char *keys : {"title desc, due_date", "due_date desc, priority", "priority desc, status"}) {
+      CAPTURE(keys);
+      both([keys](Database &db) { db.apply_sort(*ExpressionParser::parse_sort_keys(keys)); });
+
+      const auto &view = parallel.current_view();
+      REQUIRE(view.size() == parallel.view_task_count());
+      REQUIRE(view.front()->id == sequential.current_view().front()->id);
+    }
+  }
+
+  SECTION("Aggregates are reduced per part") {
+    both([](Database &db) { db.filter_by_tag("bug"); });
+    const StatusStats expected = sequential.status_stats();
+    const StatusStats actual = parallel.status_stats();
+    REQUIRE(actual.todo_count == expected.todo_count);
+    REQUIRE(actual.in_progress_count == expected.in_progress_count);
+    REQUIRE(actual.done_count == expected.done_count);
+    REQUIRE(actual.other_count == expected.other_count);
+    REQUIRE(actual.total() == parallel.view_task_count());
+    REQUIRE(parallel.average_priority() == sequential.average_priority());
+    REQUIRE(parallel.overdue_count("2024-05-01") == sequential.overdue_count("2024-05-01"));
+    REQUIRE(parallel.overdue_count("2024-05-01") > 0);
+
+    for (GroupField field : {GroupField::Status, GroupField::Tag, GroupField::CreatedMonth}) {
+      const auto expected_groups = sequential.group_stats(field, "2024-05-01");
+      const auto actual_groups = parallel.group_stats(field, "2024-05-01");
+      REQUIRE(actual_groups.size() == expected_groups.size());
+      for (size_t i = 0; i < actual_groups.size(); ++i) {
+        REQUIRE(actual_groups[i].key == expected_groups[i].key);
+        REQUIRE(actual_groups[i].count == expected_groups[i].count);
+        REQUIRE(actual_groups[i].average_priority == expected_groups[i].average_priority);
+        REQUIRE(actual_groups[i].overdue_count == expected_groups[i].overdue_count);
+        REQUIRE(actual_groups[i].min_due == expected_groups[i].min_due);
+        REQUIRE(actual_groups[i].max_due == expected_groups[i].max_due);
+      }
+    }
+  }
+}
+
+// ============================================================================
+// Incremental Reload Tests
+// ============================================================================
+
+TEST_CASE("Database incremental reload matches a full load and replay", "[core][database]") {
+  const std::vector<std::string> statuses{"todo", "done", "in-progress"};
+  auto make_task = [&statuses](int id, int version) {
+    std::vector<std::string> tags;
+    if ((id + version) % 3 == 0)
+      tags.push_back("urgent");
+    std::optional<std::string> description;
+    if (id % 2 == 0)
+      description = "Check the login flow " + std::to_string(version);
+    return Task(id,
+                (id % 5 == 0 ? "Fix login " : "Write docs ") + std::to_string(id),
+                statuses[static_cast<size_t>(id + version) % statuses.size()],
+                1 + (id * 7 + version) % 5,
+                "2024-01-" + std::to_string(10 + id % 20),
+                description,
+                std::nullopt,
+                std::nullopt,
+                tags);
+  };
+
+  std::vector<Task> before;
+  for (int id = 1; id <= 600; ++id) {
+    before.push_back(make_task(id, 0));
+  }
+
+  // Delete every 7th ID, update every 11th, append new IDs and a repeated ID (last one wins)
+  std::vector<Task> after;
+  for (int id = 1; id <= 600; ++id) {
+    if (id % 7 != 0)
+      after.push_back(make_task(id, id % 11 == 0 ? 1 : 0));
+  }
+  for (int id = 601; id <= 650; ++id) {
+    after.push_back(make_task(id, 0));
+  }
+  after.push_back(make_task(5, 2));
+
+  const std::vector<std::vector<ViewAction>> histories{
+      {},
+      {{ViewOpType::Filter, "status=todo"}},
+      {{ViewOpType::Filter, "priority>=3"}, {ViewOpType::Sort, "priority desc, title"}},
+      {{ViewOpType::FindByTag, "urgent"}, {ViewOpType::Search, "login"}, {ViewOpType::Sort, "status"}},
+      {{ViewOpType::Filter, "status=done"}, {ViewOpType::ResetFilters, ""}, {ViewOpType::Filter, "priority<3"}},
+      {{ViewOpType::Sort, "title desc"}, {ViewOpType::Filter, "status IN (todo, done) AND NOT priority=5"}},
+  };
+
+  auto view_ids = [](const Database &db) {
+    std::vector<int> ids;
+    for (const Task *task : db.current_view()) {
+      ids.push_back(task->id);
+    }
+    return ids;
+  };
+
+  for (size_t h = 0; h < histories.size(); ++h) {
+    CAPTURE(h);
+    const auto &history = histories[h];
+
+    Database incremental;
+    incremental.load(before);
+    incremental.replay_history(history);
+    const ReloadDelta delta = incremental.reload(after, history);
+
+    Database full;
+    full.load(after);
+    full.replay_history(history);
+
+    REQUIRE(delta.inserted == 50);
+    REQUIRE(delta.deleted == 85);
+    REQUIRE(delta.updated == 48); // the 47 surviving multiples of 11, and ID 5 (its last copy wins)
+    REQUIRE(incremental.total_task_count() == full.total_task_count());
+    REQUIRE(view_ids(incremental) == view_ids(full));
+    REQUIRE(incremental.get_task_by_id(5)->description == full.get_task_by_id(5)->description);
+  }
+}
+
+TEST_CASE("Database incremental reload without changes", "[core][database]") {
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "One", "todo", 3, "2024-01-01");
+  tasks.emplace_back(2, "Two", "done", 5, "2024-01-02", "");
+  tasks.emplace_back(3, "Three", "todo", 1, "2024-01-03");
+
+  Database db;
+  db.load(tasks);
+  const std::vector<ViewAction> history{{ViewOpType::Filter, "status=todo"}};
+  db.replay_history(history);
+  const Task *first = db.current_view().front();
+
+  SECTION("Identical tasks leave everything in place") {
+    REQUIRE(db.reload(tasks, history).empty());
+    REQUIRE(db.current_view().front() == first);
+    REQUIRE(db.view_task_count() == 2);
+  }
+
+  SECTION("A missing optional differs from an empty one") {
+    tasks[1].description.reset();
+    const ReloadDelta delta = db.reload(tasks, history);
+    REQUIRE(delta.updated == 1);
+    REQUIRE(delta.inserted == 0);
+    REQUIRE(delta.deleted == 0);
+    REQUIRE(db.view_task_count() == 2);
+  }
+}
+
+TEST_CASE("Database incremental reload filters only the changed rows", "[core][database]") {
+  std::vector<Task> tasks;
+  tasks.emplace_back(1, "One", "todo", 1, "2024-01-01");
+  tasks.emplace_back(2, "Two", "todo", 4, "2024-01-02");
+  tasks.emplace_back(3, "Three", "done", 2, "2024-01-03");
+  tasks.emplace_back(4, "Four", "todo", 2, "2024-01-04");
+
+  Database db;
+  db.load(tasks);
+  db.replay_history({{ViewOpType::Filter, "status=todo"}});
+  REQUIRE(db.view_task_count() == 3);
+
+  // Reload against a different filter than the one that produced the view: a row that
+  // kept its content also keeps its membership, so only the changed rows see `priority>=3`
+  tasks[2].status = "todo"; // ID 3 now fails priority>=3
+  tasks[3].priority = 5;    // ID 4 now passes it
+  tasks.emplace_back(5, "Five", "todo", 1, "2024-01-05");
+  const ReloadDelta delta =
+      db.reload(tasks, {{ViewOpType::Filter, "priority>=3"}, {ViewOpType::Sort, "priority desc"}});
+  REQUIRE(delta.updated == 2);
+  REQUIRE(delta.inserted == 1);
+
+  std::vector<int> ids;
+  for (const Task *task : db.current_view()) {
+    ids.push_back(task->id);
+  }
+  REQUIRE(ids == std::vector<int>{4, 2, 1}); // ID 1 (priority 1) is unchanged and stays
 }
@@ -0,0 +1,84 @@
+#include "io/dataset_files.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+// Temp directory of shard files, removed on destruction.
+struct ShardTempDir {
+  std::filesystem::path dir;
+  ShardTempDir() {
+    dir = std::filesystem::temp_directory_path() /
+          ("taskproc_test_shards_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(dir);
+  }
+  ~ShardTempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+  }
+  std::filesystem::path write(const std::string &name, const std::string &content = "x") const {
+    std::ofstream(dir / name) << content;
+    return dir / name;
+  }
+};
+
+TEST_CASE("is_sharded_dataset recognizes directories and patterns", "[io][shards]") {
+  ShardTempDir tmp;
+  const auto file = tmp.write("a.csv");
+
+  REQUIRE(is_sharded_dataset(tmp.dir.string()));
+  REQUIRE(is_sharded_dataset((tmp.dir / "*.csv").string()));
+  REQUIRE(is_sharded_dataset("part-?.json"));
+  REQUIRE(is_sharded_dataset("part-[0-9].json"));
+  REQUIRE(!is_sharded_dataset(file.string()));
+  REQUIRE(!is_sharded_dataset("missing.csv"));
+}
+
+TEST_CASE("dataset_files lists shards in path order", "[io][shards]") {
+  ShardTempDir tmp;
+  tmp.write("b.csv");
+  tmp.write("a.csv");
+  tmp.write("c.json");
+  std::filesystem::create_directories(tmp.dir / "nested.csv");
+
+  SECTION("Directory: regular files only") {
+    REQUIRE(dataset_files(tmp.dir.string()) ==
+            std::vector<std::filesystem::path>{tmp.dir / "a.csv", tmp.dir / "b.csv", tmp.dir / "c.json"});
+  }
+
+  SECTION("Glob pattern") {
+    REQUIRE(dataset_files((tmp.dir / "*.csv").string()) ==
+            std::vector<std::filesystem::path>{tmp.dir / "a.csv", tmp.dir / "b.csv"});
+  }
+
+  SECTION("Pattern without matches") {
+    REQUIRE(dataset_files((tmp.dir / "*.ndjson").string()).empty());
+  }
+
+  SECTION("Plain path, even if missing") {
+    REQUIRE(dataset_files("missing.csv") == std::vector<std::filesystem::path>{"missing.csv"});
+  }
+}
+
+TEST_CASE("combine_fingerprints changes with any shard", "[io][shards]") {
+  const std::vector<SourceFingerprint> files{{"s/a.csv", 10, 1}, {"s/b.csv", 20, 2}};
+  const SourceFingerprint combined = combine_fingerprints("s", files);
+
+  REQUIRE(combined.path == "s");
+  REQUIRE(combined.size == 30);
+  REQUIRE(combine_fingerprints("s", files) == combined);
+
+  auto modified = files;
+  modified[1].mtime = 3;
+  REQUIRE(combine_fingerprints("s", modified) != combined);
+
+  auto renamed = files;
+  renamed[0].path = "s/a2.csv";
+  REQUIRE(combine_fingerprints("s", renamed) != combined);
+
+  REQUIRE(combine_fingerprints("s", {files[0]}) != combined);
+  REQUIRE(combine_fingerprints("s", {files[0], files[1], {"s/c.csv", 0, 0}}) != combined);
+}
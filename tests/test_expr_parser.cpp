@@ -1,5 +1,7 @@
 #include "core/expr_parser.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
 
 // ============================================================================
 // Filter Parsing Tests
@@ -89,6 +91,75 @@ TEST_CASE("ExpressionParser filter parsing", "[core][expr_parser]") {
   }
 }
 
+// ============================================================================
+// Compound Filter Expression Tests
+// ============================================================================
+
+TEST_CASE("ExpressionParser compound filter parsing", "[core][expr_parser]") {
+  SECTION("Single term is a Term node") {
+    auto result = ExpressionParser::parse_filter_expr("title=Fix login bug");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::Term);
+    REQUIRE(result->terms.front().value == "Fix login bug");
+  }
+
+  SECTION("AND binds tighter than OR") {
+    auto result = ExpressionParser::parse_filter_expr("status=todo OR status=done AND priority>3");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::Or);
+    REQUIRE(result->children.size() == 2);
+    REQUIRE(result->children[0].kind == FilterExprKind::Term);
+    REQUIRE(result->children[1].kind == FilterExprKind::And);
+    REQUIRE(result->children[1].children[1].terms.front().op == FilterOp::GreaterThan);
+  }
+
+  SECTION("Parentheses and NOT") {
+    auto result = ExpressionParser::parse_filter_expr("NOT (priority<3 OR assignee=bob) AND id!=7");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::And);
+    REQUIRE(result->children[0].kind == FilterExprKind::Not);
+    REQUIRE(result->children[0].children.front().kind == FilterExprKind::Or);
+    REQUIRE(result->children[0].children.front().children[1].terms.front().value == "bob");
+    REQUIRE(result->children[1].terms.front().value == "7");
+  }
+
+  SECTION("IN list") {
+    auto result = ExpressionParser::parse_filter_expr("status IN (todo, in-progress)");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::In);
+    REQUIRE(result->terms.size() == 2);
+    REQUIRE(result->terms[0].field == FilterField::Status);
+    REQUIRE(result->terms[1].value == "in-progress");
+  }
+
+  SECTION("Quoted values may contain keywords and delimiters") {
+    auto result =
+        ExpressionParser::parse_filter_expr(R"x(title="Rock AND Roll (live)" OR title IN ("a, b", "say \"hi\""))x");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::Or);
+    REQUIRE(result->children[0].terms.front().value == "Rock AND Roll (live)");
+    REQUIRE(result->children[1].terms[0].value == "a, b");
+    REQUIRE(result->children[1].terms[1].value == R"(say "hi")");
+  }
+
+  SECTION("Lowercase words are part of the value") {
+    auto result = ExpressionParser::parse_filter_expr("title=salt and pepper");
+    REQUIRE(result.has_value());
+    REQUIRE(result->kind == FilterExprKind::Term);
+    REQUIRE(result->terms.front().value == "salt and pepper");
+  }
+
+  SECTION("Malformed expressions are rejected") {
+    REQUIRE(!ExpressionParser::parse_filter_expr("").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr("status=todo AND").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr("(status=todo").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr("(status=todo)) OR id=1").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr("status IN todo").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr("bogus=1 OR id=1").has_value());
+    REQUIRE(!ExpressionParser::parse_filter_expr(R"(title="unterminated)").has_value());
+  }
+}
+
 // ============================================================================
 // Sort Parsing Tests
 // ============================================================================
@@ -168,6 +239,127 @@ TEST_CASE("ExpressionParser sort parsing", "[core][expr_parser]") {
   }
 }
 
+TEST_CASE("ExpressionParser sort key lists", "[core][expr_parser]") {
+  SECTION("Keys in order, primary first") {
+    auto keys = ExpressionParser::parse_sort_keys("priority desc, due_date asc,id");
+    REQUIRE(keys.has_value());
+    REQUIRE(keys->size() == 3);
+    REQUIRE((*keys)[0].field == SortField::Priority);
+    REQUIRE((*keys)[0].direction == SortDirection::Descending);
+    REQUIRE((*keys)[1].field == SortField::DueDate);
+    REQUIRE((*keys)[1].direction == SortDirection::Ascending);
+    REQUIRE((*keys)[2].field == SortField::Id);
+    REQUIRE((*keys)[2].direction == SortDirection::Ascending);
+  }
+
+  SECTION("A single key is a one-element list") {
+    auto keys = ExpressionParser::parse_sort_keys("  title desc ");
+    REQUIRE(keys.has_value());
+    REQUIRE(keys->size() == 1);
+    REQUIRE(keys->front().field == SortField::Title);
+    REQUIRE(keys->front().direction == SortDirection::Descending);
+  }
+
+  SECTION("Any invalid or empty key rejects the list") {
+    REQUIRE_FALSE(ExpressionParser::parse_sort_keys("").has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_sort_keys("priority desc, nope").has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_sort_keys("priority,,id").has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_sort_keys("priority,").has_value());
+  }
+}
+
+TEST_CASE("ExpressionParser canonical spelling", "[core][expr_parser]") {
+  auto canonical = [](std::string_view expr) {
+    auto parsed = ExpressionParser::parse_filter_expr(expr);
+    REQUIRE(parsed.has_value());
+    return ExpressionParser::to_string(*parsed);
+  };
+
+  SECTION("Values are quoted as they parsed, inner whitespace included") {
+    REQUIRE(canonical("  title=a  b ") == "title=\"a  b\"");
+    REQUIRE(canonical("title=\"a  b\"") == canonical("title=a  b"));
+    REQUIRE(canonical("title=a b") != canonical("title=a  b"));
+    REQUIRE(canonical(R"x(title="say \"AND\" \\ (x)")x") == R"x(title="say \"AND\" \\ (x)")x");
+  }
+
+  SECTION("Nested groups are parenthesized; NOT binds to its operand") {
+    REQUIRE(canonical("status IN (todo,in-progress) AND (priority>=4 OR assignee=john)") ==
+            R"(status IN ("todo", "in-progress") AND (priority>="4" OR assignee="john"))");
+    REQUIRE(canonical("NOT (status=done OR priority<2) AND id!=3") ==
+            R"(NOT (status="done" OR priority<"2") AND id!="3")");
+  }
+
+  SECTION("The canonical spelling parses back to the same tree") {
+    for (const char *expr : {"priority>=3", "title=\"Fix (login) AND deploy\"", "NOT NOT status=done",
+                             "(id=1)", "status=todo AND (priority>4 OR (assignee=bob AND due_date<=2024-02-01))",
+                             "description IN (\"x, y\", z)"}) {
+      const std::string spelled = canonical(expr);
+      REQUIRE(canonical(spelled) == spelled);
+    }
+  }
+
+  SECTION("Sort keys: the parsed direction, ascending left implicit") {
+    auto keys = ExpressionParser::parse_sort_keys(" priority descending,due_date asc , id");
+    REQUIRE(keys.has_value());
+    REQUIRE(ExpressionParser::to_string(*keys) == "priority desc, due_date, id");
+
+    // An unknown direction is read (with a warning) as ascending
+    keys = ExpressionParser::parse_sort_keys("priority  desc");
+    REQUIRE(keys.has_value());
+    REQUIRE(ExpressionParser::to_string(*keys) == "priority");
+  }
+}
+
+TEST_CASE("ExpressionParser group-by fields and aggregates", "[core][expr_parser]") {
+  SECTION("Group fields") {
+    REQUIRE(ExpressionParser::parse_group_field("assignee") == GroupField::Assignee);
+    REQUIRE(ExpressionParser::parse_group_field("created_month") == GroupField::CreatedMonth);
+    REQUIRE_FALSE(ExpressionParser::parse_group_field("title").has_value());
+  }
+
+  SECTION("Aggregate lists keep their order and drop repeats") {
+    auto aggregates = ExpressionParser::parse_aggregates(" overdue, count ,max_due,count");
+    REQUIRE(aggregates.has_value());
+    REQUIRE(*aggregates == std::vector<Aggregate>{Aggregate::Overdue, Aggregate::Count, Aggregate::MaxDue});
+  }
+
+  SECTION("Any unknown or empty aggregate rejects the list") {
+    REQUIRE_FALSE(ExpressionParser::parse_aggregates("").has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_aggregates("count,sum").has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_aggregates("count,").has_value());
+  }
+}
+
+TEST_CASE("ExpressionParser reports the fields an action reads", "[core][expr_parser]") {
+  SECTION("Filters read the fields of every term") {
+    auto expr = ExpressionParser::parse_filter_expr("status=todo AND NOT (priority<3 OR assignee IN (bob, ann))");
+    REQUIRE(expr.has_value());
+    REQUIRE(ExpressionParser::fields_of(*expr) == (TaskField::Status | TaskField::Priority | TaskField::Assignee));
+  }
+
+  SECTION("Sorts read their keys") {
+    auto keys = ExpressionParser::parse_sort_keys("due_date desc, title");
+    REQUIRE(keys.has_value());
+    REQUIRE(ExpressionParser::fields_of(*keys) == (TaskField::DueDate | TaskField::Title));
+  }
+
+  SECTION("Recorded actions") {
+    REQUIRE(ExpressionParser::fields_of(ViewAction{ViewOpType::Filter, "priority>=4"}) == TaskField::Priority);
+    REQUIRE(ExpressionParser::fields_of(ViewAction{ViewOpType::FindByTag, "bug"}) == TaskField::Tags);
+    REQUIRE(ExpressionParser::fields_of(ViewAction{ViewOpType::Search, "login"}) ==
+            (TaskField::Title | TaskField::Description));
+    REQUIRE(ExpressionParser::fields_of(GroupField::CreatedMonth) == TaskField::CreatedDate);
+    REQUIRE(ExpressionParser::fields_of(ViewAction{ViewOpType::Sort, "bogus"}).is_all());
+  }
+
+  SECTION("Every projection holds the id") {
+    REQUIRE(TaskFields().has(TaskField::Id));
+    REQUIRE(TaskFields(TaskField::Tags).has(TaskField::Id));
+    REQUIRE(TaskFields::all().contains(TaskField::Title | TaskField::Tags));
+    REQUIRE(!TaskFields(TaskField::Title).contains(TaskField::Tags));
+  }
+}
+
 // ============================================================================
 // Edge Cases and Robustness Tests
 // ============================================================================
@@ -204,4 +396,43 @@ TEST_CASE("ExpressionParser edge cases", "[core][expr_parser]") {
     REQUIRE(result2.has_value());
     REQUIRE(result2->direction == SortDirection::Ascending);
   }
+
+  SECTION("ID and priority literals must be whole integers") {
+    REQUIRE(ExpressionParser::parse_filter_expr("priority>=-1 AND id IN (1, 2147483647)").has_value());
+    REQUIRE(ExpressionParser::parse_filter_expr("priority=\"3\"").has_value());
+
+    for (const char *expr : {"priority>=abc", "id=abc", "priority>=4abc", "priority>=99999999999", "id=",
+                             "priority IN (1, x)", "NOT (status=todo OR id<2.5)"}) {
+      CAPTURE(expr);
+      REQUIRE_FALSE(ExpressionParser::parse_filter_expr(expr).has_value());
+    }
+    REQUIRE_FALSE(ExpressionParser::parse_filter("priority>=4abc").has_value());
+
+    // Other fields compare as text
+    REQUIRE(ExpressionParser::parse_filter_expr("title=4abc").has_value());
+  }
+
+  SECTION("NOTs and groups nest at most MAX_NESTING levels") {
+    auto nested = [](const std::string &open, size_t levels, const std::string &close) {
+      std::string expr;
+      for (size_t i = 0; i < levels; ++i) {
+        expr += open;
+      }
+      expr += "status=todo";
+      for (size_t i = 0; i < levels; ++i) {
+        expr += close;
+      }
+      return expr;
+    };
+    const size_t limit = ExpressionParser::MAX_NESTING;
+    REQUIRE(ExpressionParser::parse_filter_expr(nested("(", limit, ")")).has_value());
+    REQUIRE(ExpressionParser::parse_filter_expr(nested("NOT ", limit, "")).has_value());
+    REQUIRE(ExpressionParser::parse_filter_expr(nested("NOT (", limit / 2, ")")).has_value());
+
+    // Far past the limit, as a stack overflow would need, the parse fails instead
+    REQUIRE_FALSE(ExpressionParser::parse_filter_expr(nested("(", limit + 1, ")")).has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_filter_expr(nested("NOT ", limit + 1, "")).has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_filter_expr(nested("(", 100000, ")")).has_value());
+    REQUIRE_FALSE(ExpressionParser::parse_filter_expr(nested("NOT ", 100000, "")).has_value());
+  }
 }
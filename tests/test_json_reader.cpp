@@ -112,3 +112,56 @@ TEST_CASE("JSONReader::read_tasks parses file and tags", "[io][json_reader]") {
   std::filesystem::remove(tmp, ec);
   REQUIRE(!ec); // ensure cleanup succeeded
 }
+
+// Verify the streaming parser skips unknown structure and rejects malformed input
+TEST_CASE("JSONReader::read_tasks streams without a document tree", "[io][json_reader]") {
+  std::filesystem::path tmp = std::filesystem::temp_directory_path() / "taskproc_json_stream_test.json";
+  auto write = [&tmp](const std::string &contents) {
+    std::ofstream ofs(tmp);
+    ofs << contents;
+  };
+  JSONReader reader;
+
+  SECTION("Unknown keys, nested values, nulls and duplicate keys") {
+    write(R"JSON([
+      {"id": 1, "meta": {"id": 99, "tags": ["nested"], "list": [[1], {"a": null}]},
+       "title": "First", "status": "todo", "description": null, "tags": ["a", "b"], "title": "Renamed"},
+      {"status": "done", "tags": "not-a-list", "id": 2, "title": "Second", "extra": [true, false]}
+    ])JSON");
+    auto tasks = reader.read_tasks(tmp.string());
+    REQUIRE(tasks.size() == 2);
+    REQUIRE(tasks[0].id == 1);
+    REQUIRE(tasks[0].title == "Renamed");
+    REQUIRE(tasks[0].tags == std::vector<std::string>{"a", "b"});
+    REQUIRE(tasks[0].description == "");
+    REQUIRE(tasks[1].id == 2);
+    REQUIRE(tasks[1].tags.empty());
+  }
+
+  SECTION("Empty array") {
+    write("[]");
+    REQUIRE(reader.read_tasks(tmp.string()).empty());
+  }
+
+  SECTION("Malformed JSON") {
+    write(R"JSON([{"id": 1, "title": "x", "status": "todo"})JSON");
+    REQUIRE_THROWS_AS(reader.read_tasks(tmp.string()), std::runtime_error);
+  }
+
+  SECTION("Top level is not an array of objects") {
+    write(R"JSON({"id": 1, "title": "x", "status": "todo"})JSON");
+    REQUIRE_THROWS_AS(reader.read_tasks(tmp.string()), std::runtime_error);
+    write("[1, 2]");
+    REQUIRE_THROWS_AS(reader.read_tasks(tmp.string()), std::runtime_error);
+  }
+
+  SECTION("Known field with the wrong type") {
+    write(R"JSON([{"id": "1", "title": "x", "status": "todo"}])JSON");
+    REQUIRE_THROWS_AS(reader.read_tasks(tmp.string()), std::runtime_error);
+    write(R"JSON([{"id": 1, "title": "x", "status": "todo", "tags": ["ok", 3]}])JSON");
+    REQUIRE_THROWS_AS(reader.read_tasks(tmp.string()), std::runtime_error);
+  }
+
+  std::error_code ec;
+  std::filesystem::remove(tmp, ec);
+}
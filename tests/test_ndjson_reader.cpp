@@ -0,0 +1,120 @@
+#include "io/json_reader.hpp"
+#include "io/ndjson_reader.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+// RAII temp file with the given contents
+struct TempFile {
+  std::filesystem::path path;
+  TempFile(const std::string &name, const std::string &contents) :
+      path(std::filesystem::temp_directory_path() / name) {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << contents;
+  }
+  ~TempFile() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+  }
+};
+
+std::string task_object(int id) {
+  return R"({"id": )" + std::to_string(id) + R"(, "title": "Task )" + std::to_string(id) +
+         R"(", "status": "todo", "priority": )" + std::to_string(id % 5 + 1) + R"(, "description": "a\nb", )" +
+         R"("assignee": "ann", "due_date": "2024-02-01", "tags": ["t)" + std::to_string(id % 3) + R"("]})";
+}
+} // anonymous namespace
+
+TEST_CASE("NDJSONReader::can_handle checks", "[io][ndjson_reader]") {
+  NDJSONReader reader;
+  REQUIRE(reader.can_handle("tasks.jsonl"));
+  REQUIRE(reader.can_handle("tasks.ndjson"));
+  REQUIRE(!reader.can_handle("tasks.json"));
+  REQUIRE(!reader.can_handle("tasks.jsonl.gz"));
+}
+
+TEST_CASE("NDJSONReader parses one task per line", "[io][ndjson_reader]") {
+  TempFile file("taskproc_ndjson_basic.jsonl",
+                "{\"id\": 1, \"title\": \"First\", \"status\": \"todo\", \"tags\": [\"bug\"]}\r\n"
+                "\n"
+                "   \n"
+                "{\"id\": 0, \"title\": \"Invalid\", \"status\": \"todo\"}\n"
+                "{\"id\": 2, \"title\": \"\", \"status\": \"todo\"}\n"
+                "{\"id\": 3, \"title\": \"Last\", \"status\": \"done\", \"priority\": 4}");
+
+  NDJSONReader reader;
+  auto tasks = reader.read_tasks(file.path.string());
+  REQUIRE(tasks.size() == 2);
+  REQUIRE(tasks[0].id == 1);
+  REQUIRE(tasks[0].tags == std::vector<std::string>{"bug"});
+  REQUIRE(tasks[0].priority == 1);
+  REQUIRE(tasks[1].id == 3);
+  REQUIRE(tasks[1].priority == 4);
+}
+
+TEST_CASE("NDJSONReader decodes only the projected fields", "[io][ndjson_reader]") {
+  TempFile file("taskproc_ndjson_projection.jsonl",
+                task_object(1) + "\n" + "{\"id\": 2, \"title\": \"\", \"status\": \"todo\"}\n" + task_object(3) + "\n");
+
+  NDJSONReader reader;
+  auto tasks = reader.read_tasks(file.path.string(), TaskField::Tags);
+  REQUIRE(tasks.size() == 2);
+  REQUIRE(tasks[0].id == 1);
+  REQUIRE(tasks[0].priority == 2);
+  REQUIRE(tasks[0].tags == std::vector<std::string>{"t1"});
+  REQUIRE(tasks[0].title.empty());
+  REQUIRE(tasks[0].status.empty());
+  REQUIRE(tasks[0].description->empty());
+  REQUIRE(tasks[1].id == 3);
+  REQUIRE(tasks[1].tags == std::vector<std::string>{"t0"});
+}
+
+TEST_CASE("NDJSONReader chunked parsing matches the JSON array reader", "[io][ndjson_reader]") {
+  std::string lines;
+  std::string array = "[";
+  for (int id = 1; id <= 800; ++id) {
+    lines += task_object(id) + "\n";
+    array += (id > 1 ? "," : "") + task_object(id);
+  }
+  array += "]";
+  TempFile ndjson("taskproc_ndjson_chunks.ndjson", lines);
+  TempFile json("taskproc_ndjson_chunks.json", array);
+
+  ThreadPool pool(4);
+  NDJSONReader reader(pool, 128);
+  JSONReader json_reader;
+  auto tasks = reader.read_tasks(ndjson.path.string());
+  auto expected = json_reader.read_tasks(json.path.string());
+
+  REQUIRE(tasks.size() == 800);
+  REQUIRE(tasks.size() == expected.size());
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    REQUIRE(tasks[i].id == expected[i].id);
+    REQUIRE(tasks[i].title == expected[i].title);
+    REQUIRE(tasks[i].priority == expected[i].priority);
+    REQUIRE(tasks[i].description == expected[i].description);
+    REQUIRE(tasks[i].tags == expected[i].tags);
+  }
+  REQUIRE(*tasks[0].description == "a\nb");
+}
+
+TEST_CASE("NDJSONReader names the failing line", "[io][ndjson_reader]") {
+  TempFile file("taskproc_ndjson_bad.jsonl",
+                "{\"id\": 1, \"title\": \"a\", \"status\": \"todo\"}\n"
+                "\n"
+                "{\"id\": 2, \"title\": \"b\", \"status\": \n");
+
+  NDJSONReader reader;
+  try {
+    reader.read_tasks(file.path.string());
+    FAIL("expected a parse error");
+  } catch (const std::runtime_error &e) {
+    REQUIRE(std::string(e.what()).starts_with("line 3: "));
+  }
+
+  TempFile array("taskproc_ndjson_array.jsonl", "[{\"id\": 1, \"title\": \"a\", \"status\": \"todo\"}]\n");
+  REQUIRE_THROWS_AS(reader.read_tasks(array.path.string()), std::runtime_error);
+}
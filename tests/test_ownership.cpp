@@ -1,6 +1,7 @@
 #include "core/data_manager.hpp"
 #include "core/task.hpp"
 #include "io/view_storage.hpp"
+#include "temp_cwd.hpp"
 #include <catch2/catch_test_macros.hpp>
 
 #include <filesystem>
@@ -92,6 +93,7 @@ TEST_CASE("Task value semantics", "[ownership][task]") {
 // ============================================================================
 
 TEST_CASE("DataManager ownership", "[ownership][data_manager]") {
+  TempCwd tmp; // DataManager keeps its storage and snapshot in the CWD
   SECTION("DataManager is movable") {
     auto tmp_path = std::filesystem::temp_directory_path() / "ownership_test_move.csv";
     TempFile tf(tmp_path);
@@ -115,6 +117,7 @@ TEST_CASE("DataManager ownership", "[ownership][data_manager]") {
 }
 
 TEST_CASE("DataManager task ownership", "[ownership][data_manager]") {
+  TempCwd tmp;
   SECTION("DataManager owns tasks by value") {
     auto tmp_path = std::filesystem::temp_directory_path() / "ownership_test_tasks.csv";
     TempFile tf(tmp_path);
@@ -0,0 +1,139 @@
+#include "io/parallel_csv_reader.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+// RAII temp CSV file with the given contents
+struct TempCSV {
+  std::filesystem::path path;
+  TempCSV(const std::string &name, const std::string &contents) :
+      path(std::filesystem::temp_directory_path() / name) {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs << contents;
+  }
+  ~TempCSV() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+  }
+};
+
+void require_same(const std::vector<Task> &a, const std::vector<Task> &b) {
+  REQUIRE(a.size() == b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    REQUIRE(a[i].id == b[i].id);
+    REQUIRE(a[i].title == b[i].title);
+    REQUIRE(a[i].status == b[i].status);
+    REQUIRE(a[i].priority == b[i].priority);
+    REQUIRE(a[i].created_date == b[i].created_date);
+    REQUIRE(a[i].description == b[i].description);
+    REQUIRE(a[i].assignee == b[i].assignee);
+    REQUIRE(a[i].due_date == b[i].due_date);
+    REQUIRE(a[i].tags == b[i].tags);
+  }
+}
+} // anonymous namespace
+
+TEST_CASE("ParallelCSVReader::can_handle checks", "[io][parallel_csv_reader]") {
+  ParallelCSVReader reader;
+  REQUIRE(reader.can_handle("test.csv"));
+  REQUIRE(!reader.can_handle("test.json"));
+  REQUIRE(!reader.can_handle("test.csv.gz"));
+}
+
+TEST_CASE("ParallelCSVReader parses and validates rows", "[io][parallel_csv_reader]") {
+  TempCSV csv("taskproc_parallel_basic.csv",
+              "id,title,status,priority,description,assignee,due_date,created_date,tags\n"
+              "1,\"Fix login\",\"todo\",5,\"desc\",\"john\",\"2024-01-20\",\"2024-01-15\",\"bug,urgent,frontend\"\n"
+              "2,\"Single tag\",\"done\",1,\"desc2\",\"jane\",\"2024-01-22\",\"2024-01-10\",\"tag1\"\n"
+              "3,\"NoPriorityNoTags\",\"done\",,\"desc3\",\"jane\",\"2024-01-23\",\"2025-01-10\",\n"
+              "4,\"Invalid\",,,\"desc4\",\"jane\",\"2024-01-23\",\"2025-01-10\",\n"
+              ",\"Invalid\",1,,\"desc5\",\"jane\",\"2024-01-23\",\"2025-01-10\",\n");
+
+  ParallelCSVReader reader;
+  auto tasks = reader.read_tasks(csv.path.string());
+
+  REQUIRE(tasks.size() == 3);
+  REQUIRE(tasks[0].title == "Fix login");
+  REQUIRE(tasks[0].created_date == "2024-01-15");
+  REQUIRE(tasks[0].tags == std::vector<std::string>{"bug", "urgent", "frontend"});
+  REQUIRE(tasks[1].tags == std::vector<std::string>{"tag1"});
+  REQUIRE(tasks[2].priority == 1);
+  REQUIRE(tasks[2].tags.empty());
+}
+
+TEST_CASE("ParallelCSVReader decodes only the projected fields", "[io][parallel_csv_reader]") {
+  TempCSV csv("taskproc_parallel_projection.csv",
+              "id,title,status,priority,description,assignee,due_date,created_date,tags\n"
+              "1,\"Fix login\",\"todo\",5,\"desc\",\"john\",\"2024-01-20\",\"2024-01-15\",\"bug,urgent\"\n"
+              "2,\"\",\"done\",3,\"desc2\",\"jane\",,,\n"
+              "3,\"A \"\"quoted\"\" title\",\"done\",2,\"desc3\",\"jane\",\"2024-01-23\",,\"tag1\"\n");
+
+  ParallelCSVReader reader;
+  auto tasks = reader.read_tasks(csv.path.string(), TaskField::Status | TaskField::DueDate);
+
+  // Rows are validated as without a projection: the empty title of task 2 still skips it
+  REQUIRE(tasks.size() == 2);
+  REQUIRE(tasks[0].id == 1);
+  REQUIRE(tasks[0].status == "todo");
+  REQUIRE(tasks[0].priority == 5);
+  REQUIRE(tasks[0].due_date == "2024-01-20");
+  REQUIRE(tasks[0].title.empty());
+  REQUIRE(tasks[0].created_date.empty());
+  REQUIRE(!tasks[0].description.has_value());
+  REQUIRE(!tasks[0].assignee.has_value());
+  REQUIRE(tasks[0].tags.empty());
+  REQUIRE(tasks[1].id == 3);
+  REQUIRE(tasks[1].status == "done");
+
+  auto full = reader.read_tasks(csv.path.string(), TaskFields::all());
+  REQUIRE(full.size() == 2);
+  REQUIRE(full[1].title == "A \"quoted\" title");
+  REQUIRE(full[1].tags == std::vector<std::string>{"tag1"});
+}
+
+TEST_CASE("ParallelCSVReader handles quoting across chunk boundaries", "[io][parallel_csv_reader]") {
+  // Descriptions with quoted newlines, commas and escaped quotes; CRLF line endings
+  std::string contents = "tags,id,title,status,priority,created_date,description,assignee,due_date,extra\r\n";
+  for (int id = 1; id <= 500; ++id) {
+    contents += "\"t" + std::to_string(id % 3) + ",x\"," + std::to_string(id) + ", Title " + std::to_string(id) +
+                " ,todo," + std::to_string(id % 7) + ",2024-01-01,\"line one\nline \"\"two\"\", with comma\nend\"," +
+                "bob,,ignored\r\n";
+  }
+  TempCSV csv("taskproc_parallel_quotes.csv", contents);
+
+  ThreadPool pool(4);
+  ParallelCSVReader single(pool, contents.size() * 2);
+  ParallelCSVReader chunked(pool, 64);
+
+  auto expected = single.read_tasks(csv.path.string());
+  REQUIRE(expected.size() == 500);
+  REQUIRE(expected[0].title == "Title 1");
+  REQUIRE(expected[0].description == "line one\nline \"two\", with comma\nend");
+  REQUIRE(expected[0].tags == std::vector<std::string>{"t1", "x"});
+  REQUIRE(expected[0].due_date == "");
+  REQUIRE(expected[6].priority == 1);
+  REQUIRE(expected[499].id == 500);
+
+  require_same(chunked.read_tasks(csv.path.string()), expected);
+}
+
+TEST_CASE("ParallelCSVReader reports malformed files", "[io][parallel_csv_reader]") {
+  ParallelCSVReader reader;
+
+  SECTION("Missing required column") {
+    TempCSV csv("taskproc_parallel_missing.csv", "id,title,status\n1,a,todo\n");
+    REQUIRE_THROWS_AS(reader.read_tasks(csv.path.string()), std::runtime_error);
+  }
+
+  SECTION("Non-numeric id") {
+    TempCSV csv("taskproc_parallel_badint.csv",
+                "id,title,status,priority,created_date,description,assignee,due_date,tags\n"
+                "x1,a,todo,1,,,,,\n");
+    REQUIRE_THROWS_AS(reader.read_tasks(csv.path.string()), std::runtime_error);
+  }
+
+  SECTION("Missing file") { REQUIRE_THROWS(reader.read_tasks("/nonexistent/taskproc.csv")); }
+}
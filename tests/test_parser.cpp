@@ -56,6 +56,43 @@ TEST_CASE("Command validation", "[cli][parser]") {
     REQUIRE(!result.error_message.empty());
   }
 
+  SECTION("find-by-tag requires a tag") {
+    const char *args[] = {"taskproc", "find-by-tag"};
+    auto result = CommandParser::parse(2, const_cast<char **>(args));
+
+    REQUIRE(!result.is_valid());
+    REQUIRE(!result.error_message.empty());
+  }
+
+  SECTION("reload accepts --incremental only") {
+    const char *args[] = {"taskproc", "reload", "--incremental"};
+    auto result = CommandParser::parse(3, const_cast<char **>(args));
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::Reload);
+    REQUIRE(result.incremental);
+    REQUIRE(result.args.empty());
+
+    const char *bad[] = {"taskproc", "reload", "--fast"};
+    REQUIRE(!CommandParser::parse(3, const_cast<char **>(bad)).is_valid());
+  }
+
+  SECTION("search requires a text") {
+    const char *args[] = {"taskproc", "search"};
+    auto result = CommandParser::parse(2, const_cast<char **>(args));
+
+    REQUIRE(!result.is_valid());
+    REQUIRE(!result.error_message.empty());
+  }
+
+  SECTION("search keeps every word") {
+    const char *args[] = {"taskproc", "search", "login", "bug"};
+    auto result = CommandParser::parse(4, const_cast<char **>(args));
+
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::Search);
+    REQUIRE(result.args == std::vector<std::string>{"login", "bug"});
+  }
+
   SECTION("Validate commands without arguments") {
     test_simple_command("reload", Command::Reload);
     test_simple_command("clear", Command::Clear);
@@ -63,3 +100,137 @@ TEST_CASE("Command validation", "[cli][parser]") {
     test_simple_command("list", Command::List);
   }
 }
+
+// Verify list paging options
+TEST_CASE("List paging options", "[cli][parser]") {
+  SECTION("Limit and offset in any order") {
+    const char *args[] = {"taskproc", "list", "--offset", "100", "--limit", "50"};
+    auto result = CommandParser::parse(6, const_cast<char **>(args));
+
+    REQUIRE(result.is_valid());
+    REQUIRE(result.args.empty());
+    REQUIRE(result.offset == 100);
+    REQUIRE(result.limit == 50);
+  }
+
+  SECTION("Defaults list everything") {
+    const char *args[] = {"taskproc", "list"};
+    auto result = CommandParser::parse(2, const_cast<char **>(args));
+
+    REQUIRE(result.offset == 0);
+    REQUIRE(!result.limit);
+  }
+
+  SECTION("Malformed options are rejected") {
+    for (const char *bad : {"-5", "ten", "5x"}) {
+      const char *args[] = {"taskproc", "list", "--limit", bad};
+      REQUIRE(!CommandParser::parse(4, const_cast<char **>(args)).is_valid());
+    }
+
+    const char *missing[] = {"taskproc", "list", "--offset"};
+    REQUIRE(!CommandParser::parse(3, const_cast<char **>(missing)).is_valid());
+
+    const char *unknown[] = {"taskproc", "list", "--sideways"};
+    REQUIRE(!CommandParser::parse(3, const_cast<char **>(unknown)).is_valid());
+  }
+}
+
+// Verify batch script arguments and parsing from an argument vector
+TEST_CASE("Batch arguments", "[cli][parser]") {
+  SECTION("Script file, stdin or inline text") {
+    REQUIRE(CommandParser::parse(std::vector<std::string>{"batch", "nightly.txt"}).command == Command::Batch);
+    REQUIRE(CommandParser::parse(std::vector<std::string>{"batch"}).is_valid());
+    REQUIRE(CommandParser::parse(std::vector<std::string>{"batch", "-"}).is_valid());
+
+    auto inline_script = CommandParser::parse(std::vector<std::string>{"batch", "-c", "list"});
+    REQUIRE(inline_script.is_valid());
+    REQUIRE(inline_script.args == std::vector<std::string>{"-c", "list"});
+  }
+
+  SECTION("Malformed arguments are rejected") {
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"batch", "-c"}).is_valid());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"batch", "a.txt", "b.txt"}).is_valid());
+  }
+
+  SECTION("Vector and argv forms agree") {
+    const char *args[] = {"taskproc", "filter", "status=todo"};
+    auto from_argv = CommandParser::parse(3, const_cast<char **>(args));
+    auto from_vector = CommandParser::parse(std::vector<std::string>{"filter", "status=todo"});
+    REQUIRE(from_vector.command == from_argv.command);
+    REQUIRE(from_vector.args == from_argv.args);
+  }
+}
+
+// Verify export targets and options
+TEST_CASE("Export arguments", "[cli][parser]") {
+  SECTION("View export with paging and format") {
+    auto result = CommandParser::parse(
+        std::vector<std::string>{"export", "--limit", "10", "-", "--format", "ndjson", "--offset", "5"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::Export);
+    REQUIRE(result.args == std::vector<std::string>{"-"});
+    REQUIRE(result.format == "ndjson");
+    REQUIRE(result.limit == 10);
+    REQUIRE(result.offset == 5);
+  }
+
+  SECTION("Whole dataset export takes only a format") {
+    auto result = CommandParser::parse(std::vector<std::string>{"export-all", "all.json"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::ExportAll);
+    REQUIRE(result.format.empty());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"export-all", "all.json", "--limit", "1"}).is_valid());
+  }
+
+  SECTION("Exactly one target") {
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"export"}).is_valid());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"export", "a.csv", "b.csv"}).is_valid());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"export", "a.csv", "--format"}).is_valid());
+  }
+}
+
+// Verify stats grouping options
+TEST_CASE("Stats arguments", "[cli][parser]") {
+  SECTION("View-wide totals take no arguments") {
+    auto result = CommandParser::parse(std::vector<std::string>{"stats"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::Stats);
+    REQUIRE(result.group_by.empty());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"stats", "assignee"}).is_valid());
+  }
+
+  SECTION("Grouping, aggregates and reference date") {
+    auto result = CommandParser::parse(
+        std::vector<std::string>{"stats", "--agg", "count,overdue", "--group-by", "assignee", "--today", "2024-03-01"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.group_by == "assignee");
+    REQUIRE(result.aggregates == "count,overdue");
+    REQUIRE(result.today == "2024-03-01");
+  }
+
+  SECTION("Aggregates need a grouping") {
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"stats", "--agg", "count"}).is_valid());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"stats", "--group-by"}).is_valid());
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"stats", "--limit", "3"}).is_valid());
+  }
+}
+
+TEST_CASE("Profiling options", "[cli][parser]") {
+  SECTION("Accepted anywhere, by any command") {
+    auto result = CommandParser::parse(std::vector<std::string>{"--profile", "filter", "status=todo"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.command == Command::Filter);
+    REQUIRE(result.profile);
+    REQUIRE(result.args == std::vector<std::string>{"status=todo"});
+
+    result = CommandParser::parse(std::vector<std::string>{"list", "--limit", "5", "--profile-trace", "out.json"});
+    REQUIRE(result.is_valid());
+    REQUIRE(result.limit == 5);
+    REQUIRE(!result.profile);
+    REQUIRE(result.profile_trace == "out.json");
+  }
+
+  SECTION("The trace needs a file") {
+    REQUIRE(!CommandParser::parse(std::vector<std::string>{"list", "--profile-trace"}).is_valid());
+  }
+}
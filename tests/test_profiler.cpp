@@ -0,0 +1,73 @@
+#include "core/profiler.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Profiler aggregates scopes into phases and counters", "[core][profiler]") {
+  Profiler &profiler = Profiler::instance();
+  profiler.start(false);
+  {
+    const ScopedTimer outer("test.outer");
+    for (int i = 0; i < 3; ++i) {
+      const ScopedTimer inner("test.inner");
+      auto allocated = std::make_unique<std::vector<int>>(1000);
+      profiler.count("test.items", 2);
+    }
+  }
+  profiler.stop();
+
+  {
+    const ScopedTimer after_stop("test.after_stop"); // not recorded
+  }
+
+  const auto phases = profiler.phases();
+  REQUIRE(phases.size() == 2);
+  REQUIRE(phases[0].name == "test.outer"); // first to start, although recorded last
+  REQUIRE(phases[0].calls == 1);
+  REQUIRE(phases[1].name == "test.inner");
+  REQUIRE(phases[1].calls == 3);
+  REQUIRE(phases[0].total >= phases[1].total);
+  if (Profiler::counts_allocations()) {
+    REQUIRE(phases[1].allocations >= 6);
+    REQUIRE(phases[1].allocated_bytes >= 3 * 1000 * sizeof(int));
+  }
+
+  const auto counters = profiler.counters();
+  REQUIRE(counters.size() == 1);
+  REQUIRE(counters[0].first == "test.items");
+  REQUIRE(counters[0].second == 6);
+
+  std::ostringstream report;
+  profiler.report(report);
+  REQUIRE(report.str().find("test.inner") != std::string::npos);
+  REQUIRE(report.str().find("test.items") != std::string::npos);
+}
+
+TEST_CASE("Profiler writes Chrome trace events when tracing", "[core][profiler]") {
+  Profiler &profiler = Profiler::instance();
+  profiler.start(true);
+  {
+    const ScopedTimer scope("test.\"quoted\"");
+  }
+  profiler.count("test.items", 1);
+  profiler.stop();
+
+  std::ostringstream trace;
+  profiler.write_trace(trace);
+  const std::string json = trace.str();
+  REQUIRE(json.starts_with("{\"traceEvents\":["));
+  REQUIRE(json.find(R"("name":"test.\"quoted\"")") != std::string::npos);
+  REQUIRE(json.find(R"("ph":"X")") != std::string::npos);
+  REQUIRE(json.find(R"("ph":"C")") != std::string::npos);
+  REQUIRE(json.find("e+") == std::string::npos); // timestamps are plain decimals
+
+  SECTION("A new session starts empty") {
+    profiler.start(false);
+    profiler.stop();
+    REQUIRE(profiler.phases().empty());
+    REQUIRE(profiler.counters().empty());
+  }
+}
@@ -0,0 +1,136 @@
+#include "core/row_bitmap.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+namespace {
+// Reference: sorted unique ordinals
+std::vector<std::uint32_t> random_rows(std::mt19937 &rng, std::uint32_t range, std::uint32_t count) {
+  std::uniform_int_distribution<std::uint32_t> pick(0, range - 1);
+  std::vector<std::uint32_t> rows;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    rows.push_back(pick(rng));
+  }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  return rows;
+}
+
+std::vector<std::uint32_t> iota_rows(std::uint32_t first, std::uint32_t last) {
+  std::vector<std::uint32_t> rows;
+  for (std::uint32_t row = first; row < last; ++row) {
+    rows.push_back(row);
+  }
+  return rows;
+}
+} // anonymous namespace
+
+// ============================================================================
+// RowBitmap Tests
+// ============================================================================
+
+TEST_CASE("RowBitmap membership and iteration", "[core][bitmap]") {
+  SECTION("Empty") {
+    RowBitmap bitmap;
+    REQUIRE(bitmap.empty());
+    REQUIRE(bitmap.cardinality() == 0);
+    REQUIRE(!bitmap.contains(0));
+    REQUIRE(bitmap.to_vector().empty());
+  }
+
+  SECTION("all(n) spans several chunks") {
+    auto bitmap = RowBitmap::all(150000);
+    REQUIRE(bitmap.cardinality() == 150000);
+    REQUIRE(bitmap.contains(0));
+    REQUIRE(bitmap.contains(149999));
+    REQUIRE(!bitmap.contains(150000));
+    REQUIRE(bitmap.to_vector() == iota_rows(0, 150000));
+  }
+
+  SECTION("append ignores a repeated maximum and grows past the array limit") {
+    RowBitmap bitmap;
+    for (std::uint32_t row = 0; row < 20000; row += 3) {
+      bitmap.append(row);
+      bitmap.append(row);
+    }
+    REQUIRE(bitmap.cardinality() == 6667);
+    REQUIRE(bitmap.contains(19998));
+    REQUIRE(!bitmap.contains(19997));
+  }
+
+  SECTION("from_sorted round-trips") {
+    std::vector<std::uint32_t> rows{1, 5, 65535, 65536, 70000, 1u << 20};
+    REQUIRE(RowBitmap::from_sorted(rows).to_vector() == rows);
+  }
+}
+
+TEST_CASE("RowBitmap set operations match std algorithms", "[core][bitmap]") {
+  std::mt19937 rng(42);
+
+  // Sparse, dense and contiguous shapes so every container pairing is exercised
+  const std::vector<std::vector<std::uint32_t>> shapes{
+      random_rows(rng, 200000, 300),    // array containers
+      random_rows(rng, 200000, 150000), // bitmap containers
+      iota_rows(0, 140000),            // full containers
+      iota_rows(0, 1000),              // one partial full container
+      iota_rows(70000, 72000),          // array, not a prefix
+      {},
+  };
+
+  for (const auto &a : shapes) {
+    for (const auto &b : shapes) {
+      const auto left = RowBitmap::from_sorted(a);
+      const auto right = RowBitmap::from_sorted(b);
+
+      std::vector<std::uint32_t> expected;
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      RowBitmap both = left;
+      both &= right;
+      REQUIRE(both.to_vector() == expected);
+      REQUIRE(both.cardinality() == expected.size());
+
+      expected.clear();
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      RowBitmap either = left;
+      either |= right;
+      REQUIRE(either.to_vector() == expected);
+      REQUIRE(either.cardinality() == expected.size());
+
+      expected.clear();
+      std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+      RowBitmap only = left;
+      only -= right;
+      REQUIRE(only.to_vector() == expected);
+      REQUIRE(only.cardinality() == expected.size());
+    }
+  }
+}
+
+TEST_CASE("RowBitmap filter keeps matching members", "[core][bitmap]") {
+  auto odd = RowBitmap::all(100000).filter([](std::uint32_t row) { return row % 2 == 1; });
+  REQUIRE(odd.cardinality() == 50000);
+  REQUIRE(odd.contains(99999));
+  REQUIRE(!odd.contains(50000));
+  REQUIRE(odd == RowBitmap::all(100000).filter([](std::uint32_t row) { return row & 1u; }));
+}
+
+TEST_CASE("RowBitmap chunk ranges partition the set", "[core][bitmap]") {
+  std::mt19937 rng(7);
+  const auto rows = random_rows(rng, 400000, 120000);
+  const auto bitmap = RowBitmap::from_sorted(rows);
+  REQUIRE(bitmap.chunk_count() == 7);
+
+  auto even = [](std::uint32_t row) { return row % 2 == 0; };
+  RowBitmap joined;
+  std::vector<std::uint32_t> visited;
+  for (size_t first = 0; first < bitmap.chunk_count(); first += 3) {
+    const size_t last = std::min(first + 3, bitmap.chunk_count());
+    bitmap.for_each_in(first, last, [&visited](std::uint32_t row) { visited.push_back(row); });
+    joined.append(bitmap.filter_in(first, last, even));
+  }
+  REQUIRE(visited == rows);
+  REQUIRE(joined == bitmap.filter(even));
+  REQUIRE(joined.cardinality() == bitmap.filter(even).cardinality());
+}
@@ -0,0 +1,168 @@
+#include "core/database.hpp"
+#include "core/expr_parser.hpp"
+#include "core/scan_kernels.hpp"
+#include "core/task.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <random>
+
+namespace {
+constexpr ScanOp ALL_OPS[] = {
+    ScanOp::Equal, ScanOp::NotEqual, ScanOp::Less, ScanOp::LessEqual, ScanOp::Greater, ScanOp::GreaterEqual};
+
+// Reference: one comparison per value
+bool holds(ScanOp op, std::int32_t value, std::int32_t target) {
+  switch (op) {
+  case ScanOp::Equal:
+    return value == target;
+  case ScanOp::NotEqual:
+    return value != target;
+  case ScanOp::Less:
+    return value < target;
+  case ScanOp::LessEqual:
+    return value <= target;
+  case ScanOp::Greater:
+    return value > target;
+  case ScanOp::GreaterEqual:
+    return value >= target;
+  }
+  return false;
+}
+
+std::vector<std::int32_t> random_column(std::mt19937 &rng, size_t count) {
+  std::uniform_int_distribution<std::int32_t> pick(-3, 6);
+  std::vector<std::int32_t> column(count);
+  for (auto &value : column) {
+    value = pick(rng);
+  }
+  return column;
+}
+} // anonymous namespace
+
+// ============================================================================
+// ScanKernels Tests
+// ============================================================================
+
+TEST_CASE("Scan kernels match a per-value reference", "[core][scan]") {
+  const ScanKernels &kernels = scan_kernels();
+  CAPTURE(kernels.isa);
+  std::mt19937 rng(23);
+  const auto column = random_column(rng, 1000);
+
+  SECTION("compare, with and without a missing value") {
+    for (std::uint32_t count : {0u, 1u, 7u, 8u, 63u, 64u, 65u, 200u, 1000u}) {
+      for (ScanOp op : ALL_OPS) {
+        for (std::optional<std::int32_t> missing : {std::optional<std::int32_t>{}, std::optional<std::int32_t>{-3}}) {
+          CAPTURE(count, static_cast<int>(op), missing.has_value());
+          // A stale word past the last value must be overwritten
+          std::vector<std::uint64_t> words((count + 63) / 64, ~std::uint64_t{0});
+          std::vector<std::uint64_t> scalar((count + 63) / 64, ~std::uint64_t{0});
+          kernels.compare(column.data(), count, op, 2, missing, words.data());
+          scalar_scan_kernels().compare(column.data(), count, op, 2, missing, scalar.data());
+          REQUIRE(words == scalar);
+
+          for (std::uint32_t i = 0; i < count; ++i) {
+            const bool expected = holds(op, column[i], 2) && column[i] != missing.value_or(INT32_MIN);
+            REQUIRE(((words[i / 64] >> (i % 64)) & 1) == expected);
+          }
+          if (count % 64 != 0)
+            REQUIRE(words.back() >> (count % 64) == 0);
+        }
+      }
+    }
+  }
+
+  SECTION("masked_sum and count_and") {
+    std::vector<std::uint64_t> mask(16);
+    for (auto &word : mask) {
+      word = (std::uint64_t{rng()} << 32) | rng();
+    }
+    for (std::uint32_t count : {0u, 5u, 64u, 130u, 1000u}) {
+      CAPTURE(count);
+      std::int64_t all = 0;
+      std::int64_t masked = 0;
+      for (std::uint32_t i = 0; i < count; ++i) {
+        all += column[i];
+        if ((mask[i / 64] >> (i % 64)) & 1)
+          masked += column[i];
+      }
+      REQUIRE(kernels.masked_sum(column.data(), count, nullptr) == all);
+      // Bits past `count` are ignored
+      REQUIRE(kernels.masked_sum(column.data(), count, mask.data()) == masked);
+    }
+
+    std::vector<std::uint64_t> other(16);
+    size_t expected = 0;
+    for (size_t w = 0; w < mask.size(); ++w) {
+      other[w] = mask[w] >> 3;
+      expected += static_cast<size_t>(std::popcount(mask[w] & other[w]));
+    }
+    REQUIRE(kernels.count_and(mask.data(), other.data(), mask.size()) == expected);
+    REQUIRE(kernels.count_and(mask.data(), nullptr, 0) == 0);
+  }
+}
+
+TEST_CASE("Database dense-chunk scans match per-row results", "[core][scan][database]") {
+  // The view keeps rows 0..69999 dense (a full chunk and a bitmap chunk) and later chunks sparse
+  const std::vector<std::string> statuses{"todo", "done", "in-progress", "blocked", "review"};
+  std::vector<Task> tasks;
+  for (int id = 1; id <= 140000; ++id) {
+    std::optional<std::string> assignee;
+    if (id <= 70000 || id % 50 == 0)
+      assignee = "kept";
+    std::optional<std::string> due;
+    if (id % 7 != 0)
+      due = "2024-0" + std::to_string(1 + id % 9) + "-1" + std::to_string(id % 10);
+    tasks.emplace_back(id,
+                       "Task " + std::to_string(id),
+                       statuses[static_cast<size_t>(id * 31) % statuses.size()],
+                       1 + (id * 13) % 5,
+                       "2024-01-01",
+                       std::nullopt,
+                       assignee,
+                       due);
+  }
+  const std::vector<Task> reference = tasks;
+  Database db;
+  db.load(std::move(tasks));
+  db.apply_filter(*ExpressionParser::parse_filter_expr("assignee=kept"));
+
+  auto in_view = [](const Task &task) { return task.assignee.has_value(); };
+
+  SECTION("Filters") {
+    db.apply_filter(*ExpressionParser::parse_filter_expr(
+        "(priority>=3 AND NOT status=done) OR (due_date<2024-03-01 AND status!=todo)"));
+    std::vector<int> expected;
+    for (const Task &task : reference) {
+      const bool match = (task.priority >= 3 && task.status != "done") ||
+                         (task.due_date && *task.due_date < "2024-03-01" && task.status != "todo");
+      if (in_view(task) && match)
+        expected.push_back(task.id);
+    }
+    REQUIRE(db.current_view_ids() == expected);
+  }
+
+  SECTION("Aggregates") {
+    size_t todo = 0;
+    size_t other = 0;
+    size_t overdue = 0;
+    std::int64_t priority_sum = 0;
+    size_t rows = 0;
+    for (const Task &task : reference) {
+      if (!in_view(task))
+        continue;
+      ++rows;
+      todo += task.status == "todo";
+      other += task.status == "blocked" || task.status == "review";
+      overdue += task.due_date && *task.due_date < "2024-05-01" && task.status != "done";
+      priority_sum += task.priority;
+    }
+    const StatusStats stats = db.status_stats();
+    REQUIRE(stats.todo_count == todo);
+    REQUIRE(stats.other_count == other);
+    REQUIRE(stats.total() == rows);
+    REQUIRE(db.average_priority() == static_cast<double>(priority_sum) / static_cast<double>(rows));
+    REQUIRE(db.overdue_count("2024-05-01") == overdue);
+  }
+}
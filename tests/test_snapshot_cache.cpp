@@ -0,0 +1,193 @@
+#include "io/snapshot_cache.hpp"
+#include "core/task.hpp"
+#include "temp_cwd.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+static std::vector<Task> sample_tasks() {
+  std::vector<Task> tasks;
+  tasks.emplace_back(1,
+                     "Fix login",
+                     "todo",
+                     5,
+                     "2024-01-15",
+                     "desc",
+                     "john",
+                     "2024-01-20",
+                     std::vector<std::string>{"bug", "urgent"});
+  tasks.emplace_back(2, "No optionals", "done", 1, "2024-01-10");
+  tasks.emplace_back(3, "Empty strings", "in-progress", 3, "", "", "", "", std::vector<std::string>{});
+  return tasks;
+}
+
+static std::vector<const Task *> pointers(const std::vector<Task> &tasks) {
+  std::vector<const Task *> out;
+  for (const auto &t : tasks)
+    out.push_back(&t);
+  return out;
+}
+
+TEST_CASE("SnapshotCache round-trips tasks for a matching fingerprint", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  SourceFingerprint source{"tasks.csv", 1234, 42};
+
+  auto tasks = sample_tasks();
+  cache.write(source, pointers(tasks));
+  REQUIRE(std::filesystem::exists(cache.path()));
+
+  auto restored = cache.read(source);
+  REQUIRE(restored.has_value());
+  REQUIRE(restored->size() == 3);
+
+  const Task &first = (*restored)[0];
+  REQUIRE(first.id == 1);
+  REQUIRE(first.title == "Fix login");
+  REQUIRE(first.priority == 5);
+  REQUIRE(first.description == "desc");
+  REQUIRE(first.assignee == "john");
+  REQUIRE(first.due_date == "2024-01-20");
+  REQUIRE(first.tags == std::vector<std::string>{"bug", "urgent"});
+
+  // Absent optionals and present-but-empty optionals are both preserved
+  REQUIRE(!(*restored)[1].description.has_value());
+  REQUIRE((*restored)[2].description.has_value());
+  REQUIRE((*restored)[2].description->empty());
+}
+
+TEST_CASE("SnapshotCache decodes only the projected fields", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  SourceFingerprint source{"tasks.csv", 1234, 42};
+
+  auto tasks = sample_tasks();
+  cache.write(source, pointers(tasks));
+
+  auto restored = cache.read(source, TaskField::Status | TaskField::Assignee);
+  REQUIRE(restored.has_value());
+  REQUIRE(restored->size() == 3);
+
+  const Task &first = (*restored)[0];
+  REQUIRE(first.id == 1);
+  REQUIRE(first.priority == 5);
+  REQUIRE(first.status == "todo");
+  REQUIRE(first.assignee == "john");
+  REQUIRE(first.title.empty());
+  REQUIRE(first.created_date.empty());
+  REQUIRE(!first.description.has_value());
+  REQUIRE(!first.due_date.has_value());
+  REQUIRE(first.tags.empty());
+  REQUIRE((*restored)[2].id == 3);
+  REQUIRE((*restored)[2].status == "in-progress");
+}
+
+TEST_CASE("SnapshotCache rejects stale or missing snapshots", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  SourceFingerprint source{"tasks.csv", 1234, 42};
+
+  REQUIRE(!cache.read(source).has_value());
+
+  auto tasks = sample_tasks();
+  cache.write(source, pointers(tasks));
+
+  SECTION("Different mtime") { REQUIRE(!cache.read(SourceFingerprint{"tasks.csv", 1234, 43}).has_value()); }
+  SECTION("Different size") { REQUIRE(!cache.read(SourceFingerprint{"tasks.csv", 1235, 42}).has_value()); }
+  SECTION("Different path") { REQUIRE(!cache.read(SourceFingerprint{"other.csv", 1234, 42}).has_value()); }
+
+  SECTION("Cleared snapshot") {
+    cache.clear();
+    REQUIRE(!cache.read(source).has_value());
+  }
+}
+
+TEST_CASE("SnapshotCache reports truncated snapshots", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  SourceFingerprint source{"tasks.csv", 1234, 42};
+
+  auto tasks = sample_tasks();
+  cache.write(source, pointers(tasks));
+
+  auto size = std::filesystem::file_size(cache.path());
+  std::filesystem::resize_file(cache.path(), size - 5);
+
+  REQUIRE_THROWS(cache.read(source));
+}
+
+TEST_CASE("SnapshotCache caches the text index per fingerprint", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  SourceFingerprint source{"tasks.csv", 1234, 42};
+
+  TaskColumns columns;
+  for (const auto &task : sample_tasks()) {
+    columns.append(task);
+  }
+  const TextIndex index = TextIndex::build(columns);
+
+  REQUIRE(!cache.read_text_index(source).has_value());
+  cache.write_text_index(source, index);
+  REQUIRE(std::filesystem::exists(cache.text_index_path()));
+
+  SECTION("Matching fingerprint") {
+    auto restored = cache.read_text_index(source);
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->row_count() == 3);
+    REQUIRE(restored->term_count() == index.term_count());
+    REQUIRE(restored->rows_containing("login").to_vector() == std::vector<std::uint32_t>{0});
+  }
+
+  SECTION("Different fingerprint") {
+    REQUIRE(!cache.read_text_index(SourceFingerprint{"tasks.csv", 1234, 43}).has_value());
+  }
+
+  SECTION("Truncated index") {
+    std::filesystem::resize_file(cache.text_index_path(), std::filesystem::file_size(cache.text_index_path()) - 1);
+    REQUIRE_THROWS(cache.read_text_index(source));
+  }
+
+  SECTION("Cleared with the snapshot") {
+    cache.clear();
+    REQUIRE(!std::filesystem::exists(cache.text_index_path()));
+  }
+}
+
+TEST_CASE("SnapshotCache records the shards of a dataset", "[io][snapshot]") {
+  TempCwd tmp;
+  SnapshotCache cache;
+  const SourceFingerprint source{"shards/*.csv", 300, 7};
+  const std::vector<Shard> shards{{SourceFingerprint{"shards/a.csv", 100, 1}, {1, 2, 3}},
+                                  {SourceFingerprint{"shards/b.csv", 200, 2}, {3, 4}}};
+
+  REQUIRE(!cache.read_shards(source).has_value());
+  cache.write_shards(source, shards);
+  REQUIRE(std::filesystem::exists(cache.shards_path()));
+
+  SECTION("Matching fingerprint") {
+    auto restored = cache.read_shards(source);
+    REQUIRE(restored.has_value());
+    REQUIRE(restored->size() == 2);
+    REQUIRE((*restored)[0].source == shards[0].source);
+    REQUIRE((*restored)[0].ids == std::vector<int>{1, 2, 3});
+    REQUIRE((*restored)[1].source == shards[1].source);
+    REQUIRE((*restored)[1].ids == std::vector<int>{3, 4});
+  }
+
+  SECTION("Different fingerprint") {
+    REQUIRE(!cache.read_shards(SourceFingerprint{"shards/*.csv", 300, 8}).has_value());
+  }
+
+  SECTION("Truncated list") {
+    std::filesystem::resize_file(cache.shards_path(), std::filesystem::file_size(cache.shards_path()) - 1);
+    REQUIRE_THROWS(cache.read_shards(source));
+  }
+
+  SECTION("Cleared with the snapshot") {
+    cache.clear();
+    REQUIRE(!std::filesystem::exists(cache.shards_path()));
+  }
+}
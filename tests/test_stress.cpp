@@ -0,0 +1,202 @@
+// Stress tier: million-row datasets, with a wall-time and peak-RSS budget per phase.
+//
+// Built with -DBUILD_STRESS_TESTS=ON and run with `ctest -L stress`. Budgets assume an
+// optimized build; TASKPROC_STRESS_TASKS sets the dataset size (default 1000000) and
+// TASKPROC_STRESS_TIME_SCALE multiplies every time budget (e.g. 4 for a sanitizer build).
+#include "core/data_manager.hpp"
+#include "core/database.hpp"
+#include "dataset_generator.hpp"
+#include "io/view_storage.hpp"
+#include "temp_cwd.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+size_t stress_task_count() {
+  const char *value = std::getenv("TASKPROC_STRESS_TASKS");
+  return value ? std::stoul(value) : 1'000'000;
+}
+
+double time_scale() {
+  const char *value = std::getenv("TASKPROC_STRESS_TIME_SCALE");
+  return value ? std::stod(value) : 1.0;
+}
+
+// Post: the `key` line of /proc/self/status in bytes (e.g. "VmHWM"), or std::nullopt off Linux.
+std::optional<size_t> process_status_bytes(std::string_view key) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with(key) && line.size() > key.size() && line[key.size()] == ':')
+      return std::stoul(line.substr(key.size() + 1)) * 1024; // "VmHWM:   1796 kB"
+  }
+  return std::nullopt;
+}
+
+// Post: true if the peak RSS (VmHWM) now equals the current RSS (Linux 4.0+).
+bool reset_peak_rss() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.flush();
+  return clear_refs.good();
+}
+
+struct PhaseCost {
+  double seconds{0};
+  std::optional<size_t> peak_growth; ///< Peak RSS above the RSS at the start; unknown if it cannot be reset
+};
+
+template <typename F>
+PhaseCost measure(F &&phase) {
+  const bool reset = reset_peak_rss();
+  const auto rss_before = process_status_bytes("VmRSS");
+  const auto start = std::chrono::steady_clock::now();
+  phase();
+  PhaseCost cost;
+  cost.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const auto peak = process_status_bytes("VmHWM");
+  if (reset && rss_before && peak)
+    cost.peak_growth = *peak > *rss_before ? *peak - *rss_before : 0;
+  return cost;
+}
+
+// Budgets are roughly 3x the time and 2x the memory an optimized build measures on one core,
+// so a regression to a quadratic pass or an extra copy of the dataset fails while noise does not.
+struct Budget {
+  double seconds;
+  double bytes;
+};
+
+Budget per_task(double seconds_per_million, double bytes_per_task) {
+  const double tasks = static_cast<double>(stress_task_count());
+  return {seconds_per_million * tasks / 1e6, bytes_per_task * tasks};
+}
+
+void require_within_budget(std::string_view phase, const PhaseCost &cost, const Budget &budget) {
+  const double seconds = budget.seconds * time_scale();
+  INFO(phase << ": " << cost.seconds << " s (budget " << seconds << " s)");
+  CHECK(cost.seconds <= seconds);
+  if (!cost.peak_growth) {
+    WARN(phase << ": peak RSS cannot be measured here; only wall time is checked");
+    return;
+  }
+  INFO(phase << ": peak RSS +" << *cost.peak_growth / (1 << 20) << " MiB (budget "
+             << static_cast<size_t>(budget.bytes) / (1 << 20) << " MiB)");
+  CHECK(static_cast<double>(*cost.peak_growth) <= budget.bytes);
+}
+
+// The generated dataset as CSV, written once per run into a directory that is also the CWD of
+// every test (DataManager keeps its storage and snapshot there). Removed at exit.
+struct StressDataset {
+  TempCwd cwd;
+  std::filesystem::path csv = cwd.dir / "tasks.csv";
+
+  StressDataset() { write_dataset(csv, generate_tasks(DatasetOptions{stress_task_count(), 42})); }
+};
+
+const StressDataset &stress_dataset() {
+  static const StressDataset dataset;
+  return dataset;
+}
+
+// Rounds of filters and sorts separated by resets, so every round starts from the whole dataset,
+// ending on a filtered and sorted view
+std::vector<ViewAction> long_history() {
+  std::vector<ViewAction> history;
+  for (int round = 0; round < 8; ++round) {
+    history.push_back({ViewOpType::Filter, "status IN (todo, in-progress) AND priority>=" + std::to_string(round % 5)});
+    history.push_back({ViewOpType::Sort, round % 2 ? "due_date desc, id" : "priority desc, created_date"});
+    history.push_back({ViewOpType::FindByTag, "bug"});
+    history.push_back({ViewOpType::ResetFilters, ""});
+  }
+  history.push_back({ViewOpType::Filter, "status!=done"});
+  history.push_back({ViewOpType::Sort, "due_date desc, id"});
+  return history;
+}
+} // anonymous namespace
+
+TEST_CASE("Stress: load and restart", "[stress]") {
+  const auto &dataset = stress_dataset();
+  DataManager dm;
+
+  const PhaseCost load = measure([&] { REQUIRE(dm.load_from_file(dataset.csv.string())); });
+  REQUIRE(dm.task_count() == stress_task_count());
+  require_within_budget("load", load, per_task(10.0, 1200));
+
+  // A new process: tasks come back from the snapshot instead of the CSV
+  const PhaseCost restart = measure([&] {
+    DataManager restarted;
+    REQUIRE(restarted.task_count() == stress_task_count());
+  });
+  require_within_budget("restart", restart, per_task(6.0, 900));
+}
+
+TEST_CASE("Stress: filter and sort", "[stress]") {
+  const auto &dataset = stress_dataset();
+  DataManager dm;
+  REQUIRE(dm.load_from_file(dataset.csv.string()));
+
+  // Views are ordered lazily, so each phase reads the first page as `list` would
+  const PhaseCost filter = measure([&] {
+    REQUIRE(dm.apply_filter("status IN (todo, in-progress) AND (priority>=2 OR assignee=user0)"));
+    REQUIRE(dm.view_page(0, 50).size() == 50);
+  });
+  require_within_budget("filter", filter, per_task(0.25, 64));
+
+  const PhaseCost sort = measure([&] {
+    REQUIRE(dm.apply_sort("priority desc, due_date, id"));
+    REQUIRE(dm.view_page(0, 50).front()->priority == 5);
+  });
+  require_within_budget("sort", sort, per_task(0.5, 64));
+}
+
+TEST_CASE("Stress: replay a long history", "[stress]") {
+  Database database;
+  database.load(generate_tasks(DatasetOptions{stress_task_count(), 42}));
+  const auto history = long_history();
+
+  // The whole order is materialized, as persisting the view after the replay does
+  const PhaseCost replay = measure([&] {
+    database.replay_history(history);
+    REQUIRE(!database.current_view_ids().empty());
+  });
+  require_within_budget("replay", replay, per_task(1.0, 64));
+}
+
+TEST_CASE("Stress: persist the history and view", "[stress]") {
+  const auto &dataset = stress_dataset();
+  ViewStorage storage;
+  storage.set_filepath(dataset.csv);
+
+  // One append per command, as a session of a thousand commands would
+  const PhaseCost history = measure([&] {
+    for (int i = 0; i < 1000; ++i) {
+      storage.push_action({ViewOpType::Filter, "priority>=" + std::to_string(i % 5)});
+      storage.persist();
+    }
+  });
+  require_within_budget("persist history", history, {1.0, 16.0 * (1 << 20)});
+
+  MaterializedView view;
+  view.history_hash = storage.history_hash();
+  view.task_ids.resize(stress_task_count());
+  for (size_t i = 0; i < view.task_ids.size(); ++i) {
+    view.task_ids[i] = static_cast<int>(i + 1);
+  }
+  storage.set_materialized_view(std::move(view));
+  const PhaseCost materialized = measure([&] { storage.persist(); });
+  require_within_budget("persist view", materialized, per_task(0.25, 16));
+
+  ViewStorage restored;
+  REQUIRE(restored.load_from_storage());
+  REQUIRE(restored.history().size() == 1000);
+  REQUIRE(restored.materialized_view() != nullptr);
+}
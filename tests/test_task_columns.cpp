@@ -0,0 +1,142 @@
+#include "core/date.hpp"
+#include "core/task_columns.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+// ============================================================================
+// Date Packing Tests
+// ============================================================================
+
+TEST_CASE("ISO dates pack to day numbers", "[core][date]") {
+  REQUIRE(parse_iso_date("1970-01-01") == 0);
+  REQUIRE(parse_iso_date("1970-01-02") == 1);
+  REQUIRE(parse_iso_date("1969-12-31") == -1);
+  REQUIRE(parse_iso_date("2024-03-01").value() - parse_iso_date("2024-02-28").value() == 2); // leap year
+  REQUIRE(parse_iso_date("2024-01-15T10:30:00Z") == parse_iso_date("2024-01-15"));
+
+  SECTION("Invalid dates are rejected") {
+    REQUIRE(!parse_iso_date("").has_value());
+    REQUIRE(!parse_iso_date("2024-13-01").has_value());
+    REQUIRE(!parse_iso_date("2023-02-29").has_value());
+    REQUIRE(!parse_iso_date("2024/01/01").has_value());
+    REQUIRE(!parse_iso_date("2024-01-01junk").has_value());
+    REQUIRE(to_day_number("not a date") == NO_DATE);
+  }
+}
+
+// ============================================================================
+// Columnar Storage Tests
+// ============================================================================
+
+TEST_CASE("TaskColumns stores one row per task", "[core][columns]") {
+  TaskColumns columns;
+  columns.append(Task(1, "First", "todo", 3, "2024-01-01", "desc", "alice", "2024-02-01"));
+  columns.append(Task(2, "Second", "done", 5, "2024-01-02"));
+  columns.append(Task(3, "Third", "todo", 1, "bad-date", std::nullopt, "alice"));
+
+  REQUIRE(columns.size() == 3);
+  REQUIRE(columns.id == std::vector<std::int32_t>{1, 2, 3});
+  REQUIRE(columns.priority == std::vector<std::int32_t>{3, 5, 1});
+
+  SECTION("Low-cardinality fields are dictionary-encoded") {
+    REQUIRE(columns.statuses.size() == 2);
+    REQUIRE(columns.status[0] == columns.status[2]);
+    REQUIRE(columns.statuses.value(columns.status[1]) == "done");
+    REQUIRE(columns.assignee[0] == columns.assignee[2]);
+    REQUIRE(columns.assignee[1] == TaskColumns::NO_VALUE);
+  }
+
+  SECTION("Dates are packed, missing or invalid dates use the sentinel") {
+    REQUIRE(columns.created_day[0] == parse_iso_date("2024-01-01"));
+    REQUIRE(columns.due_day[0] == parse_iso_date("2024-02-01"));
+    REQUIRE(columns.due_day[1] == NO_DATE);
+    REQUIRE(columns.created_day[2] == NO_DATE);
+  }
+
+  SECTION("Text lives in the arena") {
+    REQUIRE(columns.text(columns.title[1]) == "Second");
+    REQUIRE(columns.text(columns.description[0]) == "desc");
+    REQUIRE(columns.description[1].length == TaskColumns::NO_VALUE);
+  }
+
+  SECTION("Status rank follows string order") {
+    auto rank = columns.status_rank();
+    REQUIRE(rank[columns.status[1]] < rank[columns.status[0]]); // "done" < "todo"
+  }
+
+  SECTION("Clear drops everything") {
+    columns.clear();
+    REQUIRE(columns.size() == 0);
+    REQUIRE(columns.statuses.size() == 0);
+  }
+}
+
+TEST_CASE("TaskColumns rebuild the tasks they store", "[core][columns]") {
+  TaskColumns columns;
+  const std::vector<Task> tasks{
+      Task(7, "With everything", "todo", 4, "2024-03-01", "notes", "bob", "2024-03-09", {"bug", "ui", "bug"}),
+      Task(8, "Sparse", "done", 1, "", std::nullopt, std::nullopt, std::nullopt, {}),
+      Task(9, "Empty optionals", "todo", 2, "not-a-date", "", "", "", {"ui"}),
+  };
+  columns.reserve(tasks.size(), 64);
+  for (const auto &task : tasks) {
+    columns.append(task);
+  }
+
+  SECTION("Low-cardinality values are interned once") {
+    REQUIRE(columns.tags.size() == 2);
+    REQUIRE(columns.tags_of(0).size() == 3);
+    REQUIRE(columns.tags_of(0)[0] == columns.tags_of(0)[2]);
+    REQUIRE(columns.tags_of(1).empty());
+    REQUIRE(columns.tags_of(2)[0] == columns.tags_of(0)[1]);
+    REQUIRE(columns.due_date[1] == TaskColumns::NO_VALUE);
+    REQUIRE(columns.due_dates.value(columns.due_date[2]).empty());
+  }
+
+  SECTION("task(row) round-trips every field") {
+    for (std::uint32_t row = 0; row < tasks.size(); ++row) {
+      const Task rebuilt = columns.task(row);
+      REQUIRE(rebuilt.id == tasks[row].id);
+      REQUIRE(rebuilt.title == tasks[row].title);
+      REQUIRE(rebuilt.status == tasks[row].status);
+      REQUIRE(rebuilt.priority == tasks[row].priority);
+      REQUIRE(rebuilt.created_date == tasks[row].created_date);
+      REQUIRE(rebuilt.description == tasks[row].description);
+      REQUIRE(rebuilt.assignee == tasks[row].assignee);
+      REQUIRE(rebuilt.due_date == tasks[row].due_date);
+      REQUIRE(rebuilt.tags == tasks[row].tags);
+    }
+  }
+
+  SECTION("Row content hashes equal the hashes of the stored tasks") {
+    for (std::uint32_t row = 0; row < tasks.size(); ++row) {
+      REQUIRE(columns.content_hash(row) == content_hash(tasks[row]));
+    }
+    REQUIRE(columns.content_hash(0) != columns.content_hash(1));
+
+    // Every field counts, and a missing optional differs from an empty one
+    Task changed = tasks[2];
+    changed.assignee.reset();
+    REQUIRE(content_hash(changed) != columns.content_hash(2));
+    changed = tasks[0];
+    changed.tags.pop_back();
+    REQUIRE(content_hash(changed) != columns.content_hash(0));
+    changed = tasks[0];
+    changed.title += "!";
+    REQUIRE(content_hash(changed) != columns.content_hash(0));
+  }
+
+  SECTION("clear releases everything and the columns can be reused") {
+    columns.clear();
+    REQUIRE(columns.size() == 0);
+    REQUIRE(columns.tags.size() == 0);
+    columns.append(tasks[1]);
+    REQUIRE(columns.task(0).title == "Sparse");
+    REQUIRE(columns.tags_of(0).empty());
+  }
+
+  SECTION("Moved columns keep their text") {
+    TaskColumns moved = std::move(columns);
+    REQUIRE(moved.text(moved.title[0]) == "With everything");
+    REQUIRE(moved.task(0).description == "notes");
+  }
+}
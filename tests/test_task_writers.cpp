@@ -0,0 +1,190 @@
+#include "io/csv_writer.hpp"
+#include "io/json_reader.hpp"
+#include "io/json_writer.hpp"
+#include "io/ndjson_reader.hpp"
+#include "io/output_sink.hpp"
+#include "io/parallel_csv_reader.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+// RAII temp path, removed on scope exit
+struct TempPath {
+  std::filesystem::path path;
+  explicit TempPath(const std::string &name) : path(std::filesystem::temp_directory_path() / name) {}
+  ~TempPath() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+  }
+};
+
+std::vector<Task> sample_tasks(int count) {
+  std::vector<Task> tasks;
+  for (int id = 1; id <= count; ++id) {
+    tasks.emplace_back(id,
+                       "Task " + std::to_string(id),
+                       id % 3 == 0 ? "done" : "todo",
+                       id % 5 + 1,
+                       "2024-01-01",
+                       id % 2 == 0 ? std::optional<std::string>("Details for " + std::to_string(id)) : std::nullopt,
+                       std::optional<std::string>("ann"),
+                       std::nullopt,
+                       std::vector<std::string>{"t" + std::to_string(id % 4), "all"});
+  }
+  // Values every format must escape
+  tasks.emplace_back(count + 1,
+                     "Quote \"this\", please",
+                     "todo",
+                     3,
+                     "2024-02-01",
+                     std::optional<std::string>("line one\nline two\twith tab \\ and \x01"),
+                     std::optional<std::string>("  padded  "),
+                     std::optional<std::string>("2024-03-01"),
+                     std::vector<std::string>{"café"});
+  return tasks;
+}
+
+std::vector<const Task *> pointers(const std::vector<Task> &tasks) {
+  std::vector<const Task *> result;
+  for (const Task &task : tasks) {
+    result.push_back(&task);
+  }
+  return result;
+}
+
+std::string write_to_string(const ITaskWriter &writer, const std::vector<const Task *> &tasks) {
+  std::ostringstream out;
+  StreamSink sink(out);
+  writer.write_tasks(tasks, sink);
+  return std::move(out).str();
+}
+
+// Post: `tasks` written to a temp `extension` file with `writer` and read back with `reader`
+std::vector<Task> round_trip(const ITaskWriter &writer,
+                             ITaskReader &reader,
+                             const std::vector<Task> &tasks,
+                             const std::string &extension) {
+  TempPath file("taskproc_writer_round_trip" + extension);
+  {
+    FileSink sink(file.path);
+    writer.write_tasks(pointers(tasks), sink);
+    sink.close();
+  }
+  return reader.read_tasks(file.path.string());
+}
+
+// The JSON readers return an absent optional field as an empty string, so unset and empty compare equal
+void require_same_tasks(const std::vector<Task> &actual, const std::vector<Task> &expected) {
+  REQUIRE(actual.size() == expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    REQUIRE(actual[i].id == expected[i].id);
+    REQUIRE(actual[i].title == expected[i].title);
+    REQUIRE(actual[i].status == expected[i].status);
+    REQUIRE(actual[i].priority == expected[i].priority);
+    REQUIRE(actual[i].created_date == expected[i].created_date);
+    REQUIRE(actual[i].description.value_or("") == expected[i].description.value_or(""));
+    REQUIRE(actual[i].assignee.value_or("") == expected[i].assignee.value_or(""));
+    REQUIRE(actual[i].due_date.value_or("") == expected[i].due_date.value_or(""));
+    REQUIRE(actual[i].tags == expected[i].tags);
+  }
+}
+} // anonymous namespace
+
+// ============================================================================
+// Task Writer Tests
+// ============================================================================
+
+TEST_CASE("Writers pick formats by extension and name", "[io][writer]") {
+  CSVWriter csv;
+  JSONWriter json;
+  NDJSONWriter ndjson;
+  REQUIRE(csv.can_handle("out.csv"));
+  REQUIRE(json.can_handle("out.json"));
+  REQUIRE(!json.can_handle("out.jsonl"));
+  REQUIRE(ndjson.can_handle("out.jsonl"));
+  REQUIRE(ndjson.can_handle("out.ndjson"));
+  REQUIRE(csv.format_name() == "csv");
+  REQUIRE(json.format_name() == "json");
+  REQUIRE(ndjson.format_name() == "ndjson");
+}
+
+TEST_CASE("Writers format documents the readers accept", "[io][writer]") {
+  const std::vector<Task> tasks = sample_tasks(20);
+
+  SECTION("CSV quotes only the fields that need it") {
+    const std::string text = write_to_string(CSVWriter(), pointers(tasks));
+    REQUIRE(text.starts_with("id,title,status,priority,created_date,description,assignee,due_date,tags\n"
+                             "1,Task 1,todo,2,2024-01-01,,ann,,\"t1,all\"\n"));
+    REQUIRE(text.find("21,\"Quote \"\"this\"\", please\",todo,3") != std::string::npos);
+    REQUIRE(text.find(",\"  padded  \",2024-03-01,café\n") != std::string::npos);
+
+    ParallelCSVReader reader;
+    require_same_tasks(round_trip(CSVWriter(), reader, tasks, ".csv"), tasks);
+  }
+
+  SECTION("JSON array, pretty-printed") {
+    const std::string text = write_to_string(JSONWriter(), pointers(tasks));
+    REQUIRE(text.starts_with("[\n  {\n    \"id\": 1,\n    \"title\": \"Task 1\",\n"));
+    REQUIRE(text.find(R"("description": "line one\nline two\twith tab \\ and \u0001")") != std::string::npos);
+    REQUIRE(text.ends_with("    \"tags\": [\"café\"]\n  }\n]\n"));
+
+    JSONReader reader;
+    require_same_tasks(round_trip(JSONWriter(), reader, tasks, ".json"), tasks);
+  }
+
+  SECTION("NDJSON, one compact object per line") {
+    const std::string text = write_to_string(NDJSONWriter(), pointers(tasks));
+    REQUIRE(text.starts_with(R"({"id":1,"title":"Task 1","status":"todo","priority":2,"created_date":"2024-01-01",)"
+                             R"("assignee":"ann","tags":["t1","all"]})"
+                             "\n"));
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 21);
+
+    NDJSONReader reader;
+    require_same_tasks(round_trip(NDJSONWriter(), reader, tasks, ".jsonl"), tasks);
+  }
+
+  SECTION("Empty documents") {
+    const std::string header = "id,title,status,priority,created_date,description,assignee,due_date,tags\n";
+    REQUIRE(write_to_string(CSVWriter(), {}) == header);
+    REQUIRE(write_to_string(JSONWriter(), {}) == "[]\n");
+    REQUIRE(write_to_string(NDJSONWriter(), {}).empty());
+  }
+}
+
+TEST_CASE("Chunked writers produce the same bytes in parallel", "[io][writer]") {
+  const std::vector<Task> tasks = sample_tasks(1000);
+  const std::vector<const Task *> view = pointers(tasks);
+  ThreadPool pool(4);
+
+  // 7 rows per chunk: many waves, with a partial last chunk and wave
+  REQUIRE(write_to_string(CSVWriter(pool, 7), view) == write_to_string(CSVWriter(), view));
+  REQUIRE(write_to_string(JSONWriter(pool, 7), view) == write_to_string(JSONWriter(), view));
+  REQUIRE(write_to_string(NDJSONWriter(pool, 7), view) == write_to_string(NDJSONWriter(), view));
+
+  SECTION("A file sink receives every chunk") {
+    TempPath file("taskproc_writer_parallel.jsonl");
+    {
+      FileSink sink(file.path);
+      NDJSONWriter(pool, 7).write_tasks(view, sink);
+      sink.close();
+    }
+    NDJSONReader reader;
+    require_same_tasks(reader.read_tasks(file.path.string()), tasks);
+  }
+}
+
+TEST_CASE("FileSink reports I/O errors", "[io][writer]") {
+  REQUIRE_THROWS_AS(FileSink(std::filesystem::temp_directory_path() / "taskproc_missing_dir" / "out.csv"),
+                    std::runtime_error);
+
+  TempPath file("taskproc_writer_closed.csv");
+  FileSink sink(file.path);
+  sink.close();
+  const std::vector<std::string> buffers{"data"};
+  REQUIRE_THROWS_AS(sink.write(buffers), std::runtime_error);
+}
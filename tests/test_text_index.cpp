@@ -0,0 +1,101 @@
+#include "core/text_index.hpp"
+#include "core/task.hpp"
+#include "io/binary_io.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+TaskColumns sample_columns() {
+  TaskColumns columns;
+  columns.append(Task(1, "Fix login bug", "todo", 5, "2024-01-15", "Users cannot LOG IN after reset"));
+  columns.append(Task(2, "Write docs", "done", 1, "2024-01-10"));
+  columns.append(Task(3, "Login page redesign", "todo", 3, "2024-01-12", "New layout, café theme"));
+  columns.append(Task(4, "Relogin flow", "in-progress", 2, "2024-01-13", ""));
+  return columns;
+}
+
+std::vector<std::uint32_t> rows_of(const TextIndex &index, std::string_view word) {
+  return index.rows_containing(word).to_vector();
+}
+} // anonymous namespace
+
+// ============================================================================
+// TextIndex Tests
+// ============================================================================
+
+TEST_CASE("TextIndex splits and folds words", "[core][text_index]") {
+  REQUIRE(TextIndex::words("Fix the LOGIN-bug, now!") == std::vector<std::string>{"fix", "the", "login", "bug", "now"});
+  REQUIRE(TextIndex::words("  ,;  ").empty());
+  REQUIRE(TextIndex::words("").empty());
+
+  // Non-ASCII bytes stay inside their word and are not folded
+  REQUIRE(TextIndex::words("Café Über") == std::vector<std::string>{"café", "Über"});
+}
+
+TEST_CASE("TextIndex finds rows by word substring", "[core][text_index]") {
+  const TaskColumns columns = sample_columns();
+  const TextIndex index = TextIndex::build(columns);
+  REQUIRE(index.row_count() == 4);
+
+  SECTION("Whole words in title or description") {
+    REQUIRE(rows_of(index, "login") == std::vector<std::uint32_t>{0, 2, 3});
+    REQUIRE(rows_of(index, "users") == std::vector<std::uint32_t>{0});
+    REQUIRE(rows_of(index, "docs") == std::vector<std::uint32_t>{1});
+  }
+
+  SECTION("Substrings of a word, found through trigrams") {
+    REQUIRE(rows_of(index, "ogi") == std::vector<std::uint32_t>{0, 2, 3});
+    REQUIRE(rows_of(index, "esign") == std::vector<std::uint32_t>{2});
+    REQUIRE(rows_of(index, "caf") == std::vector<std::uint32_t>{2});
+  }
+
+  SECTION("Words shorter than a trigram") {
+    REQUIRE(rows_of(index, "in") == std::vector<std::uint32_t>{0, 2, 3});
+    REQUIRE(rows_of(index, "x") == std::vector<std::uint32_t>{0});
+  }
+
+  SECTION("Trigrams present out of order do not match") {
+    // "gin" and "log" both occur, but never as "ginlog"
+    REQUIRE(rows_of(index, "ginlog").empty());
+    REQUIRE(rows_of(index, "missing").empty());
+  }
+}
+
+TEST_CASE("TextIndex serialization round-trip", "[core][text_index]") {
+  const TaskColumns columns = sample_columns();
+  const TextIndex index = TextIndex::build(columns);
+
+  ByteWriter out;
+  index.serialize(out);
+
+  SECTION("Decoded index answers the same queries") {
+    ByteReader in(out.data());
+    const TextIndex decoded = TextIndex::deserialize(in);
+    REQUIRE(in.at_end());
+    REQUIRE(decoded.row_count() == index.row_count());
+    REQUIRE(decoded.term_count() == index.term_count());
+    for (std::string_view word : {"login", "ogi", "in", "docs", "café", "ginlog"}) {
+      REQUIRE(rows_of(decoded, word) == rows_of(index, word));
+    }
+  }
+
+  SECTION("Truncated data throws") {
+    const std::string data = out.data().substr(0, out.size() - 1);
+    ByteReader in(data);
+    REQUIRE_THROWS_AS(TextIndex::deserialize(in), std::runtime_error);
+  }
+
+  SECTION("Postings beyond the row count throw") {
+    ByteWriter bad;
+    bad.put(std::uint32_t{2}); // rows
+    bad.put(std::uint32_t{1}); // terms
+    bad.put_string("word");
+    bad.put_varint(1);
+    bad.put_varint(5); // row 5 of 2
+    ByteReader in(bad.data());
+    REQUIRE_THROWS_AS(TextIndex::deserialize(in), std::runtime_error);
+  }
+}
@@ -0,0 +1,58 @@
+#include "core/thread_pool.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+TEST_CASE("ThreadPool runs submitted jobs", "[core][thread_pool]") {
+  ThreadPool pool(3);
+  REQUIRE(pool.size() == 3);
+
+  auto answer = pool.submit([]() { return 42; });
+  REQUIRE(answer.get() == 42);
+
+  auto failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+  REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool::parallel_for covers every index", "[core][thread_pool]") {
+  ThreadPool pool(4);
+  std::vector<int> hits(1000, 0);
+  pool.parallel_for(hits.size(), [&hits](size_t i) { hits[i] += 1; });
+  REQUIRE(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+
+  SECTION("Exceptions surface after every call finished") {
+    std::atomic<int> calls{0};
+    REQUIRE_THROWS_AS(pool.parallel_for(100,
+                                        [&calls](size_t i) {
+                                          ++calls;
+                                          if (i % 10 == 0)
+                                            throw std::logic_error("bad index");
+                                        }),
+                      std::logic_error);
+    REQUIRE(calls == 100);
+  }
+
+  SECTION("A single worker runs inline") {
+    ThreadPool inline_pool(0);
+    REQUIRE(inline_pool.size() == 1);
+    int sum = 0;
+    inline_pool.parallel_for(10, [&sum](size_t i) { sum += static_cast<int>(i); });
+    REQUIRE(sum == 45);
+  }
+}
+
+TEST_CASE("ThreadPool::configured_threads reads TASKPROC_THREADS", "[core][thread_pool]") {
+  ::setenv("TASKPROC_THREADS", "6", 1);
+  REQUIRE(ThreadPool::configured_threads() == 6);
+
+  for (const char *ignored : {"0", "-2", "many", "4x", ""}) {
+    ::setenv("TASKPROC_THREADS", ignored, 1);
+    REQUIRE(ThreadPool::configured_threads() == ThreadPool::default_threads());
+  }
+
+  ::unsetenv("TASKPROC_THREADS");
+  REQUIRE(ThreadPool::configured_threads() == ThreadPool::default_threads());
+}
@@ -0,0 +1,105 @@
+#include "io/view_cache.hpp"
+#include "temp_cwd.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static size_t entry_files(const ViewCache &cache) {
+  size_t count = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(cache.directory())) {
+    count += entry.path().extension() == ".view";
+  }
+  return count;
+}
+
+TEST_CASE("ViewCache::normalize canonicalizes equivalent histories", "[io][view_cache]") {
+  SECTION("actions before the last reset and loads are dropped") {
+    const auto actions = ViewCache::normalize({
+        {ViewOpType::Load, "tasks.csv"},
+        {ViewOpType::Filter, "status=done"},
+        {ViewOpType::ResetFilters, ""},
+        {ViewOpType::Filter, "status=todo"},
+    });
+    REQUIRE(actions.size() == 1);
+    REQUIRE(actions[0].type == ViewOpType::Filter);
+    REQUIRE(actions[0].payload == "status=\"todo\"");
+  }
+
+  SECTION("filters key on their parsed tree") {
+    const auto spaced = ViewCache::normalize({{ViewOpType::Filter, "  status=todo   AND  title=a  b "}});
+    const auto quoted = ViewCache::normalize({{ViewOpType::Filter, "status=todo AND title=\"a  b\""}});
+    const auto single = ViewCache::normalize({{ViewOpType::Filter, "status=todo AND title=a b"}});
+    REQUIRE(spaced[0].payload == quoted[0].payload);
+    REQUIRE(spaced[0].payload != single[0].payload);
+  }
+
+  SECTION("sort keys key on their parsed direction") {
+    const auto spelled = ViewCache::normalize({{ViewOpType::Sort, "priority descending, id asc"}});
+    const auto terse = ViewCache::normalize({{ViewOpType::Sort, "priority desc,id"}});
+    REQUIRE(terse[0].payload == spelled[0].payload);
+
+    // "priority  desc" parses as an unknown direction, i.e. ascending
+    const auto spaced = ViewCache::normalize({{ViewOpType::Sort, "priority  desc"}});
+    REQUIRE(spaced[0].payload != ViewCache::normalize({{ViewOpType::Sort, "priority desc"}})[0].payload);
+    REQUIRE(spaced[0].payload == ViewCache::normalize({{ViewOpType::Sort, "priority"}})[0].payload);
+  }
+
+  SECTION("search text becomes its folded words") {
+    const auto loud = ViewCache::normalize({{ViewOpType::Search, "  Fix   LOGIN "}});
+    const auto quiet = ViewCache::normalize({{ViewOpType::Search, "fix login"}});
+    REQUIRE(loud[0].payload == quiet[0].payload);
+  }
+}
+
+TEST_CASE("ViewCache returns the longest cached prefix", "[io][view_cache]") {
+  TempCwd tmp;
+  ViewCache cache;
+  const SourceFingerprint source{"tasks.csv", 1234, 42};
+  const std::vector<ViewAction> filter{{ViewOpType::Filter, "status=todo"}};
+  const std::vector<ViewAction> filter_sort{{ViewOpType::Filter, "status=todo"}, {ViewOpType::Sort, "priority desc"}};
+
+  REQUIRE_FALSE(cache.longest_prefix(source, filter_sort).has_value());
+  cache.insert(source, filter, {3, 1, 2});
+
+  auto hit = cache.longest_prefix(source, filter_sort);
+  REQUIRE(hit.has_value());
+  REQUIRE(hit->length == 1);
+  REQUIRE(hit->task_ids == std::vector<int>{3, 1, 2});
+  REQUIRE_FALSE(cache.find(source, filter_sort).has_value());
+
+  cache.insert(source, filter_sort, {2, 3, 1});
+  hit = cache.longest_prefix(source, filter_sort);
+  REQUIRE(hit->length == 2);
+  REQUIRE(hit->task_ids == std::vector<int>{2, 3, 1});
+
+  SECTION("a changed dataset misses") {
+    const SourceFingerprint edited{"tasks.csv", 1234, 43};
+    REQUIRE_FALSE(cache.longest_prefix(edited, filter_sort).has_value());
+  }
+
+  SECTION("another process finds the entries on disk") {
+    ViewCache restarted;
+    auto task_ids = restarted.find(source, filter);
+    REQUIRE(task_ids.has_value());
+    REQUIRE(*task_ids == std::vector<int>{3, 1, 2});
+  }
+}
+
+TEST_CASE("ViewCache evicts the least recently used views", "[io][view_cache]") {
+  TempCwd tmp;
+  ViewCache cache(2);
+  const SourceFingerprint source{"tasks.csv", 1234, 42};
+  auto filter = [](const std::string &status) { return std::vector<ViewAction>{{ViewOpType::Filter, status}}; };
+
+  cache.insert(source, filter("status=todo"), {1});
+  cache.insert(source, filter("status=done"), {2});
+  REQUIRE(cache.find(source, filter("status=todo")).has_value()); // now more recent than "done"
+  cache.insert(source, filter("status=blocked"), {3});
+
+  REQUIRE(cache.find(source, filter("status=todo")).has_value());
+  REQUIRE(cache.find(source, filter("status=blocked")).has_value());
+  REQUIRE_FALSE(cache.find(source, filter("status=done")).has_value());
+  REQUIRE(entry_files(cache) == 2);
+}
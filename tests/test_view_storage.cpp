@@ -1,31 +1,10 @@
 #include "io/view_storage.hpp"
+#include "temp_cwd.hpp"
 #include <catch2/catch_test_macros.hpp>
 
 #include <filesystem>
+#include <fstream>
 #include <string>
-#include <system_error>
-
-// Small RAII helper for a temporary directory used as the process CWD.
-// On construction it creates a temp directory and switches CWD to it.
-// On destruction it restores the previous CWD and removes the temp directory.
-struct TempCwd {
-  std::filesystem::path dir;
-  std::filesystem::path prev;
-  TempCwd() {
-    prev = std::filesystem::current_path();
-    dir = std::filesystem::temp_directory_path() /
-          ("taskproc_test_view_storage_" + std::to_string(std::hash<std::string>{}(std::to_string(
-                                               std::chrono::steady_clock::now().time_since_epoch().count()))));
-    std::filesystem::create_directories(dir);
-    std::filesystem::current_path(dir);
-  }
-  ~TempCwd() {
-    std::error_code ec;
-    std::filesystem::current_path(prev);
-    std::filesystem::remove_all(dir, ec);
-    (void)ec;
-  }
-};
 
 // Simple helper that checks whether the storage file exists in the current CWD.
 static bool storage_file_exists(const std::string &filename = ".taskproc.storage") {
@@ -33,6 +12,7 @@ static bool storage_file_exists(const std::string &filename = ".taskproc.storage
 }
 
 TEST_CASE("ViewStorage in-memory operations", "[io][view_storage]") {
+  TempCwd tmp; // clear_history persists once a file path is set
   ViewStorage vs;
 
   REQUIRE(!vs.filepath().has_value());
@@ -160,3 +140,139 @@ TEST_CASE("ViewStorage clear_history preserves filepath but clears history", "[i
     REQUIRE(reader.history().empty());
   }
 }
+
+TEST_CASE("ViewStorage persists the materialized view alongside the history", "[io][view_storage]") {
+  TempCwd tmp;
+
+  {
+    ViewStorage writer;
+    writer.set_filepath("somefile.csv");
+    writer.push_action(ViewAction(ViewOpType::Filter, "status=todo"));
+    writer.set_materialized_view(MaterializedView{writer.history_hash(), {"somefile.csv", 10, 20}, {3, 1, 2}});
+    writer.persist();
+    REQUIRE(storage_file_exists(".taskproc.storage.view"));
+  }
+
+  ViewStorage reader;
+  REQUIRE(reader.load_from_storage());
+  const MaterializedView *view = reader.materialized_view();
+  REQUIRE(view != nullptr);
+  REQUIRE(view->history_hash == reader.history_hash());
+  REQUIRE(view->source == SourceFingerprint{"somefile.csv", 10, 20});
+  REQUIRE(view->task_ids == std::vector<int>{3, 1, 2});
+
+  SECTION("Changing the history drops the materialized view") {
+    reader.push_action(ViewAction(ViewOpType::Sort, "priority desc"));
+    REQUIRE(reader.materialized_view() == nullptr);
+
+    reader.persist();
+    REQUIRE(!storage_file_exists(".taskproc.storage.view"));
+  }
+
+  SECTION("Clearing the history drops the materialized view") {
+    reader.clear_history();
+    REQUIRE(reader.materialized_view() == nullptr);
+  }
+}
+
+TEST_CASE("ViewStorage history hash depends on every action", "[io][view_storage]") {
+  ViewStorage a;
+  ViewStorage b;
+  REQUIRE(a.history_hash() == b.history_hash());
+
+  a.push_action(ViewAction(ViewOpType::Filter, "status=todo"));
+  b.push_action(ViewAction(ViewOpType::Filter, "status=done"));
+  REQUIRE(a.history_hash() != b.history_hash());
+
+  ViewStorage c;
+  c.push_action(ViewAction(ViewOpType::Sort, "status=todo"));
+  REQUIRE(a.history_hash() != c.history_hash());
+}
+
+TEST_CASE("ViewStorage appends one checksummed record per persist", "[io][view_storage]") {
+  TempCwd tmp;
+  const auto log_size = []() { return std::filesystem::file_size(".taskproc.storage"); };
+
+  ViewStorage writer;
+  writer.set_filepath("somefile.csv");
+  writer.push_action(ViewAction(ViewOpType::Filter, "status=todo"));
+  writer.persist();
+  const auto first = log_size();
+
+  writer.push_action(ViewAction(ViewOpType::Sort, "priority desc"));
+  writer.persist();
+  const auto second = log_size();
+  REQUIRE(second > first);
+  REQUIRE(second - first < 64); // just the new action, not the whole history
+
+  writer.persist(); // nothing changed: nothing appended
+  REQUIRE(log_size() == second);
+
+  SECTION("A torn last record is ignored and the log is rewritten on the next persist") {
+    writer.push_action(ViewAction(ViewOpType::Search, "login"));
+    writer.persist();
+    std::filesystem::resize_file(".taskproc.storage", log_size() - 3);
+
+    ViewStorage reader;
+    REQUIRE(reader.load_from_storage());
+    REQUIRE(reader.history().size() == 2);
+    REQUIRE(reader.history()[1].payload == "priority desc");
+
+    reader.push_action(ViewAction(ViewOpType::FindByTag, "urgent"));
+    reader.persist();
+    ViewStorage again;
+    REQUIRE(again.load_from_storage());
+    REQUIRE(again.history().size() == 3);
+    REQUIRE(again.history()[2].payload == "urgent");
+  }
+
+  SECTION("The log is compacted after COMPACT_AFTER_RECORDS records") {
+    std::uintmax_t before = 0;
+    for (size_t i = 2; i < ViewStorage::COMPACT_AFTER_RECORDS; ++i) {
+      writer.push_action(ViewAction(ViewOpType::Filter, "priority>=" + std::to_string(i)));
+      writer.persist();
+      before = log_size();
+    }
+    writer.push_action(ViewAction(ViewOpType::Filter, "priority>=0"));
+    writer.persist();
+    REQUIRE(log_size() < before);
+
+    ViewStorage reader;
+    REQUIRE(reader.load_from_storage());
+    REQUIRE(reader.history().size() == writer.history().size());
+    REQUIRE(reader.history_hash() == writer.history_hash());
+  }
+
+  SECTION("A log changed by another process is replaced, not appended to") {
+    ViewStorage other;
+    REQUIRE(other.load_from_storage());
+    other.clear_history();
+
+    writer.push_action(ViewAction(ViewOpType::FindByTag, "urgent"));
+    writer.persist();
+
+    ViewStorage reader;
+    REQUIRE(reader.load_from_storage());
+    REQUIRE(reader.history_hash() == writer.history_hash());
+  }
+}
+
+TEST_CASE("ViewStorage reads the JSON storage of earlier versions", "[io][view_storage]") {
+  TempCwd tmp;
+  {
+    std::ofstream ofs(".taskproc.storage");
+    ofs << R"({"filepath": "somefile.csv", "history": [{"type": "filter", "payload": "status=todo"}]})";
+  }
+
+  ViewStorage reader;
+  REQUIRE(reader.load_from_storage());
+  REQUIRE(reader.filepath().value() == std::filesystem::path("somefile.csv"));
+  REQUIRE(reader.history().size() == 1);
+  REQUIRE(reader.history()[0].payload == "status=todo");
+
+  reader.push_action(ViewAction(ViewOpType::Sort, "priority desc"));
+  reader.persist();
+  ViewStorage again;
+  REQUIRE(again.load_from_storage());
+  REQUIRE(again.history().size() == 2);
+}